@@ -83,6 +83,33 @@ typedef struct trace_s
 
 typedef int cmHandle_t;
 
+// translation for idCollisionModelManager::TranslationBatch, same arguments as Translation
+typedef struct
+{
+	idVec3					start;
+	idVec3					end;
+	const idTraceModel* 	trm;
+	idMat3					trmAxis;
+	int						contentMask;
+	cmHandle_t				model;
+	idVec3					modelOrigin;
+	idMat3					modelAxis;
+	trace_t					result;			// output
+} cmTranslationRequest_t;
+
+// contents test for idCollisionModelManager::ContentsBatch, same arguments as Contents
+typedef struct
+{
+	idVec3					start;
+	const idTraceModel* 	trm;
+	idMat3					trmAxis;
+	int						contentMask;
+	cmHandle_t				model;
+	idVec3					modelOrigin;
+	idMat3					modelAxis;
+	int						contents;		// output
+} cmContentsRequest_t;
+
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
@@ -136,6 +163,12 @@ public:
 									  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 									  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis ) = 0;
 
+	// Traces all requests and fills in their results. The requests are spread over the job threads
+	// if there are enough of them. All traces, also the single ones above, are thread safe as long as
+	// no models are loaded or freed and SetupTrmModel isn't called at the same time.
+	virtual void			TranslationBatch( cmTranslationRequest_t* requests, const int numRequests ) = 0;
+	virtual void			ContentsBatch( cmContentsRequest_t* requests, const int numRequests ) = 0;
+
 	// Tests collision detection.
 	virtual void			DebugOutput( const idVec3& origin ) = 0;
 	// Draws a model.
@@ -0,0 +1,462 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+/*
+===============================================================================
+
+	Trace contexts and batched traces.
+
+===============================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "CollisionModel_local.h"
+
+static idCVar cm_parallelTraces( "cm_parallelTraces", "1", CVAR_SYSTEM | CVAR_BOOL, "spread batched collision traces over the job threads" );
+static idCVar cm_minTracesPerJob( "cm_minTracesPerJob", "32", CVAR_SYSTEM | CVAR_INTEGER, "minimum number of batched traces handed to a single job", 1, 4096 );
+
+#define MIN_CHECKED_SET_SIZE				1024
+#define MAX_TRACE_BATCH_JOBS				32
+
+/*
+===============================================================================
+
+Trace contexts
+
+===============================================================================
+*/
+
+/*
+================
+CM_GrowCheckedSet
+
+  doubles the size of the checked primitive set and re-inserts the primitives checked during the current trace
+================
+*/
+void CM_GrowCheckedSet( cm_traceContext_t* context )
+{
+	idList< const void*, TAG_COLLISION > oldPrimitives;
+	idList< int, TAG_COLLISION > oldCounts;
+
+	oldPrimitives.Swap( context->checkedPrimitives );
+	oldCounts.Swap( context->checkedCounts );
+
+	const int newSize = Max( oldCounts.Num() * 2, MIN_CHECKED_SET_SIZE );
+	context->checkedPrimitives.SetNum( newSize );
+	context->checkedCounts.SetNum( newSize );
+	memset( context->checkedCounts.Ptr(), 0, newSize * sizeof( int ) );
+
+	const int mask = newSize - 1;
+	for( int i = 0; i < oldCounts.Num(); i++ )
+	{
+		if( oldCounts[i] != context->checkCount )
+		{
+			continue;
+		}
+		int index = CM_CheckedHash( oldPrimitives[i], mask );
+		while( context->checkedCounts[index] == context->checkCount )
+		{
+			index = ( index + 1 ) & mask;
+		}
+		context->checkedPrimitives[index] = oldPrimitives[i];
+		context->checkedCounts[index] = context->checkCount;
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceContext
+
+  returns the trace context of the calling thread, registers the thread on first use
+================
+*/
+cm_traceContext_t* idCollisionModelManagerLocal::GetTraceContext()
+{
+	ptrdiff_t index = traceContextIndex;
+	if( index == 0 )
+	{
+		index = numTraceContexts.Increment();
+		if( index > MAX_TRACE_CONTEXTS )
+		{
+			common->FatalError( "idCollisionModelManagerLocal::GetTraceContext: more than %d threads tracing", MAX_TRACE_CONTEXTS );
+		}
+		traceContextIndex = index;
+	}
+
+	// the slot of a thread is kept when the contexts are freed with the map
+	cm_traceContext_t* context = traceContexts[index - 1];
+	if( context == NULL )
+	{
+		context = new( TAG_COLLISION ) cm_traceContext_t;
+		CM_GrowCheckedSet( context );
+		traceContexts[index - 1] = context;
+	}
+	return context;
+}
+
+/*
+================
+idCollisionModelManagerLocal::BeginTrace
+
+  starts a new trace in the context, tw->model must be set
+================
+*/
+void idCollisionModelManagerLocal::BeginTrace( cm_traceWork_t* tw, cm_traceContext_t* context )
+{
+	context->checkCount++;
+	context->numChecked = 0;
+
+	// states left behind by earlier traces never match the new check count, so they only
+	// need to be cleared when the arrays grow
+	if( context->vertexStates.Num() < tw->model->maxVertices )
+	{
+		context->vertexStates.SetNum( tw->model->maxVertices );
+		memset( context->vertexStates.Ptr(), 0, context->vertexStates.Num() * sizeof( cm_traceState_t ) );
+	}
+	if( context->edgeStates.Num() < tw->model->maxEdges )
+	{
+		context->edgeStates.SetNum( tw->model->maxEdges );
+		memset( context->edgeStates.Ptr(), 0, context->edgeStates.Num() * sizeof( cm_traceState_t ) );
+	}
+
+	tw->context = context;
+	tw->checkCount = context->checkCount;
+	tw->vertexStates = context->vertexStates.Ptr();
+	tw->edgeStates = context->edgeStates.Ptr();
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeTraceContexts
+================
+*/
+void idCollisionModelManagerLocal::FreeTraceContexts()
+{
+	for( int i = 0; i < MAX_TRACE_CONTEXTS; i++ )
+	{
+		delete traceContexts[i];
+		traceContexts[i] = NULL;
+	}
+
+	if( batchJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( batchJobList );
+		batchJobList = NULL;
+	}
+}
+
+/*
+===============================================================================
+
+Batched traces
+
+===============================================================================
+*/
+
+struct cmTraceBatchJob_t
+{
+	cmTranslationRequest_t* 	translations;
+	cmContentsRequest_t* 		contents;
+	int							numRequests;
+};
+
+/*
+================
+CM_TraceBatchJob
+================
+*/
+static void CM_TraceBatchJob( cmTraceBatchJob_t* job )
+{
+	for( int i = 0; i < job->numRequests; i++ )
+	{
+		if( job->translations != NULL )
+		{
+			cmTranslationRequest_t& r = job->translations[i];
+			collisionModelManager->Translation( &r.result, r.start, r.end, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+		}
+		else
+		{
+			cmContentsRequest_t& r = job->contents[i];
+			r.contents = collisionModelManager->Contents( r.start, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( CM_TraceBatchJob, "CM_TraceBatchJob" );
+
+/*
+================
+CM_NumTraceBatchJobs
+
+  returns the number of jobs to split a batch into, 1 if it should be traced on the calling thread
+================
+*/
+static int CM_NumTraceBatchJobs( const int numRequests )
+{
+	// job lists are only ever submitted from the main thread, batches issued
+	// from job threads are simply traced on that thread
+	if( !cm_parallelTraces.GetBool() || !idLib::IsMainThread() )
+	{
+		return 1;
+	}
+	const int maxJobs = Min( parallelJobManager->GetNumProcessingUnits() * 2, MAX_TRACE_BATCH_JOBS );
+	return idMath::ClampInt( 1, maxJobs, numRequests / cm_minTracesPerJob.GetInteger() );
+}
+
+/*
+================
+idCollisionModelManagerLocal::TranslationBatch
+================
+*/
+void idCollisionModelManagerLocal::TranslationBatch( cmTranslationRequest_t* requests, const int numRequests )
+{
+	const int numJobs = CM_NumTraceBatchJobs( numRequests );
+	if( numJobs <= 1 )
+	{
+		for( int i = 0; i < numRequests; i++ )
+		{
+			cmTranslationRequest_t& r = requests[i];
+			Translation( &r.result, r.start, r.end, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+		}
+		return;
+	}
+
+	if( batchJobList == NULL )
+	{
+		batchJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_TRACE_BATCH_JOBS, 0, NULL );
+	}
+
+	cmTraceBatchJob_t jobs[MAX_TRACE_BATCH_JOBS];
+	for( int i = 0; i < numJobs; i++ )
+	{
+		const int first = ( int )( ( int64 )numRequests * i / numJobs );
+		const int last = ( int )( ( int64 )numRequests * ( i + 1 ) / numJobs );
+		jobs[i].translations = requests + first;
+		jobs[i].contents = NULL;
+		jobs[i].numRequests = last - first;
+		batchJobList->AddJob( ( jobRun_t )CM_TraceBatchJob, &jobs[i] );
+	}
+	batchJobList->Submit();
+	batchJobList->Wait();
+}
+
+/*
+================
+idCollisionModelManagerLocal::ContentsBatch
+================
+*/
+void idCollisionModelManagerLocal::ContentsBatch( cmContentsRequest_t* requests, const int numRequests )
+{
+	const int numJobs = CM_NumTraceBatchJobs( numRequests );
+	if( numJobs <= 1 )
+	{
+		for( int i = 0; i < numRequests; i++ )
+		{
+			cmContentsRequest_t& r = requests[i];
+			r.contents = Contents( r.start, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+		}
+		return;
+	}
+
+	if( batchJobList == NULL )
+	{
+		batchJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_TRACE_BATCH_JOBS, 0, NULL );
+	}
+
+	cmTraceBatchJob_t jobs[MAX_TRACE_BATCH_JOBS];
+	for( int i = 0; i < numJobs; i++ )
+	{
+		const int first = ( int )( ( int64 )numRequests * i / numJobs );
+		const int last = ( int )( ( int64 )numRequests * ( i + 1 ) / numJobs );
+		jobs[i].translations = NULL;
+		jobs[i].contents = requests + first;
+		jobs[i].numRequests = last - first;
+		batchJobList->AddJob( ( jobRun_t )CM_TraceBatchJob, &jobs[i] );
+	}
+	batchJobList->Submit();
+	batchJobList->Wait();
+}
+
+/*
+===============================================================================
+
+Trace throughput test
+
+===============================================================================
+*/
+
+/*
+================
+testCollisionTraces
+================
+*/
+CONSOLE_COMMAND( testCollisionTraces, "measures collision trace throughput on the current map through the BSP tree, the BVH and batched, usage: testCollisionTraces [numTraces]", 0 )
+{
+	idBounds worldBounds;
+	if( !collisionModelManager->GetModelBounds( 0, worldBounds ) )
+	{
+		common->Printf( "no collision map loaded\n" );
+		return;
+	}
+
+	int numTraces = 16384;
+	if( args.Argc() > 1 )
+	{
+		numTraces = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	idTraceModel boxTrm( idBounds( idVec3( -16.0f, -16.0f, 0.0f ), idVec3( 16.0f, 16.0f, 64.0f ) ) );
+	const int contentMask = CONTENTS_SOLID | CONTENTS_PLAYERCLIP;
+	idRandom random( 0 );
+
+	// every other trace is a point trace, the others move a player sized box
+	idList< cmTranslationRequest_t, TAG_COLLISION > translations;
+	idList< cmContentsRequest_t, TAG_COLLISION > contents;
+	translations.SetNum( numTraces );
+	contents.SetNum( numTraces );
+	for( int i = 0; i < numTraces; i++ )
+	{
+		idVec3 start, dir;
+		for( int j = 0; j < 3; j++ )
+		{
+			start[j] = worldBounds[0][j] + random.RandomFloat() * ( worldBounds[1][j] - worldBounds[0][j] );
+			dir[j] = random.CRandomFloat();
+		}
+		dir.Normalize();
+
+		cmTranslationRequest_t& t = translations[i];
+		t.start = start;
+		t.end = start + dir * ( 64.0f + random.RandomFloat() * 960.0f );
+		t.trm = ( i & 1 ) ? &boxTrm : NULL;
+		t.trmAxis = mat3_identity;
+		t.contentMask = contentMask;
+		t.model = 0;
+		t.modelOrigin = vec3_origin;
+		t.modelAxis = mat3_identity;
+
+		cmContentsRequest_t& c = contents[i];
+		c.start = start;
+		c.trm = &boxTrm;
+		c.trmAxis = mat3_identity;
+		c.contentMask = contentMask;
+		c.model = 0;
+		c.modelOrigin = vec3_origin;
+		c.modelAxis = mat3_identity;
+	}
+
+	// serial, through the axial BSP tree and through the BVH, the BSP tree results are the reference
+	const char* treeNames[2] = { "BSP", "BVH" };
+	idList< trace_t, TAG_COLLISION > serialResults[2];
+	idList< int, TAG_COLLISION > serialContents[2];
+	double serialTranslationMsec[2];
+	double serialContentsMsec[2];
+	const bool useBVH = cm_useBVH.GetBool();
+
+	// the BVHs are only built at load time when cm_useBVH is set
+	collisionModelManagerLocal.BuildMissingBVHs();
+
+	idTimer timer;
+	for( int tree = 0; tree < 2; tree++ )
+	{
+		cm_useBVH.SetBool( tree != 0 );
+		serialResults[tree].SetNum( numTraces );
+		serialContents[tree].SetNum( numTraces );
+
+		timer.Clear();
+		timer.Start();
+		for( int i = 0; i < numTraces; i++ )
+		{
+			const cmTranslationRequest_t& t = translations[i];
+			collisionModelManager->Translation( &serialResults[tree][i], t.start, t.end, t.trm, t.trmAxis, t.contentMask, t.model, t.modelOrigin, t.modelAxis );
+		}
+		timer.Stop();
+		serialTranslationMsec[tree] = timer.Milliseconds();
+
+		timer.Clear();
+		timer.Start();
+		for( int i = 0; i < numTraces; i++ )
+		{
+			const cmContentsRequest_t& c = contents[i];
+			serialContents[tree][i] = collisionModelManager->Contents( c.start, c.trm, c.trmAxis, c.contentMask, c.model, c.modelOrigin, c.modelAxis );
+		}
+		timer.Stop();
+		serialContentsMsec[tree] = timer.Milliseconds();
+	}
+	cm_useBVH.SetBool( useBVH );
+
+	// batched, through the tree selected with cm_useBVH
+	timer.Clear();
+	timer.Start();
+	collisionModelManager->TranslationBatch( translations.Ptr(), numTraces );
+	timer.Stop();
+	const double batchTranslationMsec = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	collisionModelManager->ContentsBatch( contents.Ptr(), numTraces );
+	timer.Stop();
+	const double batchContentsMsec = timer.Milliseconds();
+
+	int numTreeMismatches = 0;
+	int numBatchMismatches = 0;
+	for( int i = 0; i < numTraces; i++ )
+	{
+		const trace_t& a = serialResults[0][i];
+		const trace_t& b = serialResults[1][i];
+		const trace_t& c = translations[i].result;
+		if( a.fraction != b.fraction || a.endpos != b.endpos || a.c.contents != b.c.contents || serialContents[0][i] != serialContents[1][i] )
+		{
+			numTreeMismatches++;
+		}
+		if( a.fraction != c.fraction || a.endpos != c.endpos || a.c.contents != c.c.contents || serialContents[0][i] != contents[i].contents )
+		{
+			numBatchMismatches++;
+		}
+	}
+
+	common->Printf( "%d traces on %d job threads (cm_parallelTraces %d, cm_useBVH %d)\n", numTraces, parallelJobManager->GetNumProcessingUnits(), cm_parallelTraces.GetInteger(), cm_useBVH.GetInteger() );
+	for( int tree = 0; tree < 2; tree++ )
+	{
+		common->Printf( "serial %s:  translation %7.2f ms %9.0f traces/s, contents %7.2f ms %9.0f tests/s\n", treeNames[tree],
+						serialTranslationMsec[tree], numTraces * 1000.0 / Max( serialTranslationMsec[tree], 0.001 ),
+						serialContentsMsec[tree], numTraces * 1000.0 / Max( serialContentsMsec[tree], 0.001 ) );
+	}
+	common->Printf( "batched %s: translation %7.2f ms %9.0f traces/s, contents %7.2f ms %9.0f tests/s\n", treeNames[useBVH ? 1 : 0],
+					batchTranslationMsec, numTraces * 1000.0 / Max( batchTranslationMsec, 0.001 ),
+					batchContentsMsec, numTraces * 1000.0 / Max( batchContentsMsec, 0.001 ) );
+	if( numTreeMismatches > 0 )
+	{
+		common->Warning( "%d BVH results differ from the BSP tree results", numTreeMismatches );
+	}
+	if( numBatchMismatches > 0 )
+	{
+		common->Warning( "%d batched results differ from the serial results", numBatchMismatches );
+	}
+}
@@ -0,0 +1,645 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+/*
+===============================================================================
+
+	Flattened bounding volume hierarchy for collision models.
+
+===============================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "CollisionModel_local.h"
+
+idCVar cm_useBVH( "cm_useBVH", "0", CVAR_SYSTEM | CVAR_BOOL, "trace through the flattened BVH of the collision models instead of the axial BSP tree, the BVH is built when a map is loaded with this set" );
+
+/*
+===============================================================================
+
+Building
+
+===============================================================================
+*/
+
+typedef struct cm_bvhPrimitive_s
+{
+	idBounds				bounds;
+	idVec3					center;
+	cm_polygon_t* 			p;					// either a polygon
+	cm_brush_t* 			b;					// or a brush
+} cm_bvhPrimitive_t;
+
+typedef struct cm_bvhBuild_s
+{
+	idList< cm_bvhPrimitive_t, TAG_COLLISION >	primitives;
+	idList< cm_bvhNode_t, TAG_COLLISION >		nodes;
+	idList< cm_bvhLeaf_t, TAG_COLLISION >		leaves;
+	idList< cm_polygon_t*, TAG_COLLISION >		polygons;
+	idList< cm_brush_t*, TAG_COLLISION >		brushes;
+} cm_bvhBuild_t;
+
+/*
+================
+CM_BVHCollectPrimitives_r
+================
+*/
+static void CM_BVHCollectPrimitives_r( cm_bvhBuild_t& build, cm_node_t* node, int checkCount )
+{
+	while( 1 )
+	{
+		for( cm_polygonRef_t* pref = node->polygons; pref; pref = pref->next )
+		{
+			cm_polygon_t* p = pref->p;
+			if( p->checkcount == checkCount )
+			{
+				continue;
+			}
+			p->checkcount = checkCount;
+
+			cm_bvhPrimitive_t& prim = build.primitives.Alloc();
+			prim.bounds = p->bounds;
+			prim.center = p->bounds.GetCenter();
+			prim.p = p;
+			prim.b = NULL;
+		}
+		for( cm_brushRef_t* bref = node->brushes; bref; bref = bref->next )
+		{
+			cm_brush_t* b = bref->b;
+			if( b->checkcount == checkCount )
+			{
+				continue;
+			}
+			b->checkcount = checkCount;
+
+			cm_bvhPrimitive_t& prim = build.primitives.Alloc();
+			prim.bounds = b->bounds;
+			prim.center = b->bounds.GetCenter();
+			prim.p = NULL;
+			prim.b = b;
+		}
+		if( node->planeType == -1 )
+		{
+			break;
+		}
+		CM_BVHCollectPrimitives_r( build, node->children[1], checkCount );
+		node = node->children[0];
+	}
+}
+
+/*
+================
+CM_BVHSplit
+
+  partitions the primitives around the median center on the largest axis, returns the size of the first half
+================
+*/
+static int CM_BVHSplit( cm_bvhPrimitive_t* prims, int num )
+{
+	idBounds centerBounds;
+	centerBounds.Clear();
+	for( int i = 0; i < num; i++ )
+	{
+		centerBounds.AddPoint( prims[i].center );
+	}
+	const idVec3 size = centerBounds[1] - centerBounds[0];
+	const int axis = ( size[0] >= size[1] && size[0] >= size[2] ) ? 0 : ( ( size[1] >= size[2] ) ? 1 : 2 );
+
+	// quick select the median
+	const int median = num >> 1;
+	int lo = 0;
+	int hi = num - 1;
+	while( lo < hi )
+	{
+		const float pivot = prims[( lo + hi ) >> 1].center[axis];
+		int i = lo;
+		int j = hi;
+		while( i <= j )
+		{
+			while( prims[i].center[axis] < pivot )
+			{
+				i++;
+			}
+			while( prims[j].center[axis] > pivot )
+			{
+				j--;
+			}
+			if( i <= j )
+			{
+				SwapValues( prims[i], prims[j] );
+				i++;
+				j--;
+			}
+		}
+		if( median <= j )
+		{
+			hi = j;
+		}
+		else if( median >= i )
+		{
+			lo = i;
+		}
+		else
+		{
+			break;
+		}
+	}
+	return median;
+}
+
+/*
+================
+CM_BVHBuildNode_r
+================
+*/
+static int CM_BVHBuildNode_r( cm_bvhBuild_t& build, int first, int num )
+{
+	const int nodeNum = build.nodes.Num();
+	build.nodes.Alloc();
+
+	// split in halves twice to get up to four children
+	int groupFirst[CM_BVH_WIDTH];
+	int groupNum[CM_BVH_WIDTH];
+	int numGroups = 0;
+	if( num <= CM_BVH_MAX_LEAF_PRIMITIVES )
+	{
+		groupFirst[0] = first;
+		groupNum[0] = num;
+		numGroups = 1;
+	}
+	else
+	{
+		const int half = CM_BVHSplit( build.primitives.Ptr() + first, num );
+		const int halfFirst[2] = { first, first + half };
+		const int halfNum[2] = { half, num - half };
+		for( int i = 0; i < 2; i++ )
+		{
+			if( halfNum[i] <= CM_BVH_MAX_LEAF_PRIMITIVES )
+			{
+				groupFirst[numGroups] = halfFirst[i];
+				groupNum[numGroups] = halfNum[i];
+				numGroups++;
+				continue;
+			}
+			const int quarter = CM_BVHSplit( build.primitives.Ptr() + halfFirst[i], halfNum[i] );
+			groupFirst[numGroups] = halfFirst[i];
+			groupNum[numGroups] = quarter;
+			numGroups++;
+			groupFirst[numGroups] = halfFirst[i] + quarter;
+			groupNum[numGroups] = halfNum[i] - quarter;
+			numGroups++;
+		}
+	}
+
+	// the node list may be reallocated by the recursion so the node is filled in through its index
+	for( int i = 0; i < CM_BVH_WIDTH; i++ )
+	{
+		idBounds bounds;
+		int child = 0;
+
+		if( i < numGroups && groupNum[i] > 0 )
+		{
+			bounds.Clear();
+			for( int j = 0; j < groupNum[i]; j++ )
+			{
+				bounds.AddBounds( build.primitives[groupFirst[i] + j].bounds );
+			}
+
+			if( groupNum[i] <= CM_BVH_MAX_LEAF_PRIMITIVES )
+			{
+				cm_bvhLeaf_t& leaf = build.leaves.Alloc();
+				leaf.firstPolygon = build.polygons.Num();
+				leaf.firstBrush = build.brushes.Num();
+				for( int j = 0; j < groupNum[i]; j++ )
+				{
+					const cm_bvhPrimitive_t& prim = build.primitives[groupFirst[i] + j];
+					if( prim.p != NULL )
+					{
+						build.polygons.Append( prim.p );
+					}
+					else
+					{
+						build.brushes.Append( prim.b );
+					}
+				}
+				leaf.numPolygons = build.polygons.Num() - leaf.firstPolygon;
+				leaf.numBrushes = build.brushes.Num() - leaf.firstBrush;
+				child = ~( build.leaves.Num() - 1 );
+			}
+			else
+			{
+				child = CM_BVHBuildNode_r( build, groupFirst[i], groupNum[i] );
+			}
+		}
+		else
+		{
+			// unused children are skipped by their zero child index
+			bounds[0].Set( idMath::INFINITUM, idMath::INFINITUM, idMath::INFINITUM );
+			bounds[1].Set( -idMath::INFINITUM, -idMath::INFINITUM, -idMath::INFINITUM );
+		}
+
+		cm_bvhNode_t& node = build.nodes[nodeNum];
+		for( int axis = 0; axis < 3; axis++ )
+		{
+			node.mins[axis][i] = bounds[0][axis];
+			node.maxs[axis][i] = bounds[1][axis];
+		}
+		node.children[i] = child;
+	}
+	return nodeNum;
+}
+
+/*
+================
+CM_BVHMemory
+================
+*/
+static int CM_BVHMemory( const cm_model_t* model )
+{
+	return model->numBVHNodes * sizeof( cm_bvhNode_t ) +
+		   model->numBVHLeaves * sizeof( cm_bvhLeaf_t ) +
+		   model->numBVHPolygons * sizeof( cm_polygon_t* ) +
+		   model->numBVHBrushes * sizeof( cm_brush_t* );
+}
+
+/*
+================
+CM_BVHAllocArrays
+================
+*/
+static void CM_BVHAllocArrays( cm_model_t* model, int numNodes, int numLeaves, int numPolygons, int numBrushes )
+{
+	model->numBVHNodes = numNodes;
+	model->bvhNodes = ( cm_bvhNode_t* ) Mem_Alloc16( numNodes * sizeof( cm_bvhNode_t ), TAG_COLLISION );
+	model->numBVHLeaves = numLeaves;
+	model->bvhLeaves = ( cm_bvhLeaf_t* ) Mem_Alloc( Max( numLeaves, 1 ) * sizeof( cm_bvhLeaf_t ), TAG_COLLISION );
+	model->numBVHPolygons = numPolygons;
+	model->bvhPolygons = ( cm_polygon_t** ) Mem_Alloc( Max( numPolygons, 1 ) * sizeof( cm_polygon_t* ), TAG_COLLISION );
+	model->numBVHBrushes = numBrushes;
+	model->bvhBrushes = ( cm_brush_t** ) Mem_Alloc( Max( numBrushes, 1 ) * sizeof( cm_brush_t* ), TAG_COLLISION );
+}
+
+/*
+================
+idCollisionModelManagerLocal::BuildBVH
+================
+*/
+void idCollisionModelManagerLocal::BuildBVH( cm_model_t* model )
+{
+	FreeBVH( model );
+
+	if( model->node == NULL )
+	{
+		return;
+	}
+
+	cm_bvhBuild_t build;
+	checkCount++;
+	CM_BVHCollectPrimitives_r( build, model->node, checkCount );
+	if( build.primitives.Num() == 0 )
+	{
+		return;
+	}
+
+	CM_BVHBuildNode_r( build, 0, build.primitives.Num() );
+
+	CM_BVHAllocArrays( model, build.nodes.Num(), build.leaves.Num(), build.polygons.Num(), build.brushes.Num() );
+	memcpy( model->bvhNodes, build.nodes.Ptr(), build.nodes.Num() * sizeof( cm_bvhNode_t ) );
+	memcpy( model->bvhLeaves, build.leaves.Ptr(), build.leaves.Num() * sizeof( cm_bvhLeaf_t ) );
+	memcpy( model->bvhPolygons, build.polygons.Ptr(), build.polygons.Num() * sizeof( cm_polygon_t* ) );
+	memcpy( model->bvhBrushes, build.brushes.Ptr(), build.brushes.Num() * sizeof( cm_brush_t* ) );
+
+	model->usedMemory += CM_BVHMemory( model );
+}
+
+/*
+================
+idCollisionModelManagerLocal::BuildMissingBVHs
+
+  must not be called while traces are running on other threads
+================
+*/
+void idCollisionModelManagerLocal::BuildMissingBVHs()
+{
+	for( int i = 0; i < numModels; i++ )
+	{
+		if( models[i] != NULL && models[i]->bvhNodes == NULL )
+		{
+			BuildBVH( models[i] );
+		}
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeBVH
+================
+*/
+void idCollisionModelManagerLocal::FreeBVH( cm_model_t* model )
+{
+	if( model->bvhNodes == NULL )
+	{
+		return;
+	}
+	model->usedMemory -= CM_BVHMemory( model );
+
+	Mem_Free16( model->bvhNodes );
+	Mem_Free( model->bvhLeaves );
+	Mem_Free( model->bvhPolygons );
+	Mem_Free( model->bvhBrushes );
+	model->numBVHNodes = 0;
+	model->bvhNodes = NULL;
+	model->numBVHLeaves = 0;
+	model->bvhLeaves = NULL;
+	model->numBVHPolygons = 0;
+	model->bvhPolygons = NULL;
+	model->numBVHBrushes = 0;
+	model->bvhBrushes = NULL;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBVH
+
+  polys and brushes are in the order they were written, which is the BVH order
+================
+*/
+void idCollisionModelManagerLocal::ReadBVH( idFile* file, cm_model_t* model, const idList< cm_polygon_t* >& polys, const idList< cm_brush_t* >& brushes )
+{
+	int numNodes = 0;
+	int numLeaves = 0;
+	file->ReadBig( numNodes );
+	file->ReadBig( numLeaves );
+	if( numNodes <= 0 )
+	{
+		return;
+	}
+
+	CM_BVHAllocArrays( model, numNodes, numLeaves, polys.Num(), brushes.Num() );
+	for( int i = 0; i < numNodes; i++ )
+	{
+		cm_bvhNode_t& node = model->bvhNodes[i];
+		file->ReadBigArray( &node.mins[0][0], 3 * CM_BVH_WIDTH );
+		file->ReadBigArray( &node.maxs[0][0], 3 * CM_BVH_WIDTH );
+		file->ReadBigArray( node.children, CM_BVH_WIDTH );
+	}
+	for( int i = 0; i < numLeaves; i++ )
+	{
+		cm_bvhLeaf_t& leaf = model->bvhLeaves[i];
+		file->ReadBig( leaf.firstPolygon );
+		file->ReadBig( leaf.numPolygons );
+		file->ReadBig( leaf.firstBrush );
+		file->ReadBig( leaf.numBrushes );
+	}
+	memcpy( model->bvhPolygons, polys.Ptr(), polys.Num() * sizeof( cm_polygon_t* ) );
+	memcpy( model->bvhBrushes, brushes.Ptr(), brushes.Num() * sizeof( cm_brush_t* ) );
+
+	model->usedMemory += CM_BVHMemory( model );
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBVH
+================
+*/
+void idCollisionModelManagerLocal::WriteBVH( idFile* file, const cm_model_t* model )
+{
+	file->WriteBig( model->numBVHNodes );
+	file->WriteBig( model->numBVHLeaves );
+	for( int i = 0; i < model->numBVHNodes; i++ )
+	{
+		const cm_bvhNode_t& node = model->bvhNodes[i];
+		file->WriteBigArray( &node.mins[0][0], 3 * CM_BVH_WIDTH );
+		file->WriteBigArray( &node.maxs[0][0], 3 * CM_BVH_WIDTH );
+		file->WriteBigArray( node.children, CM_BVH_WIDTH );
+	}
+	for( int i = 0; i < model->numBVHLeaves; i++ )
+	{
+		const cm_bvhLeaf_t& leaf = model->bvhLeaves[i];
+		file->WriteBig( leaf.firstPolygon );
+		file->WriteBig( leaf.numPolygons );
+		file->WriteBig( leaf.firstBrush );
+		file->WriteBig( leaf.numBrushes );
+	}
+}
+
+/*
+===============================================================================
+
+Tracing
+
+===============================================================================
+*/
+
+/*
+================
+idCollisionModelManagerLocal::TraceThroughBVH
+
+  Same as TraceThroughAxialBSPTree_r but walks the flattened hierarchy front to back.
+  The trace is a line from p1 to p2, the child bounds are expanded with the trace extents.
+================
+*/
+void idCollisionModelManagerLocal::TraceThroughBVH( cm_traceWork_t* tw, const idVec3& p1, const idVec3& p2 )
+{
+	const cm_model_t* model = tw->model;
+
+	// zero direction components are replaced by a tiny value so the slab test needs no special case
+	idVec3 invDir;
+	for( int i = 0; i < 3; i++ )
+	{
+		float d = p2[i] - p1[i];
+		if( idMath::Fabs( d ) < 1e-20f )
+		{
+			d = ( d < 0.0f ) ? -1e-20f : 1e-20f;
+		}
+		invDir[i] = 1.0f / d;
+	}
+
+	int stackNodes[CM_BVH_MAX_STACK];
+	float stackFractions[CM_BVH_MAX_STACK];
+	int stackDepth = 0;
+
+	stackNodes[stackDepth] = 0;
+	stackFractions[stackDepth] = 0.0f;
+	stackDepth++;
+
+#if defined(USE_INTRINSICS_SSE)
+	const __m128 vector_float_zero = _mm_setzero_ps();
+	const __m128 vector_float_one = _mm_set1_ps( 1.0f );
+	const __m128 minOffset[3] =
+	{
+		_mm_set1_ps( -tw->extents[0] - p1[0] ),
+		_mm_set1_ps( -tw->extents[1] - p1[1] ),
+		_mm_set1_ps( -tw->extents[2] - p1[2] )
+	};
+	const __m128 maxOffset[3] =
+	{
+		_mm_set1_ps( tw->extents[0] - p1[0] ),
+		_mm_set1_ps( tw->extents[1] - p1[1] ),
+		_mm_set1_ps( tw->extents[2] - p1[2] )
+	};
+	const __m128 vectorInvDir[3] =
+	{
+		_mm_set1_ps( invDir[0] ),
+		_mm_set1_ps( invDir[1] ),
+		_mm_set1_ps( invDir[2] )
+	};
+#endif
+
+	while( stackDepth > 0 )
+	{
+		stackDepth--;
+		const int nodeNum = stackNodes[stackDepth];
+
+		if( tw->quickExit )
+		{
+			return;		// stop immediately
+		}
+		if( tw->trace.fraction <= stackFractions[stackDepth] )
+		{
+			continue;	// already hit something nearer
+		}
+
+		if( nodeNum < 0 )
+		{
+			// test the primitives in the leaf
+			const cm_bvhLeaf_t& leaf = model->bvhLeaves[~nodeNum];
+			if( tw->positionTest )
+			{
+				// test if any of the trm vertices is inside a brush
+				for( int i = 0; i < leaf.numBrushes; i++ )
+				{
+					if( TestTrmVertsInBrush( tw, model->bvhBrushes[leaf.firstBrush + i] ) )
+					{
+						return;
+					}
+				}
+				// if just testing a point we're done
+				if( tw->pointTrace )
+				{
+					continue;
+				}
+				// test if the trm is stuck in any polygons
+				for( int i = 0; i < leaf.numPolygons; i++ )
+				{
+					if( TestTrmInPolygon( tw, model->bvhPolygons[leaf.firstPolygon + i] ) )
+					{
+						return;
+					}
+				}
+			}
+			else if( tw->rotation )
+			{
+				for( int i = 0; i < leaf.numPolygons; i++ )
+				{
+					if( RotateTrmThroughPolygon( tw, model->bvhPolygons[leaf.firstPolygon + i] ) )
+					{
+						return;
+					}
+				}
+			}
+			else
+			{
+				for( int i = 0; i < leaf.numPolygons; i++ )
+				{
+					if( TranslateTrmThroughPolygon( tw, model->bvhPolygons[leaf.firstPolygon + i] ) )
+					{
+						return;
+					}
+				}
+			}
+			continue;
+		}
+
+		const cm_bvhNode_t& node = model->bvhNodes[nodeNum];
+
+		// fractions at which the trace enters and leaves the expanded bounds of the four children
+		ALIGN16( float enter[CM_BVH_WIDTH] );
+		int hitBits;
+
+#if defined(USE_INTRINSICS_SSE)
+		__m128 tnear = vector_float_zero;
+		__m128 tfar = vector_float_one;
+		for( int axis = 0; axis < 3; axis++ )
+		{
+			const __m128 t0 = _mm_mul_ps( _mm_add_ps( _mm_load_ps( node.mins[axis] ), minOffset[axis] ), vectorInvDir[axis] );
+			const __m128 t1 = _mm_mul_ps( _mm_add_ps( _mm_load_ps( node.maxs[axis] ), maxOffset[axis] ), vectorInvDir[axis] );
+			tnear = _mm_max_ps( tnear, _mm_min_ps( t0, t1 ) );
+			tfar = _mm_min_ps( tfar, _mm_max_ps( t0, t1 ) );
+		}
+		_mm_store_ps( enter, tnear );
+		hitBits = _mm_movemask_ps( _mm_cmple_ps( tnear, tfar ) );
+#else
+		hitBits = 0;
+		for( int i = 0; i < CM_BVH_WIDTH; i++ )
+		{
+			float tnear = 0.0f;
+			float tfar = 1.0f;
+			for( int axis = 0; axis < 3; axis++ )
+			{
+				const float t0 = ( node.mins[axis][i] - tw->extents[axis] - p1[axis] ) * invDir[axis];
+				const float t1 = ( node.maxs[axis][i] + tw->extents[axis] - p1[axis] ) * invDir[axis];
+				tnear = Max( tnear, Min( t0, t1 ) );
+				tfar = Min( tfar, Max( t0, t1 ) );
+			}
+			enter[i] = tnear;
+			hitBits |= ( tnear <= tfar ) << i;
+		}
+#endif
+
+		// push the children far to near so the nearest one is traced first
+		int order[CM_BVH_WIDTH];
+		int numHit = 0;
+		for( int i = 0; i < CM_BVH_WIDTH; i++ )
+		{
+			if( !( hitBits & ( 1 << i ) ) || node.children[i] == 0 || enter[i] >= tw->trace.fraction )
+			{
+				continue;
+			}
+			int j = numHit++;
+			for( ; j > 0 && enter[order[j - 1]] < enter[i]; j-- )
+			{
+				order[j] = order[j - 1];
+			}
+			order[j] = i;
+		}
+		if( stackDepth + numHit > CM_BVH_MAX_STACK )
+		{
+			common->Warning( "idCollisionModelManagerLocal::TraceThroughBVH: stack overflow in %s", model->name.c_str() );
+			return;
+		}
+		for( int i = 0; i < numHit; i++ )
+		{
+			stackNodes[stackDepth] = node.children[order[i]];
+			stackFractions[stackDepth] = enter[order[i]];
+			stackDepth++;
+		}
+	}
+}
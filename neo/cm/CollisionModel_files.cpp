@@ -597,6 +597,11 @@ cm_model_t* idCollisionModelManagerLocal::ParseCollisionModel( idLexer* src )
 						model->numNodes * sizeof( cm_node_t ) +
 						model->numPolygonRefs * sizeof( cm_polygonRef_t ) +
 						model->numBrushRefs * sizeof( cm_brushRef_t );
+	// flattened hierarchy for faster traces
+	if( cm_useBVH.GetBool() )
+	{
+		BuildBVH( model );
+	}
 
 	return model;
 }
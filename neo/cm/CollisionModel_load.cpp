@@ -204,10 +204,6 @@ void idCollisionModelManagerLocal::Clear()
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -419,6 +415,8 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t* model )
 	{
 		FreeTree_r( model, model->node, model->node );
 	}
+	// free the flattened hierarchy
+	FreeBVH( model );
 	// free blocks with polygon references
 	for( polygonRefBlock = model->polygonRefBlocks; polygonRefBlock; polygonRefBlock = nextPolygonRefBlock )
 	{
@@ -480,6 +478,8 @@ void idCollisionModelManagerLocal::FreeMap()
 	Clear();
 
 	ShutdownHash();
+
+	FreeTraceContexts();
 }
 
 /*
@@ -621,6 +621,14 @@ cm_model_t* idCollisionModelManagerLocal::AllocModel()
 	model->numEdges = 0;
 	model->edges = NULL;
 	model->node = NULL;
+	model->numBVHNodes = 0;
+	model->bvhNodes = NULL;
+	model->numBVHLeaves = 0;
+	model->bvhLeaves = NULL;
+	model->numBVHPolygons = 0;
+	model->bvhPolygons = NULL;
+	model->numBVHBrushes = 0;
+	model->bvhBrushes = NULL;
 	model->nodeBlocks = NULL;
 	model->polygonRefBlocks = NULL;
 	model->brushRefBlocks = NULL;
@@ -3486,10 +3494,17 @@ void idCollisionModelManagerLocal::FinishModel( cm_model_t* model )
 						model->numNodes * sizeof( cm_node_t ) +
 						model->numPolygonRefs * sizeof( cm_polygonRef_t ) +
 						model->numBrushRefs * sizeof( cm_brushRef_t );
+	// flattened hierarchy for faster traces
+	if( cm_useBVH.GetBool() )
+	{
+		BuildBVH( model );
+	}
 }
 
-static const byte BCM_VERSION = 100;
+static const byte BCM_VERSION = 101;		// 101 adds the flattened BVH
 static const unsigned int BCM_MAGIC = ( 'B' << 24 ) | ( 'C' << 16 ) | ( 'M' << 16 ) | BCM_VERSION;
+// version 100 files are still accepted, their BVH is built at load time
+static const unsigned int BCM_MAGIC_NO_BVH = ( 'B' << 24 ) | ( 'C' << 16 ) | ( 'M' << 16 ) | 100;
 
 /*
 ================
@@ -3501,7 +3516,7 @@ cm_model_t* idCollisionModelManagerLocal::LoadBinaryModelFromFile( idFile* file,
 
 	unsigned int magic = 0;
 	file->ReadBig( magic );
-	if( magic != BCM_MAGIC )
+	if( magic != BCM_MAGIC && magic != BCM_MAGIC_NO_BVH )
 	{
 		return NULL;
 	}
@@ -3672,6 +3687,16 @@ cm_model_t* idCollisionModelManagerLocal::LoadBinaryModelFromFile( idFile* file,
 						model->numNodes * sizeof( cm_node_t ) +
 						model->numPolygonRefs * sizeof( cm_polygonRef_t ) +
 						model->numBrushRefs * sizeof( cm_brushRef_t );
+
+	if( magic == BCM_MAGIC )
+	{
+		ReadBVH( file, model, polys, brushes );
+	}
+	// older files and files written without cm_useBVH have no BVH stored
+	if( model->bvhNodes == NULL && cm_useBVH.GetBool() )
+	{
+		BuildBVH( model );
+	}
 	return model;
 }
 
@@ -3777,7 +3802,18 @@ void idCollisionModelManagerLocal::WriteBinaryModelToFile( cm_model_t* model, id
 	};
 	idList< cm_polygon_t* > polys;
 	idList< cm_brush_t* > brushes;
-	local::BuildUniqueLists( model->node, polys, brushes );
+	if( model->bvhNodes != NULL )
+	{
+		// the BVH leaves index the primitives in the order they're written
+		polys.SetNum( model->numBVHPolygons );
+		memcpy( polys.Ptr(), model->bvhPolygons, model->numBVHPolygons * sizeof( cm_polygon_t* ) );
+		brushes.SetNum( model->numBVHBrushes );
+		memcpy( brushes.Ptr(), model->bvhBrushes, model->numBVHBrushes * sizeof( cm_brush_t* ) );
+	}
+	else
+	{
+		local::BuildUniqueLists( model->node, polys, brushes );
+	}
 	assert( polys.Num() == model->numPolygons );
 	assert( brushes.Num() == model->numBrushes );
 
@@ -3823,6 +3859,7 @@ void idCollisionModelManagerLocal::WriteBinaryModelToFile( cm_model_t* model, id
 		file->WriteBigArray( brushes[i]->planes, brushes[i]->numPlanes );
 	}
 	local::WriteNodeTree( file, model->node, polys, brushes );
+	WriteBVH( file, model );
 }
 
 /*
@@ -4167,6 +4204,7 @@ void idCollisionModelManagerLocal::PrintModelInfo( const cm_model_t* model )
 	common->Printf( "%6i nodes (%i KB)\n", model->numNodes, ( model->numNodes * sizeof( cm_node_t ) ) >> 10 );
 	common->Printf( "%6i polygon refs (%i KB)\n", model->numPolygonRefs, ( model->numPolygonRefs * sizeof( cm_polygonRef_t ) ) >> 10 );
 	common->Printf( "%6i brush refs (%i KB)\n", model->numBrushRefs, ( model->numBrushRefs * sizeof( cm_brushRef_t ) ) >> 10 );
+	common->Printf( "%6i BVH nodes (%i KB)\n", model->numBVHNodes, ( model->numBVHNodes * sizeof( cm_bvhNode_t ) ) >> 10 );
 	common->Printf( "%6i internal edges\n", model->numInternalEdges );
 	common->Printf( "%6i sharp edges\n", model->numSharpEdges );
 	common->Printf( "%6i contained polygons removed\n", model->numRemovedPolys );
@@ -4196,6 +4234,7 @@ void idCollisionModelManagerLocal::AccumulateModelInfo( cm_model_t* model )
 		model->numNodes += models[i]->numNodes;
 		model->numBrushRefs += models[i]->numBrushRefs;
 		model->numPolygonRefs += models[i]->numPolygonRefs;
+		model->numBVHNodes += models[i]->numBVHNodes;
 		model->numInternalEdges += models[i]->numInternalEdges;
 		model->numSharpEdges += models[i]->numSharpEdges;
 		model->numRemovedPolys += models[i]->numRemovedPolys;
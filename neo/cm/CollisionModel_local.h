@@ -185,6 +185,39 @@ typedef struct cm_nodeBlock_s
 	struct cm_nodeBlock_s* next;				// next block with nodes
 } cm_nodeBlock_t;
 
+/*
+===============================================================================
+
+Flattened bounding volume hierarchy
+
+An alternative to the axial BSP tree, built from the same polygons and brushes.
+Every node stores the bounds of its four children in rows per axis so a trace
+can test all of them at once with SSE. Each primitive is referenced by exactly
+one leaf and the leaves index contiguous ranges of the model's BVH polygon and
+brush arrays.
+
+===============================================================================
+*/
+
+#define CM_BVH_WIDTH				4		// children per node
+#define CM_BVH_MAX_LEAF_PRIMITIVES	4		// max primitives in a leaf
+#define CM_BVH_MAX_STACK			256		// traversal stack size
+
+typedef struct cm_bvhNode_s
+{
+	float					mins[3][CM_BVH_WIDTH];	// child bounds
+	float					maxs[3][CM_BVH_WIDTH];
+	int						children[CM_BVH_WIDTH];	// > 0 node index, < 0 ~leaf index, 0 unused
+} cm_bvhNode_t;
+
+typedef struct cm_bvhLeaf_s
+{
+	int						firstPolygon;		// index into cm_model_t::bvhPolygons
+	int						numPolygons;
+	int						firstBrush;			// index into cm_model_t::bvhBrushes
+	int						numBrushes;
+} cm_bvhLeaf_t;
+
 typedef struct cm_model_s
 {
 	idStr					name;				// model name
@@ -199,6 +232,15 @@ typedef struct cm_model_s
 	int						numEdges;			// number of edges
 	cm_edge_t* 				edges;				// array with all edges used by the model
 	cm_node_t* 				node;				// first node of spatial subdivision
+	// flattened bounding volume hierarchy, NULL nodes if not built
+	int						numBVHNodes;
+	cm_bvhNode_t* 			bvhNodes;			// first node is the root
+	int						numBVHLeaves;
+	cm_bvhLeaf_t* 			bvhLeaves;
+	int						numBVHPolygons;
+	cm_polygon_t** 			bvhPolygons;		// every polygon once, ordered by leaf
+	int						numBVHBrushes;
+	cm_brush_t** 			bvhBrushes;			// every brush once, ordered by leaf
 	// blocks with allocated memory
 	cm_nodeBlock_t* 		nodeBlocks;			// list with blocks of nodes
 	cm_polygonRefBlock_t* 	polygonRefBlocks;	// list with blocks of polygon references
@@ -261,6 +303,17 @@ typedef struct cm_trmPolygon_s
 	idBounds rotationBounds;						// rotation bounds for this polygon
 } cm_trmPolygon_t;
 
+// per thread state of a model vertex or edge during a trace, kept out of cm_vertex_t and
+// cm_edge_t so traces on different threads never write to the shared collision models
+typedef struct cm_traceState_s
+{
+	int						checkcount;			// for multi-check avoidance
+	unsigned int			side;				// same as cm_vertex_t::side and cm_edge_t::side
+	unsigned int			sideSet;
+} cm_traceState_t;
+
+struct cm_traceContext_s;
+
 typedef struct cm_traceWork_s
 {
 	int numVerts;
@@ -279,6 +332,11 @@ typedef struct cm_traceWork_s
 	int contents;									// ignore polygons that do not have any of these contents flags
 	trace_t trace;									// collision detection result
 
+	struct cm_traceContext_s* context;				// trace context of the calling thread
+	int checkCount;									// for multi-check avoidance, unique for every trace of the context
+	cm_traceState_t* vertexStates;					// indexed like model->vertices
+	cm_traceState_t* edgeStates;					// indexed like model->edges
+
 	bool rotation;									// true if calculating rotational collision
 	bool pointTrace;								// true if only tracing a point
 	bool positionTest;								// true if not tracing but doing a position test
@@ -311,6 +369,89 @@ typedef struct cm_traceWork_s
 /*
 ===============================================================================
 
+Trace contexts
+
+Every thread that traces gets its own context with the check counts and
+sidedness caches that used to live in the collision model primitives, so
+Translation, Rotation, Contents and Contacts can run on several threads at
+once. Polygons and brushes aren't numbered, the ones checked during the
+current trace are kept in a small open addressing hash set instead.
+
+===============================================================================
+*/
+
+#define MAX_TRACE_CONTEXTS					64
+
+typedef struct cm_traceContext_s
+{
+	cm_traceContext_s()
+	{
+		checkCount = 0;
+		numChecked = 0;
+		getContacts = false;
+		contacts = NULL;
+		maxContacts = 0;
+		numContacts = 0;
+		memset( ( void* )&translationWork, 0, sizeof( translationWork ) );
+		memset( ( void* )&rotationWork, 0, sizeof( rotationWork ) );
+	}
+
+	int						checkCount;
+	idList< cm_traceState_t, TAG_COLLISION >	vertexStates;	// grown to the largest model traced
+	idList< cm_traceState_t, TAG_COLLISION >	edgeStates;
+	// polygons and brushes checked during the current trace
+	idList< const void*, TAG_COLLISION >		checkedPrimitives;
+	idList< int, TAG_COLLISION >				checkedCounts;
+	int						numChecked;
+	// for retrieving contact points
+	bool					getContacts;
+	contactInfo_t* 			contacts;
+	int						maxContacts;
+	int						numContacts;
+	// trace work for translations and rotations, too large for the stack
+	cm_traceWork_t			translationWork;
+	cm_traceWork_t			rotationWork;
+} cm_traceContext_t;
+
+void CM_GrowCheckedSet( cm_traceContext_t* context );
+
+ID_INLINE int CM_CheckedHash( const void* primitive, const int mask )
+{
+	return ( int )( ( ( uintptr_t )primitive >> 3 ) * 2654435761u ) & mask;
+}
+
+/*
+================
+CM_SetChecked
+
+  returns true if the polygon or brush was already checked during this trace, otherwise marks it as checked
+================
+*/
+ID_INLINE bool CM_SetChecked( cm_traceWork_t* tw, const void* primitive )
+{
+	cm_traceContext_t* context = tw->context;
+	const int mask = context->checkedCounts.Num() - 1;
+	int index = CM_CheckedHash( primitive, mask );
+	while( context->checkedCounts[index] == tw->checkCount )
+	{
+		if( context->checkedPrimitives[index] == primitive )
+		{
+			return true;
+		}
+		index = ( index + 1 ) & mask;
+	}
+	context->checkedPrimitives[index] = primitive;
+	context->checkedCounts[index] = tw->checkCount;
+	if( ++context->numChecked * 2 > context->checkedCounts.Num() )
+	{
+		CM_GrowCheckedSet( context );
+	}
+	return false;
+}
+
+/*
+===============================================================================
+
 Collision Map
 
 ===============================================================================
@@ -367,6 +508,11 @@ public:
 	int				Contacts( contactInfo_t* contacts, const int maxContacts, const idVec3& start, const idVec6& dir, const float depth,
 							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 							  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
+	// batched traces spread over the job threads
+	void			TranslationBatch( cmTranslationRequest_t* requests, const int numRequests );
+	void			ContentsBatch( cmContentsRequest_t* requests, const int numRequests );
+	// builds the BVH of every loaded model that doesn't have one yet
+	void			BuildMissingBVHs();
 	// test collision detection
 	void			DebugOutput( const idVec3& origin );
 	// draw a model
@@ -430,9 +576,22 @@ private:			// CollisionMap_contents.cpp
 private:			// CollisionMap_trace.cpp
 	void			TraceTrmThroughNode( cm_traceWork_t* tw, cm_node_t* node );
 	void			TraceThroughAxialBSPTree_r( cm_traceWork_t* tw, cm_node_t* node, float p1f, float p2f, idVec3& p1, idVec3& p2 );
+	void			TraceThroughSpatialSubdivision( cm_traceWork_t* tw, idVec3& p1, idVec3& p2 );
 	void			TraceThroughModel( cm_traceWork_t* tw );
 	void			RecurseProcBSP_r( trace_t* results, int parentNodeNum, int nodeNum, float p1f, float p2f, const idVec3& p1, const idVec3& p2 );
 
+private:			// CollisionMap_bvh.cpp
+	void			BuildBVH( cm_model_t* model );
+	void			FreeBVH( cm_model_t* model );
+	void			ReadBVH( idFile* file, cm_model_t* model, const idList< cm_polygon_t* >& polys, const idList< cm_brush_t* >& brushes );
+	void			WriteBVH( idFile* file, const cm_model_t* model );
+	void			TraceThroughBVH( cm_traceWork_t* tw, const idVec3& p1, const idVec3& p2 );
+
+private:			// CollisionMap_batch.cpp
+	cm_traceContext_t* GetTraceContext();
+	void			BeginTrace( cm_traceWork_t* tw, cm_traceContext_t* context );
+	void			FreeTraceContexts();
+
 private:			// CollisionMap_load.cpp
 	void			Clear();
 	void			FreeTrmModelStructure();
@@ -557,12 +716,16 @@ private:			// collision map data
 	// for data pruning
 	int				numProcNodes;
 	cm_procNode_t* 	procNodes;
-	// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t* 	contacts;
-	int				maxContacts;
-	int				numContacts;
+	// per thread trace contexts
+	cm_traceContext_t* traceContexts[MAX_TRACE_CONTEXTS];
+	idSysInterlockedInteger numTraceContexts;
+	ID_TLS			traceContextIndex;		// index + 1 into traceContexts[], 0 if the thread has none yet
+	idParallelJobList* batchJobList;
 };
 
+extern idCollisionModelManagerLocal	collisionModelManagerLocal;
+
+extern idCVar cm_useBVH;
+
 // for debugging
 extern idCVar cm_debugCollision;
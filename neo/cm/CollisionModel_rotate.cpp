@@ -554,7 +554,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t*
 		edge = tw->model->edges + abs( edgeNum );
 
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( tw->edgeStates[abs( edgeNum )].checkcount == tw->checkCount )
 		{
 			continue;
 		}
@@ -1190,14 +1190,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 	cm_trmPolygon_t* bp;
 	cm_vertex_t* v;
 	cm_edge_t* e;
+	cm_traceState_t* vs;
 	idVec3* rotationOrigin;
 
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( CM_SetChecked( tw, p ) )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -1311,12 +1311,12 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
 
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( tw->edgeStates[abs( edgeNum )].checkcount == tw->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			tw->edgeStates[abs( edgeNum )].checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -1327,14 +1327,15 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 			{
 
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
+				vs = tw->vertexStates + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( vs->checkcount == tw->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vs->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -1428,7 +1429,8 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceContext_t* context = idCollisionModelManagerLocal::GetTraceContext();
+	cm_traceWork_t& tw = context->rotationWork;
 
 	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
 	{
@@ -1441,8 +1443,6 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
-
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
 	tw.trace.c.type = CONTACT_NONE;
@@ -1456,6 +1456,7 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	assert( tw.angle > -180.0f && tw.angle < 180.0f );
 	tw.maxTan = initialTan = idMath::Fabs( tan( ( idMath::PI / 360.0f ) * tw.angle ) );
 	tw.model = idCollisionModelManagerLocal::models[model];
+	idCollisionModelManagerLocal::BeginTrace( &tw, context );
 	tw.start = start - modelOrigin;
 	// rotation axis, axis is assumed to be normalized
 	tw.axis = axis;
@@ -240,6 +240,23 @@ void idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( cm_traceWork_t* t
 	idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, node->children[side ^ 1], midf, p2f, mid, p2 );
 }
 
+/*
+================
+idCollisionModelManagerLocal::TraceThroughSpatialSubdivision
+================
+*/
+void idCollisionModelManagerLocal::TraceThroughSpatialSubdivision( cm_traceWork_t* tw, idVec3& p1, idVec3& p2 )
+{
+	if( cm_useBVH.GetBool() && tw->model->bvhNodes != NULL )
+	{
+		TraceThroughBVH( tw, p1, p2 );
+	}
+	else
+	{
+		TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, p1, p2 );
+	}
+}
+
 /*
 ================
 idCollisionModelManagerLocal::TraceThroughModel
@@ -255,7 +272,7 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t* tw )
 	if( !tw->rotation )
 	{
 		// trace through spatial subdivision and then through leafs
-		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, tw->start, tw->end );
+		idCollisionModelManagerLocal::TraceThroughSpatialSubdivision( tw, tw->start, tw->end );
 	}
 	else
 	{
@@ -276,7 +293,7 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t* tw )
 				rot.Set( tw->origin, tw->axis, tw->angle * ( ( float )( i + 1 ) / numSteps ) );
 				end = start * rot;
 				// trace through spatial subdivision and then through leafs
-				idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, end );
+				idCollisionModelManagerLocal::TraceThroughSpatialSubdivision( tw, start, end );
 				// no need to continue if something was hit already
 				if( tw->trace.fraction < 1.0f )
 				{
@@ -290,6 +307,6 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t* tw )
 			start = tw->start;
 		}
 		// last step of the approximation
-		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, tw->end );
+		idCollisionModelManagerLocal::TraceThroughSpatialSubdivision( tw, start, tw->end );
 	}
 }
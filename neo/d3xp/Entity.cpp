@@ -530,6 +530,7 @@ idEntity::idEntity():
 	xraySkin = NULL;
 
 	noGrab = false;
+	parallelThink = false;
 
 	scale = 1.0f; // Koz
 }
@@ -229,6 +229,8 @@ public:
 
 	bool					noGrab;
 
+	bool					parallelThink;			// ThinkParallel has work to do, see idGameLocal::RunParallelThink
+
 	renderEntity_t			xrayEntity;
 	qhandle_t				xrayEntityHandle;
 	const idDeclSkin* 		xraySkin;
@@ -266,6 +268,10 @@ public:
 
 	// thinking
 	virtual void			Think();
+	// Runs on a job thread before the entities think when g_parallelThink is set and parallelThink is true.
+	// It may read other entities but only write to this one, moving, tracing, sounds, events and presenting
+	// are left to Think.
+	virtual void			ThinkParallel() {}
 	bool					CheckDormant();	// dormant == on the active list, but out of PVS
 	virtual	void			DormantBegin();	// called when entity becomes dormant
 	virtual	void			DormantEnd();		// called when entity wakes from being dormant
@@ -193,6 +193,9 @@ idGameLocal::idGameLocal
 */
 idGameLocal::idGameLocal()
 {
+	thinkJobList = NULL;
+	afSolveJobList = NULL;
+	animFrameJobList = NULL;
 	Clear();
 }
 
@@ -412,6 +415,24 @@ void idGameLocal::Shutdown()
 
 	idEvent::Shutdown();
 
+	if( thinkJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( thinkJobList );
+		thinkJobList = NULL;
+	}
+	if( afSolveJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( afSolveJobList );
+		afSolveJobList = NULL;
+	}
+	afSolveEntities.Clear();
+	if( animFrameJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( animFrameJobList );
+		animFrameJobList = NULL;
+	}
+	animFrameJobs.Clear();
+
 	delete[] locationEntities;
 	locationEntities = NULL;
 
@@ -2622,6 +2643,250 @@ void idGameLocal::RunEntityThink( idEntity& ent, idUserCmdMgr& userCmdMgr )
 	}
 }
 
+/*
+================
+ParallelThinkJob
+================
+*/
+static void ParallelThinkJob( parallelThinkJob_t* job )
+{
+	for( int i = 0; i < job->numEntities; i++ )
+	{
+		job->entities[i]->ThinkParallel();
+	}
+}
+REGISTER_PARALLEL_JOB( ParallelThinkJob, "ParallelThinkJob" );
+
+/*
+================
+idGameLocal::RunParallelThink
+
+Runs ThinkParallel of all TIME_GROUP1 entities that have work for it on the job threads before
+any entity thinks. ThinkParallel only writes to the entity itself, so it doesn't matter in which
+order the jobs run. Everything else, like moving, tracing, sounds, events and presenting, is
+still done by Think in the serial think loop in active list order.
+================
+*/
+void idGameLocal::RunParallelThink()
+{
+	SCOPED_PROFILE_EVENT( "RunParallelThink" );
+
+	parallelThinkEntities.SetNum( 0 );
+	for( idEntity* ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->timeGroup == TIME_GROUP1 && ent->parallelThink && ( ent->thinkFlags & TH_THINK ) )
+		{
+			parallelThinkEntities.Append( ent );
+		}
+	}
+
+	if( parallelThinkEntities.Num() == 0 )
+	{
+		return;
+	}
+
+	if( thinkJobList == NULL )
+	{
+		thinkJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_GENTITIES / PARALLEL_THINK_ENTITIES_PER_JOB, 0, NULL );
+	}
+
+	const int numJobs = ( parallelThinkEntities.Num() + PARALLEL_THINK_ENTITIES_PER_JOB - 1 ) / PARALLEL_THINK_ENTITIES_PER_JOB;
+	parallelThinkJobs.SetNum( numJobs );
+	for( int i = 0; i < numJobs; i++ )
+	{
+		const int first = i * PARALLEL_THINK_ENTITIES_PER_JOB;
+		parallelThinkJobs[i].entities = parallelThinkEntities.Ptr() + first;
+		parallelThinkJobs[i].numEntities = Min( PARALLEL_THINK_ENTITIES_PER_JOB, parallelThinkEntities.Num() - first );
+		thinkJobList->AddJob( ( jobRun_t )ParallelThinkJob, &parallelThinkJobs[i] );
+	}
+	thinkJobList->Submit();
+	thinkJobList->Wait();
+}
+
+/*
+================
+AFSolveJob
+================
+*/
+static void AFSolveJob( idPhysics_AF* af )
+{
+	af->JobSolve();
+}
+REGISTER_PARALLEL_JOB( AFSolveJob, "AFSolveJob" );
+
+/*
+================
+idGameLocal::RunParallelAFSolve
+
+Solves the articulated figures of all thinking entities at once on the job threads. Everything
+that needs the rest of the world, like collecting contacts, is done on the main thread before
+the jobs start. Applying contact forces and collision impulses is done when the owner runs its
+physics, so other entities are affected in the same order as without parallel solving.
+
+If anything changes the articulated figure between here and the evaluation by its owner the
+solved state is thrown away and the figure is solved again as usual.
+================
+*/
+void idGameLocal::RunParallelAFSolve()
+{
+	SCOPED_PROFILE_EVENT( "RunParallelAFSolve" );
+
+	afSolveEntities.SetNum( 0 );
+
+	for( idEntity* ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->timeGroup != TIME_GROUP1 || ent->entityNumber < MAX_PLAYERS || !( ent->thinkFlags & TH_PHYSICS ) )
+		{
+			continue;
+		}
+		// team slaves are moved by their team master
+		if( ent->GetBindMaster() != NULL || ( ent->GetTeamMaster() != NULL && ent->GetTeamMaster() != ent ) )
+		{
+			continue;
+		}
+		idPhysics* phys = ent->GetPhysics();
+		if( !phys->IsType( idPhysics_AF::Type ) )
+		{
+			continue;
+		}
+		idPhysics_AF* af = static_cast<idPhysics_AF*>( phys );
+		if( !af->CanSolveOnJob() )
+		{
+			continue;
+		}
+
+		// disable the team for collision detection like idEntity::RunPhysics
+		idEntity* part;
+		for( part = ent; part != NULL; part = part->GetNextTeamEntity() )
+		{
+			if( !part->fl.solidForTeam )
+			{
+				part->GetPhysics()->DisableClip();
+			}
+		}
+
+		const bool solve = af->BeginJobSolve( time - previousTime, time );
+
+		for( part = ent; part != NULL; part = part->GetNextTeamEntity() )
+		{
+			if( !part->fl.solidForTeam )
+			{
+				part->GetPhysics()->EnableClip();
+			}
+		}
+
+		if( solve )
+		{
+			afSolveEntities.Alloc() = ent;
+		}
+	}
+
+	if( afSolveEntities.Num() == 0 )
+	{
+		return;
+	}
+
+	if( afSolveJobList == NULL )
+	{
+		afSolveJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_GENTITIES, 0, NULL );
+	}
+
+	for( int i = 0; i < afSolveEntities.Num(); i++ )
+	{
+		afSolveJobList->AddJob( ( jobRun_t )AFSolveJob, static_cast<idPhysics_AF*>( afSolveEntities[i].GetEntity()->GetPhysics() ) );
+	}
+	afSolveJobList->Submit();
+	afSolveJobList->Wait();
+}
+
+/*
+================
+idGameLocal::EndParallelAFSolve
+================
+*/
+void idGameLocal::EndParallelAFSolve()
+{
+	for( int i = 0; i < afSolveEntities.Num(); i++ )
+	{
+		idEntity* ent = afSolveEntities[i].GetEntity();
+		if( ent != NULL && ent->GetPhysics()->IsType( idPhysics_AF::Type ) )
+		{
+			static_cast<idPhysics_AF*>( ent->GetPhysics() )->CancelJobSolve();
+		}
+	}
+	afSolveEntities.SetNum( 0 );
+}
+
+/*
+================
+AnimFrameJob
+================
+*/
+static void AnimFrameJob( animFrameJob_t* job )
+{
+	job->animator->PrebuildFrame( job->time );
+}
+REGISTER_PARALLEL_JOB( AnimFrameJob, "AnimFrameJob" );
+
+/*
+================
+idGameLocal::RunParallelAnimFrames
+
+Creates the frames of all animated entities that may be drawn at once on the job threads,
+after everything that can change an animation this frame has run. The lazy CreateFrame calls
+from the render entity callbacks and the game code then find the frame up to date.
+================
+*/
+void idGameLocal::RunParallelAnimFrames()
+{
+	SCOPED_PROFILE_EVENT( "RunParallelAnimFrames" );
+
+	animFrameJobs.SetNum( 0 );
+
+	for( idEntity* ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->GetModelDefHandle() == -1 || ent->IsHidden() )
+		{
+			continue;
+		}
+		idAnimator* animator = ent->GetAnimator();
+		if( animator == NULL )
+		{
+			continue;
+		}
+		// the renderer only asks for the frames of entities it can see
+		if( !InPlayerPVS( ent ) )
+		{
+			continue;
+		}
+		const int frameTime = GetTimeGroupTime( ent->GetRenderEntity()->timeGroup );
+		if( !animator->NeedsFrame( frameTime ) )
+		{
+			continue;
+		}
+		animFrameJob_t& job = animFrameJobs.Alloc();
+		job.animator = animator;
+		job.time = frameTime;
+	}
+
+	if( animFrameJobs.Num() == 0 )
+	{
+		return;
+	}
+
+	if( animFrameJobList == NULL )
+	{
+		animFrameJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_GENTITIES, 0, NULL );
+	}
+
+	for( int i = 0; i < animFrameJobs.Num(); i++ )
+	{
+		animFrameJobList->AddJob( ( jobRun_t )AnimFrameJob, &animFrameJobs[i] );
+	}
+	animFrameJobList->Submit();
+	animFrameJobList->Wait();
+}
+
 idCVar g_recordTrace( "g_recordTrace", "0", CVAR_BOOL, "" );
 
 // jmarshall
@@ -2761,6 +3026,18 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 			timer_think.Clear();
 			timer_think.Start();
 
+			// solve the articulated figures on the job threads before the entities think
+			if( af_parallelSolve.GetBool() && !common->IsMultiplayer() && !inCinematic )
+			{
+				RunParallelAFSolve();
+			}
+
+			// run the parts of the entity thinks that only compute on the job threads
+			if( g_parallelThink.GetBool() && !common->IsMultiplayer() && !inCinematic )
+			{
+				RunParallelThink();
+			}
+
 			// let entities think
 			if( g_timeentities.GetFloat() )
 			{
@@ -2819,6 +3096,9 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 // jmarshall
 			RunSharedThink();
 // jmarshall end
+
+			// throw away the solved state of articulated figures that were not evaluated
+			EndParallelAFSolve();
 			// Run catch-up for any client projectiles.
 			// This is done after the main think so that all projectiles will be up-to-date
 			// when snapshots are created.
@@ -2861,6 +3141,12 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 
 			timer_events.Stop();
 
+			// create the animation frames of the visible entities on the job threads
+			if( g_parallelAnimFrames.GetBool() && !skipCinematic && g_debugAnim.GetInteger() == -1 && !cvarSystem->GetCVarInteger( "r_showSkel" ) )
+			{
+				RunParallelAnimFrames();
+			}
+
 			// free the player pvs
 			FreePlayerPVS();
 
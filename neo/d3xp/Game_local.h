@@ -288,6 +288,24 @@ enum slowmoState_t
 
 //============================================================================
 
+const int PARALLEL_THINK_ENTITIES_PER_JOB	= 16;
+
+// entities that run their ThinkParallel on a job thread, see idGameLocal::RunParallelThink
+struct parallelThinkJob_t
+{
+	idEntity* const* 		entities;
+	int						numEntities;
+};
+
+// animator that creates its frame on a job thread, see idGameLocal::RunParallelAnimFrames
+struct animFrameJob_t
+{
+	idAnimator* 			animator;
+	int						time;
+};
+
+//============================================================================
+
 class idGameLocal : public idGame
 {
 public:
@@ -660,6 +678,16 @@ private:
 	idEventQueue			eventQueue;
 	idEventQueue			savedEventQueue;
 
+	idParallelJobList* 		thinkJobList;
+	idList<idEntity*>		parallelThinkEntities;		// entities that run ThinkParallel this frame
+	idList<parallelThinkJob_t>	parallelThinkJobs;
+
+	idParallelJobList* 		afSolveJobList;
+	idList< idEntityPtr<idEntity> >	afSolveEntities;	// entities with an articulated figure solved on the job threads this frame
+
+	idParallelJobList* 		animFrameJobList;
+	idList<animFrameJob_t>	animFrameJobs;
+
 	idStaticList<spawnSpot_t, MAX_GENTITIES> spawnSpots;
 	idStaticList<idEntity*, MAX_GENTITIES> initialSpots;
 	int						currentInitialSpot;
@@ -709,6 +737,10 @@ private:
 	void					FreePlayerPVS();
 	void					UpdateGravity();
 	void					SortActiveEntityList();
+	void					RunParallelThink();
+	void					RunParallelAFSolve();
+	void					EndParallelAFSolve();
+	void					RunParallelAnimFrames();
 	void					ShowTargets();
 	void					RunDebugInfo();
 
@@ -241,6 +241,8 @@ idLight::idLight():
 	fadeTo.Set( 1, 1, 1, 1 );
 	fadeStart			= 0;
 	fadeEnd				= 0;
+	fadeColor.Set( 1, 1, 1, 1 );
+	fadeColorTime		= -1;
 	soundWasPlaying		= false;
 
 // RB begin
@@ -347,6 +349,9 @@ void idLight::Restore( idRestoreGame* savefile )
 	savefile->ReadInt( fadeEnd );
 	savefile->ReadBool( soundWasPlaying );
 
+	fadeColorTime = -1;
+	parallelThink = ( fadeEnd > 0 );
+
 	lightDefHandle = -1;
 
 	SetLightLevel();
@@ -721,6 +726,8 @@ void idLight::Fade( const idVec4& to, float fadeTime )
 	fadeTo = to;
 	fadeStart = gameLocal.time;
 	fadeEnd = gameLocal.time + SEC2MS( fadeTime );
+	fadeColorTime = -1;
+	parallelThink = true;
 	BecomeActive( TH_THINK );
 }
 
@@ -918,23 +925,22 @@ idLight::Think
 */
 void idLight::Think()
 {
-	idVec4 color;
-
 	if( thinkFlags & TH_THINK )
 	{
 		if( fadeEnd > 0 )
 		{
-			if( gameLocal.time < fadeEnd )
+			// usually done on a job thread already
+			if( fadeColorTime != gameLocal.time )
 			{
-				color.Lerp( fadeFrom, fadeTo, ( float )( gameLocal.time - fadeStart ) / ( float )( fadeEnd - fadeStart ) );
+				ThinkParallel();
 			}
-			else
+			if( gameLocal.time >= fadeEnd )
 			{
-				color = fadeTo;
 				fadeEnd = 0;
+				parallelThink = false;
 				BecomeInactive( TH_THINK );
 			}
-			SetColor( color );
+			SetColor( fadeColor );
 		}
 	}
 
@@ -942,6 +948,29 @@ void idLight::Think()
 	Present();
 }
 
+/*
+================
+idLight::ThinkParallel
+================
+*/
+void idLight::ThinkParallel()
+{
+	if( fadeEnd <= 0 )
+	{
+		return;
+	}
+
+	if( gameLocal.time < fadeEnd )
+	{
+		fadeColor.Lerp( fadeFrom, fadeTo, ( float )( gameLocal.time - fadeStart ) / ( float )( fadeEnd - fadeStart ) );
+	}
+	else
+	{
+		fadeColor = fadeTo;
+	}
+	fadeColorTime = gameLocal.time;
+}
+
 /*
 ================
 idLight::SharedThink
@@ -87,6 +87,7 @@ public:
 
 	virtual void	UpdateChangeableSpawnArgs( const idDict* source );
 	virtual void	Think();
+	virtual void	ThinkParallel();
 	virtual void	ClientThink( const int curTime, const float fraction, const bool predict );
 	virtual void	FreeLightDef();
 	virtual bool	GetPhysicsToSoundTransform( idVec3& origin, idMat3& axis );
@@ -166,6 +167,8 @@ private:
 	idVec4			fadeTo;
 	int				fadeStart;
 	int				fadeEnd;
+	idVec4			fadeColor;			// color of the fade at fadeColorTime
+	int				fadeColorTime;
 	bool			soundWasPlaying;
 
 private:
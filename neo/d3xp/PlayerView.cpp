@@ -895,6 +895,7 @@ void idPlayerView::EmitStereoEyeView( const int eye, idMenuHandler_HUD* hudManag
 
 	eyeView.viewEyeBuffer = stereoRender_swapEyes.GetBool() ? eye : -eye;
 	eyeView.stereoScreenSeparation = eye * dists.screenSeparation;
+	eyeView.stereoWorldSeparation = eyeOff;
 
 	// Koz begin
 	if( vrSystem->IsActive() )
@@ -33,10 +33,19 @@ If you have questions concerning this license or the applicable additional terms
 #include "../Game_local.h"
 
 idCVar binaryLoadAnim( "binaryLoadAnim", "1", 0, "enable binary load/write of idMD5Anim" );
+idCVar anim_compress( "anim_compress", "0", CVAR_BOOL, "store md5 anims as quantized, key frame reduced tracks" );
+idCVar anim_compressTranslationError( "anim_compressTranslationError", "0.01", CVAR_FLOAT, "maximum joint translation error in units allowed when compressing md5 anims" );
+idCVar anim_compressRotationError( "anim_compressRotationError", "0.1", CVAR_FLOAT, "maximum joint rotation error in degrees allowed when compressing md5 anims" );
 
 static const byte B_ANIM_MD5_VERSION = 101;
 static const unsigned int B_ANIM_MD5_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | B_ANIM_MD5_VERSION;
 
+// compressed anims use their own version so uncompressed binary anims stay valid
+static const byte B_ANIM_MD5_COMPRESSED_VERSION = 102;
+static const unsigned int B_ANIM_MD5_COMPRESSED_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | B_ANIM_MD5_COMPRESSED_VERSION;
+
+static const int ANIM_MAX_KEY_SPACING	= 64;	// bounds the cost of the key frame reduction
+
 static const int JOINT_FRAME_PAD	= 1;	// one extra to be able to read one more float than is necessary
 
 bool idAnimManager::forceExport = false;
@@ -61,6 +70,7 @@ idMD5Anim::idMD5Anim()
 	animLength	= 0;
 	numAnimatedComponents = 0;
 	totaldelta.Zero();
+	compressed	= false;
 }
 
 /*
@@ -92,6 +102,12 @@ void idMD5Anim::Free()
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+
+	compressed = false;
+	jointTracks.Clear();
+	tracks.Clear();
+	keyFrames.Clear();
+	keyValues.Clear();
 }
 
 /*
@@ -182,6 +198,7 @@ idMD5Anim::Allocated
 size_t idMD5Anim::Allocated() const
 {
 	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += jointTracks.Allocated() + tracks.Allocated() + keyFrames.Allocated() + keyValues.Allocated();
 	return size;
 }
 
@@ -207,6 +224,11 @@ bool idMD5Anim::LoadAnim( const char* filename )
 	if( binaryLoadAnim.GetBool() && LoadBinary( file, sourceTimeStamp ) )
 	{
 		name = filename;
+		if( anim_compress.GetBool() )
+		{
+			// binary anims written without compression, including the ones in the resource files
+			Compress();
+		}
 		if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
 		{
 			// for resource gathering write this anim to the preload file for this map
@@ -409,6 +431,11 @@ bool idMD5Anim::LoadAnim( const char* filename )
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 
+	if( anim_compress.GetBool() )
+	{
+		Compress();
+	}
+
 	if( binaryLoadAnim.GetBool() )
 	{
 		idLib::Printf( "Writing %s\n", generatedFileName.c_str() );
@@ -435,7 +462,13 @@ bool idMD5Anim::LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 
 	unsigned int magic = 0;
 	file->ReadBig( magic );
-	if( magic != B_ANIM_MD5_MAGIC )
+	if( magic != B_ANIM_MD5_MAGIC && magic != B_ANIM_MD5_COMPRESSED_MAGIC )
+	{
+		return false;
+	}
+
+	// the uncompressed data can't be recovered from a compressed anim, so regenerate it from the source
+	if( magic == B_ANIM_MD5_COMPRESSED_MAGIC && !anim_compress.GetBool() && !fileSystem->InProductionMode() )
 	{
 		return false;
 	}
@@ -501,11 +534,44 @@ bool idMD5Anim::LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		j.w = 0.0f;
 	}
 
-	file->ReadBig( num );
-	componentFrames.SetNum( num + JOINT_FRAME_PAD );
-	for( int i = 0; i < componentFrames.Num(); i++ )
+	compressed = ( magic == B_ANIM_MD5_COMPRESSED_MAGIC );
+	if( compressed )
 	{
-		file->ReadFloat( componentFrames[i] );
+		file->ReadBig( num );
+		jointTracks.SetNum( num );
+		for( int i = 0; i < num; i++ )
+		{
+			file->ReadBig( jointTracks[i].translationTrack );
+			file->ReadBig( jointTracks[i].rotationTrack );
+		}
+
+		file->ReadBig( num );
+		tracks.SetNum( num );
+		for( int i = 0; i < num; i++ )
+		{
+			animTrack_t& t = tracks[i];
+			file->ReadBig( t.firstKey );
+			file->ReadBig( t.numKeys );
+			file->ReadVec3( t.offset );
+			file->ReadVec3( t.scale );
+		}
+
+		file->ReadBig( num );
+		keyFrames.SetNum( num );
+		file->ReadBigArray( keyFrames.Ptr(), num );
+
+		file->ReadBig( num );
+		keyValues.SetNum( num );
+		file->ReadBigArray( keyValues.Ptr(), num );
+	}
+	else
+	{
+		file->ReadBig( num );
+		componentFrames.SetNum( num + JOINT_FRAME_PAD );
+		for( int i = 0; i < componentFrames.Num(); i++ )
+		{
+			file->ReadFloat( componentFrames[i] );
+		}
 	}
 
 	//file->ReadString( name );
@@ -528,7 +594,7 @@ void idMD5Anim::WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		return;
 	}
 
-	file->WriteBig( B_ANIM_MD5_MAGIC );
+	file->WriteBig( compressed ? B_ANIM_MD5_COMPRESSED_MAGIC : B_ANIM_MD5_MAGIC );
 	file->WriteBig( sourceTimeStamp );
 
 	file->WriteBig( numFrames );
@@ -567,10 +633,38 @@ void idMD5Anim::WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		file->WriteVec3( j.t );
 	}
 
-	file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
-	for( int i = 0; i < componentFrames.Num(); i++ )
+	if( compressed )
+	{
+		file->WriteBig( jointTracks.Num() );
+		for( int i = 0; i < jointTracks.Num(); i++ )
+		{
+			file->WriteBig( jointTracks[i].translationTrack );
+			file->WriteBig( jointTracks[i].rotationTrack );
+		}
+
+		file->WriteBig( tracks.Num() );
+		for( int i = 0; i < tracks.Num(); i++ )
+		{
+			animTrack_t& t = tracks[i];
+			file->WriteBig( t.firstKey );
+			file->WriteBig( t.numKeys );
+			file->WriteVec3( t.offset );
+			file->WriteVec3( t.scale );
+		}
+
+		file->WriteBig( keyFrames.Num() );
+		file->WriteBigArray( keyFrames.Ptr(), keyFrames.Num() );
+
+		file->WriteBig( keyValues.Num() );
+		file->WriteBigArray( keyValues.Ptr(), keyValues.Num() );
+	}
+	else
 	{
-		file->WriteFloat( componentFrames[i] );
+		file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
+		for( int i = 0; i < componentFrames.Num(); i++ )
+		{
+			file->WriteFloat( componentFrames[i] );
+		}
 	}
 
 	//file->WriteString( name );
@@ -578,6 +672,565 @@ void idMD5Anim::WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 	//file->WriteBig( ref_count );
 }
 
+/*
+====================
+EncodeQuat
+
+Smallest three encoding. The largest component is dropped and rebuilt from the other three on
+decode. The remaining components are within [-sqrt(0.5), sqrt(0.5)] and stored with 15 bits
+each, the two bits of the index of the dropped component go into the top bits of the first two
+words.
+====================
+*/
+static void EncodeQuat( const idQuat& q, unsigned short words[3] )
+{
+	int largest = 0;
+	for( int i = 1; i < 4; i++ )
+	{
+		if( idMath::Fabs( q[i] ) > idMath::Fabs( q[largest] ) )
+		{
+			largest = i;
+		}
+	}
+
+	// q and -q are the same rotation so the dropped component is always positive
+	const float sign = ( q[largest] < 0.0f ) ? -1.0f : 1.0f;
+
+	int n = 0;
+	for( int i = 0; i < 4; i++ )
+	{
+		if( i != largest )
+		{
+			const float f = ( q[i] * sign / idMath::SQRT_1OVER2 ) * 0.5f + 0.5f;
+			words[n++] = ( unsigned short ) idMath::ClampInt( 0, 32767, idMath::Ftoi( f * 32767.0f + 0.5f ) );
+		}
+	}
+	words[0] |= ( largest & 1 ) << 15;
+	words[1] |= ( largest >> 1 ) << 15;
+}
+
+/*
+====================
+DecodeQuat
+
+The decoded quaternion always has a positive w like the quaternions rebuilt from the md5 components.
+====================
+*/
+static void DecodeQuat( const unsigned short words[3], idQuat& q )
+{
+	const int largest = ( words[0] >> 15 ) | ( ( words[1] >> 15 ) << 1 );
+
+	float v[3];
+	for( int i = 0; i < 3; i++ )
+	{
+		v[i] = ( ( words[i] & 0x7FFF ) * ( 2.0f / 32767.0f ) - 1.0f ) * idMath::SQRT_1OVER2;
+	}
+	const float l = idMath::Sqrt( Max( 0.0f, 1.0f - v[0] * v[0] - v[1] * v[1] - v[2] * v[2] ) );
+
+	int n = 0;
+	for( int i = 0; i < 4; i++ )
+	{
+		q[i] = ( i == largest ) ? l : v[n++];
+	}
+	if( q.w < 0.0f )
+	{
+		q = -q;
+	}
+}
+
+/*
+====================
+LerpQuat
+
+Normalized linear interpolation used to rebuild the frames between two keys.
+====================
+*/
+static void LerpQuat( const idQuat& q1, const idQuat& q2, const float lerp, idQuat& q )
+{
+	const float cosom = q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+	const idQuat q3 = ( cosom < 0.0f ) ? -q2 : q2;
+
+	q = q1 + ( q3 - q1 ) * lerp;
+	q *= idMath::InvSqrt( q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w );
+	if( q.w < 0.0f )
+	{
+		q = -q;
+	}
+}
+
+/*
+====================
+ReduceKeys
+
+Greedily extends every key frame interval as long as all frames in between can be rebuilt by
+interpolating the two decoded keys within maxError. Translation errors are distances, rotation
+errors are compared against the cosine of half the allowed angle.
+====================
+*/
+static void ReduceKeys( const idVec4* original, const idVec4* decoded, const int numFrames, const bool rotation, const float maxError, idList<int>& keys )
+{
+	keys.Clear();
+	keys.Append( 0 );
+
+	int anchor = 0;
+	for( int end = 2; end < numFrames; end++ )
+	{
+		bool fits = ( end - anchor <= ANIM_MAX_KEY_SPACING );
+		for( int f = anchor + 1; f < end && fits; f++ )
+		{
+			const float lerp = ( float )( f - anchor ) / ( float )( end - anchor );
+			if( rotation )
+			{
+				idQuat q;
+				LerpQuat( idQuat( decoded[anchor].x, decoded[anchor].y, decoded[anchor].z, decoded[anchor].w ),
+						  idQuat( decoded[end].x, decoded[end].y, decoded[end].z, decoded[end].w ), lerp, q );
+				fits = idMath::Fabs( q.x * original[f].x + q.y * original[f].y + q.z * original[f].z + q.w * original[f].w ) >= maxError;
+			}
+			else
+			{
+				const idVec3 t = decoded[anchor].ToVec3() + ( decoded[end].ToVec3() - decoded[anchor].ToVec3() ) * lerp;
+				fits = ( t - original[f].ToVec3() ).LengthSqr() <= maxError * maxError;
+			}
+		}
+		if( !fits )
+		{
+			keys.Append( end - 1 );
+			anchor = end - 1;
+		}
+	}
+
+	if( numFrames > 1 )
+	{
+		keys.Append( numFrames - 1 );
+	}
+}
+
+/*
+====================
+idMD5Anim::CompressTranslation
+
+Returns false if the range of the track is too large for the 16 bit quantization to stay within maxError.
+====================
+*/
+bool idMD5Anim::CompressTranslation( int jointNum, animTrack_t& track, float maxError )
+{
+	const jointAnimInfo_t& info = jointInfo[ jointNum ];
+
+	idList<idVec4> original;
+	idList<idVec4> decoded;
+	idList<unsigned short> words;
+	original.SetNum( numFrames );
+	decoded.SetNum( numFrames );
+	words.SetNum( numFrames * 3 );
+
+	idBounds range;
+	range.Clear();
+	for( int i = 0; i < numFrames; i++ )
+	{
+		idVec3 t = baseFrame[ jointNum ].t;
+		const float* componentPtr = &componentFrames[ numAnimatedComponents * i + info.firstComponent ];
+		if( info.animBits & ANIM_TX )
+		{
+			t.x = *componentPtr++;
+		}
+		if( info.animBits & ANIM_TY )
+		{
+			t.y = *componentPtr++;
+		}
+		if( info.animBits & ANIM_TZ )
+		{
+			t.z = *componentPtr++;
+		}
+		original[i].Set( t.x, t.y, t.z, 0.0f );
+		range.AddPoint( t );
+	}
+
+	// 16 bits per axis over the range of the track
+	track.offset = range[0];
+	track.scale = ( range[1] - range[0] ) * ( 1.0f / 65535.0f );
+
+	// every axis is rounded to the nearest step
+	if( ( track.scale * 0.5f ).Length() > maxError )
+	{
+		return false;
+	}
+
+	for( int i = 0; i < numFrames; i++ )
+	{
+		for( int j = 0; j < 3; j++ )
+		{
+			int q = 0;
+			if( track.scale[j] > 0.0f )
+			{
+				q = idMath::ClampInt( 0, 65535, idMath::Ftoi( ( original[i][j] - track.offset[j] ) / track.scale[j] + 0.5f ) );
+			}
+			words[i * 3 + j] = ( unsigned short ) q;
+			decoded[i][j] = track.offset[j] + q * track.scale[j];
+		}
+		decoded[i].w = 0.0f;
+	}
+
+	idList<int> keys;
+	ReduceKeys( original.Ptr(), decoded.Ptr(), numFrames, false, maxError, keys );
+
+	track.firstKey = keyFrames.Num();
+	track.numKeys = keys.Num();
+	for( int i = 0; i < keys.Num(); i++ )
+	{
+		keyFrames.Append( ( unsigned short ) keys[i] );
+		keyValues.Append( words[keys[i] * 3 + 0] );
+		keyValues.Append( words[keys[i] * 3 + 1] );
+		keyValues.Append( words[keys[i] * 3 + 2] );
+	}
+	return true;
+}
+
+/*
+====================
+idMD5Anim::CompressRotation
+====================
+*/
+void idMD5Anim::CompressRotation( int jointNum, animTrack_t& track, float maxError )
+{
+	const jointAnimInfo_t& info = jointInfo[ jointNum ];
+
+	idList<idVec4> original;
+	idList<idVec4> decoded;
+	idList<unsigned short> words;
+	original.SetNum( numFrames );
+	decoded.SetNum( numFrames );
+	words.SetNum( numFrames * 3 );
+
+	for( int i = 0; i < numFrames; i++ )
+	{
+		idQuat q = baseFrame[ jointNum ].q;
+		const float* componentPtr = &componentFrames[ numAnimatedComponents * i + info.firstComponent ];
+		if( info.animBits & ANIM_TX )
+		{
+			componentPtr++;
+		}
+		if( info.animBits & ANIM_TY )
+		{
+			componentPtr++;
+		}
+		if( info.animBits & ANIM_TZ )
+		{
+			componentPtr++;
+		}
+		if( info.animBits & ANIM_QX )
+		{
+			q.x = *componentPtr++;
+		}
+		if( info.animBits & ANIM_QY )
+		{
+			q.y = *componentPtr++;
+		}
+		if( info.animBits & ANIM_QZ )
+		{
+			q.z = *componentPtr++;
+		}
+		q.w = q.CalcW();
+		original[i].Set( q.x, q.y, q.z, q.w );
+
+		EncodeQuat( q, &words[i * 3] );
+		DecodeQuat( &words[i * 3], q );
+		decoded[i].Set( q.x, q.y, q.z, q.w );
+	}
+
+	// the rotation tracks don't use the offset and scale
+	track.offset.Zero();
+	track.scale.Zero();
+
+	idList<int> keys;
+	ReduceKeys( original.Ptr(), decoded.Ptr(), numFrames, true, maxError, keys );
+
+	track.firstKey = keyFrames.Num();
+	track.numKeys = keys.Num();
+	for( int i = 0; i < keys.Num(); i++ )
+	{
+		keyFrames.Append( ( unsigned short ) keys[i] );
+		keyValues.Append( words[keys[i] * 3 + 0] );
+		keyValues.Append( words[keys[i] * 3 + 1] );
+		keyValues.Append( words[keys[i] * 3 + 2] );
+	}
+}
+
+/*
+====================
+idMD5Anim::Compress
+
+Replaces the float components with a quantized translation and a smallest three encoded
+rotation track per animated joint. Frames that can be rebuilt by interpolating their
+neighbouring keys within anim_compressTranslationError and anim_compressRotationError are
+dropped. Anims with a translation range too large to quantize within anim_compressTranslationError
+keep their float components.
+====================
+*/
+void idMD5Anim::Compress()
+{
+	if( compressed || numAnimatedComponents == 0 )
+	{
+		return;
+	}
+
+	// key frame numbers are stored in 16 bits
+	if( numFrames > 65536 )
+	{
+		return;
+	}
+
+	const float maxTranslationError = Max( anim_compressTranslationError.GetFloat(), 0.0f );
+	const float maxRotationError = idMath::Cos( DEG2RAD( Max( anim_compressRotationError.GetFloat(), 0.0f ) ) * 0.5f );
+
+	jointTracks.SetGranularity( 1 );
+	jointTracks.SetNum( numJoints );
+	tracks.Clear();
+	keyFrames.Clear();
+	keyValues.Clear();
+
+	for( int i = 0; i < numJoints; i++ )
+	{
+		const int animBits = jointInfo[ i ].animBits;
+
+		jointTracks[ i ].translationTrack = -1;
+		jointTracks[ i ].rotationTrack = -1;
+
+		if( animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) )
+		{
+			jointTracks[ i ].translationTrack = tracks.Num();
+			if( !CompressTranslation( i, tracks.Alloc(), maxTranslationError ) )
+			{
+				jointTracks.Clear();
+				tracks.Clear();
+				keyFrames.Clear();
+				keyValues.Clear();
+				return;
+			}
+		}
+		if( animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) )
+		{
+			jointTracks[ i ].rotationTrack = tracks.Num();
+			CompressRotation( i, tracks.Alloc(), maxRotationError );
+		}
+	}
+
+	tracks.Condense();
+	keyFrames.Condense();
+	keyValues.Condense();
+	componentFrames.Clear();
+
+	compressed = true;
+}
+
+/*
+====================
+FindKey
+
+Returns the last key at or before framenum.
+====================
+*/
+static ID_INLINE int FindKey( const unsigned short* frames, const int numKeys, const int framenum )
+{
+	int low = 0;
+	int high = numKeys - 1;
+	while( low < high )
+	{
+		const int mid = ( low + high + 1 ) >> 1;
+		if( frames[mid] <= framenum )
+		{
+			low = mid;
+		}
+		else
+		{
+			high = mid - 1;
+		}
+	}
+	return low;
+}
+
+#if defined(USE_INTRINSICS_SSE)
+
+ALIGN16( static const unsigned int SIMD_SP_animSignBit[4] )		= { IEEE_FLT_SIGN_MASK, IEEE_FLT_SIGN_MASK, IEEE_FLT_SIGN_MASK, IEEE_FLT_SIGN_MASK };
+ALIGN16( static const unsigned int SIMD_SP_animClearLast1[4] )	= { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+
+/*
+====================
+HorizontalSum_SSE
+====================
+*/
+static ID_INLINE __m128 HorizontalSum_SSE( __m128 v )
+{
+	v = _mm_add_ps( v, _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	return _mm_add_ps( v, _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+}
+
+/*
+====================
+DecodeTranslation_SSE
+====================
+*/
+static ID_INLINE __m128 DecodeTranslation_SSE( const unsigned short* words, const __m128 offset, const __m128 scale )
+{
+	const __m128 v = _mm_cvtepi32_ps( _mm_setr_epi32( words[0], words[1], words[2], 0 ) );
+	return _mm_add_ps( offset, _mm_mul_ps( v, scale ) );
+}
+
+/*
+====================
+DecodeQuat_SSE
+====================
+*/
+static ID_INLINE __m128 DecodeQuat_SSE( const unsigned short* words )
+{
+	const int largest = ( words[0] >> 15 ) | ( ( words[1] >> 15 ) << 1 );
+
+	__m128 v = _mm_cvtepi32_ps( _mm_setr_epi32( words[0] & 0x7FFF, words[1] & 0x7FFF, words[2] & 0x7FFF, 0 ) );
+	v = _mm_mul_ps( _mm_sub_ps( _mm_mul_ps( v, _mm_set1_ps( 2.0f / 32767.0f ) ), _mm_set1_ps( 1.0f ) ), _mm_set1_ps( idMath::SQRT_1OVER2 ) );
+	v = _mm_and_ps( v, ( const __m128& ) SIMD_SP_animClearLast1 );
+
+	// rebuild the dropped component in the last lane
+	__m128 l = _mm_sub_ps( _mm_set1_ps( 1.0f ), HorizontalSum_SSE( _mm_mul_ps( v, v ) ) );
+	l = _mm_sqrt_ps( _mm_max_ps( l, _mm_setzero_ps() ) );
+	v = _mm_or_ps( v, _mm_andnot_ps( ( const __m128& ) SIMD_SP_animClearLast1, l ) );
+
+	switch( largest )
+	{
+		case 0:
+			v = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 1, 0, 3 ) );
+			break;
+		case 1:
+			v = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 1, 3, 0 ) );
+			break;
+		case 2:
+			v = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 1, 0 ) );
+			break;
+	}
+
+	// negate if w is negative
+	const __m128 sign = _mm_and_ps( _mm_shuffle_ps( v, v, _MM_SHUFFLE( 3, 3, 3, 3 ) ), ( const __m128& ) SIMD_SP_animSignBit );
+	return _mm_xor_ps( v, sign );
+}
+
+#endif
+
+/*
+====================
+idMD5Anim::DecodeTranslation
+
+Writes x, y, z and a zero so the result can be stored over idJointQuat::t and idJointQuat::w.
+====================
+*/
+void idMD5Anim::DecodeTranslation( const animTrack_t& track, int framenum, float* t ) const
+{
+	const unsigned short* frames = &keyFrames[ track.firstKey ];
+	const unsigned short* values = &keyValues[ track.firstKey * 3 ];
+
+	const int k = FindKey( frames, track.numKeys, framenum );
+	const bool exact = ( frames[k] == framenum || k + 1 >= track.numKeys );
+	const float lerp = exact ? 0.0f : ( float )( framenum - frames[k] ) / ( float )( frames[k + 1] - frames[k] );
+
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128 offset = _mm_setr_ps( track.offset.x, track.offset.y, track.offset.z, 0.0f );
+	const __m128 scale = _mm_setr_ps( track.scale.x, track.scale.y, track.scale.z, 0.0f );
+
+	__m128 t0 = DecodeTranslation_SSE( values + k * 3, offset, scale );
+	if( !exact )
+	{
+		const __m128 t1 = DecodeTranslation_SSE( values + k * 3 + 3, offset, scale );
+		t0 = _mm_add_ps( t0, _mm_mul_ps( _mm_sub_ps( t1, t0 ), _mm_set1_ps( lerp ) ) );
+	}
+	_mm_storeu_ps( t, t0 );
+
+#else
+
+	const unsigned short* v0 = values + k * 3;
+	idVec3 t0( track.offset.x + v0[0] * track.scale.x, track.offset.y + v0[1] * track.scale.y, track.offset.z + v0[2] * track.scale.z );
+	if( !exact )
+	{
+		const unsigned short* v1 = v0 + 3;
+		const idVec3 t1( track.offset.x + v1[0] * track.scale.x, track.offset.y + v1[1] * track.scale.y, track.offset.z + v1[2] * track.scale.z );
+		t0 += ( t1 - t0 ) * lerp;
+	}
+	t[0] = t0.x;
+	t[1] = t0.y;
+	t[2] = t0.z;
+	t[3] = 0.0f;
+
+#endif
+}
+
+/*
+====================
+idMD5Anim::DecodeRotation
+====================
+*/
+void idMD5Anim::DecodeRotation( const animTrack_t& track, int framenum, float* q ) const
+{
+	const unsigned short* frames = &keyFrames[ track.firstKey ];
+	const unsigned short* values = &keyValues[ track.firstKey * 3 ];
+
+	const int k = FindKey( frames, track.numKeys, framenum );
+	const bool exact = ( frames[k] == framenum || k + 1 >= track.numKeys );
+
+#if defined(USE_INTRINSICS_SSE)
+
+	__m128 q0 = DecodeQuat_SSE( values + k * 3 );
+	if( !exact )
+	{
+		const float lerp = ( float )( framenum - frames[k] ) / ( float )( frames[k + 1] - frames[k] );
+
+		__m128 q1 = DecodeQuat_SSE( values + k * 3 + 3 );
+		q1 = _mm_xor_ps( q1, _mm_and_ps( HorizontalSum_SSE( _mm_mul_ps( q0, q1 ) ), ( const __m128& ) SIMD_SP_animSignBit ) );
+		q0 = _mm_add_ps( q0, _mm_mul_ps( _mm_sub_ps( q1, q0 ), _mm_set1_ps( lerp ) ) );
+		q0 = _mm_div_ps( q0, _mm_sqrt_ps( HorizontalSum_SSE( _mm_mul_ps( q0, q0 ) ) ) );
+		q0 = _mm_xor_ps( q0, _mm_and_ps( _mm_shuffle_ps( q0, q0, _MM_SHUFFLE( 3, 3, 3, 3 ) ), ( const __m128& ) SIMD_SP_animSignBit ) );
+	}
+	_mm_storeu_ps( q, q0 );
+
+#else
+
+	idQuat q0;
+	DecodeQuat( values + k * 3, q0 );
+	if( !exact )
+	{
+		const float lerp = ( float )( framenum - frames[k] ) / ( float )( frames[k + 1] - frames[k] );
+
+		idQuat q1;
+		DecodeQuat( values + k * 3 + 3, q1 );
+		LerpQuat( q0, q1, lerp, q0 );
+	}
+	q[0] = q0.x;
+	q[1] = q0.y;
+	q[2] = q0.z;
+	q[3] = q0.w;
+
+#endif
+}
+
+/*
+====================
+idMD5Anim::DecodeCompressedFrame
+====================
+*/
+void idMD5Anim::DecodeCompressedFrame( int framenum, idJointQuat* joints, const int* index, int numIndexes ) const
+{
+	for( int i = 0; i < numIndexes; i++ )
+	{
+		const int j = index[i];
+		const animJointTracks_t& jt = jointTracks[j];
+
+		if( jt.translationTrack >= 0 )
+		{
+			DecodeTranslation( tracks[ jt.translationTrack ], framenum, joints[j].t.ToFloatPtr() );
+		}
+		if( jt.rotationTrack >= 0 )
+		{
+			DecodeRotation( tracks[ jt.rotationTrack ], framenum, joints[j].q.ToFloatPtr() );
+		}
+	}
+}
+
 /*
 ====================
 idMD5Anim::IncreaseRefs
@@ -706,26 +1359,36 @@ void idMD5Anim::GetOrigin( idVec3& offset, int time, int cyclecount ) const
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
-	const float* componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float* componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
-
-	if( jointInfo[ 0 ].animBits & ANIM_TX )
+	if( compressed )
 	{
-		offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-		componentPtr1++;
-		componentPtr2++;
+		idVec4 t1, t2;
+		DecodeTranslation( tracks[ jointTracks[ 0 ].translationTrack ], frame.frame1, t1.ToFloatPtr() );
+		DecodeTranslation( tracks[ jointTracks[ 0 ].translationTrack ], frame.frame2, t2.ToFloatPtr() );
+		offset = t1.ToVec3() * frame.frontlerp + t2.ToVec3() * frame.backlerp;
 	}
-
-	if( jointInfo[ 0 ].animBits & ANIM_TY )
+	else
 	{
-		offset.y = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
-		componentPtr1++;
-		componentPtr2++;
-	}
+		const float* componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
+		const float* componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
 
-	if( jointInfo[ 0 ].animBits & ANIM_TZ )
-	{
-		offset.z = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+		if( jointInfo[ 0 ].animBits & ANIM_TX )
+		{
+			offset.x = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+			componentPtr1++;
+			componentPtr2++;
+		}
+
+		if( jointInfo[ 0 ].animBits & ANIM_TY )
+		{
+			offset.y = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+			componentPtr1++;
+			componentPtr2++;
+		}
+
+		if( jointInfo[ 0 ].animBits & ANIM_TZ )
+		{
+			offset.z = *componentPtr1 * frame.frontlerp + *componentPtr2 * frame.backlerp;
+		}
 	}
 
 	if( frame.cycleCount )
@@ -752,6 +1415,16 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 
+	if( compressed )
+	{
+		idQuat q1;
+		idQuat q2;
+		DecodeRotation( tracks[ jointTracks[ 0 ].rotationTrack ], frame.frame1, q1.ToFloatPtr() );
+		DecodeRotation( tracks[ jointTracks[ 0 ].rotationTrack ], frame.frame2, q2.ToFloatPtr() );
+		rotation.Slerp( q1, q2, frame.backlerp );
+		return;
+	}
+
 	const float*	jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
 	const float*	jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
 
@@ -868,7 +1541,14 @@ void idMD5Anim::GetBounds( idBounds& bnds, int time, int cyclecount ) const
 
 	// origin position
 	idVec3 offset = baseFrame[ 0 ].t;
-	if( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) )
+	if( compressed && ( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) )
+	{
+		idVec4 t1, t2;
+		DecodeTranslation( tracks[ jointTracks[ 0 ].translationTrack ], frame.frame1, t1.ToFloatPtr() );
+		DecodeTranslation( tracks[ jointTracks[ 0 ].translationTrack ], frame.frame2, t2.ToFloatPtr() );
+		offset = t1.ToVec3() * frame.frontlerp + t2.ToVec3() * frame.backlerp;
+	}
+	else if( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) )
 	{
 		const float* componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
 		const float* componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
@@ -989,10 +1669,28 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t& frame, idJointQuat* joints,
 	idJointQuat* blendJoints = ( idJointQuat* )_alloca16( baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
 	int* lerpIndex = ( int* )_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 
-	const float* frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
-	const float* frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
+	int numLerpJoints = 0;
+	if( compressed )
+	{
+		for( int i = 0; i < numIndexes; i++ )
+		{
+			if( jointInfo[ index[i] ].animBits != 0 )
+			{
+				lerpIndex[numLerpJoints++] = index[i];
+			}
+		}
+
+		SIMDProcessor->Memcpy( blendJoints, joints, baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
+		DecodeCompressedFrame( frame.frame1, joints, lerpIndex, numLerpJoints );
+		DecodeCompressedFrame( frame.frame2, blendJoints, lerpIndex, numLerpJoints );
+	}
+	else
+	{
+		const float* frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
+		const float* frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
 
-	int numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
+		numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
+	}
 
 	SIMDProcessor->BlendJoints( joints, blendJoints, frame.backlerp, lerpIndex, numLerpJoints );
 
@@ -1076,6 +1774,12 @@ void idMD5Anim::GetSingleFrame( int framenum, idJointQuat* joints, const int* in
 		return;
 	}
 
+	if( compressed )
+	{
+		DecodeCompressedFrame( framenum, joints, index, numIndexes );
+		return;
+	}
+
 	const float* frame = &componentFrames[framenum * numAnimatedComponents];
 
 	DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
@@ -1312,7 +2016,7 @@ void idAnimManager::ListAnims() const
 		{
 			anim = *animptr;
 			s = anim->Size();
-			gameLocal.Printf( "%8d bytes : %2d refs : %s\n", s, anim->NumRefs(), anim->Name() );
+			gameLocal.Printf( "%8d bytes : %2d refs : %s%s\n", s, anim->NumRefs(), anim->Name(), anim->IsCompressed() ? " (compressed)" : "" );
 			size += s;
 			num++;
 		}
@@ -79,6 +79,21 @@ typedef struct
 	int						firstComponent;
 } jointAnimInfo_t;
 
+// key frame reduced track of a compressed idMD5Anim
+typedef struct
+{
+	int						firstKey;		// index of the first key in keyFrames, the key values start at 3 * firstKey
+	int						numKeys;
+	idVec3					offset;			// translation tracks decode to offset + value * scale
+	idVec3					scale;
+} animTrack_t;
+
+typedef struct
+{
+	short					translationTrack;	// -1 if the translation isn't animated
+	short					rotationTrack;		// -1 if the rotation isn't animated
+} animJointTracks_t;
+
 typedef struct
 {
 	jointHandle_t			num;
@@ -222,6 +237,19 @@ private:
 	idVec3					totaldelta;
 	mutable int				ref_count;
 
+	// compressed representation, replaces componentFrames
+	bool					compressed;
+	idList<animJointTracks_t, TAG_MD5_ANIM>	jointTracks;
+	idList<animTrack_t, TAG_MD5_ANIM>		tracks;
+	idList<unsigned short, TAG_MD5_ANIM>	keyFrames;
+	idList<unsigned short, TAG_MD5_ANIM>	keyValues;		// three per key, quantized translation or smallest three quaternion
+
+	bool					CompressTranslation( int jointNum, animTrack_t& track, float maxError );
+	void					CompressRotation( int jointNum, animTrack_t& track, float maxError );
+	void					DecodeTranslation( const animTrack_t& track, int framenum, float* t ) const;
+	void					DecodeRotation( const animTrack_t& track, int framenum, float* q ) const;
+	void					DecodeCompressedFrame( int framenum, idJointQuat* joints, const int* index, int numIndexes ) const;
+
 public:
 	idMD5Anim();
 	~idMD5Anim();
@@ -236,6 +264,11 @@ public:
 	bool					LoadAnim( const char* filename );
 	bool					LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp );
 	void					WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp );
+	void					Compress();
+	bool					IsCompressed() const
+	{
+		return compressed;
+	}
 
 	void					IncreaseRefs() const;
 	void					DecreaseRefs() const;
@@ -518,6 +551,8 @@ public:
 	void						ClearForceUpdate();
 	bool						CreateFrame( int animtime, bool force );
 	bool						FrameHasChanged( int animtime ) const;
+	bool						NeedsFrame( int animtime ) const;
+	void						PrebuildFrame( int animtime );
 	void						GetDelta( int fromtime, int totime, idVec3& delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3& delta ) const;
 	void						GetOrigin( int currentTime, idVec3& pos ) const;
@@ -576,6 +611,7 @@ private:
 
 	mutable int					lastTransformTime;		// mutable because the value is updated in CreateFrame
 	mutable bool				stoppedAnimatingUpdate;
+	bool						prebuiltFrame;			// frame was created by the frame pose pass and not reported yet
 	bool						removeOriginOffset;
 	bool						forceUpdate;
 
@@ -37,6 +37,9 @@ static const char* channelNames[ ANIM_NumAnimChannels ] =
 	"all", "torso", "legs", "head", "eyelids", "rightHand", "leftHand"
 };
 
+// the renderer's r_showSkel, at file scope so it is registered on the main thread, CreateFrame can run on the job threads
+static idCVar anim_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+
 /***********************************************************************
 
 	idAnim
@@ -3803,6 +3806,7 @@ idAnimator::idAnimator()
 	joints					= NULL;
 	lastTransformTime		= -1;
 	stoppedAnimatingUpdate	= false;
+	prebuiltFrame			= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
 
@@ -5199,8 +5203,6 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 	const jointMod_t* 	jointMod;
 	const idJointQuat* 	defaultPose;
 
-	static idCVar		r_showSkel( "r_showSkel", "0", CVAR_RENDERER | CVAR_INTEGER, "", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
-
 	if( gameLocal.inCinematic && gameLocal.skipCinematic )
 	{
 		return false;
@@ -5211,10 +5213,16 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 		return false;
 	}
 
-	if( !force && !r_showSkel.GetInteger() )
+	if( !force && !anim_showSkel.GetInteger() )
 	{
 		if( lastTransformTime == currentTime )
 		{
+			// the first caller after the frame pose pass is told about the new frame
+			if( prebuiltFrame )
+			{
+				prebuiltFrame = false;
+				return true;
+			}
 			return false;
 		}
 		if( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) )
@@ -5225,6 +5233,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 
 	lastTransformTime = currentTime;
 	stoppedAnimatingUpdate = false;
+	prebuiltFrame = false;
 
 	if( entity && ( ( g_debugAnim.GetInteger() == entity->entityNumber ) || ( g_debugAnim.GetInteger() == -2 ) ) )
 	{
@@ -5463,6 +5472,46 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 	return true;
 }
 
+/*
+=====================
+idAnimator::NeedsFrame
+
+Returns true if CreateFrame would evaluate a new pose at the given time.
+=====================
+*/
+bool idAnimator::NeedsFrame( int currentTime ) const
+{
+	if( !modelDef || !modelDef->ModelHandle() )
+	{
+		return false;
+	}
+
+	if( lastTransformTime == currentTime )
+	{
+		return false;
+	}
+
+	if( lastTransformTime != -1 && !stoppedAnimatingUpdate && !IsAnimating( currentTime ) )
+	{
+		return false;
+	}
+
+	return true;
+}
+
+/*
+=====================
+idAnimator::PrebuildFrame
+
+Evaluates the pose ahead of the lazy CreateFrame calls, this may run on a job thread.
+Whether the frame changed is kept until the next CreateFrame for the same time reports it.
+=====================
+*/
+void idAnimator::PrebuildFrame( int currentTime )
+{
+	prebuiltFrame = CreateFrame( currentTime, false );
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
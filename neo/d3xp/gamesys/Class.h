@@ -311,6 +311,10 @@ public:
 	static idTypeInfo* 			GetType( int num );
 
 private:
+	friend class idEvent;
+
+	idLinkList<idEvent>			scheduledEvents;	// events posted to this object so they can be cancelled without searching the event queues
+
 	classSpawnFunc_t			CallSpawnFunc( idTypeInfo* cls );
 
 	bool						PostEventArgs( const idEventDef* ev, int time, int numargs, ... );
@@ -234,6 +234,390 @@ const idEventDef* idEventDef::FindEvent( const char* name )
 	return NULL;
 }
 
+/*
+================================================================================================
+
+	idEventTimerWheel
+
+	Hierarchical timer wheel that keeps the scheduled events. Level 0 has a slot for every
+	msec of the 256 msec block the wheel is in, each higher level has 64 slots that each cover
+	a block of the level below. Events that don't fit in the top level go in an overflow list.
+
+	Which slot an event goes in only depends on its time and the current time of the wheel,
+	so all events with the same time are always in the same list. Lists are only appended to,
+	and when the wheel enters a new block the lists that cover it are moved down starting with
+	the top level, so events with the same time fire in the order they were posted, exactly
+	like they did with the old sorted event list.
+
+	Events that are scheduled before the current time of the wheel, which can happen when the
+	game time changes, are kept in a small sorted list that fires before the wheel.
+
+================================================================================================
+*/
+
+static const int EVENT_WHEEL_LEVEL0_BITS	= 8;		// 256 msec
+static const int EVENT_WHEEL_LEVEL_BITS		= 6;		// 16 sec, 17 min, 18 hours
+static const int EVENT_WHEEL_LEVELS			= 4;
+static const int EVENT_WHEEL_OVERFLOW		= EVENT_WHEEL_LEVELS;
+static const int EVENT_WHEEL_LATE			= -1;
+
+class idEventTimerWheel
+{
+public:
+	idEventTimerWheel();
+
+	void					Clear();
+	int						Num() const;
+
+	void					Insert( idEvent* event );
+	void					Remove( idEvent* event );
+
+	// returns the next event with a time at or before the given time in firing order, NULL if there is none
+	idEvent* 				NextDue( int time );
+
+	// all events in firing order, used for save games
+	void					GetEvents( idList<idEvent*>& list ) const;
+
+private:
+	int						wheelTime;			// all events before this time have been fired
+	int						numEvents[ EVENT_WHEEL_LEVELS + 1 ];
+	idLinkList<idEvent>		late;
+	idLinkList<idEvent>		level0[ 1 << EVENT_WHEEL_LEVEL0_BITS ];
+	idLinkList<idEvent>		levels[ EVENT_WHEEL_LEVELS - 1 ][ 1 << EVENT_WHEEL_LEVEL_BITS ];
+	idLinkList<idEvent>		overflow;
+
+	static int				BlockShift( int level );
+	void					InsertLate( idEvent* event );
+	void					Advance( int time );
+	void					Cascade();
+	void					Reinsert( idLinkList<idEvent>& list );
+};
+
+/*
+================
+idEventTimerWheel::idEventTimerWheel
+================
+*/
+idEventTimerWheel::idEventTimerWheel()
+{
+	wheelTime = 0;
+	memset( numEvents, 0, sizeof( numEvents ) );
+}
+
+/*
+================
+idEventTimerWheel::BlockShift
+
+Size of the block covered by a single slot of the level above, for the overflow list this
+is the size of the block covered by the whole wheel.
+================
+*/
+int idEventTimerWheel::BlockShift( int level )
+{
+	return EVENT_WHEEL_LEVEL0_BITS + level * EVENT_WHEEL_LEVEL_BITS;
+}
+
+/*
+================
+idEventTimerWheel::Clear
+================
+*/
+void idEventTimerWheel::Clear()
+{
+	late.Clear();
+	for( int i = 0; i < ( 1 << EVENT_WHEEL_LEVEL0_BITS ); i++ )
+	{
+		level0[ i ].Clear();
+	}
+	for( int i = 0; i < EVENT_WHEEL_LEVELS - 1; i++ )
+	{
+		for( int j = 0; j < ( 1 << EVENT_WHEEL_LEVEL_BITS ); j++ )
+		{
+			levels[ i ][ j ].Clear();
+		}
+	}
+	overflow.Clear();
+
+	wheelTime = 0;
+	memset( numEvents, 0, sizeof( numEvents ) );
+}
+
+/*
+================
+idEventTimerWheel::Num
+================
+*/
+int idEventTimerWheel::Num() const
+{
+	int num = late.Num();
+	for( int i = 0; i <= EVENT_WHEEL_LEVELS; i++ )
+	{
+		num += numEvents[ i ];
+	}
+	return num;
+}
+
+/*
+================
+idEventTimerWheel::InsertLate
+================
+*/
+void idEventTimerWheel::InsertLate( idEvent* event )
+{
+	idEvent* next = late.Next();
+	while( ( next != NULL ) && ( event->time >= next->time ) )
+	{
+		next = next->eventNode.Next();
+	}
+
+	if( next )
+	{
+		event->eventNode.InsertBefore( next->eventNode );
+	}
+	else
+	{
+		event->eventNode.AddToEnd( late );
+	}
+
+	event->queue = this;
+	event->queueLevel = EVENT_WHEEL_LATE;
+}
+
+/*
+================
+idEventTimerWheel::Insert
+================
+*/
+void idEventTimerWheel::Insert( idEvent* event )
+{
+	const int time = event->time;
+
+	if( time < wheelTime )
+	{
+		if( Num() == 0 )
+		{
+			// the wheel can always be moved back while it's empty
+			wheelTime = time;
+		}
+		else
+		{
+			InsertLate( event );
+			return;
+		}
+	}
+
+	idLinkList<idEvent>* slot;
+	int level;
+	if( ( time >> BlockShift( 0 ) ) == ( wheelTime >> BlockShift( 0 ) ) )
+	{
+		level = 0;
+		slot = &level0[ time & ( ( 1 << EVENT_WHEEL_LEVEL0_BITS ) - 1 ) ];
+	}
+	else
+	{
+		slot = &overflow;
+		level = EVENT_WHEEL_OVERFLOW;
+		for( int i = 1; i < EVENT_WHEEL_LEVELS; i++ )
+		{
+			if( ( time >> BlockShift( i ) ) == ( wheelTime >> BlockShift( i ) ) )
+			{
+				level = i;
+				slot = &levels[ i - 1 ][ ( time >> BlockShift( i - 1 ) ) & ( ( 1 << EVENT_WHEEL_LEVEL_BITS ) - 1 ) ];
+				break;
+			}
+		}
+	}
+
+	event->eventNode.AddToEnd( *slot );
+	event->queue = this;
+	event->queueLevel = level;
+	numEvents[ level ]++;
+}
+
+/*
+================
+idEventTimerWheel::Remove
+================
+*/
+void idEventTimerWheel::Remove( idEvent* event )
+{
+	assert( event->queue == this );
+
+	if( event->queueLevel != EVENT_WHEEL_LATE )
+	{
+		numEvents[ event->queueLevel ]--;
+		assert( numEvents[ event->queueLevel ] >= 0 );
+	}
+	event->eventNode.Remove();
+	event->queue = NULL;
+}
+
+/*
+================
+idEventTimerWheel::Reinsert
+================
+*/
+void idEventTimerWheel::Reinsert( idLinkList<idEvent>& list )
+{
+	// events that end up in the same list again are appended, so only walk the ones that were there
+	for( int num = list.Num(); num > 0; num-- )
+	{
+		idEvent* event = list.Next();
+		Remove( event );
+		Insert( event );
+	}
+}
+
+/*
+================
+idEventTimerWheel::Cascade
+
+Called when the wheel enters a new level 0 block, moves the events of the new block down.
+================
+*/
+void idEventTimerWheel::Cascade()
+{
+	const int slotMask = ( 1 << EVENT_WHEEL_LEVEL_BITS ) - 1;
+
+	if( ( wheelTime & ( ( 1 << BlockShift( EVENT_WHEEL_LEVELS - 1 ) ) - 1 ) ) == 0 && numEvents[ EVENT_WHEEL_OVERFLOW ] > 0 )
+	{
+		Reinsert( overflow );
+	}
+	for( int i = EVENT_WHEEL_LEVELS - 1; i >= 1; i-- )
+	{
+		if( ( wheelTime & ( ( 1 << BlockShift( i - 1 ) ) - 1 ) ) == 0 && numEvents[ i ] > 0 )
+		{
+			Reinsert( levels[ i - 1 ][ ( wheelTime >> BlockShift( i - 1 ) ) & slotMask ] );
+		}
+	}
+}
+
+/*
+================
+idEventTimerWheel::Advance
+
+Moves the wheel towards the given time, skipping blocks without events.
+================
+*/
+void idEventTimerWheel::Advance( int time )
+{
+	if( numEvents[ 0 ] > 0 )
+	{
+		wheelTime++;
+		if( ( wheelTime & ( ( 1 << EVENT_WHEEL_LEVEL0_BITS ) - 1 ) ) == 0 )
+		{
+			Cascade();
+		}
+		return;
+	}
+
+	// jump to the start of the next block that has events to move down
+	int level = 1;
+	while( level <= EVENT_WHEEL_LEVELS && numEvents[ level ] == 0 )
+	{
+		level++;
+	}
+	if( level > EVENT_WHEEL_LEVELS )
+	{
+		wheelTime = time;
+		return;
+	}
+
+	const int shift = BlockShift( level - 1 );
+	const int next = ( ( wheelTime >> shift ) + 1 ) << shift;
+	if( next > time )
+	{
+		wheelTime = time;
+		return;
+	}
+
+	wheelTime = next;
+	Cascade();
+}
+
+/*
+================
+idEventTimerWheel::NextDue
+================
+*/
+idEvent* idEventTimerWheel::NextDue( int time )
+{
+	if( !late.IsListEmpty() )
+	{
+		idEvent* event = late.Next();
+		return ( event->time <= time ) ? event : NULL;
+	}
+
+	while( true )
+	{
+		idEvent* event = level0[ wheelTime & ( ( 1 << EVENT_WHEEL_LEVEL0_BITS ) - 1 ) ].Next();
+		if( event != NULL )
+		{
+			return ( event->time <= time ) ? event : NULL;
+		}
+		if( wheelTime >= time )
+		{
+			return NULL;
+		}
+		Advance( time );
+	}
+}
+
+/*
+================
+idEventTimerWheel::GetEvents
+================
+*/
+void idEventTimerWheel::GetEvents( idList<idEvent*>& list ) const
+{
+	list.SetNum( 0 );
+	list.SetGranularity( 256 );
+
+	idEvent* event;
+	for( event = late.Next(); event != NULL; event = event->eventNode.Next() )
+	{
+		list.Append( event );
+	}
+
+	// the levels hold increasingly later blocks and the slots of a level are in time order,
+	// only the events in a single slot above level 0 still have to be sorted
+	const int firstUnsorted = list.Num();
+	for( int i = 0; i < ( 1 << EVENT_WHEEL_LEVEL0_BITS ); i++ )
+	{
+		for( event = level0[ i ].Next(); event != NULL; event = event->eventNode.Next() )
+		{
+			list.Append( event );
+		}
+	}
+	for( int i = 0; i < EVENT_WHEEL_LEVELS - 1; i++ )
+	{
+		for( int j = 0; j < ( 1 << EVENT_WHEEL_LEVEL_BITS ); j++ )
+		{
+			for( event = levels[ i ][ j ].Next(); event != NULL; event = event->eventNode.Next() )
+			{
+				list.Append( event );
+			}
+		}
+	}
+	for( event = overflow.Next(); event != NULL; event = event->eventNode.Next() )
+	{
+		list.Append( event );
+	}
+
+	// stable insertion sort, keeps the order of events with the same time
+	for( int i = firstUnsorted + 1; i < list.Num(); i++ )
+	{
+		event = list[ i ];
+		int j = i - 1;
+		while( j >= firstUnsorted && list[ j ]->time > event->time )
+		{
+			list[ j + 1 ] = list[ j ];
+			j--;
+		}
+		list[ j + 1 ] = event;
+	}
+}
+
 /***********************************************************************
 
   idEvent
@@ -241,8 +625,8 @@ const idEventDef* idEventDef::FindEvent( const char* name )
 ***********************************************************************/
 
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
-static idLinkList<idEvent> FastEventQueue;
+static idEventTimerWheel EventQueue;
+static idEventTimerWheel FastEventQueue;
 static idEvent EventPool[ MAX_EVENTS ];
 
 bool idEvent::initialized = false;
@@ -414,6 +798,8 @@ idEvent::Free
 */
 void idEvent::Free()
 {
+	RemoveFromQueue();
+
 	if( data )
 	{
 		eventDataAllocator.Free( data );
@@ -429,6 +815,20 @@ void idEvent::Free()
 	eventNode.AddToEnd( FreeEvents );
 }
 
+/*
+================
+idEvent::RemoveFromQueue
+================
+*/
+void idEvent::RemoveFromQueue()
+{
+	if( queue != NULL )
+	{
+		queue->Remove( this );
+	}
+	objectNode.Remove();
+}
+
 /*
 ================
 idEvent::Schedule
@@ -436,8 +836,6 @@ idEvent::Schedule
 */
 void idEvent::Schedule( idClass* obj, const idTypeInfo* type, int time )
 {
-	idEvent* event;
-
 	assert( initialized );
 	if( !initialized )
 	{
@@ -452,43 +850,17 @@ void idEvent::Schedule( idClass* obj, const idTypeInfo* type, int time )
 
 	eventNode.Remove();
 
+	objectNode.SetOwner( this );
+	objectNode.AddToEnd( obj->scheduledEvents );
+
 	if( obj->IsType( idEntity::Type ) && ( ( ( idEntity* )( obj ) )->timeGroup == TIME_GROUP2 ) )
 	{
-		event = FastEventQueue.Next();
-		while( ( event != NULL ) && ( this->time >= event->time ) )
-		{
-			event = event->eventNode.Next();
-		}
-
-		if( event )
-		{
-			eventNode.InsertBefore( event->eventNode );
-		}
-		else
-		{
-			eventNode.AddToEnd( FastEventQueue );
-		}
-
-		return;
+		FastEventQueue.Insert( this );
 	}
 	else
 	{
 		this->time = gameLocal.slow.time + time;
-	}
-
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) )
-	{
-		event = event->eventNode.Next();
-	}
-
-	if( event )
-	{
-		eventNode.InsertBefore( event->eventNode );
-	}
-	else
-	{
-		eventNode.AddToEnd( EventQueue );
+		EventQueue.Insert( this );
 	}
 }
 
@@ -507,27 +879,12 @@ void idEvent::CancelEvents( const idClass* obj, const idEventDef* evdef )
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next )
-	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
-		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
-		}
-	}
-
-	for( event = FastEventQueue.Next(); event != NULL; event = next )
+	for( event = obj->scheduledEvents.Next(); event != NULL; event = next )
 	{
-		next = event->eventNode.Next();
-		if( event->object == obj )
+		next = event->objectNode.Next();
+		if( !evdef || ( evdef == event->eventdef ) )
 		{
-			if( !evdef || ( evdef == event->eventdef ) )
-			{
-				event->Free();
-			}
+			event->Free();
 		}
 	}
 }
@@ -546,12 +903,14 @@ void idEvent::ClearEventList()
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
+	FastEventQueue.Clear();
 
 	//
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ )
 	{
+		EventPool[ i ].queue = NULL;
 		EventPool[ i ].Free();
 	}
 }
@@ -578,16 +937,8 @@ void idEvent::ServiceEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() )
+	while( ( event = EventQueue.NextDue( gameLocal.time ) ) != NULL )
 	{
-		event = EventQueue.Next();
-		assert( event );
-
-		if( event->time > gameLocal.time )
-		{
-			break;
-		}
-
 		common->UpdateLevelLoadPacifier();
 
 		// copy the data into the local args array and set up pointers
@@ -642,9 +993,9 @@ void idEvent::ServiceEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its lists so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->RemoveFromQueue();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -692,16 +1043,8 @@ void idEvent::ServiceFastEvents()
 	const char*  materialName;
 
 	num = 0;
-	while( !FastEventQueue.IsListEmpty() )
+	while( ( event = FastEventQueue.NextDue( gameLocal.fast.time ) ) != NULL )
 	{
-		event = FastEventQueue.Next();
-		assert( event );
-
-		if( event->time > gameLocal.fast.time )
-		{
-			break;
-		}
-
 		// copy the data into the local args array and set up pointers
 		ev = event->eventdef;
 		formatspec = ev->GetArgFormat();
@@ -754,9 +1097,9 @@ void idEvent::ServiceFastEvents()
 			}
 		}
 
-		// the event is removed from its list so that if then object
+		// the event is removed from its lists so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->RemoveFromQueue();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -859,11 +1202,14 @@ void idEvent::Save( idSaveGame* savefile )
 	idStr s;
 	// RB end
 
-	savefile->WriteInt( EventQueue.Num() );
+	idList<idEvent*> events;
+	EventQueue.GetEvents( events );
+
+	savefile->WriteInt( events.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL )
+	for( int e = 0; e < events.Num(); e++ )
 	{
+		event = events[ e ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -933,23 +1279,22 @@ void idEvent::Save( idSaveGame* savefile )
 			}
 		}
 		assert( size == ( int )event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 
 	// Save the Fast EventQueue
-	savefile->WriteInt( FastEventQueue.Num() );
+	FastEventQueue.GetEvents( events );
 
-	event = FastEventQueue.Next();
-	while( event != NULL )
+	savefile->WriteInt( events.Num() );
+
+	for( int e = 0; e < events.Num(); e++ )
 	{
+		event = events[ e ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
 		savefile->WriteObject( event->object );
 		savefile->WriteInt( event->eventdef->GetArgSize() );
 		savefile->Write( event->data, event->eventdef->GetArgSize() );
-
-		event = event->eventNode.Next();
 	}
 }
 
@@ -981,7 +1326,6 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -1004,6 +1348,9 @@ void idEvent::Restore( idRestoreGame* savefile )
 		}
 
 		savefile->ReadObject( event->object );
+		event->objectNode.SetOwner( event );
+		event->objectNode.AddToEnd( event->object->scheduledEvents );
+		EventQueue.Insert( event );
 
 		// read the args
 		savefile->ReadInt( argsize );
@@ -1099,7 +1446,6 @@ void idEvent::Restore( idRestoreGame* savefile )
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( FastEventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -1122,6 +1468,9 @@ void idEvent::Restore( idRestoreGame* savefile )
 		}
 
 		savefile->ReadObject( event->object );
+		event->objectNode.SetOwner( event );
+		event->objectNode.AddToEnd( event->object->scheduledEvents );
+		FastEventQueue.Insert( event );
 
 		// read the args
 		savefile->ReadInt( argsize );
@@ -91,9 +91,12 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventTimerWheel;
 
 class idEvent
 {
+	friend class idEventTimerWheel;
+
 private:
 	const idEventDef*			eventdef;
 	byte*						data;
@@ -102,6 +105,11 @@ private:
 	const idTypeInfo*			typeinfo;
 
 	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			objectNode;		// in the list of events scheduled on the object
+	idEventTimerWheel*			queue;			// queue the event is scheduled in, NULL if not scheduled
+	int							queueLevel;		// timer wheel level, -1 for events older than the wheel
+
+	void						RemoveFromQueue();
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
@@ -51,6 +51,7 @@ extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
 extern idCVar	g_debugScript;
+extern idCVar	g_scriptFastStatements;
 extern idCVar	g_debugMover;
 extern idCVar	g_debugTriggers;
 extern idCVar	g_debugCinematic;
@@ -79,6 +80,9 @@ extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
 extern idCVar	g_timeentities;
+extern idCVar	g_parallelThink;
+extern idCVar	g_parallelAnimFrames;
+extern idCVar	g_clipBroadphase;
 
 extern idCVar	ai_debugScript;
 extern idCVar	ai_debugMove;
@@ -150,6 +154,7 @@ extern idCVar	af_showInertia;
 extern idCVar	af_showVelocity;
 extern idCVar	af_showActive;
 extern idCVar	af_testSolid;
+extern idCVar	af_parallelSolve;
 
 extern idCVar	rb_showTimings;
 extern idCVar	rb_showBodies;
@@ -52,6 +52,26 @@ typedef struct clipLink_s
 	struct clipLink_s* 		nextLink;
 } clipLink_t;
 
+#define CLIP_OCTREE_MAX_DEPTH			10
+#define CLIP_OCTREE_MIN_HALF_SIZE		32.0f
+
+// The loose bounds of an octree node are twice the size of its cell. A clip model is linked into
+// the deepest node with a cell that contains the center of the clip model and a half size that is
+// at least as large as the largest half extent of the clip model, so it is always linked into a
+// single node and completely inside the loose bounds of that node.
+typedef struct clipOctreeNode_s
+{
+	idVec3					center;					// center of the cell
+	float					halfSize;				// half size of the cell
+	idBounds				looseBounds;
+	int						depth;
+	int						numClipModels;			// clip models linked into this node
+	int						numTotalClipModels;		// clip models linked into this node and all nodes below
+	struct clipOctreeNode_s* parent;
+	struct clipOctreeNode_s* children[8];
+	idClipModel* 			clipModels;
+} clipOctreeNode_t;
+
 typedef struct trmCache_s
 {
 	idTraceModel			trm;
@@ -64,6 +84,7 @@ typedef struct trmCache_s
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
 idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
+idBlockAlloc<clipOctreeNode_t, 256>	clipOctreeNodeAllocator;
 
 
 /*
@@ -406,6 +427,8 @@ void idClipModel::Init()
 	traceModelIndex = -1;
 	clipLinks = NULL;
 	touchCount = -1;
+	octreeNode = NULL;
+	octreePrev = octreeNext = NULL;
 }
 
 /*
@@ -489,6 +512,8 @@ idClipModel::idClipModel( const idClipModel* model )
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
 	touchCount = -1;
+	octreeNode = NULL;
+	octreePrev = octreeNext = NULL;
 }
 
 /*
@@ -533,7 +558,7 @@ void idClipModel::Save( idSaveGame* savefile ) const
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
+	savefile->WriteBool( IsLinked() );
 	savefile->WriteInt( touchCount );
 }
 
@@ -594,7 +619,7 @@ idClipModel::SetPosition
 */
 void idClipModel::SetPosition( const idVec3& newOrigin, const idMat3& newAxis )
 {
-	if( clipLinks )
+	if( IsLinked() )
 	{
 		Unlink();	// unlink from old position
 	}
@@ -670,6 +695,47 @@ void idClipModel::Unlink()
 		}
 		clipLinkAllocator.Free( link );
 	}
+
+	if( octreeNode )
+	{
+		UnlinkOctree();
+	}
+}
+
+/*
+===============
+idClipModel::UnlinkOctree
+===============
+*/
+void idClipModel::UnlinkOctree()
+{
+	clipOctreeNode_t* node = octreeNode;
+
+	if( !node )
+	{
+		return;
+	}
+
+	if( octreePrev )
+	{
+		octreePrev->octreeNext = octreeNext;
+	}
+	else
+	{
+		node->clipModels = octreeNext;
+	}
+	if( octreeNext )
+	{
+		octreeNext->octreePrev = octreePrev;
+	}
+	octreePrev = octreeNext = NULL;
+	octreeNode = NULL;
+
+	node->numClipModels--;
+	for( ; node; node = node->parent )
+	{
+		node->numTotalClipModels--;
+	}
 }
 
 /*
@@ -733,6 +799,7 @@ void idClipModel::Link( idClip& clp )
 
 	if( bounds.IsCleared() )
 	{
+		UnlinkOctree();
 		return;
 	}
 
@@ -754,6 +821,16 @@ void idClipModel::Link( idClip& clp )
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
+	clp.numLinks++;
+
+	if( clp.octreeRoot )
+	{
+		// only relinks when the clip model moved into another node
+		clp.LinkOctree( this );
+		return;
+	}
+
+	UnlinkOctree();
 	Link_r( clp.clipSectors );
 }
 
@@ -810,7 +887,12 @@ idClip::idClip()
 	numClipSectors = 0;
 	clipSectors = NULL;
 	worldBounds.Zero();
+	touchCount = -1;
+	octreeRoot = NULL;
+	octreeMaxDepth = 0;
+	numOctreeNodes = 0;
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numLinks = numLinksSkipped = 0;
 }
 
 /*
@@ -880,28 +962,85 @@ idClip::Init
 void idClip::Init()
 {
 	cmHandle_t h;
+	idBounds bounds;
+
+	// get world map bounds
+	h = collisionModelManager->LoadModel( "worldMap" );
+	collisionModelManager->GetModelBounds( h, bounds );
+	// create world sectors or octree
+	InitBroadphase( bounds, ( g_clipBroadphase.GetInteger() == 1 ) ? CLIP_BROADPHASE_OCTREE : CLIP_BROADPHASE_SECTORS );
+
+	// initialize a default clip model
+	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
+
+	// set counters to zero
+	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numLinks = numLinksSkipped = 0;
+}
+
+/*
+===============
+idClip::InitBroadphase
+===============
+*/
+void idClip::InitBroadphase( const idBounds& bounds, clipBroadphase_t type )
+{
 	idVec3 size, maxSector = vec3_origin;
 
+	ShutdownBroadphase();
+
+	worldBounds = bounds;
+	touchCount = -1;
+
+	size = worldBounds[1] - worldBounds[0];
+	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
+
+	if( type == CLIP_BROADPHASE_OCTREE )
+	{
+		// the root cell is a cube around the world bounds, clip models outside of it are linked into the root
+		float halfSize = 0.5f * Max( size[0], Max( size[1], size[2] ) ) + CM_BOX_EPSILON;
+		octreeRoot = AllocOctreeNode( NULL, worldBounds.GetCenter(), halfSize );
+
+		for( octreeMaxDepth = 0; octreeMaxDepth < CLIP_OCTREE_MAX_DEPTH; octreeMaxDepth++ )
+		{
+			if( halfSize * 0.5f < CLIP_OCTREE_MIN_HALF_SIZE )
+			{
+				break;
+			}
+			halfSize *= 0.5f;
+		}
+		gameLocal.Printf( "clip octree depth is %d, smallest cell is %1.1f\n", octreeMaxDepth, 2.0f * halfSize );
+		return;
+	}
+
 	// clear clip sectors
 	clipSectors = new( TAG_PHYSICS_CLIP ) clipSector_t[MAX_SECTORS];
 	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
 	numClipSectors = 0;
-	touchCount = -1;
-	// get world map bounds
-	h = collisionModelManager->LoadModel( "worldMap" );
-	collisionModelManager->GetModelBounds( h, worldBounds );
 	// create world sectors
 	CreateClipSectors_r( 0, worldBounds, maxSector );
 
-	size = worldBounds[1] - worldBounds[0];
-	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
 	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
+}
 
-	// initialize a default clip model
-	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
+/*
+===============
+idClip::ShutdownBroadphase
+===============
+*/
+void idClip::ShutdownBroadphase()
+{
+	delete[] clipSectors;
+	clipSectors = NULL;
+	numClipSectors = 0;
 
-	// set counters to zero
-	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	if( octreeRoot )
+	{
+		FreeOctree_r( octreeRoot );
+		octreeRoot = NULL;
+	}
+	octreeMaxDepth = 0;
+	numOctreeNodes = 0;
 }
 
 /*
@@ -911,8 +1050,7 @@ idClip::Shutdown
 */
 void idClip::Shutdown()
 {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	ShutdownBroadphase();
 
 	// free the trace model used for the temporaryClipModel
 	if( temporaryClipModel.traceModelIndex != -1 )
@@ -929,6 +1067,147 @@ void idClip::Shutdown()
 	}
 
 	clipLinkAllocator.Shutdown();
+	clipOctreeNodeAllocator.Shutdown();
+}
+
+/*
+===============
+idClip::AllocOctreeNode
+===============
+*/
+clipOctreeNode_t* idClip::AllocOctreeNode( clipOctreeNode_t* parent, const idVec3& center, const float halfSize )
+{
+	clipOctreeNode_t* node = clipOctreeNodeAllocator.Alloc();
+
+	node->center = center;
+	node->halfSize = halfSize;
+	node->looseBounds[0] = center - idVec3( 2.0f * halfSize, 2.0f * halfSize, 2.0f * halfSize );
+	node->looseBounds[1] = center + idVec3( 2.0f * halfSize, 2.0f * halfSize, 2.0f * halfSize );
+	node->depth = parent ? parent->depth + 1 : 0;
+	node->numClipModels = 0;
+	node->numTotalClipModels = 0;
+	node->parent = parent;
+	memset( node->children, 0, sizeof( node->children ) );
+	node->clipModels = NULL;
+
+	numOctreeNodes++;
+
+	return node;
+}
+
+/*
+===============
+idClip::FreeOctree_r
+===============
+*/
+void idClip::FreeOctree_r( clipOctreeNode_t* node )
+{
+	for( int i = 0; i < 8; i++ )
+	{
+		if( node->children[i] )
+		{
+			FreeOctree_r( node->children[i] );
+		}
+	}
+
+	// clip models that are still linked should not point to a freed node
+	idClipModel* next;
+	for( idClipModel* mdl = node->clipModels; mdl; mdl = next )
+	{
+		next = mdl->octreeNext;
+		mdl->octreeNode = NULL;
+		mdl->octreePrev = mdl->octreeNext = NULL;
+	}
+
+	clipOctreeNodeAllocator.Free( node );
+}
+
+/*
+===============
+idClip::OctreeNodeForBounds
+
+Returns the deepest node with a cell that contains the center of the bounds and that is
+at least as large as the bounds, child nodes are created on the way down.
+===============
+*/
+clipOctreeNode_t* idClip::OctreeNodeForBounds( const idBounds& bounds )
+{
+	clipOctreeNode_t* node = octreeRoot;
+	const idVec3 center = ( bounds[0] + bounds[1] ) * 0.5f;
+	const idVec3 extents = ( bounds[1] - bounds[0] ) * 0.5f;
+	const float radius = Max( extents[0], Max( extents[1], extents[2] ) );
+
+	if( idMath::Fabs( center[0] - node->center[0] ) > node->halfSize ||
+			idMath::Fabs( center[1] - node->center[1] ) > node->halfSize ||
+			idMath::Fabs( center[2] - node->center[2] ) > node->halfSize )
+	{
+		return node;
+	}
+
+	while( node->depth < octreeMaxDepth )
+	{
+		const float childHalfSize = node->halfSize * 0.5f;
+		if( radius > childHalfSize )
+		{
+			break;
+		}
+
+		int index = 0;
+		idVec3 childCenter = node->center;
+		for( int i = 0; i < 3; i++ )
+		{
+			if( center[i] >= node->center[i] )
+			{
+				index |= 1 << i;
+				childCenter[i] += childHalfSize;
+			}
+			else
+			{
+				childCenter[i] -= childHalfSize;
+			}
+		}
+
+		if( !node->children[index] )
+		{
+			node->children[index] = AllocOctreeNode( node, childCenter, childHalfSize );
+		}
+		node = node->children[index];
+	}
+
+	return node;
+}
+
+/*
+===============
+idClip::LinkOctree
+===============
+*/
+void idClip::LinkOctree( idClipModel* mdl )
+{
+	clipOctreeNode_t* node = OctreeNodeForBounds( mdl->absBounds );
+
+	if( node == mdl->octreeNode )
+	{
+		numLinksSkipped++;
+		return;
+	}
+
+	mdl->UnlinkOctree();
+
+	mdl->octreeNode = node;
+	mdl->octreePrev = NULL;
+	mdl->octreeNext = node->clipModels;
+	if( node->clipModels )
+	{
+		node->clipModels->octreePrev = mdl;
+	}
+	node->clipModels = mdl;
+
+	node->numClipModels++;
+	for( ; node; node = node->parent )
+	{
+		node->numTotalClipModels++;
+	}
 }
 
 /*
@@ -1010,6 +1289,63 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s* node, listPa
 	}
 }
 
+/*
+====================
+idClip::ClipModelsTouchingOctree_r
+====================
+*/
+void idClip::ClipModelsTouchingOctree_r( const clipOctreeNode_t* node, listParms_t& parms ) const
+{
+	for( idClipModel* check = node->clipModels; check; check = check->octreeNext )
+	{
+		// if the clip model is enabled
+		if( !check->enabled )
+		{
+			continue;
+		}
+
+		// if the clip model does not have any contents we are looking for
+		if( !( check->contents & parms.contentMask ) )
+		{
+			continue;
+		}
+
+		// if the bounds really do overlap
+		if(	check->absBounds[0][0] > parms.bounds[1][0] ||
+				check->absBounds[1][0] < parms.bounds[0][0] ||
+				check->absBounds[0][1] > parms.bounds[1][1] ||
+				check->absBounds[1][1] < parms.bounds[0][1] ||
+				check->absBounds[0][2] > parms.bounds[1][2] ||
+				check->absBounds[1][2] < parms.bounds[0][2] )
+		{
+			continue;
+		}
+
+		if( parms.count >= parms.maxCount )
+		{
+			gameLocal.Warning( "idClip::ClipModelsTouchingOctree_r: max count" );
+			return;
+		}
+
+		parms.list[parms.count] = check;
+		parms.count++;
+	}
+
+	for( int i = 0; i < 8; i++ )
+	{
+		const clipOctreeNode_t* child = node->children[i];
+		if( !child || child->numTotalClipModels == 0 )
+		{
+			continue;
+		}
+		if( !child->looseBounds.IntersectsBounds( parms.bounds ) )
+		{
+			continue;
+		}
+		ClipModelsTouchingOctree_r( child, parms );
+	}
+}
+
 /*
 ================
 idClip::ClipModelsTouchingBounds
@@ -1036,6 +1372,13 @@ int idClip::ClipModelsTouchingBounds( const idBounds& bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
+	if( octreeRoot )
+	{
+		// every clip model is linked into a single node so there are no duplicates to skip
+		ClipModelsTouchingOctree_r( octreeRoot, parms );
+		return parms.count;
+	}
+
 	touchCount++;
 	ClipModelsTouchingBounds_r( clipSectors, parms );
 
@@ -1985,9 +2328,89 @@ idClip::PrintStatistics
 */
 void idClip::PrintStatistics()
 {
-	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
-					  numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
+	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d, links = %-3d, skipped = %-3d\n",
+					  numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts, numLinks, numLinksSkipped );
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	numLinks = numLinksSkipped = 0;
+}
+
+/*
+============
+CountOctreeNodes_r
+============
+*/
+static void CountOctreeNodes_r( const clipOctreeNode_t* node, int* numNodes, int* numClipModels, int& maxClipModels )
+{
+	numNodes[node->depth]++;
+	numClipModels[node->depth] += node->numClipModels;
+	maxClipModels = Max( maxClipModels, node->numClipModels );
+
+	for( int i = 0; i < 8; i++ )
+	{
+		if( node->children[i] )
+		{
+			CountOctreeNodes_r( node->children[i], numNodes, numClipModels, maxClipModels );
+		}
+	}
+}
+
+/*
+============
+idClip::PrintBroadphaseInfo
+============
+*/
+void idClip::PrintBroadphaseInfo() const
+{
+	if( octreeRoot )
+	{
+		int numNodes[CLIP_OCTREE_MAX_DEPTH + 1] = { 0 };
+		int numClipModels[CLIP_OCTREE_MAX_DEPTH + 1] = { 0 };
+		int maxClipModels = 0;
+
+		CountOctreeNodes_r( octreeRoot, numNodes, numClipModels, maxClipModels );
+
+		gameLocal.Printf( "loose octree: %d nodes, %d clip models, max %d in a single node\n", numOctreeNodes, octreeRoot->numTotalClipModels, maxClipModels );
+		for( int i = 0; i <= octreeMaxDepth; i++ )
+		{
+			gameLocal.Printf( "depth %2d: cell %8.1f, %5d nodes, %5d clip models\n", i, 2.0f * octreeRoot->halfSize / ( 1 << i ), numNodes[i], numClipModels[i] );
+		}
+		return;
+	}
+
+	int numLeafs = 0;
+	int numUsedLeafs = 0;
+	int numClipModels = 0;
+	int numClipLinks = 0;
+	int maxClipLinks = 0;
+
+	for( int i = 0; i < numClipSectors; i++ )
+	{
+		if( clipSectors[i].axis != -1 )
+		{
+			continue;
+		}
+		numLeafs++;
+
+		int num = 0;
+		for( const clipLink_t* link = clipSectors[i].clipLinks; link; link = link->nextInSector )
+		{
+			// the last link added for a clip model is the head of its list
+			if( link->clipModel->clipLinks == link )
+			{
+				numClipModels++;
+			}
+			num++;
+		}
+		if( num )
+		{
+			numUsedLeafs++;
+		}
+		numClipLinks += num;
+		maxClipLinks = Max( maxClipLinks, num );
+	}
+
+	gameLocal.Printf( "clip sectors: %d sectors, %d of %d leafs used, %d clip models, %d links (%1.2f per clip model), max %d in a single sector\n",
+					  numClipSectors, numUsedLeafs, numLeafs, numClipModels, numClipLinks, ( float )numClipLinks / Max( numClipModels, 1 ), maxClipLinks );
 }
 
 /*
@@ -2062,3 +2485,127 @@ bool idClip::DrawModelContactFeature( const contactInfo_t& contact, const idClip
 
 	return true;
 }
+
+/*
+============
+listClipBroadphase
+============
+*/
+CONSOLE_COMMAND( listClipBroadphase, "shows how the clip models are linked into the clip sectors or loose octree", 0 )
+{
+	if( !gameLocal.IsInGame() )
+	{
+		idLib::Printf( "listClipBroadphase needs a map to be loaded\n" );
+		return;
+	}
+	gameLocal.clip.PrintBroadphaseInfo();
+}
+
+/*
+============
+testClipBroadphase
+
+Links moving boxes into a separate idClip for both broadphases and times linking them and
+finding the boxes touching each box. Every 16th box is a large mover.
+============
+*/
+CONSOLE_COMMAND( testClipBroadphase, "times the clip sectors against the loose octree with moving clip models, usage: testClipBroadphase [numClipModels] [numFrames]", 0 )
+{
+	static const float boxSizes[] = { 8.0f, 16.0f, 32.0f, 64.0f };
+	static const char* broadphaseNames[] = { "sectors", "octree" };
+
+	if( !gameLocal.IsInGame() )
+	{
+		idLib::Printf( "testClipBroadphase needs a map to be loaded\n" );
+		return;
+	}
+
+	int numClipModels = 512;
+	int numFrames = 100;
+	if( args.Argc() > 1 )
+	{
+		numClipModels = idMath::ClampInt( 1, MAX_GENTITIES, atoi( args.Argv( 1 ) ) );
+	}
+	if( args.Argc() > 2 )
+	{
+		numFrames = Max( atoi( args.Argv( 2 ) ), 1 );
+	}
+
+	const idBounds& worldBounds = gameLocal.clip.GetWorldBounds();
+	idClipModel* clipModelList[MAX_GENTITIES];
+	int numTouching[2];
+
+	for( int type = CLIP_BROADPHASE_SECTORS; type <= CLIP_BROADPHASE_OCTREE; type++ )
+	{
+		idClip* testClip = new( TAG_PHYSICS_CLIP ) idClip;
+		testClip->InitBroadphase( worldBounds, ( clipBroadphase_t )type );
+
+		// use the same scene for both broadphases
+		idRandom random( 0 );
+		idList<idClipModel*> clipModels;
+		idList<idVec3> velocities;
+		clipModels.SetNum( numClipModels );
+		velocities.SetNum( numClipModels );
+
+		for( int i = 0; i < numClipModels; i++ )
+		{
+			const float size = ( ( i & 15 ) == 0 ) ? 512.0f : boxSizes[random.RandomInt( 4 )];
+			idVec3 origin;
+			for( int j = 0; j < 3; j++ )
+			{
+				origin[j] = worldBounds[0][j] + random.RandomFloat() * ( worldBounds[1][j] - worldBounds[0][j] );
+				velocities[i][j] = random.CRandomFloat() * 8.0f;
+			}
+			clipModels[i] = new( TAG_PHYSICS_CLIP ) idClipModel( idTraceModel( idBounds( vec3_origin ).Expand( size ) ), false );
+			clipModels[i]->Link( *testClip, gameLocal.world, i, origin, mat3_identity );
+		}
+		testClip->PrintStatistics();
+
+		uint64 linkMicroSec = 0;
+		uint64 queryMicroSec = 0;
+		numTouching[type] = 0;
+
+		for( int frame = 0; frame < numFrames; frame++ )
+		{
+			uint64 start = Sys_Microseconds();
+			for( int i = 0; i < numClipModels; i++ )
+			{
+				idVec3 origin = clipModels[i]->GetOrigin() + velocities[i];
+				for( int j = 0; j < 3; j++ )
+				{
+					// bounce off the world bounds
+					if( origin[j] < worldBounds[0][j] || origin[j] > worldBounds[1][j] )
+					{
+						velocities[i][j] = -velocities[i][j];
+						origin[j] += 2.0f * velocities[i][j];
+					}
+				}
+				clipModels[i]->Link( *testClip, gameLocal.world, i, origin, mat3_identity );
+			}
+			linkMicroSec += Sys_Microseconds() - start;
+
+			start = Sys_Microseconds();
+			for( int i = 0; i < numClipModels; i++ )
+			{
+				numTouching[type] += testClip->ClipModelsTouchingBounds( clipModels[i]->GetAbsBounds(), -1, clipModelList, MAX_GENTITIES );
+			}
+			queryMicroSec += Sys_Microseconds() - start;
+		}
+
+		idLib::Printf( "%-8s link %8.2f ms, query %8.2f ms, %d touching\n", broadphaseNames[type], linkMicroSec * 0.001f, queryMicroSec * 0.001f, numTouching[type] );
+		testClip->PrintStatistics();
+		testClip->PrintBroadphaseInfo();
+
+		for( int i = 0; i < numClipModels; i++ )
+		{
+			delete clipModels[i];
+		}
+		testClip->ShutdownBroadphase();
+		delete testClip;
+	}
+
+	if( numTouching[CLIP_BROADPHASE_SECTORS] != numTouching[CLIP_BROADPHASE_OCTREE] )
+	{
+		idLib::Printf( "TOUCHING MISMATCH\n" );
+	}
+}
@@ -44,6 +44,13 @@ class idClip;
 class idClipModel;
 class idEntity;
 
+// broadphase used by idClip to find the clip models touching some bounds
+enum clipBroadphase_t
+{
+	CLIP_BROADPHASE_SECTORS,		// fixed tree of sectors, clip models are linked into every sector they touch
+	CLIP_BROADPHASE_OCTREE			// loose octree, clip models are linked into a single node
+};
+
 //===============================================================
 //
 //	idClipModel
@@ -126,9 +133,13 @@ private:
 
 	struct clipLink_s* 		clipLinks;				// links into sectors
 	int						touchCount;
+	struct clipOctreeNode_s* octreeNode;			// loose octree node the clip model is linked into
+	idClipModel* 			octreePrev;				// previous clip model in the same octree node
+	idClipModel* 			octreeNext;				// next clip model in the same octree node
 
 	void					Init();			// initialize
 	void					Link_r( struct clipSector_s* node );
+	void					UnlinkOctree();
 
 	static int				AllocTraceModel( const idTraceModel& trm, bool persistantThroughSaves = true );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -243,7 +254,7 @@ ID_INLINE bool idClipModel::IsTraceModel() const
 
 ID_INLINE bool idClipModel::IsLinked() const
 {
-	return ( clipLinks != NULL );
+	return ( clipLinks != NULL || octreeNode != NULL );
 }
 
 ID_INLINE bool idClipModel::IsEnabled() const
@@ -283,6 +294,11 @@ public:
 	void					Init();
 	void					Shutdown();
 
+	// sets up an empty broadphase for the given bounds, Init uses g_clipBroadphase and the world bounds
+	void					InitBroadphase( const idBounds& bounds, clipBroadphase_t type );
+	void					ShutdownBroadphase();
+	clipBroadphase_t		GetBroadphase() const;
+
 	// clip versus the rest of the world
 	bool					Translation( trace_t& results, const idVec3& start, const idVec3& end,
 										 const idClipModel* mdl, const idMat3& trmAxis, int contentMask, const idEntity* passEntity );
@@ -331,6 +347,7 @@ public:
 
 	// stats and debug drawing
 	void					PrintStatistics();
+	void					PrintBroadphaseInfo() const;
 	void					DrawClipModels( const idVec3& eye, const float radius, const idEntity* passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t& contact, const idClipModel* clipModel, int lifetime ) const;
 
@@ -341,6 +358,9 @@ private:
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
 	mutable int				touchCount;
+	struct clipOctreeNode_s* octreeRoot;			// NULL when the sectors are used
+	int						octreeMaxDepth;
+	int						numOctreeNodes;
 	// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -348,10 +368,17 @@ private:
 	int						numRenderModelTraces;
 	int						numContents;
 	int						numContacts;
+	int						numLinks;				// clip models (re)linked into the broadphase
+	int						numLinksSkipped;		// octree relinks skipped because the clip model stayed in the same node
 
 private:
 	struct clipSector_s* 	CreateClipSectors_r( const int depth, const idBounds& bounds, idVec3& maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s* node, struct listParms_s& parms ) const;
+	struct clipOctreeNode_s* AllocOctreeNode( struct clipOctreeNode_s* parent, const idVec3& center, const float halfSize );
+	void					FreeOctree_r( struct clipOctreeNode_s* node );
+	struct clipOctreeNode_s* OctreeNodeForBounds( const idBounds& bounds );
+	void					LinkOctree( idClipModel* mdl );
+	void					ClipModelsTouchingOctree_r( const struct clipOctreeNode_s* node, struct listParms_s& parms ) const;
 	const idTraceModel* 	TraceModelForClipModel( const idClipModel* mdl ) const;
 	int						GetTraceClipModels( const idBounds& bounds, int contentMask, const idEntity* passEntity, idClipModel** clipModelList ) const;
 	void					TraceRenderModel( trace_t& trace, const idVec3& start, const idVec3& end, const float radius, const idMat3& axis, idClipModel* touch ) const;
@@ -376,6 +403,11 @@ ID_INLINE const idBounds& idClip::GetWorldBounds() const
 	return worldBounds;
 }
 
+ID_INLINE clipBroadphase_t idClip::GetBroadphase() const
+{
+	return ( octreeRoot != NULL ) ? CLIP_BROADPHASE_OCTREE : CLIP_BROADPHASE_SECTORS;
+}
+
 ID_INLINE idClipModel* idClip::DefaultClipModel()
 {
 	return &defaultClipModel;
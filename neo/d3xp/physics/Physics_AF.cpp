@@ -5877,7 +5877,10 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Start();
+	if( jobSolveTime < 0 )
+	{
+		timer_lcp.Start();
+	}
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
@@ -5887,7 +5890,10 @@ void idPhysics_AF::AuxiliaryForces( float timeStep )
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Stop();
+	if( jobSolveTime < 0 )
+	{
+		timer_lcp.Stop();
+	}
 #endif
 
 	// calculate auxiliary constraint forces
@@ -7033,25 +7039,37 @@ const idBounds& idPhysics_AF::GetAbsBounds( int id ) const
 
 /*
 ================
-idPhysics_AF::Evaluate
+idPhysics_AF::GetTimeStep
 ================
 */
-bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
+float idPhysics_AF::GetTimeStep( int timeStepMSec, int endTimeMSec ) const
 {
-	float timeStep;
-
 	if( timeScaleRampStart < MS2SEC( endTimeMSec ) && timeScaleRampEnd > MS2SEC( endTimeMSec ) )
 	{
-		timeStep = MS2SEC( timeStepMSec ) * ( MS2SEC( endTimeMSec ) - timeScaleRampStart ) / ( timeScaleRampEnd - timeScaleRampStart );
+		return MS2SEC( timeStepMSec ) * ( MS2SEC( endTimeMSec ) - timeScaleRampStart ) / ( timeScaleRampEnd - timeScaleRampStart );
 	}
 	else if( af_timeScale.GetFloat() != 1.0f )
 	{
-		timeStep = MS2SEC( timeStepMSec ) * af_timeScale.GetFloat();
+		return MS2SEC( timeStepMSec ) * af_timeScale.GetFloat();
 	}
 	else
 	{
-		timeStep = MS2SEC( timeStepMSec ) * timeScale;
+		return MS2SEC( timeStepMSec ) * timeScale;
 	}
+}
+
+/*
+================
+idPhysics_AF::BeginEvaluate
+
+  returns false if the simulation is suspended
+================
+*/
+bool idPhysics_AF::BeginEvaluate( int timeStepMSec, int endTimeMSec )
+{
+	float timeStep;
+
+	timeStep = GetTimeStep( timeStepMSec, endTimeMSec );
 	current.lastTimeStep = timeStep;
 
 
@@ -7088,11 +7106,11 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	AddPushVelocity( -current.pushVelocity );
 
 #ifdef AF_TIMINGS
-	timer_total.Start();
-#endif
-
-#ifdef AF_TIMINGS
-	timer_collision.Start();
+	if( jobSolveTime < 0 )
+	{
+		timer_total.Start();
+		timer_collision.Start();
+	}
 #endif
 
 	// evaluate contacts
@@ -7102,9 +7120,24 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	SetupContactConstraints();
 
 #ifdef AF_TIMINGS
-	timer_collision.Stop();
+	if( jobSolveTime < 0 )
+	{
+		timer_collision.Stop();
+	}
 #endif
 
+	return true;
+}
+
+/*
+================
+idPhysics_AF::SolveConstraints
+
+  calculates the next state from the current state, only touches this articulated figure
+================
+*/
+void idPhysics_AF::SolveConstraints( float timeStep, int endTimeMSec )
+{
 	// evaluate constraint equations
 	EvaluateConstraints( timeStep );
 
@@ -7115,16 +7148,10 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	AddFrameConstraints();
 
 #ifdef AF_TIMINGS
-	int i, numPrimary = 0, numAuxiliary = 0;
-	for( i = 0; i < primaryConstraints.Num(); i++ )
-	{
-		numPrimary += primaryConstraints[i]->J1.GetNumRows();
-	}
-	for( i = 0; i < auxiliaryConstraints.Num(); i++ )
+	if( jobSolveTime < 0 )
 	{
-		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+		timer_pc.Start();
 	}
-	timer_pc.Start();
 #endif
 
 	// factor matrices for primary constraints
@@ -7134,19 +7161,45 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	PrimaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_pc.Stop();
-	timer_ac.Start();
+	if( jobSolveTime < 0 )
+	{
+		timer_pc.Stop();
+		timer_ac.Start();
+	}
 #endif
 
 	// calculate and apply auxiliary constraint forces
 	AuxiliaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_ac.Stop();
+	if( jobSolveTime < 0 )
+	{
+		timer_ac.Stop();
+	}
 #endif
 
 	// evolve current state to next state
 	Evolve( timeStep );
+}
+
+/*
+================
+idPhysics_AF::EndEvaluate
+================
+*/
+void idPhysics_AF::EndEvaluate( float timeStep, int endTimeMSec )
+{
+#ifdef AF_TIMINGS
+	int i, numPrimary = 0, numAuxiliary = 0;
+	for( i = 0; i < primaryConstraints.Num(); i++ )
+	{
+		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+	}
+	for( i = 0; i < auxiliaryConstraints.Num(); i++ )
+	{
+		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+	}
+#endif
 
 	// debug graphics
 	DebugDraw();
@@ -7161,14 +7214,20 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	RemoveFrameConstraints();
 
 #ifdef AF_TIMINGS
-	timer_collision.Start();
+	if( jobSolveTime < 0 )
+	{
+		timer_collision.Start();
+	}
 #endif
 
 	// check for collisions between current and next state
 	CheckForCollisions( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_collision.Stop();
+	if( jobSolveTime < 0 )
+	{
+		timer_collision.Stop();
+	}
 #endif
 
 	// swap the current and next state
@@ -7212,6 +7271,12 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 	}
 
 #ifdef AF_TIMINGS
+	if( jobSolveTime >= 0 )
+	{
+		// the timers were not running while this figure was solved on a job thread
+		return;
+	}
+
 	timer_total.Stop();
 
 	if( af_showTimings.GetInteger() == 1 )
@@ -7248,10 +7313,161 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
 		timer_lcp.Clear();
 	}
 #endif
+}
+
+/*
+================
+idPhysics_AF::Evaluate
+================
+*/
+bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec )
+{
+	// the next state may have been solved on a job thread at the start of the frame
+	if( jobSolveTime >= 0 )
+	{
+		if( IsJobSolveValid( timeStepMSec, endTimeMSec ) )
+		{
+			EndEvaluate( current.lastTimeStep, endTimeMSec );
+			jobSolveTime = -1;
+			return true;
+		}
+		CancelJobSolve();
+	}
+
+	if( !BeginEvaluate( timeStepMSec, endTimeMSec ) )
+	{
+		return false;
+	}
+
+	SolveConstraints( current.lastTimeStep, endTimeMSec );
+
+	EndEvaluate( current.lastTimeStep, endTimeMSec );
+
+	return true;
+}
+
+/*
+================
+idPhysics_AF::CanSolveOnJob
+
+  figures bound to a master or with suspension constraints use the state of other entities while solving
+================
+*/
+bool idPhysics_AF::CanSolveOnJob() const
+{
+	if( masterBody || bodies.Num() == 0 )
+	{
+		return false;
+	}
+	for( int i = 0; i < constraints.Num(); i++ )
+	{
+		if( constraints[i]->GetType() == CONSTRAINT_SUSPENSION )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idPhysics_AF::BeginJobSolve
+
+  Does everything that needs the rest of the world before solving on the main thread.
+  Returns false if the figure does not need to be solved this frame.
+================
+*/
+bool idPhysics_AF::BeginJobSolve( int timeStepMSec, int endTimeMSec )
+{
+	CancelJobSolve();
+
+	jobSolveTime = endTimeMSec;
+	jobSolvePushVelocity = current.pushVelocity;
+	jobSolveFirstFrameConstraint = frameConstraints.Num();
+
+	if( !BeginEvaluate( timeStepMSec, endTimeMSec ) )
+	{
+		jobSolveTime = -1;
+		return false;
+	}
+
+	// remember the state the next state is solved from so changes before the owner thinks are noticed
+	jobSolveStates.SetNum( bodies.Num() );
+	for( int i = 0; i < bodies.Num(); i++ )
+	{
+		jobSolveStates[i] = *bodies[i]->current;
+	}
+	return true;
+}
+
+/*
+================
+idPhysics_AF::JobSolve
+================
+*/
+void idPhysics_AF::JobSolve()
+{
+	SolveConstraints( current.lastTimeStep, jobSolveTime );
+	jobSolveNumFrameConstraints = frameConstraints.Num();
+}
 
+/*
+================
+idPhysics_AF::IsJobSolveValid
+
+  the solved state can only be used if nothing changed the figure since BeginJobSolve
+================
+*/
+bool idPhysics_AF::IsJobSolveValid( int timeStepMSec, int endTimeMSec ) const
+{
+	if( jobSolveTime != endTimeMSec || changedAF || current.atRest >= 0 )
+	{
+		return false;
+	}
+	if( GetTimeStep( timeStepMSec, endTimeMSec ) != current.lastTimeStep )
+	{
+		return false;
+	}
+	if( frameConstraints.Num() != jobSolveNumFrameConstraints || jobSolveStates.Num() != bodies.Num() )
+	{
+		return false;
+	}
+	for( int i = 0; i < bodies.Num(); i++ )
+	{
+		if( memcmp( bodies[i]->current, &jobSolveStates[i], sizeof( AFBodyPState_t ) ) != 0 )
+		{
+			return false;
+		}
+	}
 	return true;
 }
 
+/*
+================
+idPhysics_AF::CancelJobSolve
+
+  throws away a solved state that was not used, Evaluate will solve the figure again
+================
+*/
+void idPhysics_AF::CancelJobSolve()
+{
+	if( jobSolveTime < 0 )
+	{
+		return;
+	}
+	jobSolveTime = -1;
+
+	// remove the frame constraints added while solving but keep any added afterwards
+	auxiliaryConstraints.SetNum( auxiliaryConstraints.Num() - ( jobSolveNumFrameConstraints ) );
+	for( int i = jobSolveNumFrameConstraints - 1; i >= jobSolveFirstFrameConstraint; i-- )
+	{
+		frameConstraints.RemoveIndex( i );
+	}
+
+	// move the af velocity back into the world frame
+	AddPushVelocity( jobSolvePushVelocity );
+}
+
 /*
 ================
 idPhysics_AF::UpdateTime
@@ -7479,6 +7695,11 @@ idPhysics_AF::idPhysics_AF()
 
 	lcp = idLCP::AllocSymmetric();
 
+	jobSolveTime = -1;
+	jobSolveFirstFrameConstraint = 0;
+	jobSolveNumFrameConstraints = 0;
+	jobSolvePushVelocity.Zero();
+
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
 	current.lastTimeStep = 0.0f;
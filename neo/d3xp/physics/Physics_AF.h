@@ -1154,6 +1154,12 @@ public:	// common physics interface
 	void					WriteToSnapshot( idBitMsg& msg ) const;
 	void					ReadFromSnapshot( const idBitMsg& msg );
 
+	// solving on the job threads before the owner thinks, see idGameLocal::RunParallelAFSolve
+	bool					CanSolveOnJob() const;
+	bool					BeginJobSolve( int timeStepMSec, int endTimeMSec );	// on the main thread
+	void					JobSolve();											// on a job thread
+	void					CancelJobSolve();
+
 private:
 	// articulated figure
 	idList<idAFTree*, TAG_IDLIB_LIST_PHYSICS>		trees;							// tree structures
@@ -1215,7 +1221,19 @@ private:
 	idAFBody* 				masterBody;						// master body
 	idLCP* 					lcp;							// linear complementarity problem solver
 
+	// solved on a job thread
+	int						jobSolveTime;					// end time the next state was solved for, -1 if not solved
+	int						jobSolveFirstFrameConstraint;	// number of frame constraints before solving
+	int						jobSolveNumFrameConstraints;	// number of frame constraints after solving
+	idVec6					jobSolvePushVelocity;			// push velocity removed from the bodies before solving
+	idList<AFBodyPState_t, TAG_IDLIB_LIST_PHYSICS>	jobSolveStates;	// body states the next state was solved from
+
 private:
+	float					GetTimeStep( int timeStepMSec, int endTimeMSec ) const;
+	bool					BeginEvaluate( int timeStepMSec, int endTimeMSec );
+	void					SolveConstraints( float timeStep, int endTimeMSec );
+	void					EndEvaluate( float timeStep, int endTimeMSec );
+	bool					IsJobSolveValid( int timeStepMSec, int endTimeMSec ) const;
 	void					BuildTrees();
 	bool					IsClosedLoop( const idAFBody* body1, const idAFBody* body2 ) const;
 	void					PrimaryFactor();
@@ -1084,6 +1084,162 @@ void idInterpreter::CallSysEvent( const function_t* func, int argsize )
 	popParms = 0;
 }
 
+/*
+====================
+idInterpreter::ExecuteFastStatement
+
+Runs a statement that was lowered by idProgram::UpdateFastStatements.
+Returns false if the statement has to go through the regular interpreter.
+====================
+*/
+ID_FORCE_INLINE bool idInterpreter::ExecuteFastStatement( const fastStatement_t& st )
+{
+	byte* stack = &localstack[ localstackBase ];
+	byte* a = ( st.stackOperands & FASTOPERAND_A ) ? stack + st.a : ( byte* )st.a;
+	byte* b = ( st.stackOperands & FASTOPERAND_B ) ? stack + st.b : ( byte* )st.b;
+	byte* c = ( st.stackOperands & FASTOPERAND_C ) ? stack + st.c : ( byte* )st.c;
+
+#define FASTOP_FLOAT( x )	( *( float* )( x ) )
+#define FASTOP_INT( x )		( *( int* )( x ) )
+#define FASTOP_BRANCH_IFNOT( condition )	\
+	{											\
+		const bool result = ( condition );		\
+		FASTOP_FLOAT( c ) = result;				\
+		NextInstruction( result ? instructionPointer + 2 : st.jump );	\
+	}
+
+	switch( st.op )
+	{
+		case FASTOP_GOTO:
+			NextInstruction( st.jump );
+			return true;
+
+		case FASTOP_IF:
+			if( FASTOP_INT( a ) != 0 )
+			{
+				NextInstruction( st.jump );
+			}
+			return true;
+
+		case FASTOP_IFNOT:
+			if( FASTOP_INT( a ) == 0 )
+			{
+				NextInstruction( st.jump );
+			}
+			return true;
+
+		case FASTOP_ADD_F:
+			FASTOP_FLOAT( c ) = FASTOP_FLOAT( a ) + FASTOP_FLOAT( b );
+			return true;
+
+		case FASTOP_SUB_F:
+			FASTOP_FLOAT( c ) = FASTOP_FLOAT( a ) - FASTOP_FLOAT( b );
+			return true;
+
+		case FASTOP_MUL_F:
+			FASTOP_FLOAT( c ) = FASTOP_FLOAT( a ) * FASTOP_FLOAT( b );
+			return true;
+
+		case FASTOP_GE:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) >= FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_LE:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) <= FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_GT:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) > FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_LT:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) < FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_EQ_F:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) == FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_NE_F:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) != FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_AND:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) != 0.0f ) && ( FASTOP_FLOAT( b ) != 0.0f );
+			return true;
+
+		case FASTOP_OR:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) != 0.0f ) || ( FASTOP_FLOAT( b ) != 0.0f );
+			return true;
+
+		case FASTOP_NOT_F:
+			FASTOP_FLOAT( c ) = ( FASTOP_FLOAT( a ) == 0.0f );
+			return true;
+
+		case FASTOP_NOT_BOOL:
+			FASTOP_FLOAT( c ) = ( FASTOP_INT( a ) == 0 );
+			return true;
+
+		case FASTOP_NEG_F:
+			FASTOP_FLOAT( c ) = -FASTOP_FLOAT( a );
+			return true;
+
+		case FASTOP_UADD_F:
+			FASTOP_FLOAT( b ) += FASTOP_FLOAT( a );
+			return true;
+
+		case FASTOP_USUB_F:
+			FASTOP_FLOAT( b ) -= FASTOP_FLOAT( a );
+			return true;
+
+		case FASTOP_UINC_F:
+			FASTOP_FLOAT( a )++;
+			return true;
+
+		case FASTOP_UDEC_F:
+			FASTOP_FLOAT( a )--;
+			return true;
+
+		case FASTOP_STORE_F:
+			FASTOP_INT( b ) = FASTOP_INT( a );
+			return true;
+
+		case FASTOP_PUSH_F:
+			Push( FASTOP_INT( a ) );
+			return true;
+
+		case FASTOP_GE_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) >= FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_LE_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) <= FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_GT_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) > FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_LT_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) < FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_EQ_F_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) == FASTOP_FLOAT( b ) );
+			return true;
+
+		case FASTOP_NE_F_IFNOT:
+			FASTOP_BRANCH_IFNOT( FASTOP_FLOAT( a ) != FASTOP_FLOAT( b ) );
+			return true;
+	}
+
+#undef FASTOP_FLOAT
+#undef FASTOP_INT
+#undef FASTOP_BRANCH_IFNOT
+
+	return false;
+}
+
 /*
 ====================
 idInterpreter::Execute
@@ -1115,6 +1271,12 @@ bool idInterpreter::Execute()
 
 	runaway = 5000000;
 
+	const bool fastStatements = g_scriptFastStatements.GetBool();
+	if( fastStatements )
+	{
+		gameLocal.program.UpdateFastStatements();
+	}
+
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying )
 	{
@@ -1125,6 +1287,15 @@ bool idInterpreter::Execute()
 			Error( "runaway loop error" );
 		}
 
+		// statements compiled while this thread runs are only lowered on the next Execute
+		if( fastStatements && instructionPointer < gameLocal.program.NumFastStatements() )
+		{
+			if( ExecuteFastStatement( gameLocal.program.GetFastStatement( instructionPointer ) ) )
+			{
+				continue;
+			}
+		}
+
 		// next statement
 		st = &gameLocal.program.GetStatement( instructionPointer );
 
@@ -2119,3 +2290,102 @@ idScriptObject* idInterpreter::GetScriptObject( int entnum ) const
 	return NULL;
 }
 // RB end
+
+/*
+================
+testScriptVM
+
+Micro benchmark for the interpreter, runs a few compute heavy script functions
+with and without g_scriptFastStatements.
+================
+*/
+static const char* scriptBenchmarkText =
+	"float scriptBench_Arith() {\n"
+	"	float i; float sum;\n"
+	"	for( i = 0; i < 10000; i++ ) { sum = sum + i * 0.5 - 1; }\n"
+	"	return sum;\n"
+	"}\n"
+	"float scriptBench_Branch() {\n"
+	"	float i; float a;\n"
+	"	for( i = 0; i < 10000; i++ ) { if( i > 5000 ) { a = a + 1; } else if( a != 3 ) { a = a - 1; } }\n"
+	"	return a;\n"
+	"}\n"
+	"float scriptBench_Add( float x, float y ) { return x + y; }\n"
+	"float scriptBench_Call() {\n"
+	"	float i; float a;\n"
+	"	for( i = 0; i < 2000; i++ ) { a = scriptBench_Add( a, i ); }\n"
+	"	return a;\n"
+	"}\n";
+
+static const char* scriptBenchmarkFunctions[] = { "scriptBench_Arith", "scriptBench_Branch", "scriptBench_Call" };
+
+CONSOLE_COMMAND( testScriptVM, "times the script interpreter with and without fast statements, usage: testScriptVM [numRuns]", 0 )
+{
+	if( !gameLocal.IsInGame() )
+	{
+		idLib::Printf( "testScriptVM needs a map to be loaded\n" );
+		return;
+	}
+
+	int numRuns = 100;
+	if( args.Argc() > 1 )
+	{
+		numRuns = Max( atoi( args.Argv( 1 ) ), 1 );
+	}
+
+	if( gameLocal.program.FindFunction( scriptBenchmarkFunctions[0] ) == NULL )
+	{
+		if( !gameLocal.program.CompileText( "testScriptVM", scriptBenchmarkText, true ) )
+		{
+			return;
+		}
+	}
+
+	const bool oldFastStatements = g_scriptFastStatements.GetBool();
+
+	idThread* thread = new idThread();
+	thread->ManualDelete();
+	thread->SetThreadName( "testScriptVM" );
+
+	for( int i = 0; i < ( int )ARRAY_COUNT( scriptBenchmarkFunctions ); i++ )
+	{
+		const function_t* func = gameLocal.program.FindFunction( scriptBenchmarkFunctions[i] );
+		if( func == NULL )
+		{
+			continue;
+		}
+
+		float result[2];
+		uint64 microSec[2];
+		for( int mode = 0; mode < 2; mode++ )
+		{
+			g_scriptFastStatements.SetBool( mode != 0 );
+
+			const uint64 start = Sys_Microseconds();
+			for( int run = 0; run < numRuns; run++ )
+			{
+				thread->CallFunction( func, true );
+				thread->Execute();
+			}
+			microSec[mode] = Sys_Microseconds() - start;
+			result[mode] = *gameLocal.program.returnDef->value.floatPtr;
+		}
+
+		idLib::Printf( "%-20s %8.2f ms -> %8.2f ms (%.2fx)%s\n", scriptBenchmarkFunctions[i],
+					   microSec[0] * 0.001f, microSec[1] * 0.001f, ( float )microSec[0] / Max( microSec[1], ( uint64 )1 ),
+					   ( result[0] != result[1] ) ? " RESULT MISMATCH" : "" );
+	}
+
+	delete thread;
+	g_scriptFastStatements.SetBool( oldFastStatements );
+
+	int numLowered = 0;
+	int numFused = 0;
+	for( int i = 0; i < gameLocal.program.NumFastStatements(); i++ )
+	{
+		const int op = gameLocal.program.GetFastStatement( i ).op;
+		numLowered += ( op != FASTOP_NONE );
+		numFused += ( op >= FASTOP_GE_IFNOT );
+	}
+	idLib::Printf( "%d of %d statements lowered, %d fused compare + branch\n", numLowered, gameLocal.program.NumStatements(), numFused );
+}
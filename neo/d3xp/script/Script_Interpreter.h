@@ -83,6 +83,7 @@ private:
 	idEntity*			GetEntity( int entnum ) const;
 	idScriptObject*		GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
+	bool				ExecuteFastStatement( const fastStatement_t& st );
 
 	void				LeaveFunction( idVarDef* returnDef );
 	void				CallEvent( const function_t* func, int argsize );
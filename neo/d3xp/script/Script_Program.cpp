@@ -1917,6 +1917,188 @@ statement_t* idProgram::AllocStatement()
 	return statements.Alloc();
 }
 
+/*
+================
+idProgram::LowerOperand
+
+Returns false if the operand can't be resolved up front.
+================
+*/
+bool idProgram::LowerOperand( const idVarDef* def, int bit, intptr_t& operand, fastStatement_t& fast ) const
+{
+	if( def == NULL )
+	{
+		operand = 0;
+		return true;
+	}
+
+	if( def->initialized == idVarDef::stackVariable )
+	{
+		operand = def->value.stackOffset;
+		fast.stackOperands |= bit;
+		return true;
+	}
+
+	// object variables only hold an offset into the object, everything else must live in global storage
+	if( def->value.bytePtr < variables || def->value.bytePtr >= variables + sizeof( variables ) )
+	{
+		return false;
+	}
+
+	operand = ( intptr_t )def->value.bytePtr;
+	return true;
+}
+
+/*
+================
+idProgram::LowerStatement
+================
+*/
+void idProgram::LowerStatement( int index )
+{
+	const statement_t& st = statements[ index ];
+	fastStatement_t& fast = fastStatements[ index ];
+
+	memset( &fast, 0, sizeof( fast ) );
+
+	int op = FASTOP_NONE;
+	switch( st.op )
+	{
+		case OP_GOTO:
+			fast.op = FASTOP_GOTO;
+			fast.jump = index + st.a->value.jumpOffset;
+			return;
+		case OP_IF:
+			op = FASTOP_IF;
+			break;
+		case OP_IFNOT:
+			op = FASTOP_IFNOT;
+			break;
+		case OP_ADD_F:
+			op = FASTOP_ADD_F;
+			break;
+		case OP_SUB_F:
+			op = FASTOP_SUB_F;
+			break;
+		case OP_MUL_F:
+			op = FASTOP_MUL_F;
+			break;
+		case OP_GE:
+			op = FASTOP_GE;
+			break;
+		case OP_LE:
+			op = FASTOP_LE;
+			break;
+		case OP_GT:
+			op = FASTOP_GT;
+			break;
+		case OP_LT:
+			op = FASTOP_LT;
+			break;
+		case OP_EQ_F:
+			op = FASTOP_EQ_F;
+			break;
+		case OP_NE_F:
+			op = FASTOP_NE_F;
+			break;
+		case OP_AND:
+			op = FASTOP_AND;
+			break;
+		case OP_OR:
+			op = FASTOP_OR;
+			break;
+		case OP_NOT_F:
+			op = FASTOP_NOT_F;
+			break;
+		case OP_NOT_BOOL:
+			op = FASTOP_NOT_BOOL;
+			break;
+		case OP_NEG_F:
+			op = FASTOP_NEG_F;
+			break;
+		case OP_UADD_F:
+			op = FASTOP_UADD_F;
+			break;
+		case OP_USUB_F:
+			op = FASTOP_USUB_F;
+			break;
+		case OP_UINC_F:
+			op = FASTOP_UINC_F;
+			break;
+		case OP_UDEC_F:
+			op = FASTOP_UDEC_F;
+			break;
+		case OP_STORE_F:
+		case OP_STORE_ENT:
+		case OP_STORE_BOOL:
+			op = FASTOP_STORE_F;
+			break;
+		case OP_PUSH_F:
+		case OP_PUSH_ENT:
+			op = FASTOP_PUSH_F;
+			break;
+		default:
+			return;
+	}
+
+	const bool isBranch = ( op == FASTOP_IF || op == FASTOP_IFNOT );
+	if( !LowerOperand( st.a, FASTOPERAND_A, fast.a, fast ) ||
+			!LowerOperand( isBranch ? NULL : st.b, FASTOPERAND_B, fast.b, fast ) ||
+			!LowerOperand( st.c, FASTOPERAND_C, fast.c, fast ) )
+	{
+		fast.op = FASTOP_NONE;
+		fast.stackOperands = 0;
+		return;
+	}
+
+	if( isBranch )
+	{
+		fast.jump = index + st.b->value.jumpOffset;
+	}
+	fast.op = op;
+
+	// fuse a compare with an IFNOT that tests its result, the result is still stored so
+	// that jumping straight to the IFNOT keeps working
+	if( op >= FASTOP_GE && op <= FASTOP_NE_F && index + 1 < statements.Num() )
+	{
+		const statement_t& next = statements[ index + 1 ];
+		if( next.op == OP_IFNOT && next.a == st.c )
+		{
+			fast.op = FASTOP_GE_IFNOT + ( op - FASTOP_GE );
+			fast.jump = index + 1 + next.b->value.jumpOffset;
+		}
+	}
+}
+
+/*
+================
+idProgram::UpdateFastStatements
+================
+*/
+void idProgram::UpdateFastStatements()
+{
+	const int first = fastStatements.Num();
+	if( first == statements.Num() )
+	{
+		return;
+	}
+
+	if( first > statements.Num() )
+	{
+		fastStatements.SetNum( statements.Num() );
+		return;
+	}
+
+	fastStatements.SetGranularity( 4096 );
+	fastStatements.SetNum( statements.Num() );
+
+	// the last statement of the previous batch may now be followed by an IFNOT it can be fused with
+	for( int i = Max( first - 1, 0 ); i < statements.Num(); i++ )
+	{
+		LowerStatement( i );
+	}
+}
+
 /*
 ==============
 idProgram::BeginCompilation
@@ -2274,6 +2456,7 @@ void idProgram::FreeData()
 	filename.Clear();
 	fileList.Clear();
 	statements.Clear();
+	fastStatements.Clear();
 	functions.Clear();
 
 	top_functions	= 0;
@@ -2498,6 +2681,10 @@ void idProgram::Restart()
 	functions.SetNum( top_functions	);
 
 	statements.SetNum( top_statements );
+	if( fastStatements.Num() > top_statements )
+	{
+		fastStatements.SetNum( top_statements );
+	}
 	fileList.SetNum( top_files );
 	filename.Clear();
 
@@ -471,6 +471,74 @@ typedef struct statement_s
 
 /***********************************************************************
 
+fastStatement_t
+
+Pre-resolved form of a statement for the interpreter fast path. Operands are
+either a pointer into global storage or an offset into the local stack, so the
+interpreter doesn't have to go through the idVarDef of every operand, and jump
+offsets are turned into absolute statement numbers. Common compare + branch
+pairs are fused into a single instruction.
+
+Statements that aren't lowered keep FASTOP_NONE and run through the regular
+interpreter switch.
+
+***********************************************************************/
+
+typedef enum
+{
+	FASTOP_NONE,
+	FASTOP_GOTO,
+	FASTOP_IF,
+	FASTOP_IFNOT,
+	FASTOP_ADD_F,
+	FASTOP_SUB_F,
+	FASTOP_MUL_F,
+	FASTOP_GE,
+	FASTOP_LE,
+	FASTOP_GT,
+	FASTOP_LT,
+	FASTOP_EQ_F,
+	FASTOP_NE_F,
+	FASTOP_AND,
+	FASTOP_OR,
+	FASTOP_NOT_F,
+	FASTOP_NOT_BOOL,
+	FASTOP_NEG_F,
+	FASTOP_UADD_F,
+	FASTOP_USUB_F,
+	FASTOP_UINC_F,
+	FASTOP_UDEC_F,
+	FASTOP_STORE_F,			// also used for STORE_ENT and STORE_BOOL, all of them copy an int
+	FASTOP_PUSH_F,			// also used for PUSH_ENT
+
+	// compare followed by an IFNOT on its result
+	FASTOP_GE_IFNOT,
+	FASTOP_LE_IFNOT,
+	FASTOP_GT_IFNOT,
+	FASTOP_LT_IFNOT,
+	FASTOP_EQ_F_IFNOT,
+	FASTOP_NE_F_IFNOT,
+
+	NUM_FASTOPS
+} fastOp_t;
+
+// set in fastStatement_t::stackOperands for operands that live on the local stack
+#define FASTOPERAND_A		BIT( 0 )
+#define FASTOPERAND_B		BIT( 1 )
+#define FASTOPERAND_C		BIT( 2 )
+
+typedef struct fastStatement_s
+{
+	unsigned short	op;				// fastOp_t
+	unsigned short	stackOperands;	// FASTOPERAND_* bits
+	int				jump;			// statement to jump to for branches
+	intptr_t		a;				// pointer, or offset from localstackBase
+	intptr_t		b;
+	intptr_t		c;
+} fastStatement_t;
+
+/***********************************************************************
+
 idProgram
 
 Handles compiling and storage of script data.  Multiple idProgram objects
@@ -492,6 +560,7 @@ private:
 	idStaticList<byte, MAX_GLOBALS>				variableDefaults;
 	idStaticList<function_t, MAX_FUNCS>			functions;
 	idStaticList<statement_t, MAX_STATEMENTS>	statements;
+	idList<fastStatement_t, TAG_SCRIPT>			fastStatements;
 	idList<idTypeDef*, TAG_SCRIPT>				types;
 	idHashIndex									typesHash;
 	idList<idVarDefName*, TAG_SCRIPT>			varDefNames;
@@ -507,6 +576,8 @@ private:
 	int											top_files;
 
 	void										CompileStats();
+	bool										LowerOperand( const idVarDef* def, int bit, intptr_t& operand, fastStatement_t& fast ) const;
+	void										LowerStatement( int index );
 
 public:
 	idVarDef*									returnDef;
@@ -571,6 +642,17 @@ public:
 		return statements.Num();
 	}
 
+	// lowers all statements compiled since the last call, see fastStatement_t
+	void										UpdateFastStatements();
+	const fastStatement_t&						GetFastStatement( int index ) const
+	{
+		return fastStatements[ index ];
+	}
+	int											NumFastStatements() const
+	{
+		return fastStatements.Num();
+	}
+
 	int 										GetReturnedInteger();
 
 	void										ReturnFloat( float value );
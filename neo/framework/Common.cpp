@@ -203,6 +203,14 @@ idCommonLocal::idCommonLocal() :
 
 	clientPrediction = 0;
 
+	benchmarkState = BENCHMARK_NONE;
+	benchmarkRecordFile = NULL;
+	benchmarkCmdIndex = 0;
+	benchmarkQuitWhenDone = false;
+	benchmarkFrameCount = 0;
+	benchmarkSavedSkipBackEnd = 0;
+	benchmarkSavedFixedTic = 0;
+
 	saveFile = NULL;
 	stringsFile = NULL;
 
@@ -1255,15 +1263,15 @@ void idCommonLocal::Init( int argc, const char* const* argv, const char* cmdline
 
 		fileSystem->BeginLevelLoad( "_startup", saveFile.GetDataPtr(), saveFile.GetAllocated() );
 
+		// init the parallel job manager, the declaration manager scans the decl files on the job threads
+		parallelJobManager->Init();
+
 		// initialize the declaration manager
 		declManager->Init();
 
 		// init journalling, etc
 		eventLoop->Init();
 
-		// init the parallel job manager
-		parallelJobManager->Init();
-
 		// Carl: init the Virtual Reality head tracking, detect any connected HMDs, and read display parameters
 		// this needs to happen before the cfg files are loaded.
 		vrSystem->HMDInit();
@@ -1796,6 +1804,10 @@ void idCommonLocal::Shutdown()
 	printf( "errorList.Clear();\n" );
 	errorList.Clear();
 
+	// free the profiler event buffers
+	printf( "profiler.Shutdown();\n" );
+	profiler.Shutdown();
+
 	// shutdown idLib
 	printf( "idLib::ShutDown();\n" );
 	idLib::ShutDown();
@@ -2262,6 +2274,10 @@ CONSOLE_COMMAND( testSIMD, "test SIMD code", NULL )
 {
 	idSIMD::Test_f( args );
 }
+CONSOLE_COMMAND( testLCP, "compares the SSE and AVX2 LCP solver kernels", NULL )
+{
+	idLCP::Test_f( args );
+}
 
 // RB begin
 CONSOLE_COMMAND( testFormattingSizes, "test printf format security", 0 )
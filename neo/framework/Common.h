@@ -77,16 +77,19 @@ class idMatchParameters;
 
 struct lobbyConnectInfo_t;
 
-ID_INLINE void BeginProfileNamedEventColor( uint32 color, VERIFY_FORMAT_STRING const char* szName )
+// named events are only recorded by the idProfiler while a "profileCapture" is running
+ID_INLINE bool BeginProfileNamedEventColor( uint32 color, VERIFY_FORMAT_STRING const char* szName )
 {
+	return profiler.BeginEvent( szName );
 }
 ID_INLINE void EndProfileNamedEvent()
 {
+	profiler.EndEvent();
 }
 
-ID_INLINE void BeginProfileNamedEvent( VERIFY_FORMAT_STRING const char* szName )
+ID_INLINE bool BeginProfileNamedEvent( VERIFY_FORMAT_STRING const char* szName )
 {
-	BeginProfileNamedEventColor( ( uint32 ) 0xFF00FF00, szName );
+	return BeginProfileNamedEventColor( ( uint32 ) 0xFF00FF00, szName );
 }
 
 class idScopedProfileEvent
@@ -94,12 +97,18 @@ class idScopedProfileEvent
 public:
 	idScopedProfileEvent( const char* name )
 	{
-		BeginProfileNamedEvent( name );
+		recording = profiler.IsCapturing() && BeginProfileNamedEvent( name );
 	}
 	~idScopedProfileEvent()
 	{
-		EndProfileNamedEvent();
+		if( recording )
+		{
+			EndProfileNamedEvent();
+		}
 	}
+
+private:
+	bool	recording;
 };
 
 #define SCOPED_PROFILE_EVENT( x ) idScopedProfileEvent scopedProfileEvent_##__LINE__( x )
@@ -0,0 +1,429 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "Common_local.h"
+
+/*
+================================================================================================
+
+	Benchmark
+
+	"benchmarkRecord <name> <map>" starts the map and records every usercmd the local
+	player generates until "benchmarkStop", the game is paused or the map is left.
+
+	"benchmark <name> [quit]" starts the same map again and feeds the recorded usercmds
+	back through idGameLocal::RunFrame, one game tic per frame, with the render back end
+	skipped. The game logic and the renderer front end (R_RenderView, R_AddLights,
+	R_AddModels and their job lists) run exactly as in normal play, which makes the
+	reported timings usable for regression tracking on machines without a real GPU
+	(e.g. with a Mesa software GL context).
+
+================================================================================================
+*/
+
+static const int	BENCHMARK_FILE_MAGIC	= ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'U' << 8 ) | 'C';
+static const int	BENCHMARK_FILE_VERSION	= 1;
+
+idCVar com_benchmarkWarmupFrames( "com_benchmarkWarmupFrames", "30", CVAR_INTEGER | CVAR_SYSTEM, "number of frames at the start of a benchmark that are not included in the results" );
+
+/*
+========================
+BenchmarkFileName
+========================
+*/
+static idStr BenchmarkFileName( const char* name, const char* extension )
+{
+	idStr fileName = "benchmarks/";
+	fileName += name;
+	fileName.SetFileExtension( extension );
+	return fileName;
+}
+
+/*
+========================
+idCommonLocal::BenchmarkRecord
+========================
+*/
+void idCommonLocal::BenchmarkRecord( const char* name, const char* mapName )
+{
+	BenchmarkStop();
+
+	idStr fileName = BenchmarkFileName( name, ".ucmd" );
+	benchmarkRecordFile = fileSystem->OpenFileWrite( fileName );
+	if( benchmarkRecordFile == NULL )
+	{
+		Warning( "Couldn't open %s for writing", fileName.c_str() );
+		return;
+	}
+
+	idStr mapNameClean = mapName;
+	mapNameClean.StripFileExtension();
+	mapNameClean.BackSlashesToSlashes();
+
+	benchmarkRecordFile->WriteBig( BENCHMARK_FILE_MAGIC );
+	benchmarkRecordFile->WriteBig( BENCHMARK_FILE_VERSION );
+	benchmarkRecordFile->WriteString( mapNameClean );
+
+	benchmarkName = name;
+	benchmarkState = BENCHMARK_RECORD_PENDING;
+	benchmarkCmdIndex = 0;
+
+	StartNewGame( mapNameClean, true, GAME_MODE_SINGLEPLAYER );
+}
+
+/*
+========================
+idCommonLocal::BenchmarkPlay
+========================
+*/
+void idCommonLocal::BenchmarkPlay( const char* name, bool quitWhenDone )
+{
+	BenchmarkStop();
+
+	idStr fileName = BenchmarkFileName( name, ".ucmd" );
+	idFile* f = fileSystem->OpenFileRead( fileName );
+	if( f == NULL )
+	{
+		Warning( "Couldn't open %s", fileName.c_str() );
+		return;
+	}
+
+	int magic = 0;
+	int version = 0;
+	idStr mapName;
+	f->ReadBig( magic );
+	f->ReadBig( version );
+	if( magic != BENCHMARK_FILE_MAGIC || version != BENCHMARK_FILE_VERSION )
+	{
+		Warning( "%s is not a valid benchmark file", fileName.c_str() );
+		delete f;
+		return;
+	}
+	f->ReadString( mapName );
+
+	benchmarkCmds.Clear();
+	while( f->Tell() < f->Length() )
+	{
+		usercmd_t& cmd = benchmarkCmds.Alloc();
+		f->ReadBigArray( cmd.angles, 3 );
+		f->ReadBig( cmd.forwardmove );
+		f->ReadBig( cmd.rightmove );
+		f->ReadBig( cmd.buttons );
+		f->ReadBig( cmd.fireCount );
+		f->ReadBig( cmd.impulse );
+		f->ReadBig( cmd.impulseSequence );
+		f->ReadBig( cmd.mx );
+		f->ReadBig( cmd.my );
+		f->ReadVec3( cmd.pos );
+		f->ReadBig( cmd.speedSquared );
+	}
+	delete f;
+
+	if( benchmarkCmds.Num() == 0 )
+	{
+		Warning( "%s doesn't contain any usercmds", fileName.c_str() );
+		return;
+	}
+
+	benchmarkName = name;
+	benchmarkQuitWhenDone = quitWhenDone;
+	benchmarkCmdIndex = 0;
+	benchmarkFrameCount = 0;
+	benchmarkFrames.Clear();
+	benchmarkFrames.SetGranularity( 1024 );
+	benchmarkState = BENCHMARK_PLAYBACK_PENDING;
+
+	Printf( "Benchmark %s: %d usercmds on %s\n", name, benchmarkCmds.Num(), mapName.c_str() );
+
+	StartNewGame( mapName, true, GAME_MODE_SINGLEPLAYER );
+}
+
+/*
+========================
+idCommonLocal::BenchmarkStop
+========================
+*/
+void idCommonLocal::BenchmarkStop()
+{
+	switch( benchmarkState )
+	{
+		case BENCHMARK_RECORD_PENDING:
+		case BENCHMARK_RECORDING:
+			Printf( "Recorded %d usercmds to %s\n", benchmarkCmdIndex, BenchmarkFileName( benchmarkName, ".ucmd" ).c_str() );
+			delete benchmarkRecordFile;
+			benchmarkRecordFile = NULL;
+			break;
+
+		case BENCHMARK_PLAYING:
+			cvarSystem->SetCVarInteger( "r_skipBackEnd", benchmarkSavedSkipBackEnd );
+			cvarSystem->SetCVarInteger( "com_fixedTic", benchmarkSavedFixedTic );
+			BenchmarkReport();
+			if( benchmarkQuitWhenDone )
+			{
+				cmdSystem->BufferCommandText( CMD_EXEC_APPEND, "quit\n" );
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	benchmarkState = BENCHMARK_NONE;
+	benchmarkCmds.Clear();
+}
+
+/*
+========================
+idCommonLocal::BenchmarkBeginFrame
+
+Starts recording or playback once the map is spawned and the game is running.
+========================
+*/
+void idCommonLocal::BenchmarkBeginFrame( bool pauseGame )
+{
+	if( benchmarkState == BENCHMARK_NONE )
+	{
+		return;
+	}
+
+	if( !mapSpawned || pauseGame )
+	{
+		if( benchmarkState == BENCHMARK_RECORDING || benchmarkState == BENCHMARK_PLAYING )
+		{
+			// left the map or brought up a menu
+			BenchmarkStop();
+		}
+		return;
+	}
+
+	if( benchmarkState == BENCHMARK_RECORD_PENDING )
+	{
+		benchmarkState = BENCHMARK_RECORDING;
+	}
+	else if( benchmarkState == BENCHMARK_PLAYBACK_PENDING )
+	{
+		// a single game tic per frame makes playback independent of the wall clock,
+		// skipping the back end leaves only the CPU side of the frame
+		benchmarkSavedSkipBackEnd = cvarSystem->GetCVarInteger( "r_skipBackEnd" );
+		benchmarkSavedFixedTic = cvarSystem->GetCVarInteger( "com_fixedTic" );
+		cvarSystem->SetCVarInteger( "r_skipBackEnd", 1 );
+		cvarSystem->SetCVarInteger( "com_fixedTic", 1 );
+		benchmarkState = BENCHMARK_PLAYING;
+	}
+}
+
+/*
+========================
+idCommonLocal::BenchmarkUsercmd
+
+Called for every usercmd that is handed to the game.
+========================
+*/
+void idCommonLocal::BenchmarkUsercmd( usercmd_t& cmd )
+{
+	if( benchmarkState == BENCHMARK_RECORDING )
+	{
+		benchmarkRecordFile->WriteBigArray( cmd.angles, 3 );
+		benchmarkRecordFile->WriteBig( cmd.forwardmove );
+		benchmarkRecordFile->WriteBig( cmd.rightmove );
+		benchmarkRecordFile->WriteBig( cmd.buttons );
+		benchmarkRecordFile->WriteBig( cmd.fireCount );
+		benchmarkRecordFile->WriteBig( cmd.impulse );
+		benchmarkRecordFile->WriteBig( cmd.impulseSequence );
+		benchmarkRecordFile->WriteBig( cmd.mx );
+		benchmarkRecordFile->WriteBig( cmd.my );
+		benchmarkRecordFile->WriteVec3( cmd.pos );
+		benchmarkRecordFile->WriteBig( cmd.speedSquared );
+		benchmarkCmdIndex++;
+	}
+	else if( benchmarkState == BENCHMARK_PLAYING && benchmarkCmdIndex < benchmarkCmds.Num() )
+	{
+		// keep the timing fields of the live usercmd, replace all the input
+		const usercmd_t& recorded = benchmarkCmds[benchmarkCmdIndex++];
+		cmd.angles[0] = recorded.angles[0];
+		cmd.angles[1] = recorded.angles[1];
+		cmd.angles[2] = recorded.angles[2];
+		cmd.forwardmove = recorded.forwardmove;
+		cmd.rightmove = recorded.rightmove;
+		cmd.buttons = recorded.buttons;
+		cmd.fireCount = recorded.fireCount;
+		cmd.impulse = recorded.impulse;
+		cmd.impulseSequence = recorded.impulseSequence;
+		cmd.mx = recorded.mx;
+		cmd.my = recorded.my;
+		cmd.pos = recorded.pos;
+		cmd.speedSquared = recorded.speedSquared;
+	}
+}
+
+/*
+========================
+idCommonLocal::BenchmarkEndFrame
+
+Called after the game / draw thread has finished the frame.
+========================
+*/
+void idCommonLocal::BenchmarkEndFrame( int numGameFrames )
+{
+	if( benchmarkState != BENCHMARK_PLAYING || numGameFrames == 0 )
+	{
+		return;
+	}
+
+	if( benchmarkFrameCount++ >= com_benchmarkWarmupFrames.GetInteger() )
+	{
+		benchmarkFrame_t& frame = benchmarkFrames.Alloc();
+		frame.gameMicroSec = frameTiming.finishGameTime - frameTiming.startGameTime;
+		frame.drawMicroSec = frameTiming.finishDrawTime - frameTiming.finishGameTime;
+		frame.frontEndMicroSec = time_frontend;
+		frame.jobsMicroSec = 0;
+		frame.jobWaitMicroSec = 0;
+		for( int i = 0; i < parallelJobManager->GetNumJobLists(); i++ )
+		{
+			idParallelJobList* jobList = parallelJobManager->GetJobList( i );
+			frame.jobsMicroSec += jobList->GetTotalProcessingTimeMicroSec();
+			frame.jobWaitMicroSec += jobList->GetWaitTimeMicroSec();
+		}
+		frame.totalMicroSec = Sys_Microseconds() - frameTiming.startSyncTime;
+	}
+
+	if( benchmarkCmdIndex >= benchmarkCmds.Num() )
+	{
+		BenchmarkStop();
+	}
+}
+
+/*
+========================
+BenchmarkPrintStat
+========================
+*/
+static void BenchmarkPrintStat( idFile* f, const char* name, idList<uint64>& samples )
+{
+	samples.SortWithTemplate( idSort_Quick< uint64, idSort_QuickDefault< uint64 > >() );
+
+	uint64 total = 0;
+	for( int i = 0; i < samples.Num(); i++ )
+	{
+		total += samples[i];
+	}
+
+	const int num = samples.Num();
+	const int p99 = Max( 0, idMath::Ftoi( idMath::Ceil( num * 0.99f ) ) - 1 );
+	const char* line = va( "%-10s min %8.3f  avg %8.3f  p99 %8.3f  max %8.3f\n", name,
+						   samples[0] * 0.001f, ( total / ( double )num ) * 0.001f, samples[p99] * 0.001f, samples[num - 1] * 0.001f );
+
+	idLib::Printf( "%s", line );
+	if( f != NULL )
+	{
+		f->Printf( "%s", line );
+	}
+}
+
+/*
+========================
+idCommonLocal::BenchmarkReport
+========================
+*/
+void idCommonLocal::BenchmarkReport()
+{
+	if( benchmarkFrames.Num() == 0 )
+	{
+		Printf( "Benchmark %s: not enough frames for a result\n", benchmarkName.c_str() );
+		return;
+	}
+
+	idFile* f = fileSystem->OpenFileWrite( BenchmarkFileName( benchmarkName, ".txt" ) );
+
+	const char* header = va( "Benchmark %s: %d frames (%d warmup), times in milliseconds\n", benchmarkName.c_str(), benchmarkFrames.Num(), com_benchmarkWarmupFrames.GetInteger() );
+	Printf( "%s", header );
+	if( f != NULL )
+	{
+		f->Printf( "%s", header );
+	}
+
+	idList<uint64> samples;
+	samples.SetNum( benchmarkFrames.Num() );
+
+	struct stat_t
+	{
+		const char* name;
+		size_t		offset;
+	} stats[] =
+	{
+		{ "game",		offsetof( benchmarkFrame_t, gameMicroSec ) },
+		{ "draw",		offsetof( benchmarkFrame_t, drawMicroSec ) },
+		{ "frontend",	offsetof( benchmarkFrame_t, frontEndMicroSec ) },
+		{ "jobs",		offsetof( benchmarkFrame_t, jobsMicroSec ) },
+		{ "jobwait",	offsetof( benchmarkFrame_t, jobWaitMicroSec ) },
+		{ "frame",		offsetof( benchmarkFrame_t, totalMicroSec ) },
+	};
+
+	for( int s = 0; s < sizeof( stats ) / sizeof( stats[0] ); s++ )
+	{
+		for( int i = 0; i < benchmarkFrames.Num(); i++ )
+		{
+			samples[i] = *( const uint64* )( ( const byte* )&benchmarkFrames[i] + stats[s].offset );
+		}
+		BenchmarkPrintStat( f, stats[s].name, samples );
+	}
+
+	delete f;
+}
+
+/*
+========================
+Benchmark commands
+========================
+*/
+CONSOLE_COMMAND( benchmarkRecord, "starts a map and records the local usercmds for the benchmark command, usage: benchmarkRecord <name> <map>", NULL )
+{
+	if( args.Argc() < 3 )
+	{
+		common->Printf( "usage: benchmarkRecord <name> <map>\n" );
+		return;
+	}
+	commonLocal.BenchmarkRecord( args.Argv( 1 ), args.Argv( 2 ) );
+}
+
+CONSOLE_COMMAND( benchmark, "replays recorded usercmds without the render back end and reports frame timings, usage: benchmark <name> [quit]", NULL )
+{
+	if( args.Argc() < 2 )
+	{
+		common->Printf( "usage: benchmark <name> [quit]\n" );
+		return;
+	}
+	commonLocal.BenchmarkPlay( args.Argv( 1 ), !idStr::Icmp( args.Argv( 2 ), "quit" ) );
+}
+
+CONSOLE_COMMAND( benchmarkStop, "stops benchmark recording or playback", NULL )
+{
+	commonLocal.BenchmarkStop();
+}
@@ -667,10 +667,12 @@ void idCommonLocal::ExecuteMapChange()
 	renderWorld->GenerateAllInteractions();
 
 	{
-		int vertexMemUsedKB = vertexCache.staticData.vertexMemUsed.GetValue() / 1024;
-		int indexMemUsedKB = vertexCache.staticData.indexMemUsed.GetValue() / 1024;
-		idLib::Printf( "Used %dkb of static vertex memory (%d%%)\n", vertexMemUsedKB, vertexMemUsedKB * 100 / ( STATIC_VERTEX_MEMORY / 1024 ) );
-		idLib::Printf( "Used %dkb of static index memory (%d%%)\n", indexMemUsedKB, indexMemUsedKB * 100 / ( STATIC_INDEX_MEMORY / 1024 ) );
+		int vertexMemUsedKB = vertexCache.StaticMemoryUsed( CACHE_VERTEX ) / 1024;
+		int indexMemUsedKB = vertexCache.StaticMemoryUsed( CACHE_INDEX ) / 1024;
+		int vertexMemAllocatedKB = vertexCache.StaticMemoryAllocated( CACHE_VERTEX ) / 1024;
+		int indexMemAllocatedKB = vertexCache.StaticMemoryAllocated( CACHE_INDEX ) / 1024;
+		idLib::Printf( "Used %dkb of %dkb static vertex memory (%d%%)\n", vertexMemUsedKB, vertexMemAllocatedKB, vertexMemUsedKB * 100 / Max( vertexMemAllocatedKB, 1 ) );
+		idLib::Printf( "Used %dkb of %dkb static index memory (%d%%)\n", indexMemUsedKB, indexMemAllocatedKB, indexMemUsedKB * 100 / Max( indexMemAllocatedKB, 1 ) );
 	}
 
 	if( common->JapaneseCensorship() )
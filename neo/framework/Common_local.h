@@ -579,6 +579,37 @@ private:
 
 	bool				showShellRequested;
 
+	// deterministic usercmd record / benchmark playback, see Common_benchmark.cpp
+	struct benchmarkFrame_t
+	{
+		uint64			gameMicroSec;			// game logic, all tics of the frame
+		uint64			drawMicroSec;			// game draw including R_RenderView
+		uint64			frontEndMicroSec;		// renderer front end as measured by the renderer
+		uint64			jobsMicroSec;			// time spent by all job threads
+		uint64			jobWaitMicroSec;		// time spent waiting for job lists to finish
+		uint64			totalMicroSec;
+	};
+
+	enum benchmarkState_t
+	{
+		BENCHMARK_NONE,
+		BENCHMARK_RECORD_PENDING,
+		BENCHMARK_RECORDING,
+		BENCHMARK_PLAYBACK_PENDING,
+		BENCHMARK_PLAYING
+	};
+
+	benchmarkState_t	benchmarkState;
+	idStr				benchmarkName;
+	idFile* 			benchmarkRecordFile;
+	idList<usercmd_t>	benchmarkCmds;
+	int					benchmarkCmdIndex;
+	bool				benchmarkQuitWhenDone;
+	int					benchmarkFrameCount;
+	idList<benchmarkFrame_t>	benchmarkFrames;
+	int					benchmarkSavedSkipBackEnd;
+	int					benchmarkSavedFixedTic;
+
 	// RB begin
 #if defined(USE_DOOMCLASSIC)
 	currentGame_t		currentGame;
@@ -656,6 +687,17 @@ private:
 
 	void	PlayIntroGui();
 
+public:
+	void	BenchmarkRecord( const char* name, const char* mapName );
+	void	BenchmarkPlay( const char* name, bool quitWhenDone );
+	void	BenchmarkStop();
+
+private:
+	void	BenchmarkBeginFrame( bool pauseGame );
+	void	BenchmarkUsercmd( usercmd_t& cmd );
+	void	BenchmarkEndFrame( int numGameFrames );
+	void	BenchmarkReport();
+
 	void	ScrubSaveGameFileName( idStr& saveFileName ) const;
 
 	// RB begin
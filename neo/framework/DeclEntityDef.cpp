@@ -29,6 +29,10 @@ If you have questions concerning this license or the applicable additional terms
 #include "precompiled.h"
 #pragma hdrstop
 
+idCVar binaryLoadEntityDefs( "binaryLoadEntityDefs", "1", CVAR_BOOL, "enable binary load/write of entityDefs in generated/decls" );
+
+static const byte BDEF_VERSION = 100;
+static const unsigned int BDEF_MAGIC = ( 'B' << 24 ) | ( 'D' << 16 ) | ( 'E' << 8 ) | BDEF_VERSION;
 
 /*
 =================
@@ -60,11 +64,38 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 	idLexer src;
 	idToken	token, token2;
 
-	src.LoadMemory( text, textLength, GetFileName(), GetLineNum() );
-	src.SetFlags( DECL_LEXER_FLAGS );
-	src.SkipUntilString( "{" );
+	// entityDefs can be found from the job threads, but the file system is only used from the main thread
+	allowBinaryVersion = allowBinaryVersion && binaryLoadEntityDefs.GetBool() && idLib::IsMainThread();
+
+	unsigned int sourceChecksum = 0;
+	idStrStatic< MAX_OSPATH > generatedFileName;
+	bool loadedBinary = false;
+	if( allowBinaryVersion )
+	{
+		// only the key/value pairs of this entityDef are stored, inheritance is
+		// resolved after loading so changes to a parent never leave a stale binary
+		generatedFileName = "generated/decls/entitydefs/";
+		generatedFileName.AppendPath( GetName() );
+		generatedFileName.Append( ".bdef" );
+
+		idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+		sourceChecksum = MD5_BlockChecksum( text, textLength );
+
+		loadedBinary = LoadBinary( file, sourceChecksum );
+		if( !loadedBinary )
+		{
+			dict.Clear();
+		}
+	}
+
+	if( !loadedBinary )
+	{
+		src.LoadMemory( text, textLength, GetFileName(), GetLineNum() );
+		src.SetFlags( DECL_LEXER_FLAGS );
+		src.SkipUntilString( "{" );
+	}
 
-	while( 1 )
+	while( !loadedBinary )
 	{
 		if( !src.ReadToken( &token ) )
 		{
@@ -99,6 +130,13 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 	// we always automatically set a "classname" key to our name
 	dict.Set( "classname", GetName() );
 
+	if( allowBinaryVersion && !loadedBinary && !fileSystem->UsingResourceFiles() )
+	{
+		declManager->MediaPrint( "writing %s\n", generatedFileName.c_str() );
+		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+		WriteBinary( outputFile, sourceChecksum );
+	}
+
 	// "inherit" keys will cause all values from another entityDef to be copied into this one
 	// if they don't conflict.  We can't have circular recursions, because each entityDef will
 	// never be parsed mroe than once
@@ -121,7 +159,14 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 			const idDeclEntityDef* copy = static_cast<const idDeclEntityDef*>( declManager->FindType( DECL_ENTITYDEF, kv->GetValue(), false ) );
 			if( !copy )
 			{
-				src.Warning( "Unknown entityDef '%s' inherited by '%s'", kv->GetValue().c_str(), GetName() );
+				if( loadedBinary )
+				{
+					common->Warning( "Unknown entityDef '%s' inherited by '%s'", kv->GetValue().c_str(), GetName() );
+				}
+				else
+				{
+					src.Warning( "Unknown entityDef '%s' inherited by '%s'", kv->GetValue().c_str(), GetName() );
+				}
 			}
 			else
 			{
@@ -149,6 +194,78 @@ bool idDeclEntityDef::Parse( const char* text, const int textLength, bool allowB
 	return true;
 }
 
+/*
+================
+idDeclEntityDef::LoadBinary
+================
+*/
+bool idDeclEntityDef::LoadBinary( idFile* file, unsigned int checksum )
+{
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	unsigned int magic = 0;
+	file->ReadBig( magic );
+	if( magic != BDEF_MAGIC )
+	{
+		return false;
+	}
+
+	unsigned int loadedChecksum;
+	file->ReadBig( loadedChecksum );
+	if( checksum != loadedChecksum && !fileSystem->InProductionMode() )
+	{
+		return false;
+	}
+
+	int numKeys = 0;
+	file->ReadBig( numKeys );
+	if( numKeys < 0 )
+	{
+		return false;
+	}
+
+	idStr key, value;
+	for( int i = 0; i < numKeys; i++ )
+	{
+		file->ReadString( key );
+		file->ReadString( value );
+		if( key.IsEmpty() )
+		{
+			return false;
+		}
+		dict.Set( key, value );
+	}
+
+	return true;
+}
+
+/*
+================
+idDeclEntityDef::WriteBinary
+================
+*/
+void idDeclEntityDef::WriteBinary( idFile* file, unsigned int checksum )
+{
+	if( file == NULL )
+	{
+		return;
+	}
+
+	file->WriteBig( BDEF_MAGIC );
+	file->WriteBig( checksum );
+	file->WriteBig( dict.GetNumKeyVals() );
+
+	for( int i = 0; i < dict.GetNumKeyVals(); i++ )
+	{
+		const idKeyValue* kv = dict.GetKeyVal( i );
+		file->WriteString( kv->GetKey() );
+		file->WriteString( kv->GetValue() );
+	}
+}
+
 /*
 ================
 idDeclEntityDef::DefaultDefinition
@@ -47,6 +47,10 @@ public:
 	virtual bool			Parse( const char* text, const int textLength, bool allowBinaryVersion );
 	virtual void			FreeData();
 	virtual void			Print();
+
+	// generated/decls binary of the entityDef's own key/value pairs, written if the MD5 of the source text differs
+	bool					LoadBinary( idFile* file, unsigned int checksum );
+	void					WriteBinary( idFile* file, unsigned int checksum );
 };
 
 #endif /* !__DECLENTITYDEF_H__ */
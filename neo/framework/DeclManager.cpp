@@ -81,6 +81,7 @@ public:
 };
 
 class idDeclFile;
+struct declScanned_t;
 
 class idDeclLocal : public idDeclBase
 {
@@ -132,6 +133,9 @@ protected:
 	// Set textSource possible with compression.
 	void						SetTextLocal( const char* text, const int length );
 
+	// Take over the textSource prepared while scanning the decl file.
+	void						SetScannedTextLocal( declScanned_t& scanned, const char* text );
+
 private:
 	idDecl* 					self;
 
@@ -156,6 +160,45 @@ private:
 	idDeclLocal* 				nextInFile;				// next decl in the decl file
 };
 
+// a decl found by idDeclFile::Scan, added to the decl manager by idDeclFile::Merge
+struct declScanned_t
+{
+	declType_t					type;
+	idStr						name;
+	int							textOffset;				// offset in the file to the decl text
+	int							textLength;				// length of the decl text
+	int							sourceLine;				// line the decl starts on
+	int							endLine;				// line after the decl, for warnings while merging
+	int							checksum;				// checksum of the decl text, only if textSource is set
+	int							compressedLength;
+	char* 						textSource;				// decl text as stored by idDeclLocal, NULL if not prepared yet
+};
+
+// a decl file that has been read and scanned for decls, possibly on a job thread
+struct declFileScan_t
+{
+	idDeclFile* 				file;
+	char* 						buffer;
+	int							length;
+	ID_TIME_T					timestamp;
+	int							checksum;
+	int							numLines;
+	bool						clean;					// false if the scan had warnings or errors
+	uint64						scanMicroSec;
+	idList<declScanned_t, TAG_IDLIB_LIST_DECL>	decls;
+};
+
+// time spent registering the decl folders of one default type, see listDeclLoadTimes
+struct declLoadTimes_t
+{
+	int							numFiles;
+	int							numDecls;
+	uint64						readMicroSec;
+	uint64						scanMicroSec;			// summed up over all job threads
+	uint64						mergeMicroSec;
+	uint64						totalMicroSec;
+};
+
 class idDeclFile
 {
 public:
@@ -163,7 +206,11 @@ public:
 	idDeclFile( const char* fileName, declType_t defaultType );
 
 	void						Reload( bool force );
-	int							LoadAndParse();
+	int							LoadAndParse( declLoadTimes_t* times = NULL );
+
+	bool						Read( declFileScan_t& scan );
+	bool						Scan( declFileScan_t& scan, bool onJob ) const;
+	int							Merge( declFileScan_t& scan );
 
 public:
 	idStr						fileName;
@@ -225,6 +272,7 @@ public:
 public:
 	static void					MakeNameCanonical( const char* name, char* result, int maxLength );
 	idDeclLocal* 				FindTypeWithoutParsing( declType_t type, const char* name, bool makeDefault = true );
+	int							GetTotalNumDecls() const;
 
 	idDeclType* 				GetDeclType( int type ) const
 	{
@@ -253,15 +301,23 @@ private:
 	int							indent;			// for MediaPrint
 	bool						insideLevelLoad;
 
+	declLoadTimes_t				loadTimes[DECL_MAX_TYPES];
+
 	static idCVar				decl_show;
+	static idCVar				decl_parallelLoad;
 
 private:
+	void						LoadDeclFilesParallel( const idList<idDeclFile*>& files, declLoadTimes_t& times );
+
 	static void					ListDecls_f( const idCmdArgs& args );
+	static void					ListDeclLoadTimes_f( const idCmdArgs& args );
+	static void					BenchmarkDeclCache_f( const idCmdArgs& args );
 	static void					ReloadDecls_f( const idCmdArgs& args );
 	static void					TouchDecl_f( const idCmdArgs& args );
 };
 
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+idCVar idDeclManagerLocal::decl_parallelLoad( "decl_parallelLoad", "1", CVAR_SYSTEM | CVAR_BOOL, "scan and compress the decl files of a folder on the job threads" );
 
 idDeclManagerLocal	declManagerLocal;
 idDeclManager* 		declManager = &declManagerLocal;
@@ -510,8 +566,6 @@ int HuffmanCompressText( const char* text, int textLength, byte* compressed, int
 	int i, j;
 	idBitMsg msg;
 
-	totalUncompressedLength += textLength;
-
 	msg.InitWrite( compressed, maxCompressedSize );
 	msg.BeginWriting();
 	for( i = 0; i < textLength; i++ )
@@ -527,11 +581,34 @@ int HuffmanCompressText( const char* text, int textLength, byte* compressed, int
 		}
 	}
 
-	totalCompressedLength += msg.GetSize();
-
 	return msg.GetSize();
 }
 
+/*
+================
+CompressDeclText
+
+Returns the decl text the way idDeclLocal stores it, this is also used from the job threads.
+================
+*/
+static char* CompressDeclText( const char* text, const int length, int& compressedLength )
+{
+	char* textSource;
+#ifdef USE_COMPRESSED_DECLS
+	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
+	idTempArray<byte> compressed( length * maxBytesPerCode );
+	compressedLength = HuffmanCompressText( text, length, compressed.Ptr(), length * maxBytesPerCode );
+	textSource = ( char* )Mem_Alloc( compressedLength, TAG_DECLTEXT );
+	memcpy( textSource, compressed.Ptr(), compressedLength );
+#else
+	compressedLength = length;
+	textSource = ( char* ) Mem_Alloc( length + 1, TAG_DECLTEXT );
+	memcpy( textSource, text, length );
+	textSource[length] = '\0';
+#endif
+	return textSource;
+}
+
 /*
 ================
 HuffmanDecompressText
@@ -663,46 +740,110 @@ This is used during both the initial load, and any reloads
 */
 int c_savedMemory = 0;
 
-int idDeclFile::LoadAndParse()
+int idDeclFile::LoadAndParse( declLoadTimes_t* times )
 {
-	int			i, numTypes;
-	idLexer		src;
-	idToken		token;
-	int			startMarker;
-	char* 		buffer;
-	int			length, size;
-	int			sourceLine;
-	idStr		name;
-	idDeclLocal* newDecl;
-	bool		reparse;
+	declFileScan_t scan;
 
 	// load the text
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, ( void** )&buffer, &timestamp );
-	if( length == -1 )
+	uint64 start = Sys_Microseconds();
+	if( !Read( scan ) )
 	{
-		common->FatalError( "couldn't load %s", fileName.c_str() );
 		return 0;
 	}
+	uint64 end = Sys_Microseconds();
+	if( times != NULL )
+	{
+		times->readMicroSec += end - start;
+	}
 
-	if( !src.LoadMemory( buffer, length, fileName ) )
+	start = end;
+	if( !Scan( scan, false ) )
 	{
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
+		Mem_Free( scan.buffer );
 		return 0;
 	}
+	end = Sys_Microseconds();
+	if( times != NULL )
+	{
+		times->scanMicroSec += end - start;
+	}
 
-	// mark all the defs that were from the last reload of this file
-	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
+	start = end;
+	Merge( scan );
+	end = Sys_Microseconds();
+	if( times != NULL )
 	{
-		decl->redefinedInReload = false;
+		times->mergeMicroSec += end - start;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
+	return checksum;
+}
 
-	checksum = MD5_BlockChecksum( buffer, length );
+/*
+================
+idDeclFile::Read
 
-	fileSize = length;
+Reads the text of the decl file, the file system is only used from the main thread.
+================
+*/
+bool idDeclFile::Read( declFileScan_t& scan )
+{
+	scan.file = this;
+	scan.buffer = NULL;
+	scan.length = fileSystem->ReadFile( fileName, ( void** )&scan.buffer, &scan.timestamp );
+	if( scan.length == -1 )
+	{
+		common->FatalError( "couldn't load %s", fileName.c_str() );
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+idDeclFile::Scan
+
+Identifies each individual declaration in the text read by idDeclFile::Read without touching the decl
+manager, so it can run on a job thread. On a job thread warnings are not printed and the decl texts are
+prepared for storage right away. If the scan had warnings or errors the scan is not clean, and the file
+should be scanned again on the main thread to report them. Returns false if the text can't be lexed.
+================
+*/
+bool idDeclFile::Scan( declFileScan_t& scan, bool onJob ) const
+{
+	int			i, numTypes;
+	idLexer		src;
+	idToken		token;
+	int			startMarker;
+	int			size;
+	int			sourceLine;
+	idStr		name;
+
+	scan.checksum = 0;
+	scan.numLines = 0;
+	scan.clean = false;
+	scan.decls.SetNum( 0 );
+
+	if( !src.LoadMemory( scan.buffer, scan.length, fileName ) )
+	{
+		if( !onJob )
+		{
+			common->Error( "Couldn't parse %s", fileName.c_str() );
+		}
+		return false;
+	}
+
+	if( onJob )
+	{
+		src.SetFlags( DECL_LEXER_FLAGS | LEXFL_NOWARNINGS | LEXFL_NOERRORS );
+	}
+	else
+	{
+		src.SetFlags( DECL_LEXER_FLAGS );
+	}
+
+	scan.checksum = MD5_BlockChecksum( scan.buffer, scan.length );
 
 	// scan through, identifying each individual declaration
 	while( 1 )
@@ -798,16 +939,70 @@ int idDeclFile::LoadAndParse()
 		src.SkipBracedSection();
 		size = src.GetFileOffset() - startMarker;
 
+		declScanned_t& scanned = scan.decls.Alloc();
+		scanned.type = identifiedType;
+		scanned.name = name;
+		scanned.textOffset = startMarker;
+		scanned.textLength = size;
+		scanned.sourceLine = sourceLine;
+		scanned.endLine = src.GetLineNum();
+		scanned.checksum = 0;
+		scanned.compressedLength = 0;
+		scanned.textSource = NULL;
+
+		if( onJob )
+		{
+			scanned.checksum = MD5_BlockChecksum( scan.buffer + startMarker, size );
+			scanned.textSource = CompressDeclText( scan.buffer + startMarker, size, scanned.compressedLength );
+		}
+	}
+
+	scan.numLines = src.GetLineNum();
+	scan.clean = !src.HadError() && !src.HadWarning();
+
+	return true;
+}
+
+/*
+================
+idDeclFile::Merge
+
+Adds the scanned decls to the decl manager in the order they appear in the file, this is also
+used during reloads. Frees the scan.
+================
+*/
+int idDeclFile::Merge( declFileScan_t& scan )
+{
+	idDeclLocal* newDecl;
+	bool		reparse;
+
+	timestamp = scan.timestamp;
+
+	// mark all the defs that were from the last reload of this file
+	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
+	{
+		decl->redefinedInReload = false;
+	}
+
+	checksum = scan.checksum;
+
+	fileSize = scan.length;
+
+	for( int i = 0; i < scan.decls.Num(); i++ )
+	{
+		declScanned_t& scanned = scan.decls[i];
+
 		// look it up, possibly getting a newly created default decl
 		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
+		newDecl = declManagerLocal.FindTypeWithoutParsing( scanned.type, scanned.name, false );
 		if( newDecl )
 		{
 			// update the existing copy
 			if( newDecl->sourceFile != this || newDecl->redefinedInReload )
 			{
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-							 name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), scanned.endLine,
+								 declManagerLocal.GetDeclNameFromType( scanned.type ), scanned.name.c_str(),
+								 newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
 				continue;
 			}
 			if( newDecl->declState != DS_UNPARSED )
@@ -818,7 +1013,7 @@ int idDeclFile::LoadAndParse()
 		else
 		{
 			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
+			newDecl = declManagerLocal.FindTypeWithoutParsing( scanned.type, scanned.name, true );
 			newDecl->nextInFile = this->decls;
 			this->decls = newDecl;
 		}
@@ -831,11 +1026,18 @@ int idDeclFile::LoadAndParse()
 			newDecl->textSource = NULL;
 		}
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
+		if( scanned.textSource != NULL )
+		{
+			newDecl->SetScannedTextLocal( scanned, scan.buffer + scanned.textOffset );
+		}
+		else
+		{
+			newDecl->SetTextLocal( scan.buffer + scanned.textOffset, scanned.textLength );
+		}
 		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
+		newDecl->sourceTextOffset = scanned.textOffset;
+		newDecl->sourceTextLength = scanned.textLength;
+		newDecl->sourceLine = scanned.sourceLine;
 		newDecl->declState = DS_UNPARSED;
 
 		// if it is currently in use, reparse it immedaitely
@@ -845,9 +1047,17 @@ int idDeclFile::LoadAndParse()
 		}
 	}
 
-	numLines = src.GetLineNum();
+	numLines = scan.numLines;
+
+	// free the texts of decls that were not taken over
+	for( int i = 0; i < scan.decls.Num(); i++ )
+	{
+		Mem_Free( scan.decls[i].textSource );
+	}
+	scan.decls.Clear();
 
-	Mem_Free( buffer );
+	Mem_Free( scan.buffer );
+	scan.buffer = NULL;
 
 	// any defs that weren't redefinedInReload should now be defaulted
 	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
@@ -885,6 +1095,7 @@ void idDeclManagerLocal::Init()
 	common->Printf( "----- Initializing Decls -----\n" );
 
 	checksum = 0;
+	memset( loadTimes, 0, sizeof( loadTimes ) );
 
 #ifdef USE_COMPRESSED_DECLS
 	SetupHuffman();
@@ -914,6 +1125,8 @@ void idDeclManagerLocal::Init()
 
 	// add console commands
 	cmdSystem->AddCommand( "listDecls", ListDecls_f, CMD_FL_SYSTEM, "lists all decls" );
+	cmdSystem->AddCommand( "listDeclLoadTimes", ListDeclLoadTimes_f, CMD_FL_SYSTEM, "lists the time spent loading the decl folders of each type" );
+	cmdSystem->AddCommand( "benchmarkDeclCache", BenchmarkDeclCache_f, CMD_FL_SYSTEM, "times reparsing the parsed materials and entityDefs from text and from generated/decls" );
 
 	cmdSystem->AddCommand( "reloadDecls", ReloadDecls_f, CMD_FL_SYSTEM, "reloads decls" );
 	cmdSystem->AddCommand( "touch", TouchDecl_f, CMD_FL_SYSTEM, "touches a decl" );
@@ -1114,10 +1327,16 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 		declFolders.Append( declFolder );
 	}
 
+	declLoadTimes_t times;
+	memset( &times, 0, sizeof( times ) );
+	const uint64 startTime = Sys_Microseconds();
+	const int startNumDecls = GetTotalNumDecls();
+
 	// scan for decl files
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 
 	// load and parse decl files
+	idList<idDeclFile*> files;
 	for( i = 0; i < fileList->GetNumFiles(); i++ )
 	{
 		fileName = declFolder->folder + "/" + fileList->GetFile( i );
@@ -1139,10 +1358,124 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 			df = new( TAG_DECL ) idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		files.Append( df );
 	}
 
 	fileSystem->FreeFileList( fileList );
+
+	if( decl_parallelLoad.GetBool() && files.Num() > 1 )
+	{
+		LoadDeclFilesParallel( files, times );
+	}
+	else
+	{
+		for( i = 0; i < files.Num(); i++ )
+		{
+			files[i]->LoadAndParse( &times );
+		}
+	}
+
+	times.numFiles = files.Num();
+	times.numDecls = GetTotalNumDecls() - startNumDecls;
+	times.totalMicroSec = Sys_Microseconds() - startTime;
+
+	common->DPrintf( "%d decls from %d files in %s/*%s, %d msec\n", times.numDecls, times.numFiles, folder, extension, ( int )( times.totalMicroSec / 1000 ) );
+
+	if( defaultType >= 0 && defaultType < DECL_MAX_TYPES )
+	{
+		declLoadTimes_t& typeTimes = loadTimes[defaultType];
+		typeTimes.numFiles += times.numFiles;
+		typeTimes.numDecls += times.numDecls;
+		typeTimes.readMicroSec += times.readMicroSec;
+		typeTimes.scanMicroSec += times.scanMicroSec;
+		typeTimes.mergeMicroSec += times.mergeMicroSec;
+		typeTimes.totalMicroSec += times.totalMicroSec;
+	}
+}
+
+/*
+================
+DeclScanJob
+================
+*/
+static void DeclScanJob( declFileScan_t* scan )
+{
+	const uint64 start = Sys_Microseconds();
+	scan->file->Scan( *scan, true );
+	scan->scanMicroSec = Sys_Microseconds() - start;
+}
+REGISTER_PARALLEL_JOB( DeclScanJob, "DeclScanJob" );
+
+/*
+===================
+idDeclManagerLocal::LoadDeclFilesParallel
+
+The files are read on the main thread, then lexed, checksummed and compressed on the job threads.
+The scanned decls are merged into the decl lists in file order afterwards, so the decl indexes are
+the same as when loading the files one by one. Files that had warnings while scanning are loaded
+again on the main thread, so the warnings are reported as usual.
+===================
+*/
+void idDeclManagerLocal::LoadDeclFilesParallel( const idList<idDeclFile*>& files, declLoadTimes_t& times )
+{
+	idList<declFileScan_t, TAG_IDLIB_LIST_DECL> scans;
+	scans.SetNum( files.Num() );
+
+	uint64 start = Sys_Microseconds();
+	for( int i = 0; i < files.Num(); i++ )
+	{
+		common->DPrintf( "...loading '%s'\n", files[i]->fileName.c_str() );
+		if( !files[i]->Read( scans[i] ) )
+		{
+			scans[i].buffer = NULL;
+		}
+		scans[i].scanMicroSec = 0;
+	}
+	uint64 end = Sys_Microseconds();
+	times.readMicroSec += end - start;
+
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, files.Num(), 0, NULL );
+	for( int i = 0; i < scans.Num(); i++ )
+	{
+		if( scans[i].buffer != NULL )
+		{
+			jobList->AddJob( ( jobRun_t )DeclScanJob, &scans[i] );
+		}
+	}
+	jobList->Submit();
+	jobList->Wait();
+	parallelJobManager->FreeJobList( jobList );
+
+	for( int i = 0; i < scans.Num(); i++ )
+	{
+		times.scanMicroSec += scans[i].scanMicroSec;
+	}
+
+	start = Sys_Microseconds();
+	for( int i = 0; i < scans.Num(); i++ )
+	{
+		declFileScan_t& scan = scans[i];
+		if( scan.buffer == NULL )
+		{
+			continue;
+		}
+		if( !scan.clean )
+		{
+			for( int j = 0; j < scan.decls.Num(); j++ )
+			{
+				Mem_Free( scan.decls[j].textSource );
+			}
+			Mem_Free( scan.buffer );
+			// LoadAndParse adds its own read, scan and merge times, keep them out of this merge time
+			const uint64 reloadStart = Sys_Microseconds();
+			files[i]->LoadAndParse( &times );
+			start += Sys_Microseconds() - reloadStart;
+			continue;
+		}
+		files[i]->Merge( scan );
+	}
+	end = Sys_Microseconds();
+	times.mergeMicroSec += end - start;
 }
 
 /*
@@ -1195,6 +1528,21 @@ int idDeclManagerLocal::GetChecksum() const
 	return MD5_BlockChecksum( checksumData, total * 2 * sizeof( int ) );
 }
 
+/*
+===================
+idDeclManagerLocal::GetTotalNumDecls
+===================
+*/
+int idDeclManagerLocal::GetTotalNumDecls() const
+{
+	int total = 0;
+	for( int i = 0; i < DECL_MAX_TYPES; i++ )
+	{
+		total += linearLists[i].Num();
+	}
+	return total;
+}
+
 /*
 ===================
 idDeclManagerLocal::GetNumDeclTypes
@@ -1874,6 +2222,104 @@ void idDeclManagerLocal::ListDecls_f( const idCmdArgs& args )
 	common->Printf( "%iKB in text, %iKB in structures\n", totalText >> 10, totalStructs >> 10 );
 }
 
+/*
+================
+idDeclManagerLocal::ListDeclLoadTimes_f
+
+The scan time is summed up over all job threads, so it can be larger than the total time.
+================
+*/
+void idDeclManagerLocal::ListDeclLoadTimes_f( const idCmdArgs& args )
+{
+	declLoadTimes_t total;
+	memset( &total, 0, sizeof( total ) );
+
+	common->Printf( "type                 files  decls    read    scan   merge   total (msec)\n" );
+	for( int i = 0; i < declManagerLocal.declTypes.Num() && i < DECL_MAX_TYPES; i++ )
+	{
+		const declLoadTimes_t& times = declManagerLocal.loadTimes[i];
+		if( declManagerLocal.declTypes[i] == NULL || times.numFiles == 0 )
+		{
+			continue;
+		}
+		common->Printf( "%-20s %5d %6d %7.1f %7.1f %7.1f %7.1f\n", declManagerLocal.declTypes[i]->typeName.c_str(), times.numFiles, times.numDecls,
+						times.readMicroSec * 0.001f, times.scanMicroSec * 0.001f, times.mergeMicroSec * 0.001f, times.totalMicroSec * 0.001f );
+
+		total.numFiles += times.numFiles;
+		total.numDecls += times.numDecls;
+		total.readMicroSec += times.readMicroSec;
+		total.scanMicroSec += times.scanMicroSec;
+		total.mergeMicroSec += times.mergeMicroSec;
+		total.totalMicroSec += times.totalMicroSec;
+	}
+	common->Printf( "%-20s %5d %6d %7.1f %7.1f %7.1f %7.1f\n", "total", total.numFiles, total.numDecls,
+					total.readMicroSec * 0.001f, total.scanMicroSec * 0.001f, total.mergeMicroSec * 0.001f, total.totalMicroSec * 0.001f );
+}
+
+/*
+===================
+idDeclManagerLocal::BenchmarkDeclCache_f
+
+Reparses every parsed material and entityDef once from the decl text (cold)
+and once from the generated/decls binaries (warm).
+===================
+*/
+void idDeclManagerLocal::BenchmarkDeclCache_f( const idCmdArgs& args )
+{
+	static const struct
+	{
+		declType_t	type;
+		const char*	cvarName;
+	} cachedTypes[] =
+	{
+		{ DECL_MATERIAL,	"binaryLoadMaterials" },
+		{ DECL_ENTITYDEF,	"binaryLoadEntityDefs" },
+	};
+
+	struct local
+	{
+		static int Reparse( const idList<idDeclLocal*, TAG_IDLIB_LIST_DECL>& list )
+		{
+			int numParsed = 0;
+			for( int i = 0; i < list.Num(); i++ )
+			{
+				if( list[i]->declState == DS_PARSED )
+				{
+					list[i]->ParseLocal();
+					numParsed++;
+				}
+			}
+			return numParsed;
+		}
+	};
+
+	common->Printf( "type                 decls    cold    warm (msec)\n" );
+	for( int i = 0; i < sizeof( cachedTypes ) / sizeof( cachedTypes[0] ); i++ )
+	{
+		const idList<idDeclLocal*, TAG_IDLIB_LIST_DECL>& list = declManagerLocal.linearLists[cachedTypes[i].type];
+		const bool oldValue = cvarSystem->GetCVarBool( cachedTypes[i].cvarName );
+
+		// bring the binaries up to date before timing anything
+		cvarSystem->SetCVarBool( cachedTypes[i].cvarName, true );
+		local::Reparse( list );
+
+		cvarSystem->SetCVarBool( cachedTypes[i].cvarName, false );
+		int64 start = Sys_Microseconds();
+		const int numParsed = local::Reparse( list );
+		int64 coldMicroSec = Sys_Microseconds() - start;
+
+		cvarSystem->SetCVarBool( cachedTypes[i].cvarName, true );
+		start = Sys_Microseconds();
+		local::Reparse( list );
+		int64 warmMicroSec = Sys_Microseconds() - start;
+
+		cvarSystem->SetCVarBool( cachedTypes[i].cvarName, oldValue );
+
+		common->Printf( "%-20s %5d %7.1f %7.1f\n", declManagerLocal.declTypes[cachedTypes[i].type]->typeName.c_str(), numParsed,
+						coldMicroSec * 0.001f, warmMicroSec * 0.001f );
+	}
+}
+
 /*
 ===================
 idDeclManagerLocal::ReloadDecls_f
@@ -2392,19 +2838,42 @@ void idDeclLocal::SetTextLocal( const char* text, const int length )
 	}
 #endif
 
+	textSource = CompressDeclText( text, length, compressedLength );
+	textLength = length;
+
 #ifdef USE_COMPRESSED_DECLS
-	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
-	byte* compressed = ( byte* )_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
-	textSource = ( char* )Mem_Alloc( compressedLength, TAG_DECLTEXT );
-	memcpy( textSource, compressed, compressedLength );
-#else
-	compressedLength = length;
-	textSource = ( char* ) Mem_Alloc( length + 1, TAG_DECLTEXT );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
+	totalUncompressedLength += textLength;
+	totalCompressedLength += compressedLength;
+#endif
+}
+
+/*
+=================
+idDeclLocal::SetScannedTextLocal
+=================
+*/
+void idDeclLocal::SetScannedTextLocal( declScanned_t& scanned, const char* text )
+{
+	Mem_Free( textSource );
+
+	checksum = scanned.checksum;
+
+#ifdef GET_HUFFMAN_FREQUENCIES
+	for( int i = 0; i < scanned.textLength; i++ )
+	{
+		huffmanFrequencies[( ( const unsigned char* )text )[i]]++;
+	}
+#endif
+
+	textSource = scanned.textSource;
+	compressedLength = scanned.compressedLength;
+	textLength = scanned.textLength;
+	scanned.textSource = NULL;
+
+#ifdef USE_COMPRESSED_DECLS
+	totalUncompressedLength += textLength;
+	totalCompressedLength += compressedLength;
 #endif
-	textLength = length;
 }
 
 /*
@@ -2713,7 +2713,7 @@ void idFileSystemLocal::Path_f( const idCmdArgs& args )
 
 	for( int i = 0; i < fileSystemLocal.resourceFiles.Num(); i++ )
 	{
-		common->Printf( "%s\n", fileSystemLocal.resourceFiles[i]->GetFileName() );
+		common->Printf( "%s%s\n", fileSystemLocal.resourceFiles[i]->GetFileName(), fileSystemLocal.resourceFiles[i]->IsMapped() ? " (mapped)" : "" );
 	}
 }
 
@@ -3327,6 +3327,14 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 		{
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
+
+		// a mapped container hands out views into the mapping, nothing is read or copied here
+		idFile* view = resourceFiles[ rc.containerIndex ]->OpenMappedFile( rc );
+		if( view != NULL )
+		{
+			return view;
+		}
+
 		idFile_InnerResource* file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
 		// DG: add parenthesis to make sure this block is only entered when file != NULL - bug found by clang.
 		if( file != NULL && ( ( memFile || rc.length <= resourceBufferAvailable ) || rc.length < 8 * 1024 * 1024 ) )
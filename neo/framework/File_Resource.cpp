@@ -37,6 +37,56 @@ idResourceContainer
 ================================================================================================
 */
 
+idCVar fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_BOOL, "memory map .resources containers and open their files as views into the mapping instead of reading them into buffers" );
+
+/*
+========================
+idResourceContainer::Map
+
+Maps the whole container read only, so OpenMappedFile can hand out views without
+copying anything. Pages are only faulted in when a view is actually read.
+========================
+*/
+void idResourceContainer::Map()
+{
+	Unmap();
+
+	// 32 bit builds can't afford to spend their address space on gigabyte containers
+	if( !fs_mapResources.GetBool() || sizeof( void* ) < 8 )
+	{
+		return;
+	}
+
+	idFile_Permanent* file = dynamic_cast< idFile_Permanent* >( resourceFile );
+	if( file == NULL || file->Length() <= 0 )
+	{
+		return;
+	}
+
+	const size_t length = ( size_t )file->Length();
+	mappedData = ( const byte* )Sys_MapFile( file->GetFilePtr(), length, &mappedHandle );
+	if( mappedData != NULL )
+	{
+		mappedLength = length;
+	}
+}
+
+/*
+========================
+idResourceContainer::Unmap
+========================
+*/
+void idResourceContainer::Unmap()
+{
+	if( mappedData != NULL )
+	{
+		Sys_UnmapFile( mappedData, mappedLength, mappedHandle );
+	}
+	mappedData = NULL;
+	mappedLength = 0;
+	mappedHandle = NULL;
+}
+
 /*
 ========================
 idResourceContainer::ReOpen
@@ -44,8 +94,52 @@ idResourceContainer::ReOpen
 */
 void idResourceContainer::ReOpen()
 {
+	Unmap();
 	delete resourceFile;
 	resourceFile = fileSystem->OpenFileRead( fileName );
+	Map();
+}
+
+/*
+========================
+idResourceContainer::OpenMappedFile
+========================
+*/
+idFile* idResourceContainer::OpenMappedFile( const idResourceCacheEntry& rc ) const
+{
+	if( mappedData == NULL || rc.offset < 0 || rc.length < 0 || ( size_t )rc.offset + ( size_t )rc.length > mappedLength )
+	{
+		return NULL;
+	}
+	return new( TAG_IDFILE ) idFile_Memory( rc.filename, ( const char* )mappedData + rc.offset, rc.length );
+}
+
+/*
+========================
+idResourceContainer::OpenFile
+========================
+*/
+idFile* idResourceContainer::OpenFile( const char* _fileName )
+{
+	idStrStatic< MAX_OSPATH > canonical = _fileName;
+	canonical.BackSlashesToSlashes();
+	canonical.ToLower();
+
+	const int key = cacheHash.GenerateKey( canonical, false );
+	for( int index = cacheHash.GetFirst( key ); index != idHashIndex::NULL_INDEX; index = cacheHash.GetNext( index ) )
+	{
+		const idResourceCacheEntry& rt = cacheTable[ index ];
+		if( idStr::Icmp( rt.filename, canonical ) == 0 )
+		{
+			idFile* file = OpenMappedFile( rt );
+			if( file == NULL )
+			{
+				file = new( TAG_IDFILE ) idFile_InnerResource( rt.filename, resourceFile, rt.offset, rt.length );
+			}
+			return file;
+		}
+	}
+	return NULL;
 }
 
 /*
@@ -55,8 +149,9 @@ idResourceContainer::Init
 */
 bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 {
-
-	if( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 )
+	// the ordered startup container used to be read completely into memory,
+	// a mapping gives the same access pattern without the up front read
+	if( idStr::Icmp( _fileName, "_ordered.resources" ) == 0 && !fs_mapResources.GetBool() )
 	{
 		resourceFile = fileSystem->OpenFileReadMemory( _fileName );
 	}
@@ -71,6 +166,8 @@ bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 		return false;
 	}
 
+	Map();
+
 	resourceFile->ReadBig( resourceMagic );
 	if( resourceMagic != RESOURCE_FILE_MAGIC )
 	{
@@ -81,11 +178,21 @@ bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 
 	resourceFile->ReadBig( tableOffset );
 	resourceFile->ReadBig( tableLength );
-	// read this into a memory buffer with a single read
-	char* const buf = ( char* )Mem_Alloc( tableLength, TAG_RESOURCE );
-	resourceFile->Seek( tableOffset, FS_SEEK_SET );
-	resourceFile->Read( buf, tableLength );
-	idFile_Memory memFile( "resourceHeader", ( const char* )buf, tableLength );
+	// read this into a memory buffer with a single read, or parse it in place if mapped
+	char* buf = NULL;
+	const char* table = NULL;
+	if( mappedData != NULL && tableOffset >= 0 && tableLength >= 0 && ( size_t )tableOffset + ( size_t )tableLength <= mappedLength )
+	{
+		table = ( const char* )mappedData + tableOffset;
+	}
+	else
+	{
+		buf = ( char* )Mem_Alloc( tableLength, TAG_RESOURCE );
+		resourceFile->Seek( tableOffset, FS_SEEK_SET );
+		resourceFile->Read( buf, tableLength );
+		table = buf;
+	}
+	idFile_Memory memFile( "resourceHeader", table, tableLength );
 
 	// Parse the resourceFile header, which includes every resource used
 	// by the game.
@@ -116,7 +223,10 @@ bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 			cacheHash.Add( key, i );
 		}
 	}
-	Mem_Free( buf );
+	if( buf != NULL )
+	{
+		Mem_Free( buf );
+	}
 
 	return true;
 }
@@ -81,6 +81,9 @@ public:
 	idResourceContainer()
 	{
 		resourceFile = NULL;
+		mappedData = NULL;
+		mappedLength = 0;
+		mappedHandle = NULL;
 		tableOffset = 0;
 		tableLength = 0;
 		resourceMagic = 0;
@@ -88,6 +91,7 @@ public:
 	}
 	~idResourceContainer()
 	{
+		Unmap();
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -98,6 +102,13 @@ public:
 	static void ExtractResourceFile( const char* fileName, const char* outPath, bool copyWavs );
 	static void UpdateResourceFile( const char* filename, const idStrList& filesToAdd );
 	idFile* OpenFile( const char* fileName );
+	// Returns a read only idFile_Memory that points straight into the mapped container,
+	// or NULL if the container isn't memory mapped. The view must not outlive the container.
+	idFile* OpenMappedFile( const idResourceCacheEntry& rc ) const;
+	bool IsMapped() const
+	{
+		return mappedData != NULL;
+	}
 	const char* GetFileName() const
 	{
 		return fileName.c_str();
@@ -105,8 +116,14 @@ public:
 	void SetContainerIndex( const int& _idx );
 	void ReOpen();
 private:
+	void		Map();
+	void		Unmap();
+
 	idStrStatic< 256 > fileName;
 	idFile* 	resourceFile;			// open file handle
+	const byte* mappedData;				// the whole container if fs_mapResources is set
+	size_t		mappedLength;
+	void* 		mappedHandle;			// platform specific mapping object
 	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
 	// a DVD layer, so it isn't a retail limitation.
 	int		tableOffset;			// table offset
@@ -534,6 +534,9 @@ void idCommonLocal::Frame()
 {
 	try
 	{
+		// start or finish a pending profile capture on the frame boundary
+		profiler.BeginFrame();
+
 		SCOPED_PROFILE_EVENT( "Common::Frame" );
 
 		// This is the only place this is incremented
@@ -906,6 +909,9 @@ void idCommonLocal::Frame()
 			usercmdGen->Clear();
 		}
 
+		// start benchmark recording or playback once the map is running
+		BenchmarkBeginFrame( pauseGame );
+
 		usercmd_t newCmd = usercmdGen->GetCurrentUsercmd();
 
 		// Store server game time - don't let time go past last SS time in case we are extrapolating
@@ -926,6 +932,7 @@ void idCommonLocal::Frame()
 		for( int i = 0 ; i < numGameFrames ; i++ )
 		{
 			newCmd.clientGameMilliseconds = FRAME_TO_MSEC( gameFrame - numGameFrames + i + 1 );
+			BenchmarkUsercmd( newCmd );
 			userCmdMgr.PutUserCmdForPlayer( game->GetLocalClientNum(), newCmd );
 		}
 
@@ -972,6 +979,8 @@ void idCommonLocal::Frame()
 		// This may block if the game is taking longer than the render back end
 		gameThread.WaitForThread();
 
+		BenchmarkEndFrame( numGameFrames );
+
 		// Send local usermds to the server.
 		// This happens after the game frame has run so that prediction data is up to date.
 		SendUsercmds( Game()->GetLocalClientNum() );
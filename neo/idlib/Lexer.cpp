@@ -270,6 +270,8 @@ void idLexer::Warning( const char* str, ... )
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 
+	hadWarning = true;
+
 	if( idLexer::flags & LEXFL_NOWARNINGS )
 	{
 		return;
@@ -2255,6 +2257,7 @@ idLexer::idLexer()
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -2277,6 +2280,7 @@ idLexer::idLexer( int flags )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -2293,6 +2297,7 @@ idLexer::idLexer( const char* filename, int flags, bool OSPath )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadFile( filename, OSPath );
 }
 
@@ -2310,6 +2315,7 @@ idLexer::idLexer( const char* ptr, int length, const char* name, int flags )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadMemory( ptr, length, name );
 }
 
@@ -2343,3 +2349,13 @@ bool idLexer::HadError() const
 	return hadError;
 }
 
+/*
+================
+idLexer::HadWarning
+================
+*/
+bool idLexer::HadWarning() const
+{
+	return hadWarning;
+}
+
@@ -141,9 +141,18 @@ idParallelJobList_Threads
 */
 
 static idCVar jobs_longJobMicroSec( "jobs_longJobMicroSec", "10000", CVAR_INTEGER, "print a warning for jobs that take more than this number of microseconds" );
+static idCVar jobs_workStealing( "jobs_workStealing", "0", CVAR_BOOL | CVAR_NOCHEAT, "schedule jobs through per thread work stealing queues instead of letting all threads fetch from the shared job lists" );
 
 
 const static int		MAX_THREADS	= 32;
+const static int		HOST_UNIT	= MAX_THREADS;		// stats slot for jobs the waiting host thread runs itself
+const static int		NUM_UNITS	= MAX_THREADS + 1;
+
+class idParallelJobList_Threads;
+
+// implemented by the work stealing scheduler in idParallelJobManagerLocal
+static bool RunQueuedJob( unsigned int threadNum );
+static void PushStealableJobs( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs, int numThreads );
 
 struct threadJobListState_t
 {
@@ -174,8 +183,8 @@ struct threadStats_t
 	uint64			startTime;
 	uint64			endTime;
 	uint64			waitTime;
-	uint64			threadExecTime[MAX_THREADS];
-	uint64			threadTotalTime[MAX_THREADS];
+	uint64			threadExecTime[NUM_UNITS];
+	uint64			threadTotalTime[NUM_UNITS];
 };
 
 class idParallelJobList_Threads
@@ -189,6 +198,7 @@ public:
 	//------------------------
 	ID_INLINE void			AddJob( jobRun_t function, void* data );
 	ID_INLINE void			InsertSyncPoint( jobSyncType_t syncType );
+	void					AddDependency( idParallelJobList_Threads* jobList );
 	void					Submit( idParallelJobList_Threads* waitForJobList_, int parallelism );
 	void					Wait();
 	bool					TryWait();
@@ -237,6 +247,7 @@ public:
 	}
 
 	bool					WaitForOtherJobList();
+	void					WaitForDependencies( int firstDependency );
 
 	//------------------------
 	// This is thread safe and called from the job threads.
@@ -251,6 +262,16 @@ public:
 
 	int						RunJobs( unsigned int threadNum, threadJobListState_t& state, bool singleJob );
 
+	//------------------------
+	// Work stealing scheduler, see idJobDeque.
+	//------------------------
+	bool					IsWorkStealing() const
+	{
+		return workStealing;
+	}
+	void					StartWorkStealing( int numThreads );
+	void					RunStolenJob( unsigned int threadNum, int jobIndex );
+
 private:
 	static const int		NUM_DONE_GUARDS = 4;	// cycle through 4 guards so we can cyclicly chain job lists
 
@@ -282,8 +303,29 @@ private:
 	threadStats_t						deferredThreadStats;
 	threadStats_t						threadStats;
 
+	// the job lists this list depends on, cleared by Wait()
+	idList< idParallelJobList_Threads*, TAG_JOBLIST >	dependencies;
+	idList< idSysInterlockedInteger*, TAG_JOBLIST >		dependencyGuards;
+
+	// work stealing state, only valid while a list is submitted with workStealing set
+	bool								workStealing;
+	volatile bool						stealingDone;
+	int									stealingThreads;
+	int									stealingSegment;
+	idList< int, TAG_JOBLIST >			stealingJobs;			// indices of the real jobs, sync point markers removed
+	idList< int, TAG_JOBLIST >			stealingSegmentEnds;	// one past the last stealingJobs index of each sync segment
+	idSysInterlockedInteger				stealingJobsLeft;		// jobs left in the current segment
+	idSysInterlockedInteger				pendingDependencies;
+	idList< idParallelJobList_Threads*, TAG_JOBLIST >	dependents;
+	idSysMutex							dependentsMutex;
+
 	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t& state, bool singleJob );
 
+	bool					AddDependent( idParallelJobList_Threads* jobList );
+	void					DependencyDone();
+	void					ReleaseSegment();
+	void					FinishWorkStealing();
+
 	static void				Nop( void* data ) {}
 
 	static int				JOB_SIGNAL;
@@ -310,7 +352,11 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	lastSignalJob( 0 ),
 	waitForGuard( NULL ),
 	currentDoneGuard( 0 ),
-	jobList()
+	jobList(),
+	workStealing( false ),
+	stealingDone( true ),
+	stealingThreads( 0 ),
+	stealingSegment( 0 )
 {
 
 	assert( listPriority != JOBLIST_PRIORITY_NONE );
@@ -432,6 +478,18 @@ ID_INLINE void idParallelJobList_Threads::InsertSyncPoint( jobSyncType_t syncTyp
 	}
 }
 
+/*
+========================
+idParallelJobList_Threads::AddDependency
+========================
+*/
+void idParallelJobList_Threads::AddDependency( idParallelJobList_Threads* jobList )
+{
+	assert( done );
+	assert( jobList != this );
+	dependencies.AddUnique( jobList );
+}
+
 /*
 ========================
 idParallelJobList_Threads::Submit
@@ -457,17 +515,24 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 
 	if( jobList.Num() == 0 )
 	{
+		dependencies.SetNum( 0 );
 		return;
 	}
 
 	if( waitForJobList != NULL )
 	{
-		waitForGuard = & waitForJobList->doneGuards[waitForJobList->currentDoneGuard];
+		dependencies.AddUnique( waitForJobList );
 	}
-	else
+
+	// remember the guards of the current submission of each dependency because those lists may be resubmitted
+	dependencyGuards.SetNum( 0 );
+	for( int i = 0; i < dependencies.Num(); i++ )
 	{
-		waitForGuard = NULL;
+		dependencyGuards.Append( & dependencies[i]->doneGuards[dependencies[i]->currentDoneGuard] );
 	}
+	// the job threads check the first dependency by themselves
+	waitForGuard = ( dependencyGuards.Num() > 0 ) ? dependencyGuards[0] : NULL;
+	workStealing = false;
 
 	currentDoneGuard = ( currentDoneGuard + 1 ) & ( NUM_DONE_GUARDS - 1 );
 	doneGuards[currentDoneGuard].SetValue( 1 );
@@ -488,6 +553,7 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 	else
 	{
 		// run all the jobs right here
+		WaitForDependencies( 0 );
 		threadJobListState_t state( GetVersion() );
 		RunJobs( 0, state, false );
 	}
@@ -511,10 +577,25 @@ void idParallelJobList_Threads::Wait()
 		bool waited = false;
 		uint64 waitStart = Sys_Microseconds();
 
-		while( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
+		if( workStealing )
 		{
-			Sys_Yield();
-			waited = true;
+			while( !stealingDone )
+			{
+				// help out instead of idling, this may run jobs from other lists as well
+				if( !RunQueuedJob( HOST_UNIT ) )
+				{
+					Sys_Yield();
+				}
+				waited = true;
+			}
+		}
+		else
+		{
+			while( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
+			{
+				Sys_Yield();
+				waited = true;
+			}
 		}
 		version.Increment();
 		while( numThreadsExecuting.GetValue() > 0 )
@@ -527,11 +608,13 @@ void idParallelJobList_Threads::Wait()
 		signalJobCount.SetNum( 0 );
 		numSyncs = 0;
 		lastSignalJob = 0;
+		workStealing = false;
 
 		uint64 waitEnd = Sys_Microseconds();
 		deferredThreadStats.waitTime = waited ? ( waitEnd - waitStart ) : 0;
 	}
 	memcpy( & threadStats, & deferredThreadStats, sizeof( threadStats ) );
+	dependencies.SetNum( 0 );
 	done = true;
 }
 
@@ -542,7 +625,7 @@ idParallelJobList_Threads::TryWait
 */
 bool idParallelJobList_Threads::TryWait()
 {
-	if( jobList.Num() == 0 || signalJobCount[signalJobCount.Num() - 1].GetValue() <= 0 )
+	if( jobList.Num() == 0 || ( workStealing ? stealingDone : ( signalJobCount[signalJobCount.Num() - 1].GetValue() <= 0 ) ) )
 	{
 		Wait();
 		return true;
@@ -568,7 +651,7 @@ idParallelJobList_Threads::GetTotalProcessingTimeMicroSec
 uint64 idParallelJobList_Threads::GetTotalProcessingTimeMicroSec() const
 {
 	uint64 total = 0;
-	for( int unit = 0; unit < MAX_THREADS; unit++ )
+	for( int unit = 0; unit < NUM_UNITS; unit++ )
 	{
 		total += threadStats.threadExecTime[unit];
 	}
@@ -583,7 +666,7 @@ idParallelJobList_Threads::GetTotalWastedTimeMicroSec
 uint64 idParallelJobList_Threads::GetTotalWastedTimeMicroSec() const
 {
 	uint64 total = 0;
-	for( int unit = 0; unit < MAX_THREADS; unit++ )
+	for( int unit = 0; unit < NUM_UNITS; unit++ )
 	{
 		total += threadStats.threadTotalTime[unit] - threadStats.threadExecTime[unit];
 	}
@@ -597,7 +680,7 @@ idParallelJobList_Threads::GetUnitProcessingTimeMicroSec
 */
 uint64 idParallelJobList_Threads::GetUnitProcessingTimeMicroSec( int unit ) const
 {
-	if( unit < 0 || unit >= MAX_THREADS )
+	if( unit < 0 || unit >= NUM_UNITS )
 	{
 		return 0;
 	}
@@ -611,7 +694,7 @@ idParallelJobList_Threads::GetUnitWastedTimeMicroSec
 */
 uint64 idParallelJobList_Threads::GetUnitWastedTimeMicroSec( int unit ) const
 {
-	if( unit < 0 || unit >= MAX_THREADS )
+	if( unit < 0 || unit >= NUM_UNITS )
 	{
 		return 0;
 	}
@@ -624,6 +707,30 @@ uint64 idParallelJobList_Threads::GetUnitWastedTimeMicroSec( int unit ) const
 	volatile void* longJobData;
 #endif
 
+/*
+========================
+CheckLongJob
+========================
+*/
+static void CheckLongJob( jobListId_t listId, jobRun_t function, void* data, unsigned int threadNum, uint64 jobMicroSec )
+{
+#ifndef _DEBUG
+	if( jobs_longJobMicroSec.GetInteger() > 0 )
+	{
+		if( jobMicroSec > jobs_longJobMicroSec.GetInteger()
+				&& listId != JOBLIST_UTILITY )
+		{
+			longJobTime = jobMicroSec * ( 1.0f / 1000.0f );
+			longJobFunc = function;
+			longJobData = data;
+			const char* jobName = GetJobName( function );
+			const char* jobListName = GetJobListName( listId );
+			idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
+		}
+	}
+#endif
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobsInternal
@@ -741,27 +848,20 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		{
 			uint64 jobStart = Sys_Microseconds();
 
+			const bool profileJob = profiler.IsCapturing() && profiler.BeginEvent( GetJobName( jobList[state.nextJobIndex].function ) );
+
 			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
 			jobList[state.nextJobIndex].executed = 1;
 
+			if( profileJob )
+			{
+				profiler.EndEvent();
+			}
+
 			uint64 jobEnd = Sys_Microseconds();
 			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
 
-#ifndef _DEBUG
-			if( jobs_longJobMicroSec.GetInteger() > 0 )
-			{
-				if( jobEnd - jobStart > jobs_longJobMicroSec.GetInteger()
-						&& GetId() != JOBLIST_UTILITY )
-				{
-					longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
-					longJobFunc = jobList[state.nextJobIndex].function;
-					longJobData = jobList[state.nextJobIndex].data;
-					const char* jobName = GetJobName( jobList[state.nextJobIndex].function );
-					const char* jobListName = GetJobListName( GetId() );
-					idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
-				}
-			}
-#endif
+			CheckLongJob( GetId(), jobList[state.nextJobIndex].function, jobList[state.nextJobIndex].data, threadNum, jobEnd - jobStart );
 		}
 
 		result |= RUN_PROGRESS;
@@ -820,6 +920,212 @@ bool idParallelJobList_Threads::WaitForOtherJobList()
 	return false;
 }
 
+/*
+========================
+idParallelJobList_Threads::WaitForDependencies
+
+Spins on the host until the dependencies starting at firstDependency are done.
+========================
+*/
+void idParallelJobList_Threads::WaitForDependencies( int firstDependency )
+{
+	for( int i = firstDependency; i < dependencyGuards.Num(); i++ )
+	{
+		while( dependencyGuards[i]->GetValue() > 0 )
+		{
+			if( !RunQueuedJob( HOST_UNIT ) )
+			{
+				Sys_Yield();
+			}
+		}
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::StartWorkStealing
+
+Instead of having every thread fetch from the shared job list the jobs are
+handed out to the work stealing queues of the job threads one sync segment
+at a time. The list is started as soon as all the lists it depends on are
+done so independent lists form a DAG that never blocks a job thread.
+A SYNC_SYNCHRONIZE acts as a full barrier between the segments.
+========================
+*/
+void idParallelJobList_Threads::StartWorkStealing( int numThreads )
+{
+	workStealing = true;
+	stealingDone = false;
+	stealingThreads = idMath::ClampInt( 1, MAX_THREADS, numThreads );
+	stealingSegment = 0;
+
+	stealingJobs.SetNum( 0 );
+	stealingSegmentEnds.SetNum( 0 );
+	for( int i = 0; i < jobList.Num(); i++ )
+	{
+		if( jobList[i].function != Nop )
+		{
+			stealingJobs.Append( i );
+		}
+		else if( jobList[i].data == & JOB_SYNCHRONIZE )
+		{
+			stealingSegmentEnds.Append( stealingJobs.Num() );
+		}
+	}
+	stealingSegmentEnds.Append( stealingJobs.Num() );
+
+	// hold a reference ourselves so the list can't start before all dependencies are registered
+	pendingDependencies.SetValue( 1 );
+	for( int i = 0; i < dependencies.Num(); i++ )
+	{
+		pendingDependencies.Increment();
+		if( !dependencies[i]->AddDependent( this ) )
+		{
+			pendingDependencies.Decrement();
+
+			// a list run by the old scheduler can't notify us so wait for it right here
+			while( dependencyGuards[i]->GetValue() > 0 )
+			{
+				if( !RunQueuedJob( HOST_UNIT ) )
+				{
+					Sys_Yield();
+				}
+			}
+		}
+	}
+	DependencyDone();
+}
+
+/*
+========================
+idParallelJobList_Threads::AddDependent
+
+Returns false if this list is not being run by the work stealing scheduler right now.
+========================
+*/
+bool idParallelJobList_Threads::AddDependent( idParallelJobList_Threads* jobList )
+{
+	idScopedCriticalSection lock( dependentsMutex );
+	if( done || !workStealing || stealingDone )
+	{
+		return false;
+	}
+	dependents.Append( jobList );
+	return true;
+}
+
+/*
+========================
+idParallelJobList_Threads::DependencyDone
+========================
+*/
+void idParallelJobList_Threads::DependencyDone()
+{
+	// this may be called from any thread, so keep Wait() from returning while jobs are being queued
+	numThreadsExecuting.Increment();
+	if( pendingDependencies.Decrement() == 0 )
+	{
+		ReleaseSegment();
+	}
+	numThreadsExecuting.Decrement();
+}
+
+/*
+========================
+idParallelJobList_Threads::ReleaseSegment
+========================
+*/
+void idParallelJobList_Threads::ReleaseSegment()
+{
+	for( ; stealingSegment < stealingSegmentEnds.Num(); stealingSegment++ )
+	{
+		const int first = ( stealingSegment > 0 ) ? stealingSegmentEnds[stealingSegment - 1] : 0;
+		const int numJobs = stealingSegmentEnds[stealingSegment] - first;
+		if( numJobs > 0 )
+		{
+			// the count must be set before any job can be stolen
+			stealingJobsLeft.SetValue( numJobs );
+			PushStealableJobs( this, stealingJobs.Ptr() + first, numJobs, stealingThreads );
+			return;
+		}
+	}
+	FinishWorkStealing();
+}
+
+/*
+========================
+idParallelJobList_Threads::FinishWorkStealing
+========================
+*/
+void idParallelJobList_Threads::FinishWorkStealing()
+{
+	deferredThreadStats.endTime = Sys_Microseconds();
+
+	idStaticList< idParallelJobList_Threads*, MAX_JOBLISTS > released;
+
+	dependentsMutex.Lock();
+	for( int i = 0; i < dependents.Num(); i++ )
+	{
+		released.Append( dependents[i] );
+	}
+	dependents.SetNum( 0 );
+	stealingDone = true;
+	dependentsMutex.Unlock();
+
+	// lists run by the old scheduler may be waiting on this
+	doneGuards[currentDoneGuard].Decrement();
+
+	for( int i = 0; i < released.Num(); i++ )
+	{
+		released[i]->DependencyDone();
+	}
+}
+
+/*
+========================
+idParallelJobList_Threads::RunStolenJob
+========================
+*/
+void idParallelJobList_Threads::RunStolenJob( unsigned int threadNum, int jobIndex )
+{
+	assert( threadNum < NUM_UNITS );
+
+	numThreadsExecuting.Increment();
+
+	uint64 jobStart = Sys_Microseconds();
+	if( deferredThreadStats.startTime == 0 )
+	{
+		deferredThreadStats.startTime = jobStart;	// first time any thread is running jobs from this list
+	}
+
+	job_t& job = jobList[jobIndex];
+
+	const bool profileJob = profiler.IsCapturing() && profiler.BeginEvent( GetJobName( job.function ) );
+
+	job.function( job.data );
+	job.executed = 1;
+
+	if( profileJob )
+	{
+		profiler.EndEvent();
+	}
+
+	uint64 jobEnd = Sys_Microseconds();
+	deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
+	deferredThreadStats.threadTotalTime[threadNum] += jobEnd - jobStart;
+
+	CheckLongJob( GetId(), job.function, job.data, threadNum, jobEnd - jobStart );
+
+	if( stealingJobsLeft.Decrement() == 0 )
+	{
+		// this was the last job of the segment so move on to the next one
+		stealingSegment++;
+		ReleaseSegment();
+	}
+
+	numThreadsExecuting.Decrement();
+}
+
 /*
 ================================================================================================
 
@@ -881,6 +1187,17 @@ void idParallelJobList::InsertSyncPoint( jobSyncType_t syncType )
 	jobListThreads->InsertSyncPoint( syncType );
 }
 
+/*
+========================
+idParallelJobList::AddDependency
+========================
+*/
+void idParallelJobList::AddDependency( idParallelJobList* jobList )
+{
+	assert( jobList != NULL && jobList != this );
+	jobListThreads->AddDependency( jobList->jobListThreads );
+}
+
 /*
 ========================
 idParallelJobList::Wait
@@ -1058,6 +1375,116 @@ struct threadJobList_t
 
 static idCVar jobs_prioritize( "jobs_prioritize", "1", CVAR_BOOL | CVAR_NOCHEAT, "prioritize job lists" );
 
+struct stealableJob_t
+{
+	idParallelJobList_Threads* 	jobList;
+	int							jobIndex;
+};
+
+/*
+================================================
+idJobDeque
+
+Queue of jobs owned by a single job thread. The owner takes jobs from the
+back while other threads steal from the front. Jobs are pushed in reverse
+order so the owner runs them in submission order and thieves take the jobs
+furthest away from what the owner is working on.
+================================================
+*/
+class idJobDeque
+{
+public:
+	idJobDeque() :
+		first( 0 ),
+		numQueued( 0 ) {}
+
+	void						Push( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs );
+	bool						PopBack( stealableJob_t& job );
+	bool						PopFront( stealableJob_t& job );
+
+	// only a hint, the queue may change at any time
+	bool						IsEmpty() const
+	{
+		return numQueued <= 0;
+	}
+
+private:
+	idList< stealableJob_t, TAG_JOBLIST >	jobs;
+	int							first;
+	volatile int				numQueued;
+	idSysMutex					mutex;
+};
+
+/*
+========================
+idJobDeque::Push
+========================
+*/
+void idJobDeque::Push( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs )
+{
+	idScopedCriticalSection lock( mutex );
+	for( int i = numJobs - 1; i >= 0; i-- )
+	{
+		stealableJob_t& job = jobs.Alloc();
+		job.jobList = jobList;
+		job.jobIndex = jobIndices[i];
+	}
+	numQueued = jobs.Num() - first;
+}
+
+/*
+========================
+idJobDeque::PopBack
+========================
+*/
+bool idJobDeque::PopBack( stealableJob_t& job )
+{
+	if( IsEmpty() )
+	{
+		return false;
+	}
+	idScopedCriticalSection lock( mutex );
+	if( jobs.Num() <= first )
+	{
+		return false;
+	}
+	job = jobs[jobs.Num() - 1];
+	jobs.SetNum( jobs.Num() - 1 );
+	if( jobs.Num() == first )
+	{
+		jobs.SetNum( 0 );
+		first = 0;
+	}
+	numQueued = jobs.Num() - first;
+	return true;
+}
+
+/*
+========================
+idJobDeque::PopFront
+========================
+*/
+bool idJobDeque::PopFront( stealableJob_t& job )
+{
+	if( IsEmpty() )
+	{
+		return false;
+	}
+	idScopedCriticalSection lock( mutex );
+	if( jobs.Num() <= first )
+	{
+		return false;
+	}
+	job = jobs[first++];
+	if( jobs.Num() == first )
+	{
+		jobs.SetNum( 0 );
+		first = 0;
+	}
+	numQueued = jobs.Num() - first;
+	return true;
+}
+
 class idJobThread : public idSysThread
 {
 public:
@@ -1068,12 +1495,19 @@ public:
 
 	void						AddJobList( idParallelJobList_Threads* jobList );
 
+	idJobDeque& 				GetJobDeque()
+	{
+		return jobDeque;
+	}
+
 private:
 	threadJobList_t				jobLists[MAX_JOBLISTS];	// cyclic buffer with job lists
 	unsigned int				firstJobList;			// index of the last job list the thread grabbed
 	unsigned int				lastJobList;			// index where the next job list to work on will be added
 	idSysMutex					addJobMutex;
 
+	idJobDeque					jobDeque;				// jobs handed out by the work stealing scheduler
+
 	unsigned int				threadNum;
 
 	virtual int					Run();
@@ -1149,6 +1583,11 @@ int idJobThread::Run()
 	int numJobLists = 0;
 	int lastStalledJobList = -1;
 
+	// register the name now, captures are started long after the job threads
+	char name[16];
+	idStr::snPrintf( name, sizeof( name ), "JLProc_%d", threadNum );
+	profiler.SetThreadName( name );
+
 	while( !IsTerminating() )
 	{
 
@@ -1165,6 +1604,11 @@ int idJobThread::Run()
 		}
 		if( numJobLists == 0 )
 		{
+			// keep running queued or stolen jobs until all the work stealing queues are empty
+			if( RunQueuedJob( threadNum ) )
+			{
+				continue;
+			}
 			break;
 		}
 
@@ -1221,7 +1665,11 @@ int idJobThread::Run()
 			{
 				if( ( result & idParallelJobList_Threads::RUN_PROGRESS ) == 0 )
 				{
-					Sys_Yield();
+					// try to hide the stall with a queued job before giving up the time slice
+					if( !RunQueuedJob( threadNum ) )
+					{
+						Sys_Yield();
+					}
 				}
 			}
 			lastStalledJobList = currentJobList;
@@ -1301,8 +1749,12 @@ public:
 
 	void						Submit( idParallelJobList_Threads* jobList, int parallelism );
 
+	void						PushStealableJobs( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs, int numThreads );
+	bool						RunQueuedJob( unsigned int threadNum );
+
 private:
 	idJobThread						threads[MAX_JOB_THREADS];
+	idSysInterlockedInteger			nextStealThread;
 	unsigned int					maxThreads;
 	int								numPhysicalCpuCores;
 	int								numLogicalCpuCores;
@@ -1323,6 +1775,26 @@ void SubmitJobList( idParallelJobList_Threads* jobList, int parallelism )
 	parallelJobManagerLocal.Submit( jobList, parallelism );
 }
 
+/*
+========================
+PushStealableJobs
+========================
+*/
+static void PushStealableJobs( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs, int numThreads )
+{
+	parallelJobManagerLocal.PushStealableJobs( jobList, jobIndices, numJobs, numThreads );
+}
+
+/*
+========================
+RunQueuedJob
+========================
+*/
+static bool RunQueuedJob( unsigned int threadNum )
+{
+	return parallelJobManagerLocal.RunQueuedJob( threadNum );
+}
+
 /*
 ========================
 idParallelJobManagerLocal::Init
@@ -1490,14 +1962,220 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads* jobList, int
 
 	if( numThreads <= 0 )
 	{
+		jobList->WaitForDependencies( 0 );
 		threadJobListState_t state( jobList->GetVersion() );
 		jobList->RunJobs( 0, state, false );
 		return;
 	}
 
+	if( jobs_workStealing.GetBool() )
+	{
+		jobList->StartWorkStealing( numThreads );
+		return;
+	}
+
+	// the job threads only know how to wait for a single other job list
+	jobList->WaitForDependencies( 1 );
+
 	for( int i = 0; i < numThreads; i++ )
 	{
 		threads[i].AddJobList( jobList );
 		threads[i].SignalWork();
 	}
 }
+
+/*
+========================
+idParallelJobManagerLocal::PushStealableJobs
+
+Spreads the jobs in contiguous chunks over the queues of numThreads job threads,
+starting at a different thread every time so consecutive lists don't pile up
+on the first threads.
+========================
+*/
+void idParallelJobManagerLocal::PushStealableJobs( idParallelJobList_Threads* jobList, const int* jobIndices, int numJobs, int numThreads )
+{
+	numThreads = idMath::ClampInt( 1, MAX_JOB_THREADS, numThreads );
+	const int numChunks = Min( numThreads, numJobs );
+	const int firstThread = ( unsigned int )nextStealThread.Increment() % numThreads;
+
+	int firstJob = 0;
+	for( int i = 0; i < numChunks; i++ )
+	{
+		const int lastJob = ( numJobs * ( i + 1 ) ) / numChunks;
+		idJobThread& thread = threads[( firstThread + i ) % numThreads];
+		thread.GetJobDeque().Push( jobList, jobIndices + firstJob, lastJob - firstJob );
+		thread.SignalWork();
+		firstJob = lastJob;
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::RunQueuedJob
+
+Runs a job from the queue of the given thread or, if that is empty, steals one
+from the other threads. Returns false if there was nothing to run.
+========================
+*/
+bool idParallelJobManagerLocal::RunQueuedJob( unsigned int threadNum )
+{
+	stealableJob_t job;
+	bool found = ( threadNum < MAX_JOB_THREADS ) && threads[threadNum].GetJobDeque().PopBack( job );
+	if( !found )
+	{
+		// start with the next thread so thieves don't all hammer the same queue
+		const unsigned int start = ( threadNum < MAX_JOB_THREADS ) ? threadNum + 1 : ( unsigned int )nextStealThread.GetValue();
+		for( int i = 0; i < MAX_JOB_THREADS && !found; i++ )
+		{
+			const unsigned int victim = ( start + i ) % MAX_JOB_THREADS;
+			if( victim != threadNum )
+			{
+				found = threads[victim].GetJobDeque().PopFront( job );
+			}
+		}
+	}
+	if( !found )
+	{
+		return false;
+	}
+	job.jobList->RunStolenJob( threadNum, job.jobIndex );
+	return true;
+}
+
+/*
+================================================================================================
+
+Scheduler microbenchmark
+
+================================================================================================
+*/
+
+/*
+========================
+SchedulerTestJob
+
+Busy loop so the job length doesn't depend on the cache or the optimizer.
+The low byte of data is the job length in microseconds, the rest only makes
+the data unique within a list.
+========================
+*/
+static void SchedulerTestJob( void* data )
+{
+	const uint64 end = Sys_Microseconds() + ( ( intptr_t )data & 255 );
+	while( Sys_Microseconds() < end )
+	{
+	}
+}
+REGISTER_PARALLEL_JOB( SchedulerTestJob, "SchedulerTestJob" );
+
+/*
+========================
+RunSchedulerTest
+
+Runs numFrames "frames" that look like the renderer front end: a list with a
+sync point in the middle (models), an independent list (lights), a list that
+depends on the first one (shadows) and a final list that depends on both of
+the others. Job lengths vary from 5 to 80 microseconds to create imbalance.
+Returns the frame times in microseconds.
+========================
+*/
+static void RunSchedulerTest( idParallelJobList* lists[4], int numJobs, int numFrames, idList<int>& frameTimes )
+{
+	frameTimes.SetNum( 0 );
+	for( int frame = 0; frame < numFrames; frame++ )
+	{
+		for( int l = 0; l < 4; l++ )
+		{
+			for( int i = 0; i < numJobs; i++ )
+			{
+				if( l == 0 && i == numJobs / 2 )
+				{
+					lists[l]->InsertSyncPoint( SYNC_SIGNAL );
+					lists[l]->InsertSyncPoint( SYNC_SYNCHRONIZE );
+				}
+				const intptr_t jobMicroSec = 5 + ( ( i * 7 + l * 3 ) & 15 ) * 5;
+				lists[l]->AddJob( SchedulerTestJob, ( void* )( ( ( intptr_t )i << 8 ) | jobMicroSec ) );
+			}
+		}
+
+		const uint64 start = Sys_Microseconds();
+
+		lists[0]->Submit();
+		lists[1]->Submit();
+		lists[2]->Submit( lists[0] );
+		lists[3]->AddDependency( lists[1] );
+		lists[3]->Submit( lists[2] );
+
+		lists[3]->Wait();
+		lists[2]->Wait();
+		lists[1]->Wait();
+		lists[0]->Wait();
+
+		frameTimes.Append( ( int )( Sys_Microseconds() - start ) );
+	}
+}
+
+/*
+========================
+testJobScheduler
+========================
+*/
+CONSOLE_COMMAND( testJobScheduler, "compares the throughput and tail latency of the job list and the work stealing scheduler, usage: testJobScheduler [numJobsPerList] [numFrames]", 0 )
+{
+	const int numJobs = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, 500, atoi( args.Argv( 1 ) ) ) : 128;
+	const int numFrames = ( args.Argc() > 2 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 2 ) ) ) : 100;
+	const int numWarmupFrames = 10;
+
+	if( parallelJobManager->GetNumFreeJobLists() < 4 )
+	{
+		idLib::Printf( "Not enough free job lists\n" );
+		return;
+	}
+
+	idParallelJobList* lists[4];
+	for( int i = 0; i < 4; i++ )
+	{
+		lists[i] = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 1, NULL );
+	}
+
+	const int savedNumThreads = jobs_numThreads.GetInteger();
+	const bool savedWorkStealing = jobs_workStealing.GetBool();
+
+	idLib::Printf( "%d frames of %d jobs\n", numFrames, numJobs * 4 );
+	idLib::Printf( "threads scheduler      jobs/ms   avg ms   p99 ms   max ms\n" );
+
+	const int threadCounts[4] = { 2, 4, 8, 16 };
+	idList<int> frameTimes;
+	for( int t = 0; t < 4; t++ )
+	{
+		for( int mode = 0; mode < 2; mode++ )
+		{
+			jobs_numThreads.SetInteger( threadCounts[t] );
+			jobs_workStealing.SetBool( mode != 0 );
+
+			RunSchedulerTest( lists, numJobs, numWarmupFrames, frameTimes );
+			RunSchedulerTest( lists, numJobs, numFrames, frameTimes );
+
+			int64 total = 0;
+			for( int i = 0; i < frameTimes.Num(); i++ )
+			{
+				total += frameTimes[i];
+			}
+			frameTimes.SortWithTemplate( idSort_QuickDefault<int>() );
+			const int p99 = frameTimes[Min( frameTimes.Num() - 1, ( frameTimes.Num() * 99 ) / 100 )];
+
+			idLib::Printf( "%7d %-12s %9.1f %8.3f %8.3f %8.3f\n", threadCounts[t], ( mode != 0 ) ? "stealing" : "job lists",
+						   ( float )numFrames * numJobs * 4 * 1000.0f / Max( total, ( int64 )1 ),
+						   total * 0.001f / numFrames, p99 * 0.001f, frameTimes[frameTimes.Num() - 1] * 0.001f );
+		}
+	}
+
+	jobs_numThreads.SetInteger( savedNumThreads );
+	jobs_workStealing.SetBool( savedWorkStealing );
+
+	for( int i = 0; i < 4; i++ )
+	{
+		parallelJobManager->FreeJobList( lists[i] );
+	}
+}
@@ -95,6 +95,8 @@ public:
 	CellSpursJob128* 		AddJobSPURS();
 	void					InsertSyncPoint( jobSyncType_t syncType );
 
+	// Make the next Submit() wait for another job list, on top of the waitForJobList passed to Submit().
+	void					AddDependency( idParallelJobList* jobList );
 	// Submit the jobs in this list.
 	void					Submit( idParallelJobList* waitForJobList = NULL, int parallelism = JOBLIST_PARALLELISM_DEFAULT );
 	// Wait for the jobs in this list to finish. Will spin in place if any jobs are not done.
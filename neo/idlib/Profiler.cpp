@@ -0,0 +1,359 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#include "precompiled.h"
+#pragma hdrstop
+#include "Profiler.h"
+
+idProfiler profiler;
+
+/*
+========================
+idProfiler::idProfiler
+========================
+*/
+idProfiler::idProfiler() :
+	capturing( false ),
+	captureFramesRequested( 0 ),
+	captureFramesLeft( 0 ),
+	captureStartMicroSec( 0 )
+{
+	memset( threads, 0, sizeof( threads ) );
+}
+
+/*
+========================
+idProfiler::Shutdown
+========================
+*/
+void idProfiler::Shutdown()
+{
+	capturing = false;
+	captureFramesRequested = 0;
+	captureFramesLeft = 0;
+
+	for( int i = 0; i < MAX_PROFILE_THREADS; i++ )
+	{
+		if( threads[i].events != NULL )
+		{
+			Mem_Free( threads[i].events );
+			threads[i].events = NULL;
+		}
+	}
+}
+
+/*
+========================
+idProfiler::GetThread
+
+Registers the calling thread on first use.
+========================
+*/
+profileThread_t* idProfiler::GetThread()
+{
+	ptrdiff_t index = threadIndex;
+	if( index == 0 )
+	{
+		index = numThreads.Increment();
+		if( index > MAX_PROFILE_THREADS )
+		{
+			// out of thread slots, this thread will simply not show up in captures
+			threadIndex = -1;
+			return NULL;
+		}
+		threadIndex = index;
+
+		profileThread_t& thread = threads[index - 1];
+		if( thread.name[0] == '\0' )
+		{
+			if( idLib::IsMainThread() )
+			{
+				idStr::Copynz( thread.name, "Main", sizeof( thread.name ) );
+			}
+			else
+			{
+				idStr::snPrintf( thread.name, sizeof( thread.name ), "Thread_%d", ( int )index );
+			}
+		}
+	}
+	else if( index < 0 )
+	{
+		return NULL;
+	}
+	return &threads[index - 1];
+}
+
+/*
+========================
+idProfiler::SetThreadName
+========================
+*/
+void idProfiler::SetThreadName( const char* name )
+{
+	profileThread_t* thread = GetThread();
+	if( thread != NULL )
+	{
+		idStr::Copynz( thread->name, name, sizeof( thread->name ) );
+	}
+}
+
+/*
+========================
+idProfiler::BeginEvent
+========================
+*/
+bool idProfiler::BeginEvent( const char* name )
+{
+	if( !capturing )
+	{
+		return false;
+	}
+
+	profileThread_t* thread = GetThread();
+	if( thread == NULL )
+	{
+		return false;
+	}
+
+	if( thread->events == NULL )
+	{
+		// only threads that actually emit events during a capture pay for a ring buffer
+		thread->events = ( profileEvent_t* )Mem_ClearedAlloc( MAX_PROFILE_EVENTS_PER_THREAD * sizeof( profileEvent_t ), TAG_IDLIB );
+	}
+
+	if( thread->depth >= MAX_PROFILE_EVENT_DEPTH )
+	{
+		// keep the nesting balanced but don't record anything this deep
+		thread->depth++;
+		return true;
+	}
+
+	const unsigned int eventNum = thread->head++;
+	profileEvent_t& event = thread->events[eventNum & ( MAX_PROFILE_EVENTS_PER_THREAD - 1 )];
+	event.name = name;
+	event.endMicroSec = 0;
+	event.startMicroSec = Sys_Microseconds();
+
+	thread->stack[thread->depth++] = eventNum;
+	return true;
+}
+
+/*
+========================
+idProfiler::EndEvent
+========================
+*/
+void idProfiler::EndEvent()
+{
+	ptrdiff_t index = threadIndex;
+	if( index <= 0 )
+	{
+		return;
+	}
+
+	profileThread_t& thread = threads[index - 1];
+	if( thread.depth <= 0 || thread.events == NULL )
+	{
+		return;
+	}
+
+	thread.depth--;
+	if( thread.depth >= MAX_PROFILE_EVENT_DEPTH )
+	{
+		return;
+	}
+
+	const unsigned int eventNum = thread.stack[thread.depth];
+	if( thread.head - eventNum > MAX_PROFILE_EVENTS_PER_THREAD )
+	{
+		// the ring buffer wrapped around while this event was open
+		return;
+	}
+	thread.events[eventNum & ( MAX_PROFILE_EVENTS_PER_THREAD - 1 )].endMicroSec = Sys_Microseconds();
+}
+
+/*
+========================
+idProfiler::StartCapture
+========================
+*/
+void idProfiler::StartCapture( int numFrames, const char* fileName )
+{
+	if( capturing || captureFramesRequested > 0 )
+	{
+		idLib::Printf( "A profile capture is already in progress\n" );
+		return;
+	}
+	captureFileName = fileName;
+	captureFramesRequested = Max( numFrames, 1 );
+}
+
+/*
+========================
+idProfiler::BeginFrame
+========================
+*/
+void idProfiler::BeginFrame()
+{
+	if( capturing )
+	{
+		if( --captureFramesLeft <= 0 )
+		{
+			StopCapture();
+		}
+	}
+	else if( captureFramesRequested > 0 )
+	{
+		captureFramesLeft = captureFramesRequested;
+		captureFramesRequested = 0;
+		captureStartMicroSec = Sys_Microseconds();
+		capturing = true;
+	}
+}
+
+/*
+========================
+idProfiler::StopCapture
+========================
+*/
+void idProfiler::StopCapture()
+{
+	capturing = false;
+
+	if( WriteChromeTrace( captureFileName ) )
+	{
+		idLib::Printf( "Wrote profile capture to %s\n", captureFileName.c_str() );
+	}
+}
+
+/*
+========================
+WriteJSONString
+========================
+*/
+static void WriteJSONString( idFile* f, const char* s )
+{
+	char buffer[256];
+	int len = 0;
+	for( ; *s != '\0' && len < ( int )sizeof( buffer ) - 3; s++ )
+	{
+		if( *s == '"' || *s == '\\' )
+		{
+			buffer[len++] = '\\';
+			buffer[len++] = *s;
+		}
+		else if( ( unsigned char )*s >= ' ' )
+		{
+			buffer[len++] = *s;
+		}
+	}
+	buffer[len] = '\0';
+	f->Printf( "\"%s\"", buffer );
+}
+
+/*
+========================
+idProfiler::WriteChromeTrace
+
+Writes all completed events of the last capture in the Chrome trace event format.
+========================
+*/
+bool idProfiler::WriteChromeTrace( const char* fileName ) const
+{
+	idFile* f = idLib::fileSystem->OpenFileWrite( fileName );
+	if( f == NULL )
+	{
+		idLib::Warning( "Couldn't open %s for writing", fileName );
+		return false;
+	}
+
+	f->Printf( "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n" );
+
+	const int num = Min( numThreads.GetValue(), MAX_PROFILE_THREADS );
+	int numWritten = 0;
+	for( int i = 0; i < num; i++ )
+	{
+		const profileThread_t& thread = threads[i];
+
+		f->Printf( "%s{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": { \"name\": ", ( numWritten++ > 0 ) ? ",\n" : "", i );
+		WriteJSONString( f, thread.name );
+		f->Printf( " } }" );
+
+		if( thread.events == NULL )
+		{
+			continue;
+		}
+
+		const unsigned int head = thread.head;
+		const unsigned int count = Min( head, ( unsigned int )MAX_PROFILE_EVENTS_PER_THREAD );
+		for( unsigned int e = head - count; e != head; e++ )
+		{
+			const profileEvent_t& event = thread.events[e & ( MAX_PROFILE_EVENTS_PER_THREAD - 1 )];
+			if( event.endMicroSec == 0 || event.startMicroSec < captureStartMicroSec || event.name == NULL )
+			{
+				continue;
+			}
+
+			f->Printf( ",\n{ \"name\": " );
+			WriteJSONString( f, event.name );
+			f->Printf( ", \"cat\": \"cpu\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %lld, \"dur\": %lld }",
+					   i, ( int64 )( event.startMicroSec - captureStartMicroSec ), ( int64 )( event.endMicroSec - event.startMicroSec ) );
+		}
+	}
+
+	f->Printf( "\n]\n}\n" );
+	delete f;
+	return true;
+}
+
+/*
+========================
+profileCapture
+========================
+*/
+CONSOLE_COMMAND( profileCapture, "captures CPU profile events for a number of frames and writes a Chrome trace JSON file, usage: profileCapture [numFrames] [filename]", 0 )
+{
+	int numFrames = 10;
+	if( args.Argc() > 1 )
+	{
+		numFrames = atoi( args.Argv( 1 ) );
+	}
+
+	idStr fileName;
+	if( args.Argc() > 2 )
+	{
+		fileName = args.Argv( 2 );
+	}
+	else
+	{
+		fileName.Format( "profile/capture_%d.json", idLib::frameNumber );
+	}
+	fileName.DefaultFileExtension( ".json" );
+
+	profiler.StartCapture( numFrames, fileName );
+	idLib::Printf( "Capturing %d frames to %s\n", Max( numFrames, 1 ), fileName.c_str() );
+}
@@ -0,0 +1,116 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+/*
+================================================================================================
+
+	Hierarchical CPU profiler
+
+	Every thread that emits named events gets its own ring buffer of events, so recording
+	an event never takes a lock. Nothing is recorded unless a capture is active, in which
+	case the cost of an event is a TLS lookup and two Sys_Microseconds() calls.
+
+	A capture is armed with the "profileCapture" console command and always starts and
+	stops on a frame boundary (see BeginFrame). When the requested number of frames has
+	been recorded the events of all threads are written out as a Chrome trace JSON file
+	that can be loaded in chrome://tracing or https://ui.perfetto.dev
+
+================================================================================================
+*/
+
+static const int MAX_PROFILE_THREADS			= 48;
+static const int MAX_PROFILE_EVENTS_PER_THREAD	= 1 << 15;	// must be a power of two
+static const int MAX_PROFILE_EVENT_DEPTH		= 64;
+
+compile_time_assert( CONST_ISPOWEROFTWO( MAX_PROFILE_EVENTS_PER_THREAD ) );
+
+struct profileEvent_t
+{
+	const char* 	name;
+	uint64			startMicroSec;
+	uint64			endMicroSec;		// 0 while the event is still open
+};
+
+struct profileThread_t
+{
+	char				name[32];
+	profileEvent_t* 	events;			// ring buffer of MAX_PROFILE_EVENTS_PER_THREAD events
+	unsigned int		head;			// total number of events ever written, wraps with the ring
+	int					depth;
+	unsigned int		stack[MAX_PROFILE_EVENT_DEPTH];
+};
+
+class idProfiler
+{
+public:
+	idProfiler();
+
+	void					Shutdown();
+
+	// Called once at the very start of every frame from the main thread.
+	// Starts and stops captures so they always cover whole frames.
+	void					BeginFrame();
+
+	// Arm a capture of the next numFrames frames, written to fileName when done.
+	void					StartCapture( int numFrames, const char* fileName );
+
+	bool					IsCapturing() const
+	{
+		return capturing;
+	}
+
+	// Name the calling thread in the trace output.
+	void					SetThreadName( const char* name );
+
+	// Thread safe, but events must be properly nested on each thread.
+	// EndEvent must only be called if BeginEvent returned true.
+	bool					BeginEvent( const char* name );
+	void					EndEvent();
+
+	bool					WriteChromeTrace( const char* fileName ) const;
+
+private:
+	volatile bool			capturing;
+	int						captureFramesRequested;
+	int						captureFramesLeft;
+	idStr					captureFileName;
+	uint64					captureStartMicroSec;
+
+	profileThread_t			threads[MAX_PROFILE_THREADS];
+	idSysInterlockedInteger	numThreads;
+	ID_TLS					threadIndex;		// index + 1 into threads[], 0 if not registered yet
+
+	profileThread_t* 		GetThread();
+	void					StopCapture();
+};
+
+extern idProfiler profiler;
+
+#endif // !__PROFILER_H__
@@ -1953,6 +1953,282 @@ bool idRenderMatrix::CullBoundsToMVPbits( const idRenderMatrix& mvp, const idBou
 #endif
 }
 
+/*
+================================================================================================
+
+Batched bounds culling
+
+Each side of the clip space is a plane in the space of the bounds, made from the rows of the
+MVP. The bounds is completely behind a plane if the corner furthest in front of it is, and per
+axis that corner uses whichever of the min and max gives the larger product with the plane
+normal. The SSE and AVX2 kernels test 4 and 8 bounds at a time with exactly the same multiplies
+and adds as the generic version, so all of them produce the same results.
+
+================================================================================================
+*/
+
+static const int NUM_CULL_PLANES = 6;
+
+// The AVX2 kernel is compiled for any x86 target and picked at run time.
+#if defined( USE_INTRINSICS_SSE ) && ( defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 ) )
+	#define RENDER_MATRIX_USE_AVX2
+#endif
+
+#if defined( RENDER_MATRIX_USE_AVX2 )
+
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+	#define RENDER_MATRIX_TARGET_AVX2
+#else
+	#define RENDER_MATRIX_TARGET_AVX2		__attribute__( ( target( "avx2" ) ) )
+#endif
+
+// set by idRenderMatrix::SetBatchCullingAVX2, this file can't see the CPUID flags or the cvars
+static bool batchCullingAVX2 = false;
+
+/*
+========================
+UseAVX2
+========================
+*/
+static bool UseAVX2()
+{
+	return batchCullingAVX2;
+}
+
+#endif
+
+/*
+========================
+GetCullPlanesForMVP
+
+The planes have the inside of the clip space on the positive side.
+========================
+*/
+static void GetCullPlanesForMVP( const idRenderMatrix& mvp, bool zeroToOne, idVec4 planes[NUM_CULL_PLANES] )
+{
+	for( int i = 0; i < 4; i++ )
+	{
+		const float r0 = mvp[0][i];
+		const float r1 = mvp[1][i];
+		const float r2 = mvp[2][i];
+		const float r3 = mvp[3][i];
+
+		planes[0][i] = zeroToOne ? r0 : r3 + r0;
+		planes[1][i] = r3 - r0;
+		planes[2][i] = zeroToOne ? r1 : r3 + r1;
+		planes[3][i] = r3 - r1;
+#if defined( CLIP_SPACE_D3D )	// the D3D clip space Z is in the range [0,1] so always compare Z vs zero whether 'zeroToOne' is true or false
+		planes[4][i] = r2;
+#else
+		planes[4][i] = zeroToOne ? r2 : r3 + r2;
+#endif
+		planes[5][i] = r3 - r2;
+	}
+}
+
+/*
+========================
+CullBoundsToPlanes_Generic
+========================
+*/
+static bool CullBoundsToPlanes_Generic( const idVec4 planes[NUM_CULL_PLANES], const idBoundsBatch& batch, int index )
+{
+	for( int i = 0; i < NUM_CULL_PLANES; i++ )
+	{
+		const idVec4& p = planes[i];
+		const float x = Max( p[0] * batch.mins[0][index], p[0] * batch.maxs[0][index] );
+		const float y = Max( p[1] * batch.mins[1][index], p[1] * batch.maxs[1][index] );
+		const float z = Max( p[2] * batch.mins[2][index], p[2] * batch.maxs[2][index] );
+		if( ( ( x + y ) + z ) + p[3] <= 0.0f )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+#if defined(USE_INTRINSICS_SSE)
+
+/*
+========================
+CullBoundsToPlanes_SSE
+
+Returns the number of bounds that were processed, the rest is left to the generic version.
+========================
+*/
+static int CullBoundsToPlanes_SSE( const idVec4 planes[NUM_CULL_PLANES], const idBoundsBatch& batch, byte* culled )
+{
+	__m128 planeX[NUM_CULL_PLANES];
+	__m128 planeY[NUM_CULL_PLANES];
+	__m128 planeZ[NUM_CULL_PLANES];
+	__m128 planeD[NUM_CULL_PLANES];
+	for( int i = 0; i < NUM_CULL_PLANES; i++ )
+	{
+		planeX[i] = _mm_set1_ps( planes[i][0] );
+		planeY[i] = _mm_set1_ps( planes[i][1] );
+		planeZ[i] = _mm_set1_ps( planes[i][2] );
+		planeD[i] = _mm_set1_ps( planes[i][3] );
+	}
+
+	const int num = batch.Num() & ~3;
+	for( int i = 0; i < num; i += 4 )
+	{
+		const __m128 minX = _mm_load_ps( batch.mins[0] + i );
+		const __m128 minY = _mm_load_ps( batch.mins[1] + i );
+		const __m128 minZ = _mm_load_ps( batch.mins[2] + i );
+		const __m128 maxX = _mm_load_ps( batch.maxs[0] + i );
+		const __m128 maxY = _mm_load_ps( batch.maxs[1] + i );
+		const __m128 maxZ = _mm_load_ps( batch.maxs[2] + i );
+
+		__m128 cull = vector_float_zero;
+		for( int j = 0; j < NUM_CULL_PLANES; j++ )
+		{
+			const __m128 x = _mm_max_ps( _mm_mul_ps( planeX[j], minX ), _mm_mul_ps( planeX[j], maxX ) );
+			const __m128 y = _mm_max_ps( _mm_mul_ps( planeY[j], minY ), _mm_mul_ps( planeY[j], maxY ) );
+			const __m128 z = _mm_max_ps( _mm_mul_ps( planeZ[j], minZ ), _mm_mul_ps( planeZ[j], maxZ ) );
+			const __m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( x, y ), z ), planeD[j] );
+			cull = _mm_or_ps( cull, _mm_cmple_ps( d, vector_float_zero ) );
+		}
+
+		const int mask = _mm_movemask_ps( cull );
+		culled[i + 0] = ( byte )( ( mask >> 0 ) & 1 );
+		culled[i + 1] = ( byte )( ( mask >> 1 ) & 1 );
+		culled[i + 2] = ( byte )( ( mask >> 2 ) & 1 );
+		culled[i + 3] = ( byte )( ( mask >> 3 ) & 1 );
+	}
+	return num;
+}
+
+#endif
+
+#if defined( RENDER_MATRIX_USE_AVX2 )
+
+/*
+========================
+CullBoundsToPlanes_AVX2
+
+Returns the number of bounds that were processed, the rest is left to the generic version.
+========================
+*/
+RENDER_MATRIX_TARGET_AVX2 static int CullBoundsToPlanes_AVX2( const idVec4 planes[NUM_CULL_PLANES], const idBoundsBatch& batch, byte* culled )
+{
+	__m256 planeX[NUM_CULL_PLANES];
+	__m256 planeY[NUM_CULL_PLANES];
+	__m256 planeZ[NUM_CULL_PLANES];
+	__m256 planeD[NUM_CULL_PLANES];
+	for( int i = 0; i < NUM_CULL_PLANES; i++ )
+	{
+		planeX[i] = _mm256_set1_ps( planes[i][0] );
+		planeY[i] = _mm256_set1_ps( planes[i][1] );
+		planeZ[i] = _mm256_set1_ps( planes[i][2] );
+		planeD[i] = _mm256_set1_ps( planes[i][3] );
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+
+	const int num = batch.Num() & ~7;
+	for( int i = 0; i < num; i += 8 )
+	{
+		// the batch arrays are only 16 byte aligned
+		const __m256 minX = _mm256_loadu_ps( batch.mins[0] + i );
+		const __m256 minY = _mm256_loadu_ps( batch.mins[1] + i );
+		const __m256 minZ = _mm256_loadu_ps( batch.mins[2] + i );
+		const __m256 maxX = _mm256_loadu_ps( batch.maxs[0] + i );
+		const __m256 maxY = _mm256_loadu_ps( batch.maxs[1] + i );
+		const __m256 maxZ = _mm256_loadu_ps( batch.maxs[2] + i );
+
+		__m256 cull = zero;
+		for( int j = 0; j < NUM_CULL_PLANES; j++ )
+		{
+			const __m256 x = _mm256_max_ps( _mm256_mul_ps( planeX[j], minX ), _mm256_mul_ps( planeX[j], maxX ) );
+			const __m256 y = _mm256_max_ps( _mm256_mul_ps( planeY[j], minY ), _mm256_mul_ps( planeY[j], maxY ) );
+			const __m256 z = _mm256_max_ps( _mm256_mul_ps( planeZ[j], minZ ), _mm256_mul_ps( planeZ[j], maxZ ) );
+			const __m256 d = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( x, y ), z ), planeD[j] );
+			cull = _mm256_or_ps( cull, _mm256_cmp_ps( d, zero, _CMP_LE_OQ ) );
+		}
+
+		const int mask = _mm256_movemask_ps( cull );
+		for( int k = 0; k < 8; k++ )
+		{
+			culled[i + k] = ( byte )( ( mask >> k ) & 1 );
+		}
+	}
+	return num;
+}
+
+#endif
+
+/*
+========================
+idRenderMatrix::CullBoundsToMVPBatch
+
+Culls all bounds of the batch like CullBoundsToMVP would, culled[i] is set to 1 if
+bounds i is completely outside the clip space and to 0 otherwise.
+========================
+*/
+void idRenderMatrix::CullBoundsToMVPBatch( const idRenderMatrix& mvp, const idBoundsBatch& batch, byte* culled, bool zeroToOne )
+{
+	idVec4 planes[NUM_CULL_PLANES];
+	GetCullPlanesForMVP( mvp, zeroToOne, planes );
+
+	int start = 0;
+#if defined( RENDER_MATRIX_USE_AVX2 )
+	if( UseAVX2() )
+	{
+		start = CullBoundsToPlanes_AVX2( planes, batch, culled );
+	}
+	else
+#endif
+	{
+#if defined(USE_INTRINSICS_SSE)
+		start = CullBoundsToPlanes_SSE( planes, batch, culled );
+#endif
+	}
+
+	for( int i = start; i < batch.Num(); i++ )
+	{
+		culled[i] = CullBoundsToPlanes_Generic( planes, batch, i ) ? 1 : 0;
+	}
+}
+
+/*
+========================
+idRenderMatrix::SetBatchCullingAVX2
+
+Only enable this if the CPU supports AVX2.
+========================
+*/
+void idRenderMatrix::SetBatchCullingAVX2( bool enable )
+{
+#if defined( RENDER_MATRIX_USE_AVX2 )
+	batchCullingAVX2 = enable;
+#endif
+}
+
+/*
+========================
+idRenderMatrix::GetBatchCullingKernel
+
+Returns the name of the kernel CullBoundsToMVPBatch uses on this CPU.
+========================
+*/
+const char* idRenderMatrix::GetBatchCullingKernel()
+{
+#if defined( RENDER_MATRIX_USE_AVX2 )
+	if( UseAVX2() )
+	{
+		return "AVX2";
+	}
+#endif
+#if defined(USE_INTRINSICS_SSE)
+	return "SSE";
+#else
+	return "generic";
+#endif
+}
+
 /*
 ========================
 idRenderMatrix::CullExtrudedBoundsToMVPbits
@@ -48,6 +48,62 @@ enum frustumCull_t
 /*
 ================================================================================================
 
+idBoundsBatch
+
+A small set of axis aligned bounds in structure-of-arrays layout for the batched culling
+functions of idRenderMatrix. It is meant to live on the stack, callers with more bounds
+fill and cull it repeatedly.
+
+================================================================================================
+*/
+class idBoundsBatch
+{
+public:
+	static const int		MAX_BOUNDS = 64;	// multiple of the 8 lanes of the widest kernel
+
+	idBoundsBatch() : num( 0 ) {}
+
+	void					Clear()
+	{
+		num = 0;
+	}
+	int						Num() const
+	{
+		return num;
+	}
+	bool					IsFull() const
+	{
+		return num >= MAX_BOUNDS;
+	}
+	ID_INLINE int			Append( const idBounds& bounds );
+
+	ALIGNTYPE16 float		mins[3][MAX_BOUNDS];
+	ALIGNTYPE16 float		maxs[3][MAX_BOUNDS];
+
+private:
+	int						num;
+};
+
+/*
+========================
+idBoundsBatch::Append
+========================
+*/
+ID_INLINE int idBoundsBatch::Append( const idBounds& bounds )
+{
+	assert( num < MAX_BOUNDS );
+	mins[0][num] = bounds[0][0];
+	mins[1][num] = bounds[0][1];
+	mins[2][num] = bounds[0][2];
+	maxs[0][num] = bounds[1][0];
+	maxs[1][num] = bounds[1][1];
+	maxs[2][num] = bounds[1][2];
+	return num++;
+}
+
+/*
+================================================================================================
+
 idRenderMatrix
 
 This is a row-major matrix and transforms are applied with left-multiplication.
@@ -146,6 +202,11 @@ public:
 	static bool				CullExtrudedBoundsToMVP( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, bool zeroToOne = false );
 	static bool				CullExtrudedBoundsToMVPbits( const idRenderMatrix& mvp, const idBounds& bounds, const idVec3& extrudeDirection, const idPlane& clipPlane, byte* outBits, bool zeroToOne = false );
 
+	// Cull a whole batch of bounds with the same MVP, culled[i] is set to 1 where CullBoundsToMVP would return true.
+	static void				CullBoundsToMVPBatch( const idRenderMatrix& mvp, const idBoundsBatch& batch, byte* culled, bool zeroToOne = false );
+	static void				SetBatchCullingAVX2( bool enable );
+	static const char* 		GetBatchCullingKernel();
+
 	// Calculate the projected bounds.
 	static void				ProjectedBounds( idBounds& projected, const idRenderMatrix& mvp, const idBounds& bounds, bool windowSpace = true );
 	static void				ProjectedNearClippedBounds( idBounds& projected, const idRenderMatrix& mvp, const idBounds& bounds, bool windowSpace = true );
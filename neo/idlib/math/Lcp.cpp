@@ -28,6 +28,7 @@ If you have questions concerning this license or the applicable additional terms
 */
 #include "precompiled.h"
 #pragma hdrstop
+#include "Lcp_AVX2.h"
 
 // this file is full of intentional case fall throughs
 //lint -e616
@@ -36,6 +37,10 @@ If you have questions concerning this license or the applicable additional terms
 //lint -e613
 
 static idCVar lcp_showFailures( "lcp_showFailures", "0", CVAR_BOOL, "show LCP solver failures" );
+static idCVar lcp_useAVX2( "lcp_useAVX2", "1", CVAR_BOOL, "use the AVX2/FMA solver kernels if the CPU supports them" );
+
+// set by idLCP::InitProcessor
+static bool lcpHasAVX2 = false;
 
 const float LCP_BOUND_EPSILON			= 1e-5f;
 const float LCP_ACCEL_EPSILON			= 1e-5f;
@@ -1868,14 +1873,388 @@ static void LDLT_Factor_Test()
 }
 #endif
 
-#define Multiply						Multiply_SIMD
-#define MultiplyAdd						MultiplyAdd_SIMD
-#define BigDotProduct					DotProduct_SIMD
-#define LowerTriangularSolve			LowerTriangularSolve_SIMD
-#define LowerTriangularSolveTranspose	LowerTriangularSolveTranspose_SIMD
+/*
+================================================================================================
+
+	Run time selection between the SSE and AVX2 kernels
+
+================================================================================================
+*/
+
+/*
+========================
+LCP_UseAVX2
+========================
+*/
+static ID_INLINE bool LCP_UseAVX2()
+{
+	return lcpHasAVX2 && lcp_useAVX2.GetBool();
+}
+
+/*
+========================
+Multiply_Select
+========================
+*/
+static ID_INLINE void Multiply_Select( float* dst, const float* src0, const float* src1, const int count )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		LCP_Multiply_AVX2( dst, src0, src1, count );
+		return;
+	}
+#endif
+	Multiply_SIMD( dst, src0, src1, count );
+}
+
+/*
+========================
+MultiplyAdd_Select
+========================
+*/
+static ID_INLINE void MultiplyAdd_Select( float* dst, const float constant, const float* src, const int count )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		LCP_MultiplyAdd_AVX2( dst, constant, src, count );
+		return;
+	}
+#endif
+	MultiplyAdd_SIMD( dst, constant, src, count );
+}
+
+/*
+========================
+DotProduct_Select
+========================
+*/
+static ID_INLINE float DotProduct_Select( const float* src0, const float* src1, const int count )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		return LCP_DotProduct_AVX2( src0, src1, count );
+	}
+#endif
+	return DotProduct_SIMD( src0, src1, count );
+}
+
+/*
+========================
+LowerTriangularSolve_Select
+========================
+*/
+static ID_INLINE void LowerTriangularSolve_Select( const idMatX& L, float* x, const float* b, const int n, int skip )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		LCP_LowerTriangularSolve_AVX2( L, x, b, n, skip );
+		return;
+	}
+#endif
+	LowerTriangularSolve_SIMD( L, x, b, n, skip );
+}
+
+/*
+========================
+LowerTriangularSolveTranspose_Select
+========================
+*/
+static ID_INLINE void LowerTriangularSolveTranspose_Select( const idMatX& L, float* x, const float* b, const int n )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		LCP_LowerTriangularSolveTranspose_AVX2( L, x, b, n );
+		return;
+	}
+#endif
+	LowerTriangularSolveTranspose_SIMD( L, x, b, n );
+}
+
+/*
+========================
+LDLT_Factor_Select
+========================
+*/
+static ID_INLINE bool LDLT_Factor_Select( idMatX& mat, idVecX& invDiag, const int n )
+{
+#if defined( LCP_USE_AVX2 )
+	if( LCP_UseAVX2() )
+	{
+		return LCP_LDLT_Factor_AVX2( mat, invDiag, n );
+	}
+#endif
+	return LDLT_Factor_SIMD( mat, invDiag, n );
+}
+
+/*
+================================================================================================
+
+	AVX2 test code
+
+================================================================================================
+*/
+
+#if defined( LCP_USE_AVX2 )
+
+#define TEST_AVX2_EPSILON			1e-3f
+#define TEST_AVX2_NUM_SAMPLES		20
+#define TEST_AVX2_NUM_ITERATIONS	50
+
+// articulated figures range from a single constraint to ragdolls with a few dozen joints
+static const int lcpTestSizes[] = { 6, 12, 18, 24, 36, 48, 64, 80, 96, 120 };
+
+/*
+========================
+MaxRelativeError
+========================
+*/
+static float MaxRelativeError( const float* a, const float* b, const int count )
+{
+	float maxError = 0.0f;
+	for( int i = 0; i < count; i++ )
+	{
+		maxError = Max( maxError, idMath::Fabs( a[i] - b[i] ) / Max( 1.0f, idMath::Fabs( a[i] ) ) );
+	}
+	return maxError;
+}
+
+/*
+========================
+PrintAVX2Result
+========================
+*/
+static void PrintAVX2Result( const char* name, const int n, const double clocksSIMD, const double clocksAVX2, const float maxError )
+{
+	const float speedUp = ( clocksAVX2 > 0.0 ) ? ( float )( clocksSIMD / clocksAVX2 ) : 0.0f;
+	const char* result = ( maxError < TEST_AVX2_EPSILON ) ? "ok" : S_COLOR_RED"X";
+	idLib::Printf( "%-30s %3d: sse %9.0f avx2 %9.0f %5.2fx err %8.2e %s\n", name, n, clocksSIMD, clocksAVX2, speedUp, maxError, result );
+}
+
+/*
+========================
+RandomSymmetricSystem
+
+Builds a well conditioned symmetric positive definite n * n system with 16 byte padded rows.
+========================
+*/
+static void RandomSymmetricSystem( idMatX& m, const int n, const int seed )
+{
+	const int paddedSize = ( n + 3 ) & ~3;
+
+	idMatX src;
+	src.Random( paddedSize, paddedSize, seed, -1.0f, 1.0f );
+	src.TransposeMultiply( m, src );
+	for( int i = 0; i < n; i++ )
+	{
+		m[i][i] += n;
+	}
+}
+
+/*
+========================
+LCP_AVX2_Test
+========================
+*/
+static void LCP_AVX2_Test()
+{
+	idTimer timer;
+
+	const int numSizes = sizeof( lcpTestSizes ) / sizeof( lcpTestSizes[0] );
+	for( int s = 0; s < numSizes; s++ )
+	{
+		const int n = lcpTestSizes[s];
+		const int paddedSize = ( n + 3 ) & ~3;
+
+		idMatX original, mat1, mat2;
+		idVecX invDiag1, invDiag2, b, x1, x2;
+
+		RandomSymmetricSystem( original, n, s );
+		b.Random( paddedSize, s, -1.0f, 1.0f );
+		invDiag1.Zero( paddedSize );
+		invDiag2.Zero( paddedSize );
+		x1.Zero( paddedSize );
+		x2.Zero( paddedSize );
+
+		double clocksSIMD = idMath::INFINITUM;
+		double clocksAVX2 = idMath::INFINITUM;
+		float dot1 = 0.0f;
+		float dot2 = 0.0f;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			timer.Clear();
+			timer.Start();
+			for( int k = 0; k < TEST_AVX2_NUM_ITERATIONS; k++ )
+			{
+				dot1 += DotProduct_SIMD( original[k % n], b.ToFloatPtr(), n );
+			}
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			timer.Clear();
+			timer.Start();
+			for( int k = 0; k < TEST_AVX2_NUM_ITERATIONS; k++ )
+			{
+				dot2 += LCP_DotProduct_AVX2( original[k % n], b.ToFloatPtr(), n );
+			}
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		PrintAVX2Result( "DotProduct", n, clocksSIMD, clocksAVX2, MaxRelativeError( &dot1, &dot2, 1 ) );
+
+		clocksSIMD = idMath::INFINITUM;
+		clocksAVX2 = idMath::INFINITUM;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			x1.Zero( paddedSize );
+			timer.Clear();
+			timer.Start();
+			for( int k = 0; k < TEST_AVX2_NUM_ITERATIONS; k++ )
+			{
+				MultiplyAdd_SIMD( x1.ToFloatPtr(), 0.01f, original[k % n], n );
+			}
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			x2.Zero( paddedSize );
+			timer.Clear();
+			timer.Start();
+			for( int k = 0; k < TEST_AVX2_NUM_ITERATIONS; k++ )
+			{
+				LCP_MultiplyAdd_AVX2( x2.ToFloatPtr(), 0.01f, original[k % n], n );
+			}
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		PrintAVX2Result( "MultiplyAdd", n, clocksSIMD, clocksAVX2, MaxRelativeError( x1.ToFloatPtr(), x2.ToFloatPtr(), n ) );
+
+		clocksSIMD = idMath::INFINITUM;
+		clocksAVX2 = idMath::INFINITUM;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			mat1 = original;
+			timer.Clear();
+			timer.Start();
+			LDLT_Factor_SIMD( mat1, invDiag1, n );
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			mat2 = original;
+			timer.Clear();
+			timer.Start();
+			LCP_LDLT_Factor_AVX2( mat2, invDiag2, n );
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		float maxError = MaxRelativeError( invDiag1.ToFloatPtr(), invDiag2.ToFloatPtr(), n );
+		for( int i = 0; i < n; i++ )
+		{
+			maxError = Max( maxError, MaxRelativeError( mat1[i], mat2[i], i + 1 ) );
+		}
+		PrintAVX2Result( "LDLT_Factor", n, clocksSIMD, clocksAVX2, maxError );
+
+		// both solves use the same factorization so only the solves are compared
+		clocksSIMD = idMath::INFINITUM;
+		clocksAVX2 = idMath::INFINITUM;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			timer.Clear();
+			timer.Start();
+			LowerTriangularSolve_SIMD( mat1, x1.ToFloatPtr(), b.ToFloatPtr(), n, 0 );
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			timer.Clear();
+			timer.Start();
+			LCP_LowerTriangularSolve_AVX2( mat1, x2.ToFloatPtr(), b.ToFloatPtr(), n, 0 );
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		PrintAVX2Result( "LowerTriangularSolve", n, clocksSIMD, clocksAVX2, MaxRelativeError( x1.ToFloatPtr(), x2.ToFloatPtr(), n ) );
+
+		clocksSIMD = idMath::INFINITUM;
+		clocksAVX2 = idMath::INFINITUM;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			timer.Clear();
+			timer.Start();
+			LowerTriangularSolveTranspose_SIMD( mat1, x1.ToFloatPtr(), b.ToFloatPtr(), n );
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			timer.Clear();
+			timer.Start();
+			LCP_LowerTriangularSolveTranspose_AVX2( mat1, x2.ToFloatPtr(), b.ToFloatPtr(), n );
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		PrintAVX2Result( "LowerTriangularSolveTranspose", n, clocksSIMD, clocksAVX2, MaxRelativeError( x1.ToFloatPtr(), x2.ToFloatPtr(), n ) );
+
+		// the complete solver with a mix of unbounded and bounded variables like an articulated figure
+		idVecX lo, hi;
+		lo.SetSize( n );
+		hi.SetSize( n );
+		for( int i = 0; i < n; i++ )
+		{
+			lo[i] = ( i % 6 < 3 ) ? -idMath::INFINITUM : -0.5f;
+			hi[i] = ( i % 6 < 3 ) ? idMath::INFINITUM : 0.5f;
+		}
+		idMatX m;
+		m.SetSize( n, n );
+		for( int i = 0; i < n; i++ )
+		{
+			memcpy( m[i], original[i], n * sizeof( float ) );
+		}
+		idVecX rhs;
+		rhs.SetSize( n );
+		memcpy( rhs.ToFloatPtr(), b.ToFloatPtr(), n * sizeof( float ) );
+		x1.SetSize( n );
+		x2.SetSize( n );
+
+		idLCP* lcp = idLCP::AllocSymmetric();
+		const bool useAVX2 = lcp_useAVX2.GetBool();
+
+		clocksSIMD = idMath::INFINITUM;
+		clocksAVX2 = idMath::INFINITUM;
+		for( int j = 0; j < TEST_AVX2_NUM_SAMPLES; j++ )
+		{
+			lcp_useAVX2.SetBool( false );
+			x1.Zero();
+			timer.Clear();
+			timer.Start();
+			lcp->Solve( m, x1, rhs, lo, hi );
+			timer.Stop();
+			clocksSIMD = Min( clocksSIMD, timer.ClockTicks() );
+
+			lcp_useAVX2.SetBool( true );
+			x2.Zero();
+			timer.Clear();
+			timer.Start();
+			lcp->Solve( m, x2, rhs, lo, hi );
+			timer.Stop();
+			clocksAVX2 = Min( clocksAVX2, timer.ClockTicks() );
+		}
+		PrintAVX2Result( "idLCP_Symmetric::Solve", n, clocksSIMD, clocksAVX2, MaxRelativeError( x1.ToFloatPtr(), x2.ToFloatPtr(), n ) );
+
+		lcp_useAVX2.SetBool( useAVX2 );
+		delete lcp;
+	}
+}
+
+#endif // #if defined( LCP_USE_AVX2 )
+
+#define Multiply						Multiply_Select
+#define MultiplyAdd						MultiplyAdd_Select
+#define BigDotProduct					DotProduct_Select
+#define LowerTriangularSolve			LowerTriangularSolve_Select
+#define LowerTriangularSolveTranspose	LowerTriangularSolveTranspose_Select
 #define UpperTriangularSolve			UpperTriangularSolve_SIMD
 #define LU_Factor						LU_Factor_SIMD
-#define LDLT_Factor						LDLT_Factor_SIMD
+#define LDLT_Factor						LDLT_Factor_Select
 #define GetMaxStep						GetMaxStep_SIMD
 
 /*
@@ -3397,6 +3776,27 @@ idLCP::~idLCP()
 {
 }
 
+/*
+========================
+idLCP::InitProcessor
+
+Picks the AVX2/FMA kernels if the CPU supports them. The SSE kernels are used otherwise and
+when the generic SIMD processor is forced.
+========================
+*/
+void idLCP::InitProcessor( bool forceGeneric )
+{
+#if defined( LCP_USE_AVX2 )
+	const int avx2FMA = CPUID_AVX2 | CPUID_FMA;
+	const bool hasAVX2 = !forceGeneric && ( idLib::sys->GetProcessorId() & avx2FMA ) == avx2FMA;
+	if( hasAVX2 != lcpHasAVX2 )
+	{
+		lcpHasAVX2 = hasAVX2;
+		idLib::common->Printf( "LCP using %s kernels\n", hasAVX2 ? "AVX2/FMA" : "SSE" );
+	}
+#endif
+}
+
 /*
 ========================
 idLCP::SetMaxIterations
@@ -3430,4 +3830,15 @@ void idLCP::Test_f( const idCmdArgs& args )
 	LowerTriangularSolveTranspose_Test();
 	LDLT_Factor_Test();
 #endif
+
+#if defined( LCP_USE_AVX2 )
+	if( !lcpHasAVX2 )
+	{
+		idLib::Printf( "the CPU doesn't support AVX2/FMA, nothing to compare\n" );
+		return;
+	}
+	LCP_AVX2_Test();
+#else
+	idLib::Printf( "the LCP AVX2 kernels are not available in this build\n" );
+#endif
 }
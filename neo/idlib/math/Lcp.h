@@ -71,6 +71,7 @@ public:
 	virtual void	SetMaxIterations( int max );
 	virtual int		GetMaxIterations();
 
+	static void		InitProcessor( bool forceGeneric );	// selects the AVX2/FMA kernels if available
 	static void		Test_f( const idCmdArgs& args );
 
 protected:
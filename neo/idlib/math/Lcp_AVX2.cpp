@@ -0,0 +1,402 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2012 Robert Beckebans
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#include "precompiled.h"
+#pragma hdrstop
+#include "Lcp_AVX2.h"
+
+/*
+================================================================================================
+
+	AVX2/FMA LCP kernels
+
+	Same contracts as the *_SIMD functions in Lcp.cpp. The rows of the matrices are only 16 byte
+	aligned so all loads are unaligned and the ends of the rows are handled with masked loads and
+	stores instead of reading into the padding. The results differ from the SSE versions only by
+	the rounding of the fused multiply-adds.
+
+================================================================================================
+*/
+
+#if defined( LCP_USE_AVX2 )
+
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+	#define LCP_TARGET_AVX2
+#else
+	#define LCP_TARGET_AVX2		__attribute__( ( target( "avx2,fma" ) ) )
+#endif
+
+// a window of 8 into this table enables the first 0 to 8 lanes
+static const int LCP_AVX2_tailMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/*
+========================
+TailMask
+========================
+*/
+LCP_TARGET_AVX2 static ID_INLINE __m256i TailMask( const int count )
+{
+	assert( count >= 0 && count <= 8 );
+	return _mm256_loadu_si256( ( const __m256i* )( LCP_AVX2_tailMask + 8 - count ) );
+}
+
+/*
+========================
+HorizontalSum
+========================
+*/
+LCP_TARGET_AVX2 static ID_INLINE float HorizontalSum( const __m256 v )
+{
+	__m128 s = _mm_add_ps( _mm256_castps256_ps128( v ), _mm256_extractf128_ps( v, 1 ) );
+	s = _mm_add_ps( s, _mm_movehl_ps( s, s ) );
+	s = _mm_add_ss( s, _mm_shuffle_ps( s, s, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	return _mm_cvtss_f32( s );
+}
+
+/*
+========================
+LCP_Multiply_AVX2
+
+dst[i] = src0[i] * src1[i];
+========================
+*/
+LCP_TARGET_AVX2 void LCP_Multiply_AVX2( float* dst, const float* src0, const float* src1, const int count )
+{
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		_mm256_storeu_ps( dst + i, _mm256_mul_ps( _mm256_loadu_ps( src0 + i ), _mm256_loadu_ps( src1 + i ) ) );
+	}
+	if( i < count )
+	{
+		const __m256i mask = TailMask( count - i );
+		_mm256_maskstore_ps( dst + i, mask, _mm256_mul_ps( _mm256_maskload_ps( src0 + i, mask ), _mm256_maskload_ps( src1 + i, mask ) ) );
+	}
+}
+
+/*
+========================
+LCP_MultiplyAdd_AVX2
+
+dst[i] += constant * src[i];
+========================
+*/
+LCP_TARGET_AVX2 void LCP_MultiplyAdd_AVX2( float* dst, const float constant, const float* src, const int count )
+{
+	const __m256 c = _mm256_set1_ps( constant );
+
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		_mm256_storeu_ps( dst + i, _mm256_fmadd_ps( _mm256_loadu_ps( src + i ), c, _mm256_loadu_ps( dst + i ) ) );
+	}
+	if( i < count )
+	{
+		const __m256i mask = TailMask( count - i );
+		_mm256_maskstore_ps( dst + i, mask, _mm256_fmadd_ps( _mm256_maskload_ps( src + i, mask ), c, _mm256_maskload_ps( dst + i, mask ) ) );
+	}
+}
+
+/*
+========================
+LCP_DotProduct_AVX2
+
+dot = src0[0] * src1[0] + src0[1] * src1[1] + src0[2] * src1[2] + ...
+========================
+*/
+LCP_TARGET_AVX2 float LCP_DotProduct_AVX2( const float* src0, const float* src1, const int count )
+{
+	__m256 s0 = _mm256_setzero_ps();
+	__m256 s1 = _mm256_setzero_ps();
+
+	int i = 0;
+	for( ; i + 16 <= count; i += 16 )
+	{
+		s0 = _mm256_fmadd_ps( _mm256_loadu_ps( src0 + i + 0 ), _mm256_loadu_ps( src1 + i + 0 ), s0 );
+		s1 = _mm256_fmadd_ps( _mm256_loadu_ps( src0 + i + 8 ), _mm256_loadu_ps( src1 + i + 8 ), s1 );
+	}
+	if( i + 8 <= count )
+	{
+		s0 = _mm256_fmadd_ps( _mm256_loadu_ps( src0 + i ), _mm256_loadu_ps( src1 + i ), s0 );
+		i += 8;
+	}
+	if( i < count )
+	{
+		const __m256i mask = TailMask( count - i );
+		s1 = _mm256_fmadd_ps( _mm256_maskload_ps( src0 + i, mask ), _mm256_maskload_ps( src1 + i, mask ), s1 );
+	}
+	return HorizontalSum( _mm256_add_ps( s0, s1 ) );
+}
+
+/*
+========================
+LCP_LowerTriangularSolve_AVX2
+
+Solves x in Lx = b for the n * n sub-matrix of L.
+	* if skip > 0 the first skip elements of x are assumed to be valid already
+	* L has to be a lower triangular matrix with (implicit) ones on the diagonal
+	* x == b is allowed
+
+Four rows are solved at a time so every load of x is shared by four rows of L.
+========================
+*/
+LCP_TARGET_AVX2 void LCP_LowerTriangularSolve_AVX2( const idMatX& L, float* x, const float* b, const int n, const int skip )
+{
+	int i = skip;
+
+	for( ; i + 4 <= n; i += 4 )
+	{
+		const float* l0 = L[i + 0];
+		const float* l1 = L[i + 1];
+		const float* l2 = L[i + 2];
+		const float* l3 = L[i + 3];
+
+		__m256 s0 = _mm256_setzero_ps();
+		__m256 s1 = _mm256_setzero_ps();
+		__m256 s2 = _mm256_setzero_ps();
+		__m256 s3 = _mm256_setzero_ps();
+
+		int j = 0;
+		for( ; j + 8 <= i; j += 8 )
+		{
+			const __m256 xj = _mm256_loadu_ps( x + j );
+			s0 = _mm256_fmadd_ps( _mm256_loadu_ps( l0 + j ), xj, s0 );
+			s1 = _mm256_fmadd_ps( _mm256_loadu_ps( l1 + j ), xj, s1 );
+			s2 = _mm256_fmadd_ps( _mm256_loadu_ps( l2 + j ), xj, s2 );
+			s3 = _mm256_fmadd_ps( _mm256_loadu_ps( l3 + j ), xj, s3 );
+		}
+		if( j < i )
+		{
+			const __m256i mask = TailMask( i - j );
+			const __m256 xj = _mm256_maskload_ps( x + j, mask );
+			s0 = _mm256_fmadd_ps( _mm256_maskload_ps( l0 + j, mask ), xj, s0 );
+			s1 = _mm256_fmadd_ps( _mm256_maskload_ps( l1 + j, mask ), xj, s1 );
+			s2 = _mm256_fmadd_ps( _mm256_maskload_ps( l2 + j, mask ), xj, s2 );
+			s3 = _mm256_fmadd_ps( _mm256_maskload_ps( l3 + j, mask ), xj, s3 );
+		}
+
+		// solve the 4x4 triangle on the diagonal
+		const float x0 = b[i + 0] - HorizontalSum( s0 );
+		const float x1 = b[i + 1] - HorizontalSum( s1 ) - l1[i + 0] * x0;
+		const float x2 = b[i + 2] - HorizontalSum( s2 ) - l2[i + 0] * x0 - l2[i + 1] * x1;
+		const float x3 = b[i + 3] - HorizontalSum( s3 ) - l3[i + 0] * x0 - l3[i + 1] * x1 - l3[i + 2] * x2;
+
+		x[i + 0] = x0;
+		x[i + 1] = x1;
+		x[i + 2] = x2;
+		x[i + 3] = x3;
+	}
+
+	// go through any remaining rows
+	for( ; i < n; i++ )
+	{
+		x[i] = b[i] - LCP_DotProduct_AVX2( L[i], x, i );
+	}
+}
+
+/*
+========================
+LCP_LowerTriangularSolveTranspose_AVX2
+
+Solves x in L'x = b for the n * n sub-matrix of L.
+	* L has to be a lower triangular matrix with (implicit) ones on the diagonal
+	* x == b is allowed
+
+Walks up the rows of L and subtracts each solved element from the elements above it, so L is
+read along its rows instead of down its columns.
+========================
+*/
+LCP_TARGET_AVX2 void LCP_LowerTriangularSolveTranspose_AVX2( const idMatX& L, float* x, const float* b, const int n )
+{
+	if( x != b )
+	{
+		memcpy( x, b, n * sizeof( float ) );
+	}
+
+	int i = n;
+
+	// process 4 rows at a time
+	for( ; i >= 4; i -= 4 )
+	{
+		const float* l0 = L[i - 4];
+		const float* l1 = L[i - 3];
+		const float* l2 = L[i - 2];
+		const float* l3 = L[i - 1];
+
+		// solve the 4x4 triangle on the diagonal
+		const float x3 = x[i - 1];
+		const float x2 = x[i - 2] - l3[i - 2] * x3;
+		const float x1 = x[i - 3] - l3[i - 3] * x3 - l2[i - 3] * x2;
+		const float x0 = x[i - 4] - l3[i - 4] * x3 - l2[i - 4] * x2 - l1[i - 4] * x1;
+
+		x[i - 4] = x0;
+		x[i - 3] = x1;
+		x[i - 2] = x2;
+
+		// remove the four solved elements from all elements above them
+		const __m256 v0 = _mm256_set1_ps( x0 );
+		const __m256 v1 = _mm256_set1_ps( x1 );
+		const __m256 v2 = _mm256_set1_ps( x2 );
+		const __m256 v3 = _mm256_set1_ps( x3 );
+
+		const int count = i - 4;
+
+		int j = 0;
+		for( ; j + 8 <= count; j += 8 )
+		{
+			__m256 xj = _mm256_loadu_ps( x + j );
+			xj = _mm256_fnmadd_ps( _mm256_loadu_ps( l0 + j ), v0, xj );
+			xj = _mm256_fnmadd_ps( _mm256_loadu_ps( l1 + j ), v1, xj );
+			xj = _mm256_fnmadd_ps( _mm256_loadu_ps( l2 + j ), v2, xj );
+			xj = _mm256_fnmadd_ps( _mm256_loadu_ps( l3 + j ), v3, xj );
+			_mm256_storeu_ps( x + j, xj );
+		}
+		if( j < count )
+		{
+			const __m256i mask = TailMask( count - j );
+			__m256 xj = _mm256_maskload_ps( x + j, mask );
+			xj = _mm256_fnmadd_ps( _mm256_maskload_ps( l0 + j, mask ), v0, xj );
+			xj = _mm256_fnmadd_ps( _mm256_maskload_ps( l1 + j, mask ), v1, xj );
+			xj = _mm256_fnmadd_ps( _mm256_maskload_ps( l2 + j, mask ), v2, xj );
+			xj = _mm256_fnmadd_ps( _mm256_maskload_ps( l3 + j, mask ), v3, xj );
+			_mm256_maskstore_ps( x + j, mask, xj );
+		}
+	}
+
+	// go through the remaining rows at the top
+	for( ; i > 0; i-- )
+	{
+		const float* lptr = L[i - 1];
+		const float s = x[i - 1];
+		for( int j = 0; j < i - 1; j++ )
+		{
+			x[j] -= lptr[j] * s;
+		}
+	}
+}
+
+/*
+========================
+LCP_LDLT_Factor_AVX2
+
+In-place factorization LDL' of the n * n sub-matrix of mat. The reciprocal of the diagonal
+elements are stored in invDiag.
+========================
+*/
+LCP_TARGET_AVX2 bool LCP_LDLT_Factor_AVX2( idMatX& mat, idVecX& invDiag, const int n )
+{
+	float* v = ( float* ) _alloca16( ( ( n + 7 ) & ~7 ) * sizeof( float ) );
+	float* diag = ( float* ) _alloca16( ( ( n + 7 ) & ~7 ) * sizeof( float ) );
+	float* invDiagPtr = invDiag.ToFloatPtr();
+
+	for( int i = 0; i < n; i++ )
+	{
+		float* mptr = mat[i];
+
+		// v = D * row i of L and the diagonal element of D
+		__m256 t0 = _mm256_setzero_ps();
+
+		int k = 0;
+		for( ; k + 8 <= i; k += 8 )
+		{
+			const __m256 m0 = _mm256_loadu_ps( mptr + k );
+			const __m256 v0 = _mm256_mul_ps( _mm256_loadu_ps( diag + k ), m0 );
+			_mm256_storeu_ps( v + k, v0 );
+			t0 = _mm256_fmadd_ps( m0, v0, t0 );
+		}
+		if( k < i )
+		{
+			const __m256i mask = TailMask( i - k );
+			const __m256 m0 = _mm256_maskload_ps( mptr + k, mask );
+			const __m256 v0 = _mm256_mul_ps( _mm256_maskload_ps( diag + k, mask ), m0 );
+			_mm256_maskstore_ps( v + k, mask, v0 );
+			t0 = _mm256_fmadd_ps( m0, v0, t0 );
+		}
+
+		const float sum = mptr[i] - HorizontalSum( t0 );
+
+		if( fabs( sum ) < idMath::FLT_SMALLEST_NON_DENORMAL )
+		{
+			return false;
+		}
+
+		const float d = 1.0f / sum;
+		mptr[i] = sum;
+		diag[i] = sum;
+		invDiagPtr[i] = d;
+
+		// column i of L for the rows below, four rows at a time
+		int j = i + 1;
+		for( ; j + 4 <= n; j += 4 )
+		{
+			float* ra = mat[j + 0];
+			float* rb = mat[j + 1];
+			float* rc = mat[j + 2];
+			float* rd = mat[j + 3];
+
+			__m256 sa = _mm256_setzero_ps();
+			__m256 sb = _mm256_setzero_ps();
+			__m256 sc = _mm256_setzero_ps();
+			__m256 sd = _mm256_setzero_ps();
+
+			k = 0;
+			for( ; k + 8 <= i; k += 8 )
+			{
+				const __m256 v0 = _mm256_loadu_ps( v + k );
+				sa = _mm256_fmadd_ps( _mm256_loadu_ps( ra + k ), v0, sa );
+				sb = _mm256_fmadd_ps( _mm256_loadu_ps( rb + k ), v0, sb );
+				sc = _mm256_fmadd_ps( _mm256_loadu_ps( rc + k ), v0, sc );
+				sd = _mm256_fmadd_ps( _mm256_loadu_ps( rd + k ), v0, sd );
+			}
+			if( k < i )
+			{
+				const __m256i mask = TailMask( i - k );
+				const __m256 v0 = _mm256_maskload_ps( v + k, mask );
+				sa = _mm256_fmadd_ps( _mm256_maskload_ps( ra + k, mask ), v0, sa );
+				sb = _mm256_fmadd_ps( _mm256_maskload_ps( rb + k, mask ), v0, sb );
+				sc = _mm256_fmadd_ps( _mm256_maskload_ps( rc + k, mask ), v0, sc );
+				sd = _mm256_fmadd_ps( _mm256_maskload_ps( rd + k, mask ), v0, sd );
+			}
+
+			ra[i] = ( ra[i] - HorizontalSum( sa ) ) * d;
+			rb[i] = ( rb[i] - HorizontalSum( sb ) ) * d;
+			rc[i] = ( rc[i] - HorizontalSum( sc ) ) * d;
+			rd[i] = ( rd[i] - HorizontalSum( sd ) ) * d;
+		}
+		for( ; j < n; j++ )
+		{
+			float* rptr = mat[j];
+			rptr[i] = ( rptr[i] - LCP_DotProduct_AVX2( rptr, v, i ) ) * d;
+		}
+	}
+	return true;
+}
+
+#endif // #if defined( LCP_USE_AVX2 )
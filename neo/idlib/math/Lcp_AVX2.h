@@ -0,0 +1,59 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2012 Robert Beckebans
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __MATH_LCP_AVX2_H__
+#define __MATH_LCP_AVX2_H__
+
+/*
+===============================================================================
+
+	AVX2/FMA versions of the LCP solver kernels.
+
+	These are compiled for AVX2 regardless of the global compiler flags. idLCP only calls them
+	after idSIMD::InitProcessor found a CPU that supports both AVX2 and FMA.
+
+===============================================================================
+*/
+
+#if defined( USE_INTRINSICS_SSE ) && ( defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) )
+	#define LCP_USE_AVX2
+#endif
+
+#if defined( LCP_USE_AVX2 )
+
+void	LCP_Multiply_AVX2( float* dst, const float* src0, const float* src1, const int count );
+void	LCP_MultiplyAdd_AVX2( float* dst, const float constant, const float* src, const int count );
+float	LCP_DotProduct_AVX2( const float* src0, const float* src1, const int count );
+void	LCP_LowerTriangularSolve_AVX2( const idMatX& L, float* x, const float* b, const int n, const int skip );
+void	LCP_LowerTriangularSolveTranspose_AVX2( const idMatX& L, float* x, const float* b, const int n );
+bool	LCP_LDLT_Factor_AVX2( idMatX& mat, idVecX& invDiag, const int n );
+
+#endif
+
+#endif /* !__MATH_LCP_AVX2_H__ */
@@ -36,11 +36,8 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 
-float	idMatX::temp[MATX_MAX_TEMP + 4];
-// RB: changed int to intptr_t
-float* 	idMatX::tempPtr = ( float* )( ( ( intptr_t ) idMatX::temp + 15 ) & ~15 );
-// RB end
-int		idMatX::tempIndex = 0;
+ALIGN16( ID_THREAD_LOCAL float idMatX::tempPtr[MATX_MAX_TEMP] );
+ID_THREAD_LOCAL int idMatX::tempIndex = 0;
 
 
 /*
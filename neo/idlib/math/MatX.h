@@ -261,9 +261,9 @@ private:
 	int				alloced;				// floats allocated, if -1 then mat points to data set with SetData
 	float* 			mat;					// memory the matrix is stored
 
-	static float	temp[MATX_MAX_TEMP + 4];	// used to store intermediate results
-	static float* 	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	// every thread has its own memory pool so intermediate results can be used on the job threads
+	ALIGN16( static ID_THREAD_LOCAL float tempPtr[MATX_MAX_TEMP] );	// 16 byte aligned memory to store intermediate results
+	static ID_THREAD_LOCAL int tempIndex;	// index into memory pool, wraps around
 
 private:
 	void			SetTempSize( int rows, int columns );
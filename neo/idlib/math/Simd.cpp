@@ -99,6 +99,8 @@ void idSIMD::InitProcessor( const char* module, bool forceGeneric )
 		idLib::common->Printf( "%s using %s for SIMD processing\n", module, SIMDProcessor->GetName() );
 	}
 
+	idLCP::InitProcessor( forceGeneric );
+
 	if( cpuid & CPUID_FTZ )
 	{
 		idLib::sys->FPU_SetFTZ( true );
@@ -36,11 +36,8 @@ If you have questions concerning this license or the applicable additional terms
 //
 //===============================================================
 
-float	idVecX::temp[VECX_MAX_TEMP + 4];
-// RB: changed int to intptr_t
-float* 	idVecX::tempPtr = ( float* )( ( ( intptr_t ) idVecX::temp + 15 ) & ~15 );
-// RB end
-int		idVecX::tempIndex = 0;
+ALIGN16( ID_THREAD_LOCAL float idVecX::tempPtr[VECX_MAX_TEMP] );
+ID_THREAD_LOCAL int idVecX::tempIndex = 0;
 
 /*
 =============
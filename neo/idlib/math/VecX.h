@@ -121,9 +121,9 @@ private:
 	int				alloced;				// if -1 p points to data set with SetData
 	float* 			p;						// memory the vector is stored
 
-	static float	temp[VECX_MAX_TEMP + 4];	// used to store intermediate results
-	static float* 	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	// every thread has its own memory pool so intermediate results can be used on the job threads
+	ALIGN16( static ID_THREAD_LOCAL float tempPtr[VECX_MAX_TEMP] );	// 16 byte aligned memory to store intermediate results
+	static ID_THREAD_LOCAL int tempIndex;	// index into memory pool, wraps around
 
 	ID_INLINE void	SetTempSize( int size );
 };
@@ -190,6 +190,13 @@ Defines and macros usable in all code
 #define _alloca128( x )					((void *)ALIGN( (uintptr_t)_alloca( ALIGN( x, 128 ) + 128 ), 128 ) )
 // RB end
 
+// thread local storage for plain data with a constant initializer, ID_TLS can only hold a pointer or an integer
+#ifdef _MSC_VER
+	#define ID_THREAD_LOCAL					__declspec( thread )
+#else
+	#define ID_THREAD_LOCAL					__thread
+#endif
+
 #define likely( x )	( x )
 #define unlikely( x )	( x )
 
@@ -98,6 +98,7 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 	int	scaledWidth = width;
 	int scaledHeight = height;
 	images.SetNum( numLevels );
+	idDxtEncoder dxt;
 	for( int level = 0; level < images.Num(); level++ )
 	{
 		idBinaryImageData& img = images[ level ];
@@ -137,24 +138,22 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 		// compress data or convert floats as necessary
 		if( textureFormat == FMT_DXT1 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight / 2 );
 			if( image_highQualityCompression.GetBool() )
 			{
 				commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT1HQ", width, height ) );
 
-				dxt.CompressImageDXT1HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT1HQ, 8, dxtPic, img.data, dxtWidth, dxtHeight );
 			}
 			else
 			{
 				commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT1Fast", width, height ) );
 
-				dxt.CompressImageDXT1Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT1Fast, 8, dxtPic, img.data, dxtWidth, dxtHeight );
 			}
 		}
 		else if( textureFormat == FMT_DXT5 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight );
 			if( colorFormat == CFM_NORMAL_DXT5 )
 			{
@@ -162,13 +161,13 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - NormalMapDXT5HQ", width, height ) );
 
-					dxt.CompressNormalMapDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressNormalMapDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - NormalMapDXT5Fast", width, height ) );
 
-					dxt.CompressNormalMapDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressNormalMapDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 			else if( colorFormat == CFM_YCOCG_DXT5 )
@@ -177,13 +176,13 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - YCoCgDXT5HQ", width, height ) );
 
-					dxt.CompressYCoCgDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressYCoCgDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - YCoCgDXT5Fast", width, height ) );
 
-					dxt.CompressYCoCgDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressYCoCgDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 			else
@@ -193,13 +192,13 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT5HQ", width, height ) );
 
-					dxt.CompressImageDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT5Fast", width, height ) );
 
-					dxt.CompressImageDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 		}
@@ -360,6 +359,7 @@ void idBinaryImage::Load2DAtlasMipchainFromMemory( int width, int height, const
 	const int numColors = 5;
 	static idVec4 colors[numColors] = { colorBlue, colorCyan, colorGreen, colorYellow, colorRed };
 
+	idDxtEncoder dxt;
 	for( int level = 0; level < images.Num(); level++ )
 	{
 		idBinaryImageData& img = images[ level ];
@@ -449,24 +449,22 @@ void idBinaryImage::Load2DAtlasMipchainFromMemory( int width, int height, const
 		// compress data or convert floats as necessary
 		if( textureFormat == FMT_DXT1 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight / 2 );
 			if( image_highQualityCompression.GetBool() )
 			{
 				commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT1HQ", width, height ) );
 
-				dxt.CompressImageDXT1HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT1HQ, 8, dxtPic, img.data, dxtWidth, dxtHeight );
 			}
 			else
 			{
 				commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT1Fast", width, height ) );
 
-				dxt.CompressImageDXT1Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT1Fast, 8, dxtPic, img.data, dxtWidth, dxtHeight );
 			}
 		}
 		else if( textureFormat == FMT_DXT5 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight );
 			if( colorFormat == CFM_NORMAL_DXT5 )
 			{
@@ -474,13 +472,13 @@ void idBinaryImage::Load2DAtlasMipchainFromMemory( int width, int height, const
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - NormalMapDXT5HQ", width, height ) );
 
-					dxt.CompressNormalMapDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressNormalMapDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - NormalMapDXT5Fast", width, height ) );
 
-					dxt.CompressNormalMapDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressNormalMapDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 			else if( colorFormat == CFM_YCOCG_DXT5 )
@@ -489,13 +487,13 @@ void idBinaryImage::Load2DAtlasMipchainFromMemory( int width, int height, const
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - YCoCgDXT5HQ", width, height ) );
 
-					dxt.CompressYCoCgDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressYCoCgDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - YCoCgDXT5Fast", width, height ) );
 
-					dxt.CompressYCoCgDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressYCoCgDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 			else
@@ -505,13 +503,13 @@ void idBinaryImage::Load2DAtlasMipchainFromMemory( int width, int height, const
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT5HQ", width, height ) );
 
-					dxt.CompressImageDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT5HQ, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 				else
 				{
 					commonLocal.LoadPacifierBinarizeInfo( va( "(%d x %d) - DXT5Fast", width, height ) );
 
-					dxt.CompressImageDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
+					dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT5Fast, 16, dxtPic, img.data, dxtWidth, dxtHeight );
 				}
 			}
 		}
@@ -663,6 +661,7 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 
 	images.SetNum( fileData.numLevels * 6 );
 
+	idDxtEncoder dxt;
 	for( int side = 0; side < 6; side++ )
 	{
 		const byte* orig = pics[side];
@@ -699,14 +698,12 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 			if( textureFormat == FMT_DXT1 )
 			{
 				img.Alloc( padSize * padSize / 2 );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT1Fast( padSrc, img.data, padSize, padSize );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT1Fast, 8, padSrc, img.data, padSize, padSize );
 			}
 			else if( textureFormat == FMT_DXT5 )
 			{
 				img.Alloc( padSize * padSize );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT5Fast( padSrc, img.data, padSize, padSize );
+				dxt.CompressImageParallel( &idDxtEncoder::CompressImageDXT5Fast, 16, padSrc, img.data, padSize, padSize );
 			}
 			else
 			{
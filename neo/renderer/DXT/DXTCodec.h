@@ -58,8 +58,13 @@ public:
 	idDxtEncoder()
 	{
 		srcPadding = dstPadding = 0;
+		progressCounter = NULL;
+		useAVX2 = AVX2Available();
+		jobList = NULL;
 	}
-	~idDxtEncoder() {}
+	~idDxtEncoder();
+
+	typedef void ( idDxtEncoder::*compressFunction_t )( const byte* inBuf, byte* outBuf, int width, int height );
 
 	void	SetSrcPadding( int pad )
 	{
@@ -70,6 +75,22 @@ public:
 		dstPadding = pad;
 	}
 
+	// Progress is added to this counter instead of going to the binarize pacifier, which may only
+	// be updated from the main thread.
+	void	SetProgressCounter( idSysInterlockedInteger* counter )
+	{
+		progressCounter = counter;
+	}
+
+	// Splits the image into strips of block rows and runs compress on them on the job threads,
+	// each strip with its own encoder. blockSize is the number of output bytes per 4x4 block.
+	// Falls back to a single call for small images or when not called from the main thread.
+	// The job list is kept by the encoder, so use one encoder for all mip levels of an image.
+	void	CompressImageParallel( compressFunction_t compress, int blockSize, const byte* inBuf, byte* outBuf, int width, int height );
+
+	// true if the AVX2 versions of the high quality search kernels can be used
+	static bool	AVX2Available();
+
 	// high quality DXT1 compression (no alpha), uses exhaustive search to find a line through color space and is very slow
 	void	CompressImageDXT1HQ( const byte* inBuf, byte* outBuf, int width, int height );
 
@@ -210,6 +231,11 @@ private:
 	byte* 				outData;
 	int					srcPadding;
 	int					dstPadding;
+	idSysInterlockedInteger* progressCounter;
+	bool				useAVX2;
+	idParallelJobList* 	jobList;			// allocated by the first CompressImageParallel that runs jobs
+
+	void				ProgressIncrement( int count );
 
 	void				EmitByte( byte b );
 	void				EmitUShort( unsigned short s );
@@ -238,6 +264,7 @@ private:
 	int					GetSquareAlphaError( const byte* colorBlock, const int alphaOffset, const byte minAlpha, const byte maxAlpha, int lastError ) const;
 	int					GetMinMaxAlphaHQ( const byte* colorBlock, const int alphaOffset, byte* minColor, byte* maxColor ) const;
 	int					GetSquareColorsError( const byte* colorBlock, const unsigned short color0, const unsigned short color1, int lastError ) const;
+	int					GetSquareColorsError_AVX2( const byte* colorBlock, const unsigned short color0, const unsigned short color1, int lastError ) const;
 	int					GetMinMaxColorsHQ( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack ) const;
 	int					GetSquareCTX1Error( const byte* colorBlock, const byte* color0, const byte* color1, int lastError ) const;
 	int					GetMinMaxCTX1HQ( const byte* colorBlock, byte* minColor, byte* maxColor ) const;
@@ -246,6 +273,7 @@ private:
 	int					GetSquareNormalsDXT1Error( const int* colorBlock, const unsigned short color0, const unsigned short color1, int lastError, unsigned int& colorIndices ) const;
 	int					GetMinMaxNormalsDXT1HQ( const byte* colorBlock, byte* minColor, byte* maxColor, unsigned int& colorIndices, bool noBlack ) const;
 	int					GetSquareNormalsDXT5Error( const int* normalBlock, const byte* minNormal, const byte* maxNormal, int lastError, unsigned int& colorIndices, byte* alphaIndices ) const;
+	int					GetSquareNormalsDXT5Error_AVX2( const int* normalBlock, const byte* minNormal, const byte* maxNormal, int lastError, unsigned int& colorIndices, byte* alphaIndices ) const;
 	int					GetMinMaxNormalsDXT5HQ( const byte* normalBlock, byte* minColor, byte* maxColor, unsigned int& colorIndices, byte* alphaIndices ) const;
 	int					GetMinMaxNormalsDXT5HQFast( const byte* normalBlock, byte* minColor, byte* maxColor, unsigned int& colorIndices, byte* alphaIndices ) const;
 	void				ScaleYCoCg( byte* colorBlock ) const;
@@ -35,4 +35,23 @@ Contains the DxtEncoder and DxtDecoder declarations.
 */
 #include "precompiled.h"
 
+// components of a DXT5 normal map block that hold the normal
+#if 0	// object-space
+	#define NORMAL_DXT5_C0		0
+	#define NORMAL_DXT5_C1		1
+	#define NORMAL_DXT5_C2		3
+#else
+	#define NORMAL_DXT5_C0		1
+	#define NORMAL_DXT5_C1		2
+	#define NORMAL_DXT5_C2		3
+#endif
+
+void NormalizeDXT5( const int* vector, int* intNormal );
+
+// The AVX2 search kernels are compiled for any x86 target and picked at run time. Not on 32 bit
+// MSVC where NormalDistanceDXT5 uses an inline assembly approximation the kernels don't match.
+#if defined( USE_INTRINSICS_SSE ) && ( defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) ) && !( defined( _MSC_VER ) && defined( _M_IX86 ) )
+	#define DXT_USE_AVX2
+#endif
+
 #endif // !__DXTCODEC_LOCAL_H__
@@ -34,6 +34,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "DXTCodec_local.h"
 #include "DXTCodec.h"
 
+idCVar image_parallelCompression( "image_parallelCompression", "1", CVAR_RENDERER | CVAR_BOOL, "split DXT compression of large images across the job threads" );
+
 #define INSET_COLOR_SHIFT		4		// inset the bounding box with ( range >> shift )
 #define INSET_ALPHA_SHIFT		5		// inset alpha channel
 
@@ -580,6 +582,13 @@ return: 4 byte color index block
 */
 int idDxtEncoder::GetSquareColorsError( const byte* colorBlock, const unsigned short color0, const unsigned short color1, int lastError ) const
 {
+#if defined( DXT_USE_AVX2 )
+	if( useAVX2 )
+	{
+		return GetSquareColorsError_AVX2( colorBlock, color0, color1, lastError );
+	}
+#endif
+
 	int i, j;
 	byte colors[4][4];
 
@@ -1193,6 +1202,32 @@ int NormalDistanceDXT1( const int* vector, const int* normalized )
 #endif
 }
 
+/*
+========================
+NormalizeDXT5
+
+Renormalizes the NORMAL_DXT5_C0/C1/C2 components of a DXT5 normal map palette entry,
+the other component of intNormal is left untouched.
+========================
+*/
+void NormalizeDXT5( const int* vector, int* intNormal )
+{
+	const int c0 = NORMAL_DXT5_C0;
+	const int c1 = NORMAL_DXT5_C1;
+	const int c2 = NORMAL_DXT5_C2;
+	float floatNormal[3];
+	floatNormal[0] = vector[c0] / 255.0f * 2.0f - 1.0f;
+	floatNormal[1] = vector[c1] / 255.0f * 2.0f - 1.0f;
+	floatNormal[2] = vector[c2] / 255.0f * 2.0f - 1.0f;
+	float rcplen = idMath::InvSqrt( floatNormal[0] * floatNormal[0] + floatNormal[1] * floatNormal[1] + floatNormal[2] * floatNormal[2] );
+	floatNormal[0] *= rcplen;
+	floatNormal[1] *= rcplen;
+	floatNormal[2] *= rcplen;
+	intNormal[c0] = idMath::Ftob( ( floatNormal[0] + 1.0f ) / 2.0f * 255.0f + 0.5f );
+	intNormal[c1] = idMath::Ftob( ( floatNormal[1] + 1.0f ) / 2.0f * 255.0f + 0.5f );
+	intNormal[c2] = idMath::Ftob( ( floatNormal[2] + 1.0f ) / 2.0f * 255.0f + 0.5f );
+}
+
 /*
 ========================
 NormalDistanceDXT5
@@ -1252,27 +1287,11 @@ int NormalDistanceDXT5( const int* vector, const int* normalized )
 	}
 	return result;
 #else
-#if 0	// object-space
-	const int c0 = 0;
-	const int c1 = 1;
-	const int c2 = 3;
-#else
-	const int c0 = 1;
-	const int c1 = 2;
-	const int c2 = 3;
-#endif
-	float floatNormal[3];
-	byte intNormal[4];
-	floatNormal[0] = vector[c0] / 255.0f * 2.0f - 1.0f;
-	floatNormal[1] = vector[c1] / 255.0f * 2.0f - 1.0f;
-	floatNormal[2] = vector[c2] / 255.0f * 2.0f - 1.0f;
-	float rcplen = idMath::InvSqrt( floatNormal[0] * floatNormal[0] + floatNormal[1] * floatNormal[1] + floatNormal[2] * floatNormal[2] );
-	floatNormal[0] *= rcplen;
-	floatNormal[1] *= rcplen;
-	floatNormal[2] *= rcplen;
-	intNormal[c0] = idMath::Ftob( ( floatNormal[0] + 1.0f ) / 2.0f * 255.0f + 0.5f );
-	intNormal[c1] = idMath::Ftob( ( floatNormal[1] + 1.0f ) / 2.0f * 255.0f + 0.5f );
-	intNormal[c2] = idMath::Ftob( ( floatNormal[2] + 1.0f ) / 2.0f * 255.0f + 0.5f );
+	const int c0 = NORMAL_DXT5_C0;
+	const int c1 = NORMAL_DXT5_C1;
+	const int c2 = NORMAL_DXT5_C2;
+	int intNormal[4];
+	NormalizeDXT5( vector, intNormal );
 	int result =	( ( intNormal[ c0 ] - normalized[ c0 ] ) * ( intNormal[ c0 ] - normalized[ c0 ] ) ) +
 					( ( intNormal[ c1 ] - normalized[ c1 ] ) * ( intNormal[ c1 ] - normalized[ c1 ] ) ) +
 					( ( intNormal[ c2 ] - normalized[ c2 ] ) * ( intNormal[ c2 ] - normalized[ c2 ] ) );
@@ -1522,6 +1541,13 @@ paramO:	maxNormal	- Max normal found
 */
 int idDxtEncoder::GetSquareNormalsDXT5Error( const int* normalBlock, const byte* minNormal, const byte* maxNormal, int lastError, unsigned int& colorIndices, byte* alphaIndices ) const
 {
+#if defined( DXT_USE_AVX2 )
+	if( useAVX2 )
+	{
+		return GetSquareNormalsDXT5Error_AVX2( normalBlock, minNormal, maxNormal, lastError, colorIndices, alphaIndices );
+	}
+#endif
+
 	byte alphas[8];
 	byte colors[4][4];
 
@@ -2168,6 +2194,145 @@ int idDxtEncoder::FindCTX1Indices( const byte* colorBlock, const byte* color0, c
 	return error;
 }
 
+/*
+========================
+idDxtEncoder::ProgressIncrement
+========================
+*/
+void idDxtEncoder::ProgressIncrement( int count )
+{
+	if( progressCounter != NULL )
+	{
+		progressCounter->Add( count );
+	}
+	else
+	{
+		commonLocal.LoadPacifierBinarizeProgressIncrement( count );
+	}
+}
+
+/*
+========================
+idDxtEncoder::~idDxtEncoder
+========================
+*/
+idDxtEncoder::~idDxtEncoder()
+{
+	if( jobList != NULL )
+	{
+		parallelJobManager->FreeJobList( jobList );
+	}
+}
+
+/*
+========================
+CompressStripJob
+========================
+*/
+struct dxtStripJob_t
+{
+	idDxtEncoder::compressFunction_t	compress;
+	const byte* 						inBuf;
+	byte* 								outBuf;
+	int									width;
+	int									height;
+	int									srcPadding;
+	int									dstPadding;
+	idSysInterlockedInteger* 			progress;
+};
+
+static void CompressStripJob( dxtStripJob_t* job )
+{
+	idDxtEncoder encoder;
+	encoder.SetSrcPadding( job->srcPadding );
+	encoder.SetDstPadding( job->dstPadding );
+	encoder.SetProgressCounter( job->progress );
+	( encoder.*job->compress )( job->inBuf, job->outBuf, job->width, job->height );
+}
+
+REGISTER_PARALLEL_JOB( CompressStripJob, "CompressStripJob" );
+
+/*
+========================
+idDxtEncoder::CompressImageParallel
+
+All block based encoders compress each 4x4 block independently of the others, so an image can
+be split at any block row without changing the output.
+
+params:	compress	- encoder function to run on each strip
+params:	blockSize	- bytes per compressed 4x4 block
+params:	inBuf		- image to compress
+paramO:	outBuf		- result of compression
+params:	width		- width of image
+params:	height		- height of image
+========================
+*/
+void idDxtEncoder::CompressImageParallel( compressFunction_t compress, int blockSize, const byte* inBuf, byte* outBuf, int width, int height )
+{
+	const int MIN_STRIP_BLOCKS = 256;	// don't bother with jobs for less work than this per strip
+	const int MAX_STRIPS = 64;
+
+	const int numProcessingUnits = parallelJobManager->GetNumProcessingUnits();
+	const int blockRows = height >> 2;
+	const int blocksPerRow = width >> 2;
+
+	int numStrips = Min( blockRows, Min( numProcessingUnits * 4, MAX_STRIPS ) );
+	numStrips = Min( numStrips, ( blockRows * blocksPerRow ) / MIN_STRIP_BLOCKS );
+
+	if( !image_parallelCompression.GetBool() || numStrips <= 1 || width < 4 || ( width & 3 ) != 0 || ( height & 3 ) != 0 || !idLib::IsMainThread() )
+	{
+		( this->*compress )( inBuf, outBuf, width, height );
+		return;
+	}
+
+	const int inRowSize = width * 4 * 4 + srcPadding;
+	const int outRowSize = blocksPerRow * blockSize + dstPadding;
+	const int rowsPerStrip = ( blockRows + numStrips - 1 ) / numStrips;
+
+	idSysInterlockedInteger progress;
+	dxtStripJob_t jobs[MAX_STRIPS];
+
+	if( jobList == NULL )
+	{
+		jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_STRIPS, 0, NULL );
+	}
+
+	int numJobs = 0;
+	for( int row = 0; row < blockRows; row += rowsPerStrip )
+	{
+		dxtStripJob_t& job = jobs[numJobs++];
+		job.compress = compress;
+		job.inBuf = inBuf + row * inRowSize;
+		job.outBuf = outBuf + row * outRowSize;
+		job.width = width;
+		job.height = Min( rowsPerStrip, blockRows - row ) * 4;
+		job.srcPadding = srcPadding;
+		job.dstPadding = dstPadding;
+		job.progress = &progress;
+		jobList->AddJob( ( jobRun_t )CompressStripJob, &job );
+	}
+
+	jobList->Submit();
+
+	// forward the progress of the jobs to the pacifier while waiting
+	int reported = 0;
+	for( ;; )
+	{
+		const bool done = jobList->TryWait();
+		const int current = progress.GetValue();
+		if( current > reported )
+		{
+			ProgressIncrement( current - reported );
+			reported = current;
+		}
+		if( done )
+		{
+			break;
+		}
+		Sys_Yield();
+	}
+}
+
 /*
 ========================
 idDxtEncoder::CompressImageDXT1HQ
@@ -2211,7 +2376,7 @@ void idDxtEncoder::CompressImageDXT1HQ( const byte* inBuf, byte* outBuf, int wid
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -2293,7 +2458,7 @@ void idDxtEncoder::CompressImageDXT5HQ( const byte* inBuf, byte* outBuf, int wid
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -2393,7 +2558,7 @@ void idDxtEncoder::CompressImageCTX1HQ( const byte* inBuf, byte* outBuf, int wid
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -2887,7 +3052,7 @@ void idDxtEncoder::CompressYCoCgDXT5HQ( const byte* inBuf, byte* outBuf, int wid
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 			ScaleYCoCg( block );
@@ -2994,7 +3159,7 @@ void idDxtEncoder::CompressYCoCgCTX1DXT5AHQ( const byte* inBuf, byte* outBuf, in
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -3143,7 +3308,7 @@ void idDxtEncoder::CompressNormalMapDXT1HQ( const byte* inBuf, byte* outBuf, int
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -3213,7 +3378,7 @@ void idDxtEncoder::CompressNormalMapDXT1RenormalizeHQ( const byte* inBuf, byte*
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -3476,7 +3641,7 @@ void idDxtEncoder::CompressNormalMapDXT5HQ( const byte* inBuf, byte* outBuf, int
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -3588,7 +3753,7 @@ void idDxtEncoder::CompressNormalMapDXT5RenormalizeHQ( const byte* inBuf, byte*
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -3675,7 +3840,7 @@ void idDxtEncoder::CompressNormalMapDXN2HQ( const byte* inBuf, byte* outBuf, int
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -4437,7 +4602,7 @@ void idDxtEncoder::CompressImageDXT1Fast_Generic( const byte* inBuf, byte* outBu
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -4482,7 +4647,7 @@ void idDxtEncoder::CompressImageDXT1AlphaFast_Generic( const byte* inBuf, byte*
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -4536,7 +4701,7 @@ void idDxtEncoder::CompressImageDXT5Fast_Generic( const byte* inBuf, byte* outBu
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -4887,7 +5052,7 @@ void idDxtEncoder::CompressYCoCgDXT5Fast_Generic( const byte* inBuf, byte* outBu
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -4942,7 +5107,7 @@ void idDxtEncoder::CompressYCoCgAlphaDXT5Fast( const byte* inBuf, byte* outBuf,
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -5010,7 +5175,7 @@ void idDxtEncoder::CompressYCoCgCTX1DXT5AFast_Generic( const byte* inBuf, byte*
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -5204,7 +5369,7 @@ void idDxtEncoder::CompressNormalMapDXT5Fast_Generic( const byte* inBuf, byte* o
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -5253,7 +5418,7 @@ void idDxtEncoder::CompressImageDXN1Fast_Generic( const byte* inBuf, byte* outBu
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -5297,7 +5462,7 @@ void idDxtEncoder::CompressNormalMapDXN2Fast_Generic( const byte* inBuf, byte* o
 	{
 		for( int i = 0; i < width; i += 4 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			ExtractBlock( inBuf + i * 4, width, block );
 
@@ -5460,7 +5625,7 @@ void idDxtEncoder::ConvertNormalMapDXN2_DXT5( const byte* inBuf, byte* outBuf, i
 	{
 		for( int i = 0; i < width; i += 4, inBuf += 16, outBuf += 16 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			// decode normal Y stored as a DXT5 alpha channel
 			DecodeDXNAlphaValues( inBuf + 0, values );
@@ -5612,7 +5777,7 @@ void idDxtEncoder::ConvertNormalMapDXT5_DXN2( const byte* inBuf, byte* outBuf, i
 	{
 		for( int i = 0; i < width; i += 4, inBuf += 16, outBuf += 16 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			// decode normal Y stored as a DXT5 alpha channel
 			DecodeNormalYValues( inBuf + 8, minNormalY, maxNormalY, values );
@@ -5664,7 +5829,7 @@ void idDxtEncoder::ConvertImageDXN1_DXT1( const byte* inBuf, byte* outBuf, int w
 	{
 		for( int i = 0; i < width; i += 4, inBuf += 8, outBuf += 8 )
 		{
-			commonLocal.LoadPacifierBinarizeProgressIncrement( 16 );
+			ProgressIncrement( 16 );
 
 			// decode single channel stored as a DXT5 alpha channel
 			DecodeDXNAlphaValues( inBuf + 0, values );
@@ -5693,3 +5858,96 @@ void idDxtEncoder::ConvertImageDXN1_DXT1( const byte* inBuf, byte* outBuf, int w
 		inBuf += srcPadding;
 	}
 }
+
+/*
+========================
+testDXTEncoder
+========================
+*/
+struct dxtBenchmarkFormat_t
+{
+	const char* 						name;
+	idDxtEncoder::compressFunction_t	compress;
+	int									blockSize;
+	bool								highQuality;
+};
+
+static const dxtBenchmarkFormat_t dxtBenchmarkFormats[] =
+{
+	{ "DXT1Fast",			&idDxtEncoder::CompressImageDXT1Fast,		8,	false },
+	{ "DXT5Fast",			&idDxtEncoder::CompressImageDXT5Fast,		16,	false },
+	{ "YCoCgDXT5Fast",		&idDxtEncoder::CompressYCoCgDXT5Fast,		16,	false },
+	{ "NormalMapDXT5Fast",	&idDxtEncoder::CompressNormalMapDXT5Fast,	16,	false },
+	{ "DXT1HQ",				&idDxtEncoder::CompressImageDXT1HQ,			8,	true },
+	{ "DXT5HQ",				&idDxtEncoder::CompressImageDXT5HQ,			16,	true },
+	{ "YCoCgDXT5HQ",		&idDxtEncoder::CompressYCoCgDXT5HQ,			16,	true },
+	{ "NormalMapDXT5HQ",	&idDxtEncoder::CompressNormalMapDXT5HQ,		16,	true },
+};
+
+extern idCVar image_dxtAVX2;
+
+CONSOLE_COMMAND( testDXTEncoder, "measures DXT compression throughput per format, single threaded, with AVX2 kernels and on the job threads, usage: testDXTEncoder [size]", 0 )
+{
+	int size = 1024;
+	if( args.Argc() > 1 )
+	{
+		size = Max( ( atoi( args.Argv( 1 ) ) + 3 ) & ~3, 16 );
+	}
+
+	// a smooth gradient with some noise, so the high quality searches get realistic color ranges
+	idTempArray<byte> image( size * size * 4 );
+	idRandom random( 0 );
+	for( int y = 0; y < size; y++ )
+	{
+		for( int x = 0; x < size; x++ )
+		{
+			byte* pixel = image.Ptr() + ( y * size + x ) * 4;
+			pixel[0] = ( byte )idMath::ClampInt( 0, 255, x * 255 / size + random.RandomInt( 16 ) - 8 );
+			pixel[1] = ( byte )idMath::ClampInt( 0, 255, y * 255 / size + random.RandomInt( 16 ) - 8 );
+			pixel[2] = ( byte )idMath::ClampInt( 0, 255, ( x + y ) * 127 / size + random.RandomInt( 16 ) - 8 );
+			pixel[3] = ( byte )idMath::ClampInt( 0, 255, 255 - x * 255 / size + random.RandomInt( 16 ) - 8 );
+		}
+	}
+
+	static const char* modeNames[] = { "generic", "AVX2", "jobs" };
+
+	const bool oldParallel = image_parallelCompression.GetBool();
+	const bool oldAVX2 = image_dxtAVX2.GetBool();
+
+	idLib::Printf( "%d job threads, AVX2 %s\n", parallelJobManager->GetNumProcessingUnits(), idDxtEncoder::AVX2Available() ? "available" : "not available" );
+	idLib::Printf( "%-18s %9s %10s %10s %10s\n", "format", "size", modeNames[0], modeNames[1], modeNames[2] );
+
+	for( int i = 0; i < ( int )ARRAY_COUNT( dxtBenchmarkFormats ); i++ )
+	{
+		const dxtBenchmarkFormat_t& format = dxtBenchmarkFormats[i];
+
+		// the exhaustive searches are far too slow for the full size
+		const int formatSize = format.highQuality ? Max( ( size / 8 ) & ~3, 16 ) : size;
+		const int outputSize = ( formatSize / 4 ) * ( formatSize / 4 ) * format.blockSize;
+
+		idTempArray<byte> output( outputSize * 3 );
+		float mpixPerSec[3];
+		for( int mode = 0; mode < 3; mode++ )
+		{
+			image_dxtAVX2.SetBool( mode != 0 );
+			image_parallelCompression.SetBool( mode == 2 );
+
+			idSysInterlockedInteger progress;
+			idDxtEncoder encoder;
+			encoder.SetProgressCounter( &progress );
+
+			const uint64 start = Sys_Microseconds();
+			encoder.CompressImageParallel( format.compress, format.blockSize, image.Ptr(), output.Ptr() + mode * outputSize, formatSize, formatSize );
+			const uint64 microSec = Max( Sys_Microseconds() - start, ( uint64 )1 );
+
+			mpixPerSec[mode] = ( float )formatSize * formatSize / microSec;
+		}
+
+		const bool mismatch = memcmp( output.Ptr(), output.Ptr() + outputSize, outputSize ) != 0 || memcmp( output.Ptr(), output.Ptr() + 2 * outputSize, outputSize ) != 0;
+		idLib::Printf( "%-18s %4dx%-4d %10.2f %10.2f %10.2f MPix/s%s\n", format.name, formatSize, formatSize,
+					   mpixPerSec[0], mpixPerSec[1], mpixPerSec[2], mismatch ? " OUTPUT MISMATCH" : "" );
+	}
+
+	image_parallelCompression.SetBool( oldParallel );
+	image_dxtAVX2.SetBool( oldAVX2 );
+}
@@ -0,0 +1,323 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2014-2016 Robert Beckebans
+Copyright (C) 2014-2016 Kot in Action Creative Artel
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#include "precompiled.h"
+#pragma hdrstop
+#include "framework/Common_local.h"
+#include "DXTCodec_local.h"
+#include "DXTCodec.h"
+
+/*
+================================================================================================
+
+	AVX2 versions of the error functions used by the exhaustive high quality searches.
+
+	The searches call these for every candidate pair of end points so this is where nearly all of
+	the HQ compression time goes. The results, including the chosen indices, are identical to the
+	generic versions. The code is compiled for AVX2 regardless of the global compiler flags and
+	only used if the CPU supports it.
+
+================================================================================================
+*/
+
+idCVar image_dxtAVX2( "image_dxtAVX2", "1", CVAR_RENDERER | CVAR_BOOL, "use the AVX2 kernels for high quality DXT compression if the CPU supports them" );
+
+#if defined( DXT_USE_AVX2 )
+
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+	#include <intrin.h>
+	#define DXT_TARGET_AVX2
+#else
+	#define DXT_TARGET_AVX2		__attribute__( ( target( "avx2" ) ) )
+#endif
+
+/*
+========================
+LowestBit
+========================
+*/
+static ID_INLINE int LowestBit( unsigned int mask )
+{
+	assert( mask != 0 );
+#if defined( _MSC_VER )
+	unsigned long index;
+	_BitScanForward( &index, mask );
+	return ( int )index;
+#else
+	return __builtin_ctz( mask );
+#endif
+}
+
+/*
+========================
+idDxtEncoder::AVX2Available
+========================
+*/
+bool idDxtEncoder::AVX2Available()
+{
+	return ( idLib::sys->GetProcessorId() & CPUID_AVX2 ) != 0 && image_dxtAVX2.GetBool();
+}
+
+/*
+========================
+idDxtEncoder::GetSquareColorsError_AVX2
+
+Same as GetSquareColorsError, but always returns the full error of the block. Callers only use
+the result to compare against lastError, so skipping the early out doesn't change the outcome.
+========================
+*/
+DXT_TARGET_AVX2 int idDxtEncoder::GetSquareColorsError_AVX2( const byte* colorBlock, const unsigned short color0, const unsigned short color1, int lastError ) const
+{
+	byte colors[4][4];
+
+	ColorFrom565( color0, colors[0] );
+	ColorFrom565( color1, colors[1] );
+
+	if( color0 > color1 )
+	{
+		colors[2][0] = ( 2 * colors[0][0] + 1 * colors[1][0] ) / 3;
+		colors[2][1] = ( 2 * colors[0][1] + 1 * colors[1][1] ) / 3;
+		colors[2][2] = ( 2 * colors[0][2] + 1 * colors[1][2] ) / 3;
+		colors[3][0] = ( 1 * colors[0][0] + 2 * colors[1][0] ) / 3;
+		colors[3][1] = ( 1 * colors[0][1] + 2 * colors[1][1] ) / 3;
+		colors[3][2] = ( 1 * colors[0][2] + 2 * colors[1][2] ) / 3;
+	}
+	else
+	{
+		colors[2][0] = ( 1 * colors[0][0] + 1 * colors[1][0] ) / 2;
+		colors[2][1] = ( 1 * colors[0][1] + 1 * colors[1][1] ) / 2;
+		colors[2][2] = ( 1 * colors[0][2] + 1 * colors[1][2] ) / 2;
+		colors[3][0] = 0;
+		colors[3][1] = 0;
+		colors[3][2] = 0;
+	}
+
+	// widen the 16 pixels to 16 bit channels, 4 pixels per register, with alpha cleared
+	const __m256i rgbMask = _mm256_set1_epi64x( 0x0000FFFFFFFFFFFFLL );
+	const __m256i p0 = _mm256_and_si256( _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* )( colorBlock +  0 ) ) ), rgbMask );
+	const __m256i p1 = _mm256_and_si256( _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* )( colorBlock + 16 ) ) ), rgbMask );
+	const __m256i p2 = _mm256_and_si256( _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* )( colorBlock + 32 ) ) ), rgbMask );
+	const __m256i p3 = _mm256_and_si256( _mm256_cvtepu8_epi16( _mm_loadu_si128( ( const __m128i* )( colorBlock + 48 ) ) ), rgbMask );
+
+	__m256i minDist0 = _mm256_set1_epi32( -1 );
+	__m256i minDist1 = _mm256_set1_epi32( -1 );
+
+	for( int j = 0; j < 4; j++ )
+	{
+		const __m256i c = _mm256_set1_epi64x( ( int64 )colors[j][0] | ( ( int64 )colors[j][1] << 16 ) | ( ( int64 )colors[j][2] << 32 ) );
+
+		__m256i d0 = _mm256_sub_epi16( p0, c );
+		__m256i d1 = _mm256_sub_epi16( p1, c );
+		__m256i d2 = _mm256_sub_epi16( p2, c );
+		__m256i d3 = _mm256_sub_epi16( p3, c );
+
+		// r*r+g*g and b*b per pixel, summed up to one distance per pixel
+		d0 = _mm256_madd_epi16( d0, d0 );
+		d1 = _mm256_madd_epi16( d1, d1 );
+		d2 = _mm256_madd_epi16( d2, d2 );
+		d3 = _mm256_madd_epi16( d3, d3 );
+
+		minDist0 = _mm256_min_epu32( minDist0, _mm256_hadd_epi32( d0, d1 ) );
+		minDist1 = _mm256_min_epu32( minDist1, _mm256_hadd_epi32( d2, d3 ) );
+	}
+
+	__m256i sum = _mm256_add_epi32( minDist0, minDist1 );
+	__m128i s = _mm_add_epi32( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) );
+	s = _mm_add_epi32( s, _mm_shuffle_epi32( s, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+	s = _mm_add_epi32( s, _mm_shuffle_epi32( s, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+	return _mm_cvtsi128_si32( s );
+}
+
+/*
+========================
+idDxtEncoder::GetSquareNormalsDXT5Error_AVX2
+
+The generic version renormalizes each of the 32 color/alpha palette combinations again for every
+pixel. Here they are renormalized once and the distances of a pixel to all of them are computed
+in four registers.
+========================
+*/
+DXT_TARGET_AVX2 int idDxtEncoder::GetSquareNormalsDXT5Error_AVX2( const int* normalBlock, const byte* minNormal, const byte* maxNormal, int lastError, unsigned int& colorIndices, byte* alphaIndices ) const
+{
+	byte alphas[8];
+	byte colors[4][4];
+
+	unsigned short smin = ColorTo565( minNormal );
+	unsigned short smax = ColorTo565( maxNormal );
+
+	ColorFrom565( smax, colors[0] );
+	ColorFrom565( smin, colors[1] );
+
+	if( smax > smin )
+	{
+		colors[2][0] = ( 2 * colors[0][0] + 1 * colors[1][0] ) / 3;
+		colors[2][1] = ( 2 * colors[0][1] + 1 * colors[1][1] ) / 3;
+		colors[2][2] = ( 2 * colors[0][2] + 1 * colors[1][2] ) / 3;
+		colors[3][0] = ( 1 * colors[0][0] + 2 * colors[1][0] ) / 3;
+		colors[3][1] = ( 1 * colors[0][1] + 2 * colors[1][1] ) / 3;
+		colors[3][2] = ( 1 * colors[0][2] + 2 * colors[1][2] ) / 3;
+	}
+	else
+	{
+		assert( smax == smin );
+		colors[2][0] = ( 1 * colors[0][0] + 1 * colors[1][0] ) / 2;
+		colors[2][1] = ( 1 * colors[0][1] + 1 * colors[1][1] ) / 2;
+		colors[2][2] = ( 1 * colors[0][2] + 1 * colors[1][2] ) / 2;
+		colors[3][0] = 0;
+		colors[3][1] = 0;
+		colors[3][2] = 0;
+	}
+
+	alphas[0] = maxNormal[3];
+	alphas[1] = minNormal[3];
+
+	if( maxNormal[3] > minNormal[3] )
+	{
+		alphas[2] = ( 6 * alphas[0] + 1 * alphas[1] ) / 7;
+		alphas[3] = ( 5 * alphas[0] + 2 * alphas[1] ) / 7;
+		alphas[4] = ( 4 * alphas[0] + 3 * alphas[1] ) / 7;
+		alphas[5] = ( 3 * alphas[0] + 4 * alphas[1] ) / 7;
+		alphas[6] = ( 2 * alphas[0] + 5 * alphas[1] ) / 7;
+		alphas[7] = ( 1 * alphas[0] + 6 * alphas[1] ) / 7;
+	}
+	else
+	{
+		alphas[2] = ( 4 * alphas[0] + 1 * alphas[1] ) / 5;
+		alphas[3] = ( 3 * alphas[0] + 2 * alphas[1] ) / 5;
+		alphas[4] = ( 2 * alphas[0] + 3 * alphas[1] ) / 5;
+		alphas[5] = ( 1 * alphas[0] + 4 * alphas[1] ) / 5;
+		alphas[6] = 0;
+		alphas[7] = 255;
+	}
+
+	// renormalized palette, entry j * 8 + k is color j with alpha k like in the generic loop
+	ALIGN16( int palette[3][32] );
+	for( int j = 0; j < 4; j++ )
+	{
+		for( int k = 0; k < 8; k++ )
+		{
+			int normal[4];
+			int intNormal[4];
+			normal[0] = colors[j][0];
+			normal[1] = colors[j][1];
+			normal[2] = colors[j][2];
+			normal[3] = alphas[k];
+			NormalizeDXT5( normal, intNormal );
+			palette[0][j * 8 + k] = intNormal[NORMAL_DXT5_C0];
+			palette[1][j * 8 + k] = intNormal[NORMAL_DXT5_C1];
+			palette[2][j * 8 + k] = intNormal[NORMAL_DXT5_C2];
+		}
+	}
+
+	__m256i pal[3][4];
+	for( int c = 0; c < 3; c++ )
+	{
+		for( int v = 0; v < 4; v++ )
+		{
+			pal[c][v] = _mm256_loadu_si256( ( const __m256i* )&palette[c][v * 8] );
+		}
+	}
+
+	int error = 0;
+	int tempColorIndices[16];
+	int tempAlphaIndices[16];
+	for( int i = 0; i < 16; i++ )
+	{
+		const __m256i n0 = _mm256_set1_epi32( normalBlock[i * 4 + NORMAL_DXT5_C0] );
+		const __m256i n1 = _mm256_set1_epi32( normalBlock[i * 4 + NORMAL_DXT5_C1] );
+		const __m256i n2 = _mm256_set1_epi32( normalBlock[i * 4 + NORMAL_DXT5_C2] );
+
+		__m256i dist[4];
+		for( int v = 0; v < 4; v++ )
+		{
+			__m256i d0 = _mm256_sub_epi32( pal[0][v], n0 );
+			__m256i d1 = _mm256_sub_epi32( pal[1][v], n1 );
+			__m256i d2 = _mm256_sub_epi32( pal[2][v], n2 );
+			d0 = _mm256_mullo_epi32( d0, d0 );
+			d1 = _mm256_mullo_epi32( d1, d1 );
+			d2 = _mm256_mullo_epi32( d2, d2 );
+			dist[v] = _mm256_add_epi32( _mm256_add_epi32( d0, d1 ), d2 );
+		}
+
+		// broadcast the smallest distance to all lanes
+		__m256i minDist = _mm256_min_epu32( _mm256_min_epu32( dist[0], dist[1] ), _mm256_min_epu32( dist[2], dist[3] ) );
+		minDist = _mm256_min_epu32( minDist, _mm256_permute2x128_si256( minDist, minDist, 1 ) );
+		minDist = _mm256_min_epu32( minDist, _mm256_shuffle_epi32( minDist, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+		minDist = _mm256_min_epu32( minDist, _mm256_shuffle_epi32( minDist, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+
+		// the generic loop keeps the first palette entry with the smallest distance
+		unsigned int mask = 0;
+		for( int v = 0; v < 4; v++ )
+		{
+			mask |= ( unsigned int )_mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( dist[v], minDist ) ) ) << ( v * 8 );
+		}
+		const int best = LowestBit( mask );
+		tempColorIndices[i] = best >> 3;
+		tempAlphaIndices[i] = best & 7;
+
+		error += _mm_cvtsi128_si32( _mm256_castsi256_si128( minDist ) );
+
+		if( error >= lastError )
+		{
+			return error;
+		}
+	}
+
+	alphaIndices[0] = byte( ( tempAlphaIndices[ 0] >> 0 ) | ( tempAlphaIndices[ 1] << 3 ) | ( tempAlphaIndices[ 2] << 6 ) );
+	alphaIndices[1] = byte( ( tempAlphaIndices[ 2] >> 2 ) | ( tempAlphaIndices[ 3] << 1 ) | ( tempAlphaIndices[ 4] << 4 ) | ( tempAlphaIndices[ 5] << 7 ) );
+	alphaIndices[2] = byte( ( tempAlphaIndices[ 5] >> 1 ) | ( tempAlphaIndices[ 6] << 2 ) | ( tempAlphaIndices[ 7] << 5 ) );
+
+	alphaIndices[3] = byte( ( tempAlphaIndices[ 8] >> 0 ) | ( tempAlphaIndices[ 9] << 3 ) | ( tempAlphaIndices[10] << 6 ) );
+	alphaIndices[4] = byte( ( tempAlphaIndices[10] >> 2 ) | ( tempAlphaIndices[11] << 1 ) | ( tempAlphaIndices[12] << 4 ) | ( tempAlphaIndices[13] << 7 ) );
+	alphaIndices[5] = byte( ( tempAlphaIndices[13] >> 1 ) | ( tempAlphaIndices[14] << 2 ) | ( tempAlphaIndices[15] << 5 ) );
+
+	colorIndices = 0;
+	for( int i = 0; i < 16; i++ )
+	{
+		colorIndices |= ( tempColorIndices[i] << ( unsigned int )( i << 1 ) );
+	}
+
+	return error;
+}
+
+#else
+
+/*
+========================
+idDxtEncoder::AVX2Available
+========================
+*/
+bool idDxtEncoder::AVX2Available()
+{
+	return false;
+}
+
+#endif
@@ -265,6 +265,15 @@ enum imageFileType_t
 
 #define	MAX_IMAGE_NAME	256
 
+// per stage load times, read and decode are summed over all threads that loaded images
+struct imageLoadTiming_t
+{
+	uint64				readMicroSec;			// file access, including waiting for other loaders
+	uint64				decodeMicroSec;			// parsing generated files
+	uint64				uploadMicroSec;
+	int					numBinarized;
+};
+
 class idImage
 {
 	friend class Framebuffer;
@@ -334,7 +343,11 @@ public:
 	{
 		levelLoadReferenced = true;
 	}
-	void		ActuallyLoadImage( bool fromBackEnd );
+	void		ActuallyLoadImage( bool fromBackEnd, imageLoadTiming_t* timing = NULL );
+
+	// Reads the generated file for this image into im, returns false if it has to be binarized.
+	// Doesn't touch any GL state and serializes its file access, so it can run on a job thread.
+	bool		LoadGeneratedImage( idBinaryImage& im, imageLoadTiming_t* timing );
 
 	//---------------------------------------------
 	// Platform specific implementations
@@ -371,6 +384,26 @@ public:
 		return usage;
 	}
 
+	textureFilter_t GetFilter() const
+	{
+		return filter;
+	}
+
+	textureRepeat_t GetRepeat() const
+	{
+		return repeat;
+	}
+
+	cubeFiles_t GetCubeFiles() const
+	{
+		return cubeFiles;
+	}
+
+	int GetCubeMapSize() const
+	{
+		return cubeMapSize;
+	}
+
 	bool				IsLoaded() const;
 
 	// RB
@@ -429,6 +462,9 @@ private:
 
 	void				DeriveOpts();
 	void				AllocImage();
+	void				FinishLoadImage( idBinaryImage& im, bool usable, imageLoadTiming_t* timing );
+	bool				BinarizeImage( idBinaryImage& im );
+	void				UploadBinaryImage( idBinaryImage& im );
 	void				SetSamplerState( textureFilter_t tf, textureRepeat_t tr );
 
 	// parameters that define this image
@@ -530,7 +566,10 @@ public:
 	void				Preload( const idPreloadManifest& manifest, const bool& mapPreload );
 
 	// Loads unloaded level images
-	int					LoadLevelImages( bool pacifier );
+	int					LoadLevelImages( bool pacifier, imageLoadTiming_t* timing = NULL );
+
+	// Loads the given images, reading and decoding on the job threads if image_parallelLoad is set
+	int					LoadImages( const idList<idImage*>& loadImages, bool pacifier, imageLoadTiming_t* timing );
 
 	// used to clear and then write the dds conversion batch file
 	void				StartBuild();
@@ -586,6 +625,7 @@ public:
 	idImage* 			AllocStandaloneImage( const char* name );
 
 	bool				ExcludePreloadImage( const char* name );
+	void				PrintImageLoadTiming( const imageLoadTiming_t& timing );
 
 	idList<idImage*, TAG_IDLIB_LIST_IMAGE>	images;
 	idHashIndex			imageHash;
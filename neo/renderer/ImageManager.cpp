@@ -38,6 +38,8 @@ idImageManager	imageManager;
 idImageManager* globalImages = &imageManager;
 
 idCVar preLoad_Images( "preLoad_Images", "1", CVAR_SYSTEM | CVAR_BOOL, "preload images during beginlevelload" );
+idCVar image_parallelLoad( "image_parallelLoad", "1", CVAR_RENDERER | CVAR_BOOL, "read and decode generated images on the job threads during level loads, only the uploads stay on the main thread" );
+idCVar image_parallelLoadBatch( "image_parallelLoadBatch", "32", CVAR_RENDERER | CVAR_INTEGER, "number of images read ahead while the previous batch is uploaded", 1, 1024 );
 
 /*
 ===============
@@ -867,23 +869,43 @@ void idImageManager::Preload( const idPreloadManifest& manifest, const bool& map
 	{
 		// preload this levels images
 		idLib::Printf( "Preloading images...\n" );
-		preloadingMapImages = mapPreload;
+
+		// when loading in parallel ImageFromFile only creates the images and they are
+		// all loaded in one go afterwards
+		const bool deferLoad = image_parallelLoad.GetBool() && insideLevelLoad;
+		preloadingMapImages = mapPreload && !deferLoad;
 		int	start = Sys_Milliseconds();
 		int numLoaded = 0;
 
+		idList<idImage*> loadImages;
+		imageLoadTiming_t timing;
+		memset( &timing, 0, sizeof( timing ) );
+
 		//fileSystem->StartPreload( preloadImageFiles );
 		for( int i = 0; i < manifest.NumResources(); i++ )
 		{
 			const preloadEntry_s& p = manifest.GetPreloadByIndex( i );
 			if( p.resType == PRELOAD_IMAGE && !ExcludePreloadImage( p.resourceName ) )
 			{
-				globalImages->ImageFromFile( p.resourceName, ( textureFilter_t )p.imgData.filter, ( textureRepeat_t )p.imgData.repeat, ( textureUsage_t )p.imgData.usage, ( cubeFiles_t )p.imgData.cubeMap );
+				idImage* image = globalImages->ImageFromFile( p.resourceName, ( textureFilter_t )p.imgData.filter, ( textureRepeat_t )p.imgData.repeat, ( textureUsage_t )p.imgData.usage, ( cubeFiles_t )p.imgData.cubeMap );
+				if( deferLoad && !image->IsLoaded() && image->generatorFunction == NULL )
+				{
+					loadImages.AddUnique( image );
+				}
 				numLoaded++;
 			}
 		}
+		if( loadImages.Num() > 0 )
+		{
+			LoadImages( loadImages, false, &timing );
+		}
 		//fileSystem->StopPreload();
 		int	end = Sys_Milliseconds();
 		idLib::Printf( "%05d images preloaded ( or were already loaded ) in %5.1f seconds\n", numLoaded, ( end - start ) * 0.001 );
+		if( loadImages.Num() > 0 )
+		{
+			PrintImageLoadTiming( timing );
+		}
 		idLib::Printf( "----------------------------------------\n" );
 		preloadingMapImages = false;
 	}
@@ -894,30 +916,179 @@ void idImageManager::Preload( const idPreloadManifest& manifest, const bool& map
 idImageManager::LoadLevelImages
 ===============
 */
-int idImageManager::LoadLevelImages( bool pacifier )
+int idImageManager::LoadLevelImages( bool pacifier, imageLoadTiming_t* timing )
 {
-	int	loadCount = 0;
+	idList<idImage*> loadImages;
 	for( int i = 0 ; i < images.Num() ; i++ )
 	{
 		idImage* image = images[ i ];
 
-		if( pacifier )
+		if( image->generatorFunction )
 		{
-			common->UpdateLevelLoadPacifier();
+			continue;
 		}
 
-		if( image->generatorFunction )
+		if( image->levelLoadReferenced && !image->IsLoaded() )
 		{
+			loadImages.Append( image );
+		}
+	}
+
+	if( pacifier )
+	{
+		common->UpdateLevelLoadPacifier();
+	}
+
+	imageLoadTiming_t localTiming;
+	if( timing == NULL )
+	{
+		memset( &localTiming, 0, sizeof( localTiming ) );
+		timing = &localTiming;
+	}
+	return LoadImages( loadImages, pacifier, timing );
+}
+
+/*
+===============
+LoadGeneratedImageJob
+===============
+*/
+struct imageLoadJob_t
+{
+	idImage* 			image;
+	idBinaryImage* 		binaryImage;
+	bool				usable;
+	imageLoadTiming_t	timing;
+};
+
+static void LoadGeneratedImageJob( imageLoadJob_t* job )
+{
+	job->usable = job->image->LoadGeneratedImage( *job->binaryImage, &job->timing );
+}
+
+REGISTER_PARALLEL_JOB( LoadGeneratedImageJob, "LoadGeneratedImageJob" );
+
+/*
+===============
+idImageManager::LoadImages
+
+The images are loaded in batches that go through two job lists: while the generated files of
+one batch are read and decoded on the job threads, the previous batch is uploaded here.
+Anything that may touch the file system on the main thread, binarizing missing or outdated
+images and the loading pacifier, only happens once the job threads are idle again.
+===============
+*/
+int idImageManager::LoadImages( const idList<idImage*>& loadImages, bool pacifier, imageLoadTiming_t* timing )
+{
+	if( !image_parallelLoad.GetBool() || !tr.IsInitialized() || cvarSystem->GetCVarBool( "fs_buildresources" ) || loadImages.Num() <= 1 )
+	{
+		for( int i = 0; i < loadImages.Num(); i++ )
+		{
+			if( pacifier )
+			{
+				common->UpdateLevelLoadPacifier();
+			}
+			loadImages[i]->ActuallyLoadImage( false, timing );
+		}
+		return loadImages.Num();
+	}
+
+	const int batchSize = Max( image_parallelLoadBatch.GetInteger(), 1 );
+	const int numBatches = ( loadImages.Num() + batchSize - 1 ) / batchSize;
+
+	idList<imageLoadJob_t> jobs;
+	jobs.SetNum( loadImages.Num() );
+	for( int i = 0; i < jobs.Num(); i++ )
+	{
+		jobs[i].image = loadImages[i];
+		jobs[i].binaryImage = NULL;
+		jobs[i].usable = false;
+		memset( &jobs[i].timing, 0, sizeof( jobs[i].timing ) );
+	}
+
+	idParallelJobList* jobLists[2];
+	for( int i = 0; i < 2; i++ )
+	{
+		jobLists[i] = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batchSize, 0, NULL );
+	}
+
+	for( int batch = 0; batch <= numBatches; batch++ )
+	{
+		idParallelJobList* jobList = jobLists[batch & 1];
+
+		// start reading the next batch
+		if( batch < numBatches )
+		{
+			const int last = Min( ( batch + 1 ) * batchSize, jobs.Num() );
+			for( int i = batch * batchSize; i < last; i++ )
+			{
+				jobs[i].binaryImage = new( TAG_IMAGE ) idBinaryImage( jobs[i].image->GetName() );
+				jobList->AddJob( ( jobRun_t )LoadGeneratedImageJob, &jobs[i] );
+			}
+			jobList->Submit();
+		}
+
+		if( batch == 0 )
+		{
+			jobList->Wait();
 			continue;
 		}
 
-		if( image->levelLoadReferenced && !image->IsLoaded() )
+		// upload the previous batch in the mean time
+		const int first = ( batch - 1 ) * batchSize;
+		const int last = Min( batch * batchSize, jobs.Num() );
+		for( int i = first; i < last; i++ )
+		{
+			imageLoadJob_t& job = jobs[i];
+			if( job.usable )
+			{
+				job.image->FinishLoadImage( *job.binaryImage, true, timing );
+				delete job.binaryImage;
+				job.binaryImage = NULL;
+			}
+		}
+
+		if( batch < numBatches )
+		{
+			jobList->Wait();
+		}
+
+		for( int i = first; i < last; i++ )
 		{
-			loadCount++;
-			image->ActuallyLoadImage( false );
+			imageLoadJob_t& job = jobs[i];
+			if( !job.usable )
+			{
+				job.image->FinishLoadImage( *job.binaryImage, false, timing );
+				delete job.binaryImage;
+				job.binaryImage = NULL;
+			}
+			timing->readMicroSec += job.timing.readMicroSec;
+			timing->decodeMicroSec += job.timing.decodeMicroSec;
+		}
+
+		if( pacifier )
+		{
+			common->UpdateLevelLoadPacifier();
 		}
 	}
-	return loadCount;
+
+	for( int i = 0; i < 2; i++ )
+	{
+		parallelJobManager->FreeJobList( jobLists[i] );
+	}
+
+	return jobs.Num();
+}
+
+/*
+===============
+idImageManager::PrintImageLoadTiming
+===============
+*/
+void idImageManager::PrintImageLoadTiming( const imageLoadTiming_t& timing )
+{
+	idLib::Printf( "%5.1f ms reading, %5.1f ms decoding ( summed over all threads ), %5.1f ms uploading, %i images binarized\n",
+				   timing.readMicroSec * 0.001, timing.decodeMicroSec * 0.001, timing.uploadMicroSec * 0.001, timing.numBinarized );
 }
 
 /*
@@ -931,10 +1102,13 @@ void idImageManager::EndLevelLoad()
 
 	idLib::Printf( "----- idImageManager::EndLevelLoad -----\n" );
 	int start = Sys_Milliseconds();
-	int	loadCount = LoadLevelImages( true );
+	imageLoadTiming_t timing;
+	memset( &timing, 0, sizeof( timing ) );
+	int	loadCount = LoadLevelImages( true, &timing );
 
 	int	end = Sys_Milliseconds();
 	idLib::Printf( "%5i images loaded in %5.1f seconds\n", loadCount, ( end - start ) * 0.001 );
+	PrintImageLoadTiming( timing );
 	idLib::Printf( "----------------------------------------\n" );
 	//R_ListImages_f( idCmdArgs( "sorted sorted", false ) );
 }
@@ -287,6 +287,79 @@ void idImage::GetGeneratedName( idStr& _name, const textureUsage_t& _usage, cons
 	}
 }
 
+/*
+===============
+R_LoadGeneratedImage
+
+Same as idBinaryImage::LoadFromGeneratedFile( ID_TIME_T ), but the file is read into memory
+under imageFileMutex and parsed from there, so this can be called from the job threads while
+only the actual file access is serialized. Files that already live in memory, like views into
+a mapped resource container, are parsed in place without the extra copy.
+===============
+*/
+static idSysMutex imageFileMutex;
+
+static ID_TIME_T R_LoadGeneratedImage( idBinaryImage& im, ID_TIME_T sourceFileTime, imageLoadTiming_t* timing )
+{
+	idStr binaryFileName;
+	idBinaryImage::GetGeneratedFileName( binaryFileName, im.GetName() );
+
+	uint64 start = Sys_Microseconds();
+
+	idFile* bFile = NULL;
+	byte* buffer = NULL;
+	int length = 0;
+	ID_TIME_T timestamp = FILE_NOT_FOUND_TIMESTAMP;
+	{
+		idScopedCriticalSection lock( imageFileMutex );
+
+		bFile = fileSystem->OpenFileRead( binaryFileName );
+		if( bFile != NULL )
+		{
+			length = bFile->Length();
+			timestamp = bFile->Timestamp();
+			if( dynamic_cast< idFile_Memory* >( bFile ) == NULL )
+			{
+				buffer = ( byte* )Mem_Alloc( length, TAG_TEMP );
+				if( bFile->Read( buffer, length ) != length )
+				{
+					timestamp = FILE_NOT_FOUND_TIMESTAMP;
+				}
+				delete bFile;
+				bFile = NULL;
+			}
+		}
+	}
+
+	uint64 end = Sys_Microseconds();
+	if( timing != NULL )
+	{
+		timing->readMicroSec += end - start;
+	}
+
+	if( timestamp != FILE_NOT_FOUND_TIMESTAMP )
+	{
+		idFile_Memory memFile( binaryFileName, ( const char* )buffer, length );
+		if( !im.LoadFromGeneratedFile( ( bFile != NULL ) ? bFile : &memFile, sourceFileTime ) )
+		{
+			timestamp = FILE_NOT_FOUND_TIMESTAMP;
+		}
+	}
+
+	delete bFile;
+
+	if( buffer != NULL )
+	{
+		Mem_Free( buffer );
+	}
+
+	if( timing != NULL )
+	{
+		timing->decodeMicroSec += Sys_Microseconds() - end;
+	}
+	return timestamp;
+}
+
 /*
 ===============
 ActuallyLoadImage
@@ -295,7 +368,7 @@ Absolutely every image goes through this path
 On exit, the idImage will have a valid OpenGL texture number that can be bound
 ===============
 */
-void idImage::ActuallyLoadImage( bool fromBackEnd )
+void idImage::ActuallyLoadImage( bool fromBackEnd, imageLoadTiming_t* timing )
 {
 	// if we don't have a rendering context yet, just return
 	if( !tr.IsInitialized() )
@@ -310,6 +383,65 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 		return;
 	}
 
+	idBinaryImage im( GetName() );
+	bool usable = LoadGeneratedImage( im, timing );
+	FinishLoadImage( im, usable, timing );
+}
+
+/*
+===============
+idImage::FinishLoadImage
+
+Binarizes the image if LoadGeneratedImage didn't find a usable generated file and uploads it.
+Main thread only.
+===============
+*/
+void idImage::FinishLoadImage( idBinaryImage& im, bool usable, imageLoadTiming_t* timing )
+{
+	if( usable )
+	{
+		if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
+		{
+			// for resource gathering write this image to the preload file for this map,
+			// images are never loaded in parallel while building resources
+			fileSystem->AddImagePreload( GetName(), filter, repeat, usage, cubeFiles );
+		}
+	}
+	else
+	{
+		if( timing != NULL )
+		{
+			timing->numBinarized++;
+		}
+		if( !BinarizeImage( im ) )
+		{
+			return;
+		}
+	}
+
+	uint64 start = Sys_Microseconds();
+
+	UploadBinaryImage( im );
+
+	if( timing != NULL )
+	{
+		timing->uploadMicroSec += Sys_Microseconds() - start;
+	}
+}
+
+/*
+===============
+idImage::LoadGeneratedImage
+
+Figures out the image options and loads the matching generated .bimage into im.
+Returns false if there is no usable generated file and the image has to be binarized.
+
+This does not touch any GL state and all file access is serialized by imageFileMutex,
+so the image manager runs it on the job threads for level loads.
+===============
+*/
+bool idImage::LoadGeneratedImage( idBinaryImage& im, imageLoadTiming_t* timing )
+{
 	// RB: the following does not load the source images from disk because pic is NULL
 	// but it tries to get the timestamp to see if we have a newer file than the one in the compressed .bimage
 
@@ -327,6 +459,9 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 	}
 	else
 	{
+		uint64 start = Sys_Microseconds();
+		idScopedCriticalSection lock( imageFileMutex );
+
 		// RB: added CF_2D_ARRAY
 		if( cubeFiles == CF_2D_ARRAY )
 		{
@@ -343,6 +478,11 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 			opts.textureType = TT_2D;
 			R_LoadImageProgram( GetName(), NULL, NULL, NULL, &sourceFileTime, &usage );
 		}
+
+		if( timing != NULL )
+		{
+			timing->readMicroSec += Sys_Microseconds() - start;
+		}
 	}
 
 	// RB: PBR HACK - RMAO maps should end with _rmao insted of _s
@@ -362,8 +502,8 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 	GetGeneratedName( generatedName, usage, cubeFiles );
 
 	// RB: try to load the .bimage and skip if sourceFileTime is newer
-	idBinaryImage im( generatedName );
-	binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+	im.SetName( generatedName );
+	binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 
 	// BFHACK, do not want to tweak on buildgame so catch these images here
 	if( binaryFileTime == FILE_NOT_FOUND_TIMESTAMP && fileSystem->UsingResourceFiles() )
@@ -375,35 +515,35 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 			{
 				generatedName.Replace( "white#__0000", "white#__0200" );
 				im.SetName( generatedName );
-				binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+				binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 				break;
 			}
 			if( generatedName.Find( "guis/assets/white#__0100", false ) >= 0 )
 			{
 				generatedName.Replace( "white#__0100", "white#__0200" );
 				im.SetName( generatedName );
-				binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+				binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 				break;
 			}
 			if( generatedName.Find( "textures/black#__0100", false ) >= 0 )
 			{
 				generatedName.Replace( "black#__0100", "black#__0200" );
 				im.SetName( generatedName );
-				binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+				binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 				break;
 			}
 			if( generatedName.Find( "textures/decals/bulletglass1_d#__0100", false ) >= 0 )
 			{
 				generatedName.Replace( "bulletglass1_d#__0100", "bulletglass1_d#__0200" );
 				im.SetName( generatedName );
-				binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+				binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 				break;
 			}
 			if( generatedName.Find( "models/monsters/skeleton/skeleton01_d#__1000", false ) >= 0 )
 			{
 				generatedName.Replace( "skeleton01_d#__1000", "skeleton01_d#__0100" );
 				im.SetName( generatedName );
-				binaryFileTime = im.LoadFromGeneratedFile( sourceFileTime );
+				binaryFileTime = R_LoadGeneratedImage( im, sourceFileTime, timing );
 				break;
 			}
 		}
@@ -423,167 +563,188 @@ void idImage::ActuallyLoadImage( bool fromBackEnd )
 		opts.format = ( textureFormat_t )header.format;
 		opts.textureType = ( textureType_t )header.textureType;
 
-		if( cvarSystem->GetCVarBool( "fs_buildresources" ) )
-		{
-			// for resource gathering write this image to the preload file for this map
-			fileSystem->AddImagePreload( GetName(), filter, repeat, usage, cubeFiles );
-		}
+		return true;
 	}
-	else
-	{
-		// RB: try to read the source image from disk
 
-		idStr binarizeReason = "binarize: unknown reason";
-		if( binaryFileTime == FILE_NOT_FOUND_TIMESTAMP )
-		{
-			binarizeReason = va( "binarize: binary file not found '%s'", generatedName.c_str() );
-		}
-		else if( header.colorFormat != opts.colorFormat )
-		{
-			binarizeReason = va( "binarize: mismatch color format '%s'", generatedName.c_str() );
-		}
-		else if( header.colorFormat != opts.colorFormat )
-		{
-			binarizeReason = va( "binarize: mismatched color format '%s'", generatedName.c_str() );
-		}
-		else if( header.textureType != opts.textureType )
-		{
-			binarizeReason = va( "binarize: mismatched texture type '%s'", generatedName.c_str() );
-		}
-		//else if( toolUsage )
-		//	binarizeReason = va( "binarize: tool usage '%s'", generatedName.c_str() );
+	return false;
+}
 
-		if( cubeFiles == CF_NATIVE || cubeFiles == CF_CAMERA || cubeFiles == CF_SINGLE )
-		{
-			int size;
-			byte* pics[6];
+/*
+===============
+idImage::BinarizeImage
 
-			if( !R_LoadCubeImages( GetName(), cubeFiles, pics, &size, &sourceFileTime, cubeMapSize ) || size == 0 )
-			{
-				idLib::Warning( "Couldn't load cube image: %s", GetName() );
-				defaulted = true; // RB
-				return;
-			}
+Loads the source images, converts them into im and writes the generated file.
+Returns false if the source couldn't be loaded, in which case a default image has already been
+created and there is nothing left to upload. Main thread only.
+===============
+*/
+bool idImage::BinarizeImage( idBinaryImage& im )
+{
+	const bimageFile_t& header = im.GetFileHeader();
+	const idStr generatedName = im.GetName();
 
-			repeat = TR_CLAMP;
+	// RB: try to read the source image from disk
 
-			opts.textureType = TT_CUBIC;
-			opts.width = size;
-			opts.height = size;
-			opts.numLevels = 0;
+	idStr binarizeReason = "binarize: unknown reason";
+	if( binaryFileTime == FILE_NOT_FOUND_TIMESTAMP )
+	{
+		binarizeReason = va( "binarize: binary file not found '%s'", generatedName.c_str() );
+	}
+	else if( header.colorFormat != opts.colorFormat )
+	{
+		binarizeReason = va( "binarize: mismatch color format '%s'", generatedName.c_str() );
+	}
+	else if( header.colorFormat != opts.colorFormat )
+	{
+		binarizeReason = va( "binarize: mismatched color format '%s'", generatedName.c_str() );
+	}
+	else if( header.textureType != opts.textureType )
+	{
+		binarizeReason = va( "binarize: mismatched texture type '%s'", generatedName.c_str() );
+	}
+	//else if( toolUsage )
+	//	binarizeReason = va( "binarize: tool usage '%s'", generatedName.c_str() );
 
-			DeriveOpts();
+	if( cubeFiles == CF_NATIVE || cubeFiles == CF_CAMERA || cubeFiles == CF_SINGLE )
+	{
+		int size;
+		byte* pics[6];
 
-			// foresthale 2014-05-30: give a nice progress display when binarizing
-			commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
-			if( opts.numLevels > 1 )
-			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
-			}
-			else
-			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
-			}
+		if( !R_LoadCubeImages( GetName(), cubeFiles, pics, &size, &sourceFileTime, cubeMapSize ) || size == 0 )
+		{
+			idLib::Warning( "Couldn't load cube image: %s", GetName() );
+			defaulted = true; // RB
+			return false;
+		}
 
-			im.LoadCubeFromMemory( size, ( const byte** )pics, opts.numLevels, opts.format, opts.gammaMips );
+		repeat = TR_CLAMP;
 
-			commonLocal.LoadPacifierBinarizeEnd();
+		opts.textureType = TT_CUBIC;
+		opts.width = size;
+		opts.height = size;
+		opts.numLevels = 0;
 
-			repeat = TR_CLAMP;
+		DeriveOpts();
 
-			for( int i = 0; i < 6; i++ )
-			{
-				if( pics[i] )
-				{
-					Mem_Free( pics[i] );
-				}
-			}
+		// foresthale 2014-05-30: give a nice progress display when binarizing
+		commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
+		if( opts.numLevels > 1 )
+		{
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
 		}
 		else
 		{
-			int width, height;
-			byte* pic;
-
-			// load the full specification, and perform any image program calculations
-			R_LoadImageProgram( GetName(), &pic, &width, &height, &sourceFileTime, &usage );
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
+		}
 
-			if( pic == NULL )
-			{
-				idLib::Warning( "Couldn't load image: %s : %s", GetName(), generatedName.c_str() );
-
-				// create a default so it doesn't get continuously reloaded
-				opts.width = 8;
-				opts.height = 8;
-				opts.numLevels = 1;
-				DeriveOpts();
-				AllocImage();
-
-				// clear the data so it's not left uninitialized
-				idTempArray<byte> clear( opts.width * opts.height * 4 );
-				memset( clear.Ptr(), 0, clear.Size() );
-				for( int level = 0; level < opts.numLevels; level++ )
-				{
-					SubImageUpload( level, 0, 0, 0, opts.width >> level, opts.height >> level, clear.Ptr() );
-				}
+		im.LoadCubeFromMemory( size, ( const byte** )pics, opts.numLevels, opts.format, opts.gammaMips );
 
-				defaulted = true; // RB
-				return;
-			}
+		commonLocal.LoadPacifierBinarizeEnd();
 
-			opts.width = width;
-			opts.height = height;
-			opts.numLevels = 0;
+		repeat = TR_CLAMP;
 
-			// RB
-			if( cubeFiles == CF_2D_PACKED_MIPCHAIN )
+		for( int i = 0; i < 6; i++ )
+		{
+			if( pics[i] )
 			{
-				opts.width = width * ( 2.0f / 3.0f );
+				Mem_Free( pics[i] );
 			}
+		}
+	}
+	else
+	{
+		int width, height;
+		byte* pic;
+
+		// load the full specification, and perform any image program calculations
+		R_LoadImageProgram( GetName(), &pic, &width, &height, &sourceFileTime, &usage );
 
+		if( pic == NULL )
+		{
+			idLib::Warning( "Couldn't load image: %s : %s", GetName(), generatedName.c_str() );
+
+			// create a default so it doesn't get continuously reloaded
+			opts.width = 8;
+			opts.height = 8;
+			opts.numLevels = 1;
 			DeriveOpts();
+			AllocImage();
 
-			// foresthale 2014-05-30: give a nice progress display when binarizing
-			commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
-			if( opts.numLevels > 1 )
+			// clear the data so it's not left uninitialized
+			idTempArray<byte> clear( opts.width * opts.height * 4 );
+			memset( clear.Ptr(), 0, clear.Size() );
+			for( int level = 0; level < opts.numLevels; level++ )
 			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
-			}
-			else
-			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
+				SubImageUpload( level, 0, 0, 0, opts.width >> level, opts.height >> level, clear.Ptr() );
 			}
 
-			commonLocal.LoadPacifierBinarizeEnd();
+			defaulted = true; // RB
+			return false;
+		}
 
-			// foresthale 2014-05-30: give a nice progress display when binarizing
-			commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
-			if( opts.numLevels > 1 )
-			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
-			}
-			else
-			{
-				commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
-			}
+		opts.width = width;
+		opts.height = height;
+		opts.numLevels = 0;
 
-			// RB: convert to compressed DXT or whatever choosen target format
-			if( cubeFiles == CF_2D_PACKED_MIPCHAIN )
-			{
-				im.Load2DAtlasMipchainFromMemory( width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat );
-			}
-			else
-			{
-				im.Load2DFromMemory( opts.width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat, opts.gammaMips );
-			}
-			commonLocal.LoadPacifierBinarizeEnd();
+		// RB
+		if( cubeFiles == CF_2D_PACKED_MIPCHAIN )
+		{
+			opts.width = width * ( 2.0f / 3.0f );
+		}
+
+		DeriveOpts();
+
+		// foresthale 2014-05-30: give a nice progress display when binarizing
+		commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
+		if( opts.numLevels > 1 )
+		{
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
+		}
+		else
+		{
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
+		}
+
+		commonLocal.LoadPacifierBinarizeEnd();
+
+		// foresthale 2014-05-30: give a nice progress display when binarizing
+		commonLocal.LoadPacifierBinarizeFilename( generatedName.c_str(), binarizeReason.c_str() );
+		if( opts.numLevels > 1 )
+		{
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 * 4 / 3 );
+		}
+		else
+		{
+			commonLocal.LoadPacifierBinarizeProgressTotal( opts.width * opts.width * 6 );
+		}
 
-			Mem_Free( pic );
+		// RB: convert to compressed DXT or whatever choosen target format
+		if( cubeFiles == CF_2D_PACKED_MIPCHAIN )
+		{
+			im.Load2DAtlasMipchainFromMemory( width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat );
 		}
+		else
+		{
+			im.Load2DFromMemory( opts.width, opts.height, pic, opts.numLevels, opts.format, opts.colorFormat, opts.gammaMips );
+		}
+		commonLocal.LoadPacifierBinarizeEnd();
 
-		// RB: write the compressed .bimage which contains the optimized GPU format
-		binaryFileTime = im.WriteGeneratedFile( sourceFileTime );
+		Mem_Free( pic );
 	}
 
+	// RB: write the compressed .bimage which contains the optimized GPU format
+	binaryFileTime = im.WriteGeneratedFile( sourceFileTime );
+
+	return true;
+}
+
+/*
+===============
+idImage::UploadBinaryImage
+===============
+*/
+void idImage::UploadBinaryImage( idBinaryImage& im )
+{
 	AllocImage();
 
 	for( int i = 0; i < im.NumImages(); i++ )
@@ -864,6 +864,215 @@ void idInteraction::CreateStaticInteraction()
 	}
 }
 
+/*
+===========================================================================
+
+idInteractionCache implementation
+
+===========================================================================
+*/
+
+idSysInterlockedInteger idInteractionCache::totalMemory;
+
+/*
+===============
+idInteractionCache::~idInteractionCache
+===============
+*/
+idInteractionCache::~idInteractionCache()
+{
+	Clear();
+}
+
+/*
+===============
+idInteractionCache::Clear
+===============
+*/
+void idInteractionCache::Clear()
+{
+	for( int i = 0; i < surfaces.Num(); i++ )
+	{
+		if( surfaces[i]->allocatedBytes > 0 )
+		{
+			tr.pc.c_interactionCacheInvalidations++;
+		}
+		FreeIndices( surfaces[i] );
+		delete surfaces[i];
+	}
+	surfaces.Clear();
+	surfaceHash.Free();
+}
+
+/*
+===============
+idInteractionCache::Purge
+===============
+*/
+bool idInteractionCache::Purge( int oldestFrameCount )
+{
+	bool purged = false;
+	for( int i = surfaces.Num() - 1; i >= 0; i-- )
+	{
+		if( surfaces[i]->lastFrameCount >= oldestFrameCount )
+		{
+			continue;
+		}
+		FreeIndices( surfaces[i] );
+		delete surfaces[i];
+		surfaces.RemoveIndexFast( i );
+		purged = true;
+	}
+
+	if( purged )
+	{
+		surfaceHash.Clear();
+		for( int i = 0; i < surfaces.Num(); i++ )
+		{
+			surfaceHash.Add( surfaceHash.GenerateKey( surfaces[i]->lightIndex, surfaces[i]->surfaceNum ), i );
+		}
+	}
+
+	return surfaces.Num() == 0;
+}
+
+/*
+===============
+idInteractionCache::FreeIndices
+===============
+*/
+void idInteractionCache::FreeIndices( interactionCacheSurface_t* surf )
+{
+	Mem_Free16( surf->lightIndices );
+	Mem_Free16( surf->shadowIndices );
+	surf->lightIndices = NULL;
+	surf->shadowIndices = NULL;
+	surf->numLightIndices = -1;
+	surf->numShadowIndices = -1;
+	surf->numShadowIndicesNoCaps = -1;
+
+	totalMemory.Add( -surf->allocatedBytes );
+	surf->allocatedBytes = 0;
+}
+
+/*
+===============
+idInteractionCache::FindSurface
+
+The light origin and projection are compared in surface space, so an entity
+that moves together with a light still finds its indices.
+===============
+*/
+interactionCacheSurface_t* idInteractionCache::FindSurface( int lightIndex, int surfaceNum, const srfTriangles_t* tri,
+		const idVec3& localLightOrigin, const idRenderMatrix& localLightProject, bool cullShadowTriangles )
+{
+	interactionCacheSurface_t* surf = NULL;
+
+	const int key = surfaceHash.GenerateKey( lightIndex, surfaceNum );
+	for( int i = surfaceHash.First( key ); i != -1; i = surfaceHash.Next( i ) )
+	{
+		if( surfaces[i]->lightIndex == lightIndex && surfaces[i]->surfaceNum == surfaceNum )
+		{
+			surf = surfaces[i];
+			break;
+		}
+	}
+
+	if( surf == NULL )
+	{
+		surf = new( TAG_RENDER_INTERACTION ) interactionCacheSurface_t;
+		surf->lightIndex = lightIndex;
+		surf->surfaceNum = surfaceNum;
+		surf->tri = NULL;
+		surf->lightIndices = NULL;
+		surf->shadowIndices = NULL;
+		surf->allocatedBytes = 0;
+		surfaceHash.Add( key, surfaces.Append( surf ) );
+	}
+	else if( surf->tri == tri && surf->numVerts == tri->numVerts && surf->numIndexes == tri->numIndexes &&
+			 surf->cullShadowTriangles == cullShadowTriangles &&
+			 surf->localLightOrigin == localLightOrigin &&
+			 memcmp( &surf->localLightProject, &localLightProject, sizeof( localLightProject ) ) == 0 )
+	{
+		// don't keep anything for keys that change every frame
+		surf->lastFrameCount = tr.frameCount;
+		return ( tr.frameCount > surf->firstFrameCount ) ? surf : NULL;
+	}
+	else if( surf->allocatedBytes > 0 )
+	{
+		tr.pc.c_interactionCacheInvalidations++;
+	}
+
+	FreeIndices( surf );
+
+	surf->tri = tri;
+	surf->numVerts = tri->numVerts;
+	surf->numIndexes = tri->numIndexes;
+	surf->localLightOrigin = localLightOrigin;
+	surf->localLightProject = localLightProject;
+	surf->cullShadowTriangles = cullShadowTriangles;
+	surf->firstFrameCount = tr.frameCount;
+	surf->lastFrameCount = tr.frameCount;
+
+	return NULL;
+}
+
+/*
+===============
+idInteractionCache::AllocIndices
+===============
+*/
+bool idInteractionCache::AllocIndices( interactionCacheSurface_t* surf, triIndex_t*& indices, int numIndices )
+{
+	if( indices != NULL )
+	{
+		return true;
+	}
+
+	// the copy to the vertex cache reads whole INDEX_CACHE_ALIGN blocks
+	const int bytes = ALIGN( numIndices * sizeof( triIndex_t ), INDEX_CACHE_ALIGN );
+	if( totalMemory.Add( bytes ) > r_interactionCacheMegs.GetInteger() * 1024 * 1024 )
+	{
+		totalMemory.Add( -bytes );
+		return false;
+	}
+
+	indices = ( triIndex_t* )Mem_Alloc16( bytes, TAG_RENDER_INTERACTION );
+	surf->allocatedBytes += bytes;
+	return true;
+}
+
+/*
+===============
+idInteractionCache::AllocLightIndices
+===============
+*/
+bool idInteractionCache::AllocLightIndices( interactionCacheSurface_t* surf )
+{
+	if( !AllocIndices( surf, surf->lightIndices, surf->numIndexes ) )
+	{
+		return false;
+	}
+	surf->numLightIndices = -1;
+	return true;
+}
+
+/*
+===============
+idInteractionCache::AllocShadowIndices
+===============
+*/
+bool idInteractionCache::AllocShadowIndices( interactionCacheSurface_t* surf, int maxShadowIndices )
+{
+	if( !AllocIndices( surf, surf->shadowIndices, maxShadowIndices ) )
+	{
+		return false;
+	}
+	surf->numShadowIndices = -1;
+	surf->numShadowIndicesNoCaps = -1;
+	return true;
+}
+
 /*
 ===================
 R_ShowInteractionMemory_f
@@ -152,6 +152,86 @@ private:
 	void					Unlink();
 };
 
+/*
+===============================================================================
+
+	Interaction cache for dynamic interactions.
+
+	Dynamic interactions do not have an idInteraction, so the culled light
+	triangles and shadow volume indices are normally recreated by the
+	DynamicShadowVolumeJob every view. An entity that does not change between
+	frames keeps a copy of these indices in main memory, keyed on the light
+	and surface, so later views only have to copy them to the vertex cache.
+
+	The shadow volume is always stored with caps, the caps / Z-fail decision
+	for a view is made by the StaticShadowVolumeJob like for static interactions.
+
+	The cache is freed with the entity derived data, which happens on every
+	entity update. Keys that have not been looked up for a while, because the
+	light was freed or the entity is no longer in view, are purged before the
+	models of each view are added.
+
+===============================================================================
+*/
+
+struct interactionCacheSurface_t
+{
+	// key
+	int						lightIndex;
+	int						surfaceNum;
+	const srfTriangles_t* 	tri;
+	int						numVerts;
+	int						numIndexes;
+	idVec3					localLightOrigin;
+	idRenderMatrix			localLightProject;
+	bool					cullShadowTriangles;
+	int						firstFrameCount;		// indices are only kept once the key was seen in an earlier frame
+	int						lastFrameCount;			// the key is purged when it hasn't been looked up for a while
+
+	// -1 until written by the DynamicShadowVolumeJob
+	int						numLightIndices;
+	int						numShadowIndices;		// with caps
+	int						numShadowIndicesNoCaps;
+
+	triIndex_t* 			lightIndices;
+	triIndex_t* 			shadowIndices;
+	int						allocatedBytes;
+};
+
+class idInteractionCache
+{
+public:
+	~idInteractionCache();
+
+	// returns NULL if the key has not been stable for more than a frame yet
+	interactionCacheSurface_t* 	FindSurface( int lightIndex, int surfaceNum, const srfTriangles_t* tri,
+			const idVec3& localLightOrigin, const idRenderMatrix& localLightProject, bool cullShadowTriangles );
+
+	// allocate space for the job to write the indices, returns false if over the memory budget
+	bool					AllocLightIndices( interactionCacheSurface_t* surf );
+	bool					AllocShadowIndices( interactionCacheSurface_t* surf, int maxShadowIndices );
+
+	void					Clear();
+
+	// frees the keys that have not been looked up since oldestFrameCount, returns true if the cache is empty
+	bool					Purge( int oldestFrameCount );
+
+	static int				TotalMemory()
+	{
+		return totalMemory.GetValue();
+	}
+
+private:
+	void					FreeIndices( interactionCacheSurface_t* surf );
+	bool					AllocIndices( interactionCacheSurface_t* surf, triIndex_t*& indices, int numIndices );
+
+	idList< interactionCacheSurface_t*, TAG_RENDER_INTERACTION >	surfaces;
+	idHashIndex				surfaceHash;
+
+	// all interaction caches, may be changed by parallel R_AddSingleModel jobs
+	static idSysInterlockedInteger	totalMemory;
+};
+
 void R_ShowInteractionMemory_f( const idCmdArgs& args );
 
 #endif /* !__INTERACTION_H__ */
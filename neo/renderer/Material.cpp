@@ -74,6 +74,10 @@ typedef struct mtrParsingData_s
 } mtrParsingData_t;
 
 idCVar r_forceSoundOpAmplitude( "r_forceSoundOpAmplitude", "0", CVAR_FLOAT, "Don't call into the sound system for amplitudes" );
+idCVar binaryLoadMaterials( "binaryLoadMaterials", "1", CVAR_BOOL, "enable binary load/write of materials in generated/decls" );
+
+static const byte BMTR_VERSION = 102;
+static const unsigned int BMTR_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'T' << 8 ) | BMTR_VERSION;
 
 /*
 =============
@@ -2592,6 +2596,12 @@ void idMaterial::ParseMaterial( idLexer& src )
 			SetMaterialFlag( MF_NOSHADOWS );
 			continue;
 		}
+		// opaque surfaces that must never hide what is behind them, like ones that are hidden by a stage condition
+		else if( !token.Icmp( "noOccluder" ) )
+		{
+			SetMaterialFlag( MF_NOOCCLUDER );
+			continue;
+		}
 		else if( !token.Icmp( "suppressInSubview" ) )
 		{
 			suppressInSubview = true;
@@ -2987,6 +2997,39 @@ bool idMaterial::Parse( const char* text, const int textLength, bool allowBinary
 	idToken	token;
 	mtrParsingData_t parsingData;
 
+	// materials can be found from the job threads, but the file system is only used from the main thread
+	allowBinaryVersion = allowBinaryVersion && binaryLoadMaterials.GetBool() && idLib::IsMainThread();
+
+	unsigned int sourceChecksum = 0;
+	idStrStatic< MAX_OSPATH > generatedFileName;
+	if( allowBinaryVersion )
+	{
+		// Try to load the generated version of it
+		// If successful,
+		// - Create an MD5 of the hash of the source
+		// - Load the MD5 of the generated, if they differ, create a new generated
+		generatedFileName = "generated/decls/materials/";
+		generatedFileName.AppendPath( GetName() );
+		generatedFileName.Append( ".bmtr" );
+
+		idFileLocal file( fileSystem->OpenFileReadMemory( generatedFileName ) );
+		sourceChecksum = MD5_BlockChecksum( text, textLength );
+
+		CommonInit();
+		if( LoadBinary( file, sourceChecksum ) )
+		{
+			// if we are doing an fs_copyfiles, also reference the editorImage
+			if( cvarSystem->GetCVarInteger( "fs_copyFiles" ) )
+			{
+				GetEditorImage();
+			}
+			return true;
+		}
+
+		// throw away anything a stale or truncated binary left behind
+		FreeData();
+	}
+
 	src.LoadMemory( text, textLength, GetFileName(), GetLineNum() );
 	src.SetFlags( DECL_LEXER_FLAGS );
 	src.SkipUntilString( "{" );
@@ -3221,11 +3264,13 @@ bool idMaterial::Parse( const char* text, const int textLength, bool allowBinary
 
 	// see if the registers are completely constant, and don't need to be evaluated
 	// per-surface
-	CheckForConstantRegisters();
+	CheckForConstantRegisters( pd->registersAreConstant );
 
 	// See if the material is trivial for the fast path
 	SetFastPathImages();
 
+	const bool registersAreConstant = pd->registersAreConstant;
+
 	pd = NULL;	// the pointer will be invalid after exiting this function
 
 	// finish things up
@@ -3234,9 +3279,426 @@ bool idMaterial::Parse( const char* text, const int textLength, bool allowBinary
 		MakeDefault();
 		return false;
 	}
+
+	if( allowBinaryVersion && CanWriteBinary() && !fileSystem->UsingResourceFiles() )
+	{
+		declManager->MediaPrint( "writing %s\n", generatedFileName.c_str() );
+		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+		WriteBinary( outputFile, sourceChecksum, registersAreConstant );
+	}
+	return true;
+}
+
+/*
+===============
+R_WriteMaterialImage
+
+Images are stored with the parameters they were created with, so loading a
+binary material finds or creates the same image that parsing it would have.
+===============
+*/
+static void R_WriteMaterialImage( idFile* file, const idImage* image )
+{
+	if( image == NULL )
+	{
+		file->WriteString( "" );
+		return;
+	}
+	file->WriteString( image->GetName() );
+	file->WriteBig( image->GetFilter() );
+	file->WriteBig( image->GetRepeat() );
+	file->WriteBig( image->GetUsage() );
+	file->WriteBig( image->GetCubeFiles() );
+	file->WriteBig( image->GetCubeMapSize() );
+}
+
+/*
+===============
+R_ReadMaterialImage
+===============
+*/
+static idImage* R_ReadMaterialImage( idFile* file )
+{
+	idStr name;
+	file->ReadString( name );
+	if( name.IsEmpty() )
+	{
+		return NULL;
+	}
+
+	textureFilter_t filter;
+	textureRepeat_t repeat;
+	textureUsage_t usage;
+	cubeFiles_t cubeFiles;
+	int cubeMapSize;
+	file->ReadBig( filter );
+	file->ReadBig( repeat );
+	file->ReadBig( usage );
+	file->ReadBig( cubeFiles );
+	file->ReadBig( cubeMapSize );
+
+	return globalImages->ImageFromFile( name, filter, repeat, usage, cubeFiles, cubeMapSize );
+}
+
+/*
+===============
+idMaterial::CanWriteBinary
+
+Cinematics, guis and program stages hold references that can't be
+recreated from a binary file, so those materials are always parsed.
+===============
+*/
+bool idMaterial::CanWriteBinary() const
+{
+	if( gui != NULL )
+	{
+		return false;
+	}
+	for( int i = 0; i < numStages; i++ )
+	{
+		if( stages[i].texture.cinematic != NULL || stages[i].newStage != NULL )
+		{
+			return false;
+		}
+	}
 	return true;
 }
 
+/*
+===============
+idMaterial::LoadBinary
+
+Returns false if the file is stale or damaged, the caller parses the source text instead.
+===============
+*/
+bool idMaterial::LoadBinary( idFile* file, unsigned int checksum )
+{
+	if( file == NULL )
+	{
+		return false;
+	}
+
+	// the file ends with its own length and the magic, so a truncated file is rejected before reading any of it
+	static const int BMTR_TRAILER_SIZE = 2 * sizeof( unsigned int );
+	const int fileLength = file->Length();
+	if( fileLength < BMTR_TRAILER_SIZE )
+	{
+		return false;
+	}
+	unsigned int trailerLength = 0;
+	unsigned int trailerMagic = 0;
+	file->Seek( fileLength - BMTR_TRAILER_SIZE, FS_SEEK_SET );
+	if( file->ReadBig( trailerLength ) != sizeof( trailerLength ) || file->ReadBig( trailerMagic ) != sizeof( trailerMagic ) ||
+			trailerLength != ( unsigned int )fileLength || trailerMagic != BMTR_MAGIC )
+	{
+		return false;
+	}
+	file->Seek( 0, FS_SEEK_SET );
+
+	unsigned int magic = 0;
+	file->ReadBig( magic );
+	if( magic != BMTR_MAGIC )
+	{
+		return false;
+	}
+
+	unsigned int loadedChecksum;
+	file->ReadBig( loadedChecksum );
+	if( checksum != loadedChecksum && !fileSystem->InProductionMode() )
+	{
+		return false;
+	}
+
+	// twoSided surfaces only cast shadows with shadow mapping
+	bool shadowMapping;
+	file->ReadBool( shadowMapping );
+	if( shadowMapping != r_useShadowMapping.GetBool() )
+	{
+		return false;
+	}
+
+	file->ReadString( desc );
+	file->ReadString( renderBump );
+	file->ReadString( editorImageName );
+	lightFalloffImage = R_ReadMaterialImage( file );
+
+	file->ReadBig( entityGui );
+	file->ReadBool( noFog );
+	file->ReadBig( spectrum );
+	file->ReadFloat( polygonOffset );
+	file->ReadBig( contentFlags );
+	file->ReadBig( surfaceFlags );
+	file->ReadBig( materialFlags );
+
+	file->ReadBig( decalInfo.stayTime );
+	file->ReadBig( decalInfo.fadeTime );
+	file->ReadBigArray( decalInfo.start, 4 );
+	file->ReadBigArray( decalInfo.end, 4 );
+
+	file->ReadFloat( sort );
+	file->ReadBig( stereoEye );
+	file->ReadBig( deform );
+	file->ReadBigArray( deformRegisters, 4 );
+
+	int deformDeclType;
+	idStr deformDeclName;
+	file->ReadBig( deformDeclType );
+	file->ReadString( deformDeclName );
+	if( !deformDeclName.IsEmpty() )
+	{
+		deformDecl = declManager->FindType( ( declType_t )deformDeclType, deformDeclName, true );
+	}
+	file->ReadBigArray( texGenRegisters, MAX_TEXGEN_REGISTERS );
+
+	file->ReadBig( coverage );
+	file->ReadBig( cullType );
+	file->ReadBig( subViewType );
+	file->ReadBool( shouldCreateBackSides );
+	file->ReadBool( fogLight );
+	file->ReadBool( blendLight );
+	file->ReadBool( ambientLight );
+	file->ReadBool( unsmoothedTangents );
+	file->ReadBool( mikktspace );
+	file->ReadBool( hasSubview );
+	file->ReadBool( allowOverlays );
+	file->ReadFloat( editorAlpha );
+	file->ReadBool( suppressInSubview );
+	file->ReadBool( portalSky );
+
+	bool registersAreConstant;
+	file->ReadBool( registersAreConstant );
+
+	file->ReadBig( numOps );
+	file->ReadBig( numRegisters );
+	file->ReadBig( numStages );
+	file->ReadBig( numAmbientStages );
+	if( numOps < 0 || numOps > MAX_EXPRESSION_OPS || numRegisters < 0 || numRegisters > MAX_EXPRESSION_REGISTERS ||
+			numStages < 0 || numStages > MAX_SHADER_STAGES )
+	{
+		numOps = numRegisters = numStages = 0;
+		return false;
+	}
+
+	if( numOps )
+	{
+		ops = ( expOp_t* )R_StaticAlloc( numOps * sizeof( ops[0] ), TAG_MATERIAL );
+	}
+	for( int i = 0; i < numOps; i++ )
+	{
+		expOp_t* op = &ops[i];
+		file->ReadBig( op->opType );
+		if( op->opType == OP_TYPE_TABLE )
+		{
+			// table indexes depend on the decl load order, so tables are stored by name
+			idStr tableName;
+			file->ReadString( tableName );
+			const idDecl* table = declManager->FindType( DECL_TABLE, tableName, false );
+			if( table == NULL )
+			{
+				return false;
+			}
+			op->a = table->Index();
+		}
+		else
+		{
+			file->ReadBig( op->a );
+		}
+		file->ReadBig( op->b );
+		file->ReadBig( op->c );
+	}
+
+	if( numRegisters )
+	{
+		expressionRegisters = ( float* )R_StaticAlloc( numRegisters * sizeof( expressionRegisters[0] ), TAG_MATERIAL );
+		file->ReadBigArray( expressionRegisters, numRegisters );
+	}
+
+	if( numStages )
+	{
+		stages = ( shaderStage_t* )R_ClearedStaticAlloc( numStages * sizeof( stages[0] ) );
+	}
+	for( int i = 0; i < numStages; i++ )
+	{
+		shaderStage_t* ss = &stages[i];
+		file->ReadBig( ss->conditionRegister );
+		file->ReadBig( ss->lighting );
+		file->ReadBig( ss->drawStateBits );
+		file->ReadBigArray( ss->color.registers, 4 );
+		file->ReadBool( ss->hasAlphaTest );
+		file->ReadBig( ss->alphaTestRegister );
+
+		textureStage_t* ts = &ss->texture;
+		ts->image = R_ReadMaterialImage( file );
+		file->ReadBig( ts->texgen );
+		file->ReadBool( ts->hasMatrix );
+		file->ReadBigArray( &ts->matrix[0][0], 6 );
+		file->ReadBig( ts->dynamic );
+		file->ReadBig( ts->width );
+		file->ReadBig( ts->height );
+
+		file->ReadBig( ss->vertexColor );
+		file->ReadBool( ss->ignoreAlphaTest );
+		file->ReadFloat( ss->privatePolygonOffset );
+
+		bool hasStencil;
+		file->ReadBool( hasStencil );
+		if( hasStencil )
+		{
+			ss->stencilStage = ( stencilStage_t* )Mem_Alloc( sizeof( stencilStage_t ), TAG_MATERIAL );
+			*ss->stencilStage = stencilStage_t();
+			file->ReadBig( ss->stencilStage->ref );
+			file->ReadBig( ss->stencilStage->readMask );
+			file->ReadBig( ss->stencilStage->writeMask );
+			file->ReadBig( ss->stencilStage->comp );
+			file->ReadBig( ss->stencilStage->pass );
+			file->ReadBig( ss->stencilStage->fail );
+			file->ReadBig( ss->stencilStage->zFail );
+		}
+	}
+
+	// anything but the trailer left over means the file doesn't match this version of the reader
+	if( file->Tell() != fileLength - BMTR_TRAILER_SIZE )
+	{
+		return false;
+	}
+
+	CheckForConstantRegisters( registersAreConstant );
+	SetFastPathImages();
+
+	return true;
+}
+
+/*
+===============
+idMaterial::WriteBinary
+===============
+*/
+void idMaterial::WriteBinary( idFile* file, unsigned int checksum, bool registersAreConstant ) const
+{
+	if( file == NULL )
+	{
+		return;
+	}
+
+	file->WriteBig( BMTR_MAGIC );
+	file->WriteBig( checksum );
+	file->WriteBool( r_useShadowMapping.GetBool() );
+
+	file->WriteString( desc );
+	file->WriteString( renderBump );
+	file->WriteString( editorImageName );
+	R_WriteMaterialImage( file, lightFalloffImage );
+
+	file->WriteBig( entityGui );
+	file->WriteBool( noFog );
+	file->WriteBig( spectrum );
+	file->WriteFloat( polygonOffset );
+	file->WriteBig( contentFlags );
+	file->WriteBig( surfaceFlags );
+	file->WriteBig( materialFlags );
+
+	file->WriteBig( decalInfo.stayTime );
+	file->WriteBig( decalInfo.fadeTime );
+	file->WriteBigArray( decalInfo.start, 4 );
+	file->WriteBigArray( decalInfo.end, 4 );
+
+	file->WriteFloat( sort );
+	file->WriteBig( stereoEye );
+	file->WriteBig( deform );
+	file->WriteBigArray( deformRegisters, 4 );
+	if( deformDecl != NULL )
+	{
+		file->WriteBig( ( int )deformDecl->GetType() );
+		file->WriteString( deformDecl->GetName() );
+	}
+	else
+	{
+		file->WriteBig( ( int )DECL_MAX_TYPES );
+		file->WriteString( "" );
+	}
+	file->WriteBigArray( texGenRegisters, MAX_TEXGEN_REGISTERS );
+
+	file->WriteBig( coverage );
+	file->WriteBig( cullType );
+	file->WriteBig( subViewType );
+	file->WriteBool( shouldCreateBackSides );
+	file->WriteBool( fogLight );
+	file->WriteBool( blendLight );
+	file->WriteBool( ambientLight );
+	file->WriteBool( unsmoothedTangents );
+	file->WriteBool( mikktspace );
+	file->WriteBool( hasSubview );
+	file->WriteBool( allowOverlays );
+	file->WriteFloat( editorAlpha );
+	file->WriteBool( suppressInSubview );
+	file->WriteBool( portalSky );
+
+	file->WriteBool( registersAreConstant );
+
+	file->WriteBig( numOps );
+	file->WriteBig( numRegisters );
+	file->WriteBig( numStages );
+	file->WriteBig( numAmbientStages );
+
+	for( int i = 0; i < numOps; i++ )
+	{
+		const expOp_t* op = &ops[i];
+		file->WriteBig( op->opType );
+		if( op->opType == OP_TYPE_TABLE )
+		{
+			file->WriteString( declManager->DeclByIndex( DECL_TABLE, op->a, false )->GetName() );
+		}
+		else
+		{
+			file->WriteBig( op->a );
+		}
+		file->WriteBig( op->b );
+		file->WriteBig( op->c );
+	}
+
+	file->WriteBigArray( expressionRegisters, numRegisters );
+
+	for( int i = 0; i < numStages; i++ )
+	{
+		const shaderStage_t* ss = &stages[i];
+		file->WriteBig( ss->conditionRegister );
+		file->WriteBig( ss->lighting );
+		file->WriteBig( ss->drawStateBits );
+		file->WriteBigArray( ss->color.registers, 4 );
+		file->WriteBool( ss->hasAlphaTest );
+		file->WriteBig( ss->alphaTestRegister );
+
+		const textureStage_t* ts = &ss->texture;
+		R_WriteMaterialImage( file, ts->image );
+		file->WriteBig( ts->texgen );
+		file->WriteBool( ts->hasMatrix );
+		file->WriteBigArray( &ts->matrix[0][0], 6 );
+		file->WriteBig( ts->dynamic );
+		file->WriteBig( ts->width );
+		file->WriteBig( ts->height );
+
+		file->WriteBig( ss->vertexColor );
+		file->WriteBool( ss->ignoreAlphaTest );
+		file->WriteFloat( ss->privatePolygonOffset );
+
+		file->WriteBool( ss->stencilStage != NULL );
+		if( ss->stencilStage != NULL )
+		{
+			file->WriteBig( ss->stencilStage->ref );
+			file->WriteBig( ss->stencilStage->readMask );
+			file->WriteBig( ss->stencilStage->writeMask );
+			file->WriteBig( ss->stencilStage->comp );
+			file->WriteBig( ss->stencilStage->pass );
+			file->WriteBig( ss->stencilStage->fail );
+			file->WriteBig( ss->stencilStage->zFail );
+		}
+	}
+
+	// trailer checked by LoadBinary
+	file->WriteBig( ( unsigned int )( file->Tell() + 2 * sizeof( unsigned int ) ) );
+	file->WriteBig( BMTR_MAGIC );
+}
+
 /*
 ===================
 idMaterial::Print
@@ -3572,11 +4034,11 @@ As of 5/2/03, about half of the unique materials loaded on typical
 maps are constant, but 2/3 of the surface references are.
 ==================
 */
-void idMaterial::CheckForConstantRegisters()
+void idMaterial::CheckForConstantRegisters( bool registersAreConstant )
 {
 	assert( constantRegisters == NULL );
 
-	if( !pd->registersAreConstant )
+	if( !registersAreConstant )
 	{
 		return;
 	}
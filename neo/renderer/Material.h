@@ -360,6 +360,7 @@ typedef enum
 	MF_GUITARGET				= BIT( 12 ), // Admer: this GUI surface is used to compute a GUI render map, but a GUI should NOT be drawn on it
 	MF_AUTOGEN_TEMPLATE			= BIT( 13 ), // Admer: this material is a template for auto-generated templates
 	MF_ORIGIN					= BIT( 14 ), // Admer: for origin brushes
+	MF_NOOCCLUDER				= BIT( 15 ), // never rasterized into the software occlusion buffer
 } materialFlags_t;
 
 // contents flags, NOTE: make sure to keep the defines in doom_defs.script up to date with these!
@@ -972,9 +973,14 @@ private:
 	void				MultiplyTextureMatrix( textureStage_t* ts, int registers[2][3] );	// FIXME: for some reason the const is bad for gcc and Mac
 	void				SortInteractionStages();
 	void				AddImplicitStages( const textureRepeat_t trpDefault = TR_REPEAT );
-	void				CheckForConstantRegisters();
+	void				CheckForConstantRegisters( bool registersAreConstant );
 	void				SetFastPathImages();
 
+	// generated/decls binary, loaded instead of re-parsing, written if the MD5 of the source text differs
+	bool				LoadBinary( idFile* file, unsigned int checksum );
+	void				WriteBinary( idFile* file, unsigned int checksum, bool registersAreConstant ) const;
+	bool				CanWriteBinary() const;
+
 private:
 	idStr				desc;				// description
 	idStr				renderBump;			// renderbump command options, without the "renderbump" at the start
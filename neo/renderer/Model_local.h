@@ -182,7 +182,8 @@ public:
 	}
 
 	void						UpdateSurface( const struct renderEntity_s* ent, const idJointMat* joints,
-			const idJointMat* entJointsInverted, modelSurface_t* surf );
+			const idJointMat* entJointsInverted, modelSurface_t* surf,
+			const idDrawVert* skinnedVerts, const idBounds* skinnedBounds );
 	void						CalculateBounds( const idJointMat* entJoints, idBounds& bounds ) const;
 	int							NearestJoint( int a, int b, int c ) const;
 
@@ -197,9 +198,26 @@ private:
 	int							surfaceNum;			// number of the static surface created for this mesh
 };
 
+// skinning of a joint pose, shared by the entities and views that instantiate the same md5 model
+// with exactly the same joints, see idRenderModelMD5::InstantiateDynamicModel
+struct md5SkinnedPose_t
+{
+	unsigned int					hash;
+	int								lastUsed;			// tr.frameCount of the last instantiation that used the pose
+	bool							cpuSkinned;			// skinnedVerts hold the vertices transformed on the CPU
+	idList<idJointMat, TAG_JOINTMAT>	joints;			// entity joints the pose was created from
+	idList<idJointMat, TAG_JOINTMAT>	jointsInverted;
+	idList<idBounds, TAG_MODEL>		meshBounds;
+	idList<bool, TAG_MODEL>			meshValid;			// false for meshes that were skipped because of a skin
+	idList<int, TAG_MODEL>			meshFirstVert;
+	idList<idDrawVert, TAG_MODEL>	skinnedVerts;
+};
+
 class idRenderModelMD5 : public idRenderModelStatic
 {
 public:
+	virtual						~idRenderModelMD5();
+
 	virtual void				InitFromFile( const char* fileName );
 	virtual bool				LoadBinaryModel( idFile* file, const ID_TIME_T sourceTimeStamp );
 	virtual void				WriteBinaryModel( idFile* file, ID_TIME_T* _timeStamp = NULL ) const;
@@ -230,8 +248,16 @@ private:
 	idList<idJointMat, TAG_MODEL>	invertedDefaultPose;
 	idList<idMD5Mesh, TAG_MODEL>	meshes;
 
+	idSysMutex					poseCacheMutex;
+	idList<md5SkinnedPose_t*, TAG_MODEL>	poseCache;		// recently instantiated poses, least recently used is replaced
+	idList<unsigned int, TAG_MODEL>	poseMisses;		// hashes of recently missed poses, a pose is only stored when it misses again
+
 	void						DrawJoints( const renderEntity_t* ent, const viewDef_t* view ) const;
 	void						ParseJoint( idLexer& parser, idMD5Joint* joint, idJointQuat* defaultPose );
+
+	const md5SkinnedPose_t*		FindSkinnedPose( unsigned int hash, const idJointMat* entJoints, bool cpuSkinning );
+	void						StoreSkinnedPose( unsigned int hash, const idJointMat* entJoints, const idRenderModelStatic* staticModel, bool cpuSkinning );
+	void						ClearPoseCache();
 };
 
 /*
@@ -47,6 +47,9 @@ static const byte MD5B_VERSION = 106;
 static const unsigned int MD5B_MAGIC = ( '5' << 24 ) | ( 'D' << 16 ) | ( 'M' << 8 ) | MD5B_VERSION;
 
 idCVar r_useGPUSkinning( "r_useGPUSkinning", "1", CVAR_INTEGER, "animate normals and tangents instead of deriving" );
+idCVar r_useMD5PoseCache( "r_useMD5PoseCache", "1", CVAR_RENDERER | CVAR_BOOL, "share the skinned surfaces and bounds of md5 models between entities and views with the same joint pose" );
+
+static const int MD5_MAX_CACHED_POSES = 8;
 
 /***********************************************************************
 
@@ -486,7 +489,8 @@ idMD5Mesh::UpdateSurface
 ====================
 */
 void idMD5Mesh::UpdateSurface( const struct renderEntity_s* ent, const idJointMat* entJoints,
-							   const idJointMat* entJointsInverted, modelSurface_t* surf )
+							   const idJointMat* entJointsInverted, modelSurface_t* surf,
+							   const idDrawVert* skinnedVerts, const idBounds* skinnedBounds )
 {
 
 	tr.pc.c_deformedSurfaces++;
@@ -552,12 +556,27 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s* ent, const idJointMa
 			assert( tri->verts != NULL );	// quiet analyze warning
 			memcpy( tri->verts, deformInfo->verts, deformInfo->numOutputVerts * sizeof( deformInfo->verts[0] ) );	// copy over the texture coordinates
 		}
-		TransformVertsAndTangents( tri->verts, deformInfo->numOutputVerts, deformInfo->verts, entJointsInverted );
+		if( skinnedVerts != NULL )
+		{
+			// another entity already skinned this pose
+			memcpy( tri->verts, skinnedVerts, deformInfo->numOutputVerts * sizeof( tri->verts[0] ) );
+		}
+		else
+		{
+			TransformVertsAndTangents( tri->verts, deformInfo->numOutputVerts, deformInfo->verts, entJointsInverted );
+		}
 		tri->referencedVerts = false;
 	}
 	tri->tangentsCalculated = true;
 
-	CalculateBounds( entJoints, tri->bounds );
+	if( skinnedBounds != NULL )
+	{
+		tri->bounds = *skinnedBounds;
+	}
+	else
+	{
+		CalculateBounds( entJoints, tri->bounds );
+	}
 }
 
 /*
@@ -664,6 +683,16 @@ int idMD5Mesh::NearestJoint( int a, int b, int c ) const
 
 ***********************************************************************/
 
+/*
+====================
+idRenderModelMD5::~idRenderModelMD5
+====================
+*/
+idRenderModelMD5::~idRenderModelMD5()
+{
+	ClearPoseCache();
+}
+
 /*
 ====================
 idRenderModelMD5::ParseJoint
@@ -733,6 +762,8 @@ bool idRenderModelMD5::LoadBinaryModel( idFile* file, const ID_TIME_T sourceTime
 		return false;
 	}
 
+	ClearPoseCache();
+
 	int tempNum;
 	file->ReadBig( tempNum );
 	joints.SetNum( tempNum );
@@ -1514,6 +1545,23 @@ static void TransformJoints( idJointMat* __restrict outJoints, const int numJoin
 #endif
 }
 
+/*
+====================
+R_HashJoints
+====================
+*/
+static unsigned int R_HashJoints( const idJointMat* joints, const int numJoints )
+{
+	const unsigned int* words = reinterpret_cast<const unsigned int*>( joints );
+	const int numWords = numJoints * sizeof( idJointMat ) / sizeof( words[0] );
+	unsigned int hash = 2166136261u;
+	for( int i = 0; i < numWords; i++ )
+	{
+		hash = ( hash ^ words[i] ) * 16777619u;
+	}
+	return hash;
+}
+
 /*
 ====================
 idRenderModelMD5::InstantiateDynamicModel
@@ -1579,6 +1627,24 @@ idRenderModel* idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		}
 	}
 
+	// look for an entity or view that already instantiated this pose
+	const bool cpuSkinning = !( r_useGPUSkinning.GetBool() && glConfig.gpuSkinningAvailable );
+	const bool usePoseCache = r_useMD5PoseCache.GetBool();
+	unsigned int poseHash = 0;
+	const md5SkinnedPose_t* pose = NULL;
+	if( usePoseCache )
+	{
+		poseHash = R_HashJoints( ent->joints, joints.Num() );
+
+		// the lock is held until the pose has been copied, so it can't be replaced meanwhile
+		poseCacheMutex.Lock();
+		pose = FindSkinnedPose( poseHash, ent->joints, cpuSkinning );
+		if( pose == NULL )
+		{
+			poseCacheMutex.Unlock();
+		}
+	}
+
 	// update the GPU joints array
 	const int numInvertedJoints = SIMD_ROUND_JOINTS( joints.Num() );
 	if( staticModel->jointsInverted == NULL )
@@ -1593,7 +1659,14 @@ idRenderModel* idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		assert( staticModel->numInvertedJoints == numInvertedJoints );
 	}
 
-	TransformJoints( staticModel->jointsInverted, joints.Num(), ent->joints, invertedDefaultPose.Ptr() );
+	if( pose != NULL )
+	{
+		memcpy( staticModel->jointsInverted, pose->jointsInverted.Ptr(), joints.Num() * sizeof( staticModel->jointsInverted[0] ) );
+	}
+	else
+	{
+		TransformJoints( staticModel->jointsInverted, joints.Num(), ent->joints, invertedDefaultPose.Ptr() );
+	}
 
 	// create all the surfaces
 	idMD5Mesh* mesh = meshes.Ptr();
@@ -1628,7 +1701,18 @@ idRenderModel* idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, staticModel->jointsInverted, surf );
+		const idDrawVert* skinnedVerts = NULL;
+		const idBounds* skinnedBounds = NULL;
+		if( pose != NULL && pose->meshValid[i] )
+		{
+			skinnedBounds = &pose->meshBounds[i];
+			if( cpuSkinning )
+			{
+				skinnedVerts = &pose->skinnedVerts[pose->meshFirstVert[i]];
+			}
+		}
+
+		mesh->UpdateSurface( ent, ent->joints, staticModel->jointsInverted, surf, skinnedVerts, skinnedBounds );
 		assert( surf->geometry != NULL );	// to get around compiler warning
 
 		// the deformation of the tangents can be deferred until each surface is added to the view
@@ -1637,9 +1721,146 @@ idRenderModel* idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		staticModel->bounds.AddBounds( surf->geometry->bounds );
 	}
 
+	if( pose != NULL )
+	{
+		tr.pc.c_md5PoseCacheHits++;
+		poseCacheMutex.Unlock();
+	}
+	else if( usePoseCache )
+	{
+		idScopedCriticalSection lock( poseCacheMutex );
+		tr.pc.c_md5PoseCacheMisses++;
+		StoreSkinnedPose( poseHash, ent->joints, staticModel, cpuSkinning );
+	}
+
 	return staticModel;
 }
 
+/*
+====================
+idRenderModelMD5::FindSkinnedPose
+
+Returns the cached pose created from exactly the same joints, the caller must hold the pose cache lock.
+====================
+*/
+const md5SkinnedPose_t* idRenderModelMD5::FindSkinnedPose( unsigned int hash, const idJointMat* entJoints, bool cpuSkinning )
+{
+	for( int i = 0; i < poseCache.Num(); i++ )
+	{
+		md5SkinnedPose_t* pose = poseCache[i];
+		if( pose->hash != hash || pose->cpuSkinned != cpuSkinning || pose->joints.Num() != joints.Num() || pose->meshValid.Num() != meshes.Num() )
+		{
+			continue;
+		}
+		if( memcmp( pose->joints.Ptr(), entJoints, joints.Num() * sizeof( entJoints[0] ) ) != 0 )
+		{
+			continue;
+		}
+		pose->lastUsed = tr.frameCount;
+		return pose;
+	}
+	return NULL;
+}
+
+/*
+====================
+idRenderModelMD5::StoreSkinnedPose
+
+Copies the skinning of a freshly instantiated snapshot into the pose cache, replacing the least
+recently used pose. A pose is only copied the second time it misses, so poses that are never
+shared don't pay for the copy. The caller must hold the pose cache lock.
+====================
+*/
+void idRenderModelMD5::StoreSkinnedPose( unsigned int hash, const idJointMat* entJoints, const idRenderModelStatic* staticModel, bool cpuSkinning )
+{
+	if( FindSkinnedPose( hash, entJoints, cpuSkinning ) != NULL )
+	{
+		// another thread instantiated the same pose meanwhile
+		return;
+	}
+
+	const int missIndex = poseMisses.FindIndex( hash );
+	if( missIndex == -1 )
+	{
+		if( poseMisses.Num() >= MD5_MAX_CACHED_POSES )
+		{
+			poseMisses.RemoveIndex( 0 );
+		}
+		poseMisses.Append( hash );
+		return;
+	}
+	poseMisses.RemoveIndex( missIndex );
+
+	md5SkinnedPose_t* pose;
+	if( poseCache.Num() < MD5_MAX_CACHED_POSES )
+	{
+		pose = new( TAG_MODEL ) md5SkinnedPose_t;
+		poseCache.Append( pose );
+	}
+	else
+	{
+		pose = poseCache[0];
+		for( int i = 1; i < poseCache.Num(); i++ )
+		{
+			if( poseCache[i]->lastUsed < pose->lastUsed )
+			{
+				pose = poseCache[i];
+			}
+		}
+	}
+
+	pose->hash = hash;
+	pose->lastUsed = tr.frameCount;
+	pose->cpuSkinned = cpuSkinning;
+
+	pose->joints.SetNum( joints.Num() );
+	memcpy( pose->joints.Ptr(), entJoints, joints.Num() * sizeof( entJoints[0] ) );
+	pose->jointsInverted.SetNum( joints.Num() );
+	memcpy( pose->jointsInverted.Ptr(), staticModel->jointsInverted, joints.Num() * sizeof( staticModel->jointsInverted[0] ) );
+
+	pose->meshBounds.SetNum( meshes.Num() );
+	pose->meshValid.SetNum( meshes.Num() );
+	pose->meshFirstVert.SetNum( meshes.Num() );
+
+	int numVerts = 0;
+	for( int i = 0; i < meshes.Num(); i++ )
+	{
+		pose->meshFirstVert[i] = numVerts;
+		numVerts += meshes[i].deformInfo->numOutputVerts;
+	}
+	pose->skinnedVerts.SetNum( cpuSkinning ? numVerts : 0 );
+
+	for( int i = 0; i < meshes.Num(); i++ )
+	{
+		// meshes that were skipped because of a skin are marked invalid, entities finding this pose skin them themselves
+		int surfaceNum;
+		if( !staticModel->FindSurfaceWithId( i, surfaceNum ) )
+		{
+			pose->meshValid[i] = false;
+			continue;
+		}
+		const srfTriangles_t* tri = staticModel->surfaces[surfaceNum].geometry;
+		pose->meshValid[i] = true;
+		pose->meshBounds[i] = tri->bounds;
+		if( cpuSkinning )
+		{
+			memcpy( &pose->skinnedVerts[pose->meshFirstVert[i]], tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+		}
+	}
+}
+
+/*
+====================
+idRenderModelMD5::ClearPoseCache
+====================
+*/
+void idRenderModelMD5::ClearPoseCache()
+{
+	idScopedCriticalSection lock( poseCacheMutex );
+	poseCache.DeleteContents( true );
+	poseMisses.Clear();
+}
+
 /*
 ====================
 idRenderModelMD5::IsDynamicModel
@@ -1768,6 +1989,7 @@ void idRenderModelMD5::PurgeModel()
 	joints.Clear();
 	defaultPose.Clear();
 	meshes.Clear();
+	ClearPoseCache();
 }
 
 /*
@@ -1780,6 +2002,14 @@ int	idRenderModelMD5::Memory() const
 	int total = sizeof( *this );
 	total += joints.MemoryUsed() + defaultPose.MemoryUsed() + meshes.MemoryUsed();
 
+	// count up cached poses
+	for( int i = 0; i < poseCache.Num(); i++ )
+	{
+		const md5SkinnedPose_t* pose = poseCache[i];
+		total += sizeof( *pose ) + pose->joints.MemoryUsed() + pose->jointsInverted.MemoryUsed() + pose->meshBounds.MemoryUsed();
+		total += pose->meshValid.MemoryUsed() + pose->meshFirstVert.MemoryUsed() + pose->skinnedVerts.MemoryUsed();
+	}
+
 	// count up strings
 	for( int i = 0; i < joints.Num(); i++ )
 	{
@@ -0,0 +1,481 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "RenderCommon.h"
+
+// clip space triangles are clipped to a guard band this many times the view size, so the
+// screen space edge functions never have to deal with huge coordinates
+static const float OCCLUSION_GUARD_BAND = 2.0f;
+
+// an occluder must be this much nearer (as a fraction of the distance) than the nearest
+// point of the bounds, so interpolation errors never hide surfaces that touch an occluder
+static const float OCCLUSION_DEPTH_BIAS = 1.001f;
+
+static const int MAX_OCCLUDER_CLIP_VERTS = 3 + 5;
+
+/*
+========================
+idOcclusionBuffer::idOcclusionBuffer
+========================
+*/
+idOcclusionBuffer::idOcclusionBuffer()
+{
+	mvp.Identity();
+	zNear = 1.0f;
+	numRasterizedTris = 0;
+	depth = ( float* )Mem_Alloc16( WIDTH * HEIGHT * sizeof( depth[0] ), TAG_RENDER );
+	memset( depth, 0, WIDTH * HEIGHT * sizeof( depth[0] ) );
+}
+
+/*
+========================
+idOcclusionBuffer::~idOcclusionBuffer
+========================
+*/
+idOcclusionBuffer::~idOcclusionBuffer()
+{
+	Mem_Free16( depth );
+}
+
+/*
+========================
+idOcclusionBuffer::Clear
+========================
+*/
+void idOcclusionBuffer::Clear( const idRenderMatrix& mvp_, float zNear_ )
+{
+	mvp = mvp_;
+	zNear = zNear_;
+	numRasterizedTris = 0;
+	memset( depth, 0, WIDTH * HEIGHT * sizeof( depth[0] ) );
+}
+
+/*
+========================
+idOcclusionBuffer::RasterizeTriangles
+========================
+*/
+int idOcclusionBuffer::RasterizeTriangles( const idVec3* verts, const int* indexes, const idPlane* facePlanes, int numIndexes, const idVec3& viewOrigin )
+{
+	int numTris = 0;
+	for( int i = 0, face = 0; i < numIndexes; i += 3, face++ )
+	{
+		// skipping back faces can only remove occlusion, so it is always safe
+		if( facePlanes[face].Distance( viewOrigin ) < 0.0f )
+		{
+			continue;
+		}
+
+		ALIGNTYPE16 idVec4 clip[3];
+		mvp.TransformPoint( verts[indexes[i + 0]], clip[0] );
+		mvp.TransformPoint( verts[indexes[i + 1]], clip[1] );
+		mvp.TransformPoint( verts[indexes[i + 2]], clip[2] );
+
+		RasterizeClippedTriangle( clip );
+		numTris++;
+	}
+	numRasterizedTris += numTris;
+	return numTris;
+}
+
+/*
+========================
+R_OccluderClipDistance
+
+Distance to the near plane and the four guard band planes in clip space,
+positive on the inside.
+========================
+*/
+static ID_INLINE float R_OccluderClipDistance( const idVec4& v, int plane, float zNear )
+{
+	switch( plane )
+	{
+		case 0:
+			return v.w - zNear;
+		case 1:
+			return v.x + OCCLUSION_GUARD_BAND * v.w;
+		case 2:
+			return OCCLUSION_GUARD_BAND * v.w - v.x;
+		case 3:
+			return v.y + OCCLUSION_GUARD_BAND * v.w;
+		default:
+			return OCCLUSION_GUARD_BAND * v.w - v.y;
+	}
+}
+
+/*
+========================
+idOcclusionBuffer::RasterizeClippedTriangle
+========================
+*/
+void idOcclusionBuffer::RasterizeClippedTriangle( const idVec4 clip[3] )
+{
+	int clipBits[3];
+	for( int i = 0; i < 3; i++ )
+	{
+		clipBits[i] = 0;
+		for( int p = 0; p < 5; p++ )
+		{
+			clipBits[i] |= ( R_OccluderClipDistance( clip[i], p, zNear ) < 0.0f ) << p;
+		}
+	}
+
+	// completely outside one of the planes
+	if( clipBits[0] & clipBits[1] & clipBits[2] )
+	{
+		return;
+	}
+
+	idVec4 polygon[2][MAX_OCCLUDER_CLIP_VERTS];
+	int numPoints = 3;
+	int current = 0;
+	polygon[0][0] = clip[0];
+	polygon[0][1] = clip[1];
+	polygon[0][2] = clip[2];
+
+	const int crossedPlanes = clipBits[0] | clipBits[1] | clipBits[2];
+	for( int p = 0; p < 5; p++ )
+	{
+		if( !( crossedPlanes & ( 1 << p ) ) )
+		{
+			continue;
+		}
+
+		const idVec4* in = polygon[current];
+		idVec4* out = polygon[current ^ 1];
+		int numOut = 0;
+
+		for( int i = 0; i < numPoints; i++ )
+		{
+			const idVec4& v0 = in[i];
+			const idVec4& v1 = in[( i + 1 ) % numPoints];
+			const float d0 = R_OccluderClipDistance( v0, p, zNear );
+			const float d1 = R_OccluderClipDistance( v1, p, zNear );
+
+			if( d0 >= 0.0f )
+			{
+				out[numOut++] = v0;
+			}
+			if( ( d0 >= 0.0f ) != ( d1 >= 0.0f ) )
+			{
+				const float f = d0 / ( d0 - d1 );
+				out[numOut++] = v0 + ( v1 - v0 ) * f;
+			}
+		}
+
+		numPoints = numOut;
+		current ^= 1;
+		if( numPoints < 3 )
+		{
+			return;
+		}
+	}
+
+	// project to the buffer, z is 1/w
+	idVec3 screen[MAX_OCCLUDER_CLIP_VERTS];
+	for( int i = 0; i < numPoints; i++ )
+	{
+		const idVec4& v = polygon[current][i];
+		const float invW = 1.0f / v.w;
+		screen[i].x = ( v.x * invW * 0.5f + 0.5f ) * WIDTH;
+		screen[i].y = ( v.y * invW * 0.5f + 0.5f ) * HEIGHT;
+		screen[i].z = invW;
+	}
+
+	RasterizeScreenPolygon( screen, numPoints );
+}
+
+/*
+========================
+idOcclusionBuffer::RasterizeScreenPolygon
+
+Writes the farthest 1/w inside every pixel that is completely covered by the convex polygon.
+The clipped polygon is rasterized as a whole, splitting it into triangles would leave
+the pixels along the splitting edges uncovered.
+========================
+*/
+void idOcclusionBuffer::RasterizeScreenPolygon( const idVec3* screen, int numPoints )
+{
+	assert( numPoints >= 3 && numPoints <= MAX_OCCLUDER_CLIP_VERTS );
+
+	// edge functions E(x,y) = A * x + B * y + C, each one is zero on the edge from a vertex to the next
+	float a[MAX_OCCLUDER_CLIP_VERTS];
+	float b[MAX_OCCLUDER_CLIP_VERTS];
+	float c[MAX_OCCLUDER_CLIP_VERTS];
+	float area = 0.0f;
+	idVec2 mins( idMath::INFINITUM, idMath::INFINITUM );
+	idVec2 maxs( -idMath::INFINITUM, -idMath::INFINITUM );
+	for( int i = 0; i < numPoints; i++ )
+	{
+		const idVec3& v0 = screen[i];
+		const idVec3& v1 = screen[( i + 1 ) % numPoints];
+		a[i] = v0.y - v1.y;
+		b[i] = v1.x - v0.x;
+		c[i] = v0.x * v1.y - v0.y * v1.x;
+		area += c[i];
+		mins.x = Min( mins.x, v0.x );
+		mins.y = Min( mins.y, v0.y );
+		maxs.x = Max( maxs.x, v0.x );
+		maxs.y = Max( maxs.y, v0.y );
+	}
+	if( idMath::Fabs( area ) < 1e-6f )
+	{
+		return;
+	}
+
+	// pixels with their center inside the bounds of the polygon, pixels completely inside are a subset
+	const int minX = Max( idMath::Ftoi( ceilf( mins.x - 0.5f ) ), 0 );
+	const int maxX = Min( idMath::Ftoi( floorf( maxs.x - 0.5f ) ), WIDTH - 1 );
+	const int minY = Max( idMath::Ftoi( ceilf( mins.y - 0.5f ) ), 0 );
+	const int maxY = Min( idMath::Ftoi( floorf( maxs.y - 0.5f ) ), HEIGHT - 1 );
+	if( minX > maxX || minY > maxY )
+	{
+		return;
+	}
+
+	// 1/w is a plane in screen space, take it from the largest triangle of the fan
+	int bestTri = 2;
+	float bestArea = 0.0f;
+	for( int i = 2; i < numPoints; i++ )
+	{
+		const idVec3& v0 = screen[0];
+		const idVec3& v1 = screen[i - 1];
+		const idVec3& v2 = screen[i];
+		const float triArea = idMath::Fabs( ( v1.x - v0.x ) * ( v2.y - v0.y ) - ( v2.x - v0.x ) * ( v1.y - v0.y ) );
+		if( triArea > bestArea )
+		{
+			bestArea = triArea;
+			bestTri = i;
+		}
+	}
+	const idVec3& v0 = screen[0];
+	const idVec3& v1 = screen[bestTri - 1];
+	const idVec3& v2 = screen[bestTri];
+	const float triArea = ( v1.x - v0.x ) * ( v2.y - v0.y ) - ( v2.x - v0.x ) * ( v1.y - v0.y );
+	if( idMath::Fabs( triArea ) < 1e-6f )
+	{
+		return;
+	}
+	// the edge functions of the triangle divided by its area are the barycentric coordinates
+	const float invArea = 1.0f / triArea;
+	const float za = ( ( v1.y - v2.y ) * v0.z + ( v2.y - v0.y ) * v1.z + ( v0.y - v1.y ) * v2.z ) * invArea;
+	const float zb = ( ( v2.x - v1.x ) * v0.z + ( v0.x - v2.x ) * v1.z + ( v1.x - v0.x ) * v2.z ) * invArea;
+	const float z0 = v0.z - za * v0.x - zb * v0.y;
+	// store the farthest point of the polygon plane inside the pixel instead of the pixel center
+	const float zc = z0 - 0.5f * ( idMath::Fabs( za ) + idMath::Fabs( zb ) );
+
+	// Make the edge functions positive on the inside, and likewise only cover pixels that are
+	// completely inside the polygon by testing each edge function at the pixel corner nearest to
+	// the edge. A crack between two occluders is never closed that way.
+	const float orientation = ( area < 0.0f ) ? -1.0f : 1.0f;
+	for( int i = 0; i < numPoints; i++ )
+	{
+		a[i] *= orientation;
+		b[i] *= orientation;
+		c[i] = c[i] * orientation - 0.5f * ( idMath::Fabs( a[i] ) + idMath::Fabs( b[i] ) );
+	}
+
+	const int startX = minX & ~3;
+
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128 vector_float_zero = _mm_setzero_ps();
+	const __m128 vector_float_lane_offsets = _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+	const __m128 vector_float_four = _mm_set1_ps( 4.0f );
+	const __m128 vector_za = _mm_set1_ps( za );
+
+	__m128 vector_a[MAX_OCCLUDER_CLIP_VERTS];
+	for( int i = 0; i < numPoints; i++ )
+	{
+		vector_a[i] = _mm_set1_ps( a[i] );
+	}
+
+	for( int y = minY; y <= maxY; y++ )
+	{
+		const float py = y + 0.5f;
+		__m128 row_e[MAX_OCCLUDER_CLIP_VERTS];
+		for( int i = 0; i < numPoints; i++ )
+		{
+			row_e[i] = _mm_set1_ps( b[i] * py + c[i] );
+		}
+		const __m128 row_z = _mm_set1_ps( zb * py + zc );
+
+		float* row = depth + y * WIDTH;
+		__m128 px = _mm_add_ps( _mm_set1_ps( ( float )startX ), vector_float_lane_offsets );
+
+		for( int x = startX; x <= maxX; x += 4 )
+		{
+			__m128 inside = _mm_cmpge_ps( _mm_madd_ps( vector_a[0], px, row_e[0] ), vector_float_zero );
+			for( int i = 1; i < numPoints; i++ )
+			{
+				inside = _mm_and_ps( inside, _mm_cmpge_ps( _mm_madd_ps( vector_a[i], px, row_e[i] ), vector_float_zero ) );
+			}
+			const __m128 z = _mm_madd_ps( vector_za, px, row_z );
+
+			const __m128 old = _mm_load_ps( row + x );
+			_mm_store_ps( row + x, _mm_sel_ps( old, _mm_max_ps( old, z ), inside ) );
+
+			px = _mm_add_ps( px, vector_float_four );
+		}
+	}
+
+#else
+
+	for( int y = minY; y <= maxY; y++ )
+	{
+		const float py = y + 0.5f;
+		float* row = depth + y * WIDTH;
+
+		for( int x = minX; x <= maxX; x++ )
+		{
+			const float px = x + 0.5f;
+			int i = 0;
+			for( ; i < numPoints; i++ )
+			{
+				if( a[i] * px + b[i] * py + c[i] < 0.0f )
+				{
+					break;
+				}
+			}
+			if( i < numPoints )
+			{
+				continue;
+			}
+			row[x] = Max( row[x], za * px + zb * py + zc );
+		}
+	}
+
+#endif
+}
+
+/*
+========================
+idOcclusionBuffer::IsOccluded
+
+The nearest point of a box is always one of its corners, and as long as all corners are in
+front of the near plane the projected box is inside the rectangle of the projected corners.
+========================
+*/
+bool idOcclusionBuffer::IsOccluded( const idRenderMatrix& boundsMVP, const idBounds& bounds ) const
+{
+	if( numRasterizedTris == 0 )
+	{
+		return false;
+	}
+
+	float minX = idMath::INFINITUM;
+	float minY = idMath::INFINITUM;
+	float maxX = -idMath::INFINITUM;
+	float maxY = -idMath::INFINITUM;
+	float nearestInvW = 0.0f;
+
+	for( int i = 0; i < 8; i++ )
+	{
+		const idVec3 corner( bounds[( i >> 0 ) & 1][0], bounds[( i >> 1 ) & 1][1], bounds[( i >> 2 ) & 1][2] );
+		idVec4 clip;
+		boundsMVP.TransformPoint( corner, clip );
+
+		// anything reaching the near plane is too close to be hidden
+		if( clip.w <= zNear )
+		{
+			return false;
+		}
+
+		const float invW = 1.0f / clip.w;
+		const float x = ( clip.x * invW * 0.5f + 0.5f ) * WIDTH;
+		const float y = ( clip.y * invW * 0.5f + 0.5f ) * HEIGHT;
+		minX = Min( minX, x );
+		maxX = Max( maxX, x );
+		minY = Min( minY, y );
+		maxY = Max( maxY, y );
+		nearestInvW = Max( nearestInvW, invW );
+	}
+
+	if( maxX < 0.0f || minX > WIDTH || maxY < 0.0f || minY > HEIGHT )
+	{
+		// off screen, this is left to the frustum culling
+		return false;
+	}
+
+	// Every pixel the bounds touch must have an occluder in front of the nearest corner.
+	// Occluders only cover pixels they completely contain, so testing the touched pixels is enough.
+	const int x1 = Max( idMath::Ftoi( floorf( minX ) ), 0 );
+	const int x2 = Min( idMath::Ftoi( floorf( maxX ) ), WIDTH - 1 );
+	const int y1 = Max( idMath::Ftoi( floorf( minY ) ), 0 );
+	const int y2 = Min( idMath::Ftoi( floorf( maxY ) ), HEIGHT - 1 );
+
+	const float testInvW = nearestInvW * OCCLUSION_DEPTH_BIAS;
+	const int startX = x1 & ~3;
+
+#if defined(USE_INTRINSICS_SSE)
+
+	const __m128 vector_test = _mm_set1_ps( testInvW );
+	const __m128 vector_x1 = _mm_set1_ps( ( float )x1 );
+	const __m128 vector_x2 = _mm_set1_ps( ( float )x2 );
+	const __m128 vector_float_lanes = _mm_set_ps( 3.0f, 2.0f, 1.0f, 0.0f );
+	const __m128 vector_float_four = _mm_set1_ps( 4.0f );
+
+	for( int y = y1; y <= y2; y++ )
+	{
+		const float* row = depth + y * WIDTH;
+		__m128 px = _mm_add_ps( _mm_set1_ps( ( float )startX ), vector_float_lanes );
+
+		for( int x = startX; x <= x2; x += 4 )
+		{
+			__m128 visible = _mm_cmple_ps( _mm_load_ps( row + x ), vector_test );
+			visible = _mm_and_ps( visible, _mm_cmpge_ps( px, vector_x1 ) );
+			visible = _mm_and_ps( visible, _mm_cmple_ps( px, vector_x2 ) );
+			if( _mm_movemask_ps( visible ) != 0 )
+			{
+				return false;
+			}
+			px = _mm_add_ps( px, vector_float_four );
+		}
+	}
+
+#else
+
+	for( int y = y1; y <= y2; y++ )
+	{
+		const float* row = depth + y * WIDTH;
+		for( int x = x1; x <= x2; x++ )
+		{
+			if( row[x] <= testInvW )
+			{
+				return false;
+			}
+		}
+	}
+
+#endif
+
+	return true;
+}
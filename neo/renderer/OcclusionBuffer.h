@@ -0,0 +1,88 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __OCCLUSIONBUFFER_H__
+#define __OCCLUSIONBUFFER_H__
+
+/*
+================================================================================================
+
+idOcclusionBuffer
+
+A low resolution CPU depth buffer that large opaque world triangles are rasterized into,
+so entities, lights and shadows completely hidden behind them can be culled before any
+interactions or draw surfaces are created for them.
+
+The buffer stores 1/w of the nearest occluder at each pixel, which interpolates linearly
+in screen space and does not depend on the depth range of the projection. 0 means nothing
+was rasterized at that pixel. Occluders only cover the pixels they completely contain,
+with the farthest depth inside the pixel, so a crack between occluders is never closed.
+================================================================================================
+*/
+
+class idOcclusionBuffer
+{
+public:
+	static const int	WIDTH = 256;		// must be a multiple of 4
+	static const int	HEIGHT = 128;
+
+	idOcclusionBuffer();
+	~idOcclusionBuffer();
+
+	// clears the depth buffer and sets the matrix the occluders will be rasterized with
+	void				Clear( const idRenderMatrix& mvp, float zNear );
+
+	// rasterizes the triangles that face the view origin, returns the number of triangles that were not culled
+	int					RasterizeTriangles( const idVec3* verts, const int* indexes, const idPlane* facePlanes, int numIndexes, const idVec3& viewOrigin );
+
+	// returns true if the bounds transformed by the mvp are completely behind rasterized occluders
+	bool				IsOccluded( const idRenderMatrix& boundsMVP, const idBounds& bounds ) const;
+
+	bool				IsEmpty() const
+	{
+		return numRasterizedTris == 0;
+	}
+	int					GetNumRasterizedTriangles() const
+	{
+		return numRasterizedTris;
+	}
+	const float*		GetDepth() const
+	{
+		return depth;
+	}
+
+private:
+	void				RasterizeClippedTriangle( const idVec4 clip[3] );
+	void				RasterizeScreenPolygon( const idVec3* screen, int numPoints );
+
+	idRenderMatrix		mvp;
+	float				zNear;
+	int					numRasterizedTris;
+	float*				depth;				// 1/w of the nearest occluder, WIDTH * HEIGHT
+};
+
+#endif /* !__OCCLUSIONBUFFER_H__ */
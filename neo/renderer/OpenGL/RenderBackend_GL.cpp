@@ -584,42 +584,24 @@ void idRenderBackend::DrawElementsWithCounters( const drawSurf_t* surf )
 {
 	// get vertex buffer
 	const vertCacheHandle_t vbHandle = surf->ambientCache;
-	idVertexBuffer* vertexBuffer;
-	if( vertexCache.CacheIsStatic( vbHandle ) )
+	idVertexBuffer* vertexBuffer = vertexCache.GetDrawVertexBuffer( vbHandle );
+	if( vertexBuffer == NULL )
 	{
-		vertexBuffer = &vertexCache.staticData.vertexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( vbHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "RB_DrawElementsWithCounters, vertexBuffer == NULL" );
-			return;
-		}
-		vertexBuffer = &vertexCache.frameData[vertexCache.drawListNum].vertexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( vbHandle ) != VERTCACHE_OVERFLOW_PAGE, "RB_DrawElementsWithCounters, vertexBuffer == NULL" );
+		return;
 	}
-	const int vertOffset = ( int )( vbHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const int vertOffset = vertexCache.CacheOffset( vbHandle );
 
 	// get index buffer
 	const vertCacheHandle_t ibHandle = surf->indexCache;
-	idIndexBuffer* indexBuffer;
-	if( vertexCache.CacheIsStatic( ibHandle ) )
+	idIndexBuffer* indexBuffer = vertexCache.GetDrawIndexBuffer( ibHandle );
+	if( indexBuffer == NULL )
 	{
-		indexBuffer = &vertexCache.staticData.indexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( ibHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "RB_DrawElementsWithCounters, indexBuffer == NULL" );
-			return;
-		}
-		indexBuffer = &vertexCache.frameData[vertexCache.drawListNum].indexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( ibHandle ) != VERTCACHE_OVERFLOW_PAGE, "RB_DrawElementsWithCounters, indexBuffer == NULL" );
+		return;
 	}
 	// RB: 64 bit fixes, changed int to GLintptr
-	const GLintptr indexOffset = ( GLintptr )( ibHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const GLintptr indexOffset = ( GLintptr )vertexCache.CacheOffset( ibHandle );
 	// RB end
 
 	RENDERLOG_PRINTF( "Binding Buffers: %p:%i %p:%i\n", vertexBuffer, vertOffset, indexBuffer, indexOffset );
@@ -1549,41 +1531,23 @@ void idRenderBackend::DrawStencilShadowPass( const drawSurf_t* drawSurf, const b
 
 	// get vertex buffer
 	const vertCacheHandle_t vbHandle = drawSurf->shadowCache;
-	idVertexBuffer* vertexBuffer;
-	if( vertexCache.CacheIsStatic( vbHandle ) )
+	idVertexBuffer* vertexBuffer = vertexCache.GetDrawVertexBuffer( vbHandle );
+	if( vertexBuffer == NULL )
 	{
-		vertexBuffer = &vertexCache.staticData.vertexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( vbHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "DrawStencilShadowPass, vertexBuffer == NULL" );
-			return;
-		}
-		vertexBuffer = &vertexCache.frameData[ vertexCache.drawListNum ].vertexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( vbHandle ) != VERTCACHE_OVERFLOW_PAGE, "DrawStencilShadowPass, vertexBuffer == NULL" );
+		return;
 	}
-	const int vertOffset = ( int )( vbHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const int vertOffset = vertexCache.CacheOffset( vbHandle );
 
 	// get index buffer
 	const vertCacheHandle_t ibHandle = drawSurf->indexCache;
-	idIndexBuffer* indexBuffer;
-	if( vertexCache.CacheIsStatic( ibHandle ) )
+	idIndexBuffer* indexBuffer = vertexCache.GetDrawIndexBuffer( ibHandle );
+	if( indexBuffer == NULL )
 	{
-		indexBuffer = &vertexCache.staticData.indexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( ibHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "DrawStencilShadowPass, indexBuffer == NULL" );
-			return;
-		}
-		indexBuffer = &vertexCache.frameData[ vertexCache.drawListNum ].indexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( ibHandle ) != VERTCACHE_OVERFLOW_PAGE, "DrawStencilShadowPass, indexBuffer == NULL" );
+		return;
 	}
-	const uint64 indexOffset = ( int )( ibHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const uint64 indexOffset = vertexCache.CacheOffset( ibHandle );
 
 	RENDERLOG_PRINTF( "Binding Buffers: %p %p\n", vertexBuffer, indexBuffer );
 
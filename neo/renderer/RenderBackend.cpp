@@ -148,41 +148,23 @@ void RB_DrawStripWithCounters( const drawSurf_t* surf )
 {
 	// get vertex buffer
 	const vertCacheHandle_t vbHandle = surf->ambientCache;
-	idVertexBuffer* vertexBuffer;
-	if( vertexCache.CacheIsStatic( vbHandle ) )
+	idVertexBuffer* vertexBuffer = vertexCache.GetDrawVertexBuffer( vbHandle );
+	if( vertexBuffer == NULL )
 	{
-		vertexBuffer = &vertexCache.staticData.vertexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( vbHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "RB_DrawElementsWithCounters, vertexBuffer == NULL" );
-			return;
-		}
-		vertexBuffer = &vertexCache.frameData[vertexCache.drawListNum].vertexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( vbHandle ) != VERTCACHE_OVERFLOW_PAGE, "RB_DrawElementsWithCounters, vertexBuffer == NULL" );
+		return;
 	}
-	const int vertOffset = ( int )( vbHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const int vertOffset = vertexCache.CacheOffset( vbHandle );
 
 	// get index buffer
 	const vertCacheHandle_t ibHandle = surf->indexCache;
-	idIndexBuffer* indexBuffer;
-	if( vertexCache.CacheIsStatic( ibHandle ) )
+	idIndexBuffer* indexBuffer = vertexCache.GetDrawIndexBuffer( ibHandle );
+	if( indexBuffer == NULL )
 	{
-		indexBuffer = &vertexCache.staticData.indexBuffer;
-	}
-	else
-	{
-		const uint64 frameNum = ( int )( ibHandle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		if( frameNum != ( ( vertexCache.currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
-		{
-			idLib::Warning( "RB_DrawElementsWithCounters, indexBuffer == NULL" );
-			return;
-		}
-		indexBuffer = &vertexCache.frameData[vertexCache.drawListNum].indexBuffer;
+		idLib::WarningIf( vertexCache.CachePage( ibHandle ) != VERTCACHE_OVERFLOW_PAGE, "RB_DrawElementsWithCounters, indexBuffer == NULL" );
+		return;
 	}
-	const size_t indexOffset = ( size_t )( ibHandle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const size_t indexOffset = ( size_t )vertexCache.CacheOffset( ibHandle );
 
 	RENDERLOG_PRINTF( "Binding Buffers: %p:%i %p:%i\n", vertexBuffer, vertOffset, indexBuffer, indexOffset );
 
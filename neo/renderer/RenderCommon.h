@@ -34,6 +34,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "GLState.h"
 #include "ScreenRect.h"
+#include "OcclusionBuffer.h"
 #include "Image.h"
 #include "Font.h"
 #include "Framebuffer.h"
@@ -312,6 +313,8 @@ public:
 	idInteraction* 			firstInteraction;		// doubly linked list
 	idInteraction* 			lastInteraction;
 
+	idInteractionCache* 	interactionCache;		// dynamic interaction indices kept across frames
+
 	bool					needsPortalSky;
 };
 
@@ -608,6 +611,9 @@ struct viewDef_t
 
 	int					areaNum;				// -1 = not in a valid area
 
+	// NULL if software occlusion culling was not done for this view
+	const idOcclusionBuffer* occlusionBuffer;
+
 	// An array in frame temporary memory that lists if an area can be reached without
 	// crossing a closed door.  This is used to avoid drawing interactions
 	// when the light is behind a closed door.
@@ -959,6 +965,8 @@ public:
 
 	idParallelJobList* 		frontEndJobList;
 
+	idOcclusionBuffer* 		occlusionBuffer;		// only used by the front end of the view being set up
+
 	// RB irradiance and GGX background jobs
 	idParallelJobList* 					envprobeJobList;
 	idList<calcEnvprobeParms_t*>		envprobeJobs;
@@ -1014,6 +1022,11 @@ extern idCVar r_useLightPortalCulling;		// 0 = none, 1 = box, 2 = exact clip of
 extern idCVar r_useLightAreaCulling;		// 0 = off, 1 = on
 extern idCVar r_useLightScissors;			// 1 = use custom scissor rectangle for each light
 extern idCVar r_useEntityPortalCulling;		// 0 = none, 1 = box
+extern idCVar r_useSoftwareOcclusion;		// cull against a CPU rasterized depth buffer of the world
+extern idCVar r_occluderMinArea;			// smallest world triangle that is used as an occluder
+extern idCVar r_useStereoSharedVisibility;	// find the visible entities and lights once for both eyes of a stereo pair
+extern idCVar r_useInteractionCache;		// keep dynamic light triangles and shadow volumes across frames
+extern idCVar r_interactionCacheMegs;		// main memory budget of the dynamic interaction cache
 extern idCVar r_skipPrelightShadows;		// 1 = skip the dmap generated static shadow volumes
 extern idCVar r_useCachedDynamicModels;		// 1 = cache snapshots of dynamic models
 extern idCVar r_useSeamlessCubeMap;
@@ -1084,6 +1097,8 @@ extern idCVar r_showLightScissors;			// show light scissor rectangles
 extern idCVar r_showMemory;					// print frame memory utilization
 extern idCVar r_showCull;					// report sphere and box culling stats
 extern idCVar r_showAddModel;				// report stats from tr_addModel
+extern idCVar r_showSoftwareOcclusion;		// report software occlusion culling stats
+extern idCVar r_showInteractionCache;		// report dynamic interaction cache stats
 extern idCVar r_showSurfaces;				// report surface/light/shadow counts
 extern idCVar r_showPrimitives;				// report vertex/index/draw counts
 extern idCVar r_showPortals;				// draw portal outlines in color based on passed / not passed
@@ -1293,6 +1308,7 @@ RENDERWORLD_PORTALS
 
 viewEntity_t* R_SetEntityDefViewEntity( idRenderEntityLocal* def );
 viewLight_t* R_SetLightDefViewLight( idRenderLightLocal* def );
+viewEnvprobe_t* R_SetEnvprobeDefViewEnvprobe( RenderEnvprobeLocal* probe );
 
 /*
 ============================================================
@@ -1325,6 +1341,7 @@ void* R_StaticAlloc( int bytes, const memTag_t tag = TAG_RENDER_STATIC );		// ju
 void* R_ClearedStaticAlloc( int bytes );	// with memset
 void R_StaticFree( void* data );
 
+void R_SetupViewFrustum( viewDef_t* viewDef );
 void R_RenderView( viewDef_t* parms );
 void R_RenderPostProcess( viewDef_t* parms );
 
@@ -1351,6 +1368,18 @@ void R_OptimizeViewLightsList();
 /*
 ============================================================
 
+TR_FRONTEND_OCCLUSION
+
+============================================================
+*/
+
+void R_SoftwareOcclusionCull();
+bool R_CullShadowBoundsByOcclusion( const viewDef_t* viewDef, const idBounds& shadowBounds );
+void R_FinishSoftwareOcclusionCull();
+
+/*
+============================================================
+
 TR_FRONTEND_ADDMODELS
 
 ============================================================
@@ -52,6 +52,7 @@ idRenderEntityLocal::idRenderEntityLocal()
 	entityRefs				= NULL;
 	firstInteraction		= NULL;
 	lastInteraction			= NULL;
+	interactionCache		= NULL;
 	needsPortalSky			= false;
 }
 
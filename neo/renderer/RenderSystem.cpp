@@ -59,9 +59,11 @@ static void R_PerformanceCounters()
 
 	if( r_showDynamic.GetBool() )
 	{
-		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
+		common->Printf( "callback:%i md5:%i (pose hits:%i misses:%i) dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
 						tr.pc.c_entityDefCallbacks,
 						tr.pc.c_generateMd5,
+						tr.pc.c_md5PoseCacheHits,
+						tr.pc.c_md5PoseCacheMisses,
 						tr.pc.c_deformedVerts,
 						tr.pc.c_deformedIndexes / 3,
 						tr.pc.c_tangentIndexes / 3,
@@ -82,6 +84,18 @@ static void R_PerformanceCounters()
 		common->Printf( "viewEntities:%i  shadowEntities:%i  viewLights:%i\n", tr.pc.c_visibleViewEntities,
 						tr.pc.c_shadowViewEntities, tr.pc.c_viewLights );
 	}
+	if( r_showSoftwareOcclusion.GetBool() )
+	{
+		common->Printf( "occluderTris:%i  entities:%i culled:%i  lights culled:%i  shadows culled:%i  %i usec\n",
+						tr.pc.c_occluderTris, tr.pc.c_occlusionTestedEntities, tr.pc.c_occlusionCulledEntities,
+						tr.pc.c_occlusionCulledLights, tr.pc.c_occlusionCulledShadows, ( int )tr.pc.occlusionMicroSec );
+	}
+	if( r_showInteractionCache.GetBool() )
+	{
+		common->Printf( "interactionCache hits:%i  misses:%i  invalidations:%i  %i kB\n",
+						tr.pc.c_interactionCacheHits, tr.pc.c_interactionCacheMisses,
+						tr.pc.c_interactionCacheInvalidations, idInteractionCache::TotalMemory() >> 10 );
+	}
 	if( r_showUpdates.GetBool() )
 	{
 		common->Printf( "entityUpdates:%i  entityRefs:%i  lightUpdates:%i  lightRefs:%i\n",
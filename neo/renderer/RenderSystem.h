@@ -116,7 +116,12 @@ struct performanceCounters_t
 	int		c_box_cull_out;
 	int		c_createInteractions;	// number of calls to idInteraction::CreateInteraction
 	int		c_createShadowVolumes;
+	int		c_interactionCacheHits;			// dynamic light tris / shadow volumes copied from an earlier frame
+	int		c_interactionCacheMisses;		// dynamic light tris / shadow volumes created and kept for later frames
+	int		c_interactionCacheInvalidations;	// kept indices freed because the entity, light or model changed
 	int		c_generateMd5;
+	int		c_md5PoseCacheHits;	// md5 instantiations that reused the skinning of another entity or view
+	int		c_md5PoseCacheMisses;
 	int		c_entityDefCallbacks;
 	int		c_alloc;			// counts for R_StaticAllc/R_StaticFree
 	int		c_free;
@@ -134,6 +139,12 @@ struct performanceCounters_t
 	int		c_entityReferences;
 	int		c_lightReferences;
 	int		c_guiSurfs;
+	int		c_occluderTris;					// world triangles rasterized into the software occlusion buffer
+	int		c_occlusionTestedEntities;
+	int		c_occlusionCulledEntities;
+	int		c_occlusionCulledLights;
+	int		c_occlusionCulledShadows;		// entity / light shadows that could only fall behind occluders
+	uint64	occlusionMicroSec;
 
 	uint64	frontEndMicroSec;	// sum of time in all RE_RenderScene's in a frame
 };
@@ -138,6 +138,11 @@ idCVar r_useLightPortalCulling( "r_useLightPortalCulling", "1", CVAR_RENDERER |
 idCVar r_useLightAreaCulling( "r_useLightAreaCulling", "1", CVAR_RENDERER | CVAR_BOOL, "0 = off, 1 = on" );
 idCVar r_useLightScissors( "r_useLightScissors", "3", CVAR_RENDERER | CVAR_INTEGER, "0 = no scissor, 1 = non-clipped scissor, 2 = near-clipped scissor, 3 = fully-clipped scissor", 0, 3, idCmdSystem::ArgCompletion_Integer<0, 3> );
 idCVar r_useEntityPortalCulling( "r_useEntityPortalCulling", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = none, 1 = cull frustum corners to plane, 2 = exact clip the frustum faces", 0, 2, idCmdSystem::ArgCompletion_Integer<0, 2> );
+idCVar r_useSoftwareOcclusion( "r_useSoftwareOcclusion", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "cull entities, lights and shadows hidden behind world geometry with a CPU rasterized depth buffer" );
+idCVar r_useStereoSharedVisibility( "r_useStereoSharedVisibility", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "flow through the portals once for both eye views of a stereo pair and reuse the visible entities and lights for the second eye" );
+idCVar r_useInteractionCache( "r_useInteractionCache", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "keep the culled light triangles and shadow volume indices of dynamic interactions across frames while the entity and light do not change" );
+idCVar r_interactionCacheMegs( "r_interactionCacheMegs", "32", CVAR_RENDERER | CVAR_INTEGER | CVAR_ARCHIVE, "main memory budget of the dynamic interaction cache", 0, 1024 );
+idCVar r_occluderMinArea( "r_occluderMinArea", "1024", CVAR_RENDERER | CVAR_FLOAT, "world triangles smaller than this many square units are not used as occluders, takes effect on the next map load" );
 idCVar r_logFile( "r_logFile", "0", CVAR_RENDERER | CVAR_INTEGER, "number of frames to emit GL logs" );
 idCVar r_clear( "r_clear", "2", CVAR_RENDERER, "force screen clear every frame, 1 = purple, 2 = black, 'r g b' = custom" );
 
@@ -190,6 +195,8 @@ idCVar r_showNormals( "r_showNormals", "0", CVAR_RENDERER | CVAR_FLOAT, "draws w
 idCVar r_showMemory( "r_showMemory", "0", CVAR_RENDERER | CVAR_BOOL, "print frame memory utilization" );
 idCVar r_showCull( "r_showCull", "0", CVAR_RENDERER | CVAR_BOOL, "report sphere and box culling stats" );
 idCVar r_showAddModel( "r_showAddModel", "0", CVAR_RENDERER | CVAR_BOOL, "report stats from tr_addModel" );
+idCVar r_showSoftwareOcclusion( "r_showSoftwareOcclusion", "0", CVAR_RENDERER | CVAR_BOOL, "report software occlusion culling stats" );
+idCVar r_showInteractionCache( "r_showInteractionCache", "0", CVAR_RENDERER | CVAR_BOOL, "report dynamic interaction cache stats" );
 idCVar r_showDepth( "r_showDepth", "0", CVAR_RENDERER | CVAR_BOOL, "display the contents of the depth buffer and the depth range" );
 idCVar r_showSurfaces( "r_showSurfaces", "0", CVAR_RENDERER | CVAR_BOOL, "report surface/light/shadow counts" );
 idCVar r_showPrimitives( "r_showPrimitives", "0", CVAR_RENDERER | CVAR_INTEGER, "report drawsurf/index/vertex counts" );
@@ -1645,6 +1652,7 @@ void idRenderSystemLocal::Clear()
 	// Koz end
 
 	frontEndJobList = NULL;
+	occlusionBuffer = NULL;
 
 	// RB
 	envprobeJobList = NULL;
@@ -2145,6 +2153,7 @@ void idRenderSystemLocal::Init()
 	}
 
 	frontEndJobList = parallelJobManager->AllocJobList( JOBLIST_RENDERER_FRONTEND, JOBLIST_PRIORITY_MEDIUM, 2048, 0, NULL );
+	occlusionBuffer = new( TAG_RENDER ) idOcclusionBuffer;
 	timerQueryId = 0;
 
 	bInitialized = true;
@@ -2196,6 +2205,9 @@ void idRenderSystemLocal::Shutdown()
 
 	parallelJobManager->FreeJobList( frontEndJobList );
 
+	delete occlusionBuffer;
+	occlusionBuffer = NULL;
+
 	Clear();
 
 	ShutdownOpenGL();
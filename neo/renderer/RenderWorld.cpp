@@ -147,6 +147,11 @@ idRenderWorldLocal::idRenderWorldLocal()
 	mapTimeStamp = FILE_NOT_FOUND_TIMESTAMP;
 
 	generateAllInteractionsCalled = false;
+	areaOccludersBuilt = false;
+
+	InvalidateStereoVisibility();
+	nextStereoVisibility = 0;
+	stereoFloodView = NULL;
 
 	areaNodes = NULL;
 	numAreaNodes = 0;
@@ -399,6 +404,9 @@ void idRenderWorldLocal::FreeEntityDef( qhandle_t entityHandle )
 
 	R_FreeEntityDefDerivedData( def, false, false );
 
+	// a second eye view must not reference the freed def
+	InvalidateStereoVisibility();
+
 	// if we are playing a demo, these will have been freed
 	// in R_FreeEntityDefDerivedData(), otherwise the gui
 	// object still exists in the game
@@ -568,6 +576,7 @@ void idRenderWorldLocal::FreeLightDef( qhandle_t lightHandle )
 	}
 
 	R_FreeLightDefDerivedData( light );
+	InvalidateStereoVisibility();
 
 	delete light;
 	lightDefs[lightHandle] = NULL;
@@ -711,6 +720,7 @@ void idRenderWorldLocal::FreeEnvprobeDef( qhandle_t envprobeHandle )
 	}
 
 	R_FreeEnvprobeDefDerivedData( probe );
+	InvalidateStereoVisibility();
 
 	delete probe;
 	envprobeDefs[envprobeHandle] = NULL;
@@ -2082,6 +2092,36 @@ void idRenderWorldLocal::FreeInteractions()
 	}
 }
 
+/*
+===================
+idRenderWorldLocal::PurgeInteractionCaches
+
+Frees the cached dynamic interaction indices of lights that were freed or
+entities that are no longer in view, so they don't hold on to the
+r_interactionCacheMegs budget. Must not be called while jobs are running.
+===================
+*/
+static const int INTERACTION_CACHE_MAX_UNUSED_FRAMES = 60;
+
+void idRenderWorldLocal::PurgeInteractionCaches()
+{
+	const int oldestFrameCount = tr.frameCount - INTERACTION_CACHE_MAX_UNUSED_FRAMES;
+
+	for( int i = 0; i < entityDefs.Num(); i++ )
+	{
+		idRenderEntityLocal* def = entityDefs[i];
+		if( def == NULL || def->interactionCache == NULL )
+		{
+			continue;
+		}
+		if( def->interactionCache->Purge( oldestFrameCount ) )
+		{
+			delete def->interactionCache;
+			def->interactionCache = NULL;
+		}
+	}
+}
+
 /*
 ==================
 idRenderWorldLocal::PushFrustumIntoTree_r
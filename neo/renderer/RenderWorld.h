@@ -267,6 +267,7 @@ typedef struct renderView_s
 	// the viewEyeBuffer may be of a different polarity than stereoScreenSeparation if the eyes have been swapped
 	int						viewEyeBuffer;				// -1 = left eye, 1 = right eye, 0 = monoscopic view or GUI
 	float					stereoScreenSeparation;		// projection matrix horizontal offset, positive or negative based on camera eye
+	float					stereoWorldSeparation;		// offset along viewaxis[1] that was applied to vieworg for this eye
 
 	int						rdflags;			// RB: RDF_NOSHADOWS, etc
 } renderView_t;
@@ -75,6 +75,10 @@ void R_FreeEntityDefDerivedData( idRenderEntityLocal* def, bool keepDecals, bool
 	}
 	def->dynamicModelFrameCount = 0;
 
+	// the light triangles and shadow volumes of dynamic interactions are no longer valid
+	delete def->interactionCache;
+	def->interactionCache = NULL;
+
 	// clear the dynamic model if present
 	if( def->dynamicModel )
 	{
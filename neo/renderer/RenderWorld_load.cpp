@@ -98,6 +98,8 @@ void idRenderWorldLocal::FreeWorld()
 	}
 	localModels.Clear();
 
+	FreeAreaOccluders();
+
 	areaReferenceAllocator.Shutdown();
 	interactionAllocator.Shutdown();
 
@@ -138,6 +138,14 @@ typedef struct
 	// this is the area number, else CHILDREN_HAVE_MULTIPLE_AREAS
 } areaNode_t;
 
+// large opaque triangles of an area model that are rasterized into the software occlusion buffer
+struct areaOccluders_t
+{
+	idList<idVec3, TAG_RENDER>		verts;
+	idList<int, TAG_RENDER>			indexes;
+	idList<idPlane, TAG_RENDER>		facePlanes;		// one per triangle, used for back face culling
+};
+
 struct reusableDecal_t
 {
 	qhandle_t				entityHandle;
@@ -267,6 +275,34 @@ public:
 
 	bool					generateAllInteractionsCalled;
 
+	// built on demand the first time software occlusion culling is used on this world
+	idList<areaOccluders_t, TAG_RENDER>	areaOccluders;
+	bool					areaOccludersBuilt;
+
+	// the visible entities and lights found by flowing both eyes of a stereo pair through
+	// the portals at once, so the second eye view of the frame can skip the portal flow
+	struct stereoVisibility_t
+	{
+		int					frameCount;
+		renderView_t		partnerView;		// the eye view that can reuse this
+		int					areaNum;
+		idList<int, TAG_RENDER>						areas;
+		idList<idRenderEntityLocal*, TAG_RENDER>	entities;
+		idList<idScreenRect, TAG_RENDER>			entityRects;
+		idList<idRenderLightLocal*, TAG_RENDER>		lights;
+		idList<idScreenRect, TAG_RENDER>			lightRects;
+		idList<RenderEnvprobeLocal*, TAG_RENDER>	envprobes;
+		idList<idScreenRect, TAG_RENDER>			envprobeRects;
+	};
+
+	// a portal sky view and the player view may both be rendered in stereo each frame
+	static const int		MAX_STEREO_VISIBILITY = 2;
+	stereoVisibility_t		stereoVisibility[MAX_STEREO_VISIBILITY];
+	int						nextStereoVisibility;
+
+	// the other eye while the view is flowed through the portals for a stereo pair
+	viewDef_t* 				stereoFloodView;
+
 	//-----------------------
 	// RenderWorld_load.cpp
 
@@ -324,6 +360,12 @@ public:
 	void					BuildConnectedAreas();
 	void					FindViewLightsAndEntities();
 
+	void					CullBoundsBatchToView( const idBoundsBatch& batch, byte* culled ) const;
+	viewDef_t* 				SetupStereoPartnerView();
+	void					SaveStereoVisibility( const viewDef_t* partnerView );
+	bool					ReuseStereoVisibility();
+	void					InvalidateStereoVisibility();
+
 	void					FloodLightThroughArea_r( idRenderLightLocal* light, int areaNum, const portalStack_t* ps );
 	void					FlowLightThroughPortals( idRenderLightLocal* light );
 
@@ -339,6 +381,13 @@ public:
 	}
 	void					ShowPortals();
 
+	//--------------------------
+	// tr_frontend_occlusion.cpp
+
+	void					BuildAreaOccluders();
+	void					FreeAreaOccluders();
+	int						RasterizeAreaOccluders( idOcclusionBuffer& buffer, const idVec3& viewOrigin );
+
 
 	//--------------------------
 	// RenderWorld.cpp
@@ -355,6 +404,7 @@ public:
 	float					DrawTextLength( const char* text, float scale, int len = 0 );
 
 	void					FreeInteractions();
+	void					PurgeInteractionCaches();
 
 	void					PushFrustumIntoTree_r( idRenderEntityLocal* def, idRenderLightLocal* light, const frustumCorners_t& corners, int nodeNum );
 	void					PushFrustumIntoTree( idRenderEntityLocal* def, idRenderLightLocal* light, const idRenderMatrix& frustumTransform, const idBounds& frustumBounds );
@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "RenderCommon.h"
 
+idCVar r_cullBatchAVX2( "r_cullBatchAVX2", "1", CVAR_RENDERER | CVAR_BOOL, "use the AVX2 kernel for batched bounds culling if the CPU supports it" );
+
 // if we hit this many planes, we will just stop cropping the
 // view down, which is still correct, just conservative
 const int MAX_PORTAL_PLANES	= 20;
@@ -159,7 +161,8 @@ bool idRenderWorldLocal::CullEntityByPortals( const idRenderEntityLocal* entity,
 			// the entity frustum planes face inward, so the planes that have the
 			// view origin on the positive side will be the "back" faces of the entity,
 			// which must have some fragment inside the portal stack planes to be visible
-			if( frustumPlanes[i].Distance( tr.viewDef->renderView.vieworg ) <= 0.0f )
+			if( frustumPlanes[i].Distance( tr.viewDef->renderView.vieworg ) <= 0.0f
+					&& ( stereoFloodView == NULL || frustumPlanes[i].Distance( stereoFloodView->renderView.vieworg ) <= 0.0f ) )
 			{
 				continue;
 			}
@@ -212,6 +215,41 @@ bool idRenderWorldLocal::CullEntityByPortals( const idRenderEntityLocal* entity,
 	return false;
 }
 
+/*
+===================
+R_SetBatchCullingKernel
+===================
+*/
+static void R_SetBatchCullingKernel()
+{
+	idRenderMatrix::SetBatchCullingAVX2( r_cullBatchAVX2.GetBool() && ( Sys_GetProcessorId() & CPUID_AVX2 ) != 0 );
+}
+
+/*
+===================
+idRenderWorldLocal::CullBoundsBatchToView
+
+Culls a batch of world space bounds to the view frustum. While a stereo pair
+is flowed through the portals the bounds are only culled if both eyes cull them.
+===================
+*/
+void idRenderWorldLocal::CullBoundsBatchToView( const idBoundsBatch& batch, byte* culled ) const
+{
+	R_SetBatchCullingKernel();
+
+	idRenderMatrix::CullBoundsToMVPBatch( tr.viewDef->worldSpace.mvp, batch, culled );
+
+	if( stereoFloodView != NULL )
+	{
+		byte partnerCulled[idBoundsBatch::MAX_BOUNDS];
+		idRenderMatrix::CullBoundsToMVPBatch( stereoFloodView->worldSpace.mvp, batch, partnerCulled );
+		for( int i = 0; i < batch.Num(); i++ )
+		{
+			culled[i] &= partnerCulled[i];
+		}
+	}
+}
+
 /*
 ===================
 AddAreaViewEntities
@@ -223,46 +261,70 @@ void idRenderWorldLocal::AddAreaViewEntities( int areaNum, const portalStack_t*
 {
 	portalArea_t* area = &portalAreas[ areaNum ];
 
-	for( areaReference_t* ref = area->entityRefs.areaNext; ref != &area->entityRefs; ref = ref->areaNext )
-	{
-		idRenderEntityLocal*	 entity = ref->entity;
+	idBoundsBatch batch;
+	idRenderEntityLocal* batchEntities[idBoundsBatch::MAX_BOUNDS];
+	byte frustumCulled[idBoundsBatch::MAX_BOUNDS];
 
-		// debug tool to allow viewing of only one entity at a time
-		if( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != entity->index )
+	areaReference_t* ref = area->entityRefs.areaNext;
+	while( ref != &area->entityRefs )
+	{
+		// the portal planes are always inside the view frustum, so anything the frustum culls
+		// can be skipped before the much more expensive per entity portal culling
+		batch.Clear();
+		for( ; ref != &area->entityRefs && !batch.IsFull(); ref = ref->areaNext )
 		{
-			continue;
+			batchEntities[batch.Append( ref->entity->globalReferenceBounds )] = ref->entity;
+		}
+		if( r_useEntityPortalCulling.GetInteger() != 0 )
+		{
+			CullBoundsBatchToView( batch, frustumCulled );
+		}
+		else
+		{
+			memset( frustumCulled, 0, batch.Num() );
 		}
 
-		// remove decals that are completely faded away
-		R_FreeEntityDefFadedDecals( entity, tr.viewDef->renderView.time[0] );
-
-		// check for completely suppressing the model
-		if( !r_skipSuppress.GetBool() )
+		for( int i = 0; i < batch.Num(); i++ )
 		{
-			if( entity->parms.suppressSurfaceInViewID
-					&& entity->parms.suppressSurfaceInViewID == tr.viewDef->renderView.viewID )
+			idRenderEntityLocal*	 entity = batchEntities[i];
+
+			// debug tool to allow viewing of only one entity at a time
+			if( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != entity->index )
 			{
 				continue;
 			}
-			if( entity->parms.allowSurfaceInViewID
-					&& entity->parms.allowSurfaceInViewID != tr.viewDef->renderView.viewID )
+
+			// remove decals that are completely faded away
+			R_FreeEntityDefFadedDecals( entity, tr.viewDef->renderView.time[0] );
+
+			// check for completely suppressing the model
+			if( !r_skipSuppress.GetBool() )
 			{
-				continue;
+				if( entity->parms.suppressSurfaceInViewID
+						&& entity->parms.suppressSurfaceInViewID == tr.viewDef->renderView.viewID )
+				{
+					continue;
+				}
+				if( entity->parms.allowSurfaceInViewID
+						&& entity->parms.allowSurfaceInViewID != tr.viewDef->renderView.viewID )
+				{
+					continue;
+				}
 			}
-		}
 
-		// cull reference bounds
-		if( CullEntityByPortals( entity, ps ) )
-		{
-			// we are culled out through this portal chain, but it might
-			// still be visible through others
-			continue;
-		}
+			// cull reference bounds
+			if( frustumCulled[i] || CullEntityByPortals( entity, ps ) )
+			{
+				// we are culled out through this portal chain, but it might
+				// still be visible through others
+				continue;
+			}
 
-		viewEntity_t* vEnt = R_SetEntityDefViewEntity( entity );
+			viewEntity_t* vEnt = R_SetEntityDefViewEntity( entity );
 
-		// possibly expand the scissor rect
-		vEnt->scissorRect.Union( ps->rect );
+			// possibly expand the scissor rect
+			vEnt->scissorRect.Union( ps->rect );
+		}
 	}
 }
 
@@ -301,7 +363,8 @@ bool idRenderWorldLocal::CullLightByPortals( const idRenderLightLocal* light, co
 			// the light frustum planes face inward, so the planes that have the
 			// view origin on the positive side will be the "back" faces of the light,
 			// which must have some fragment inside the the portal stack planes to be visible
-			if( frustumPlanes[i].Distance( tr.viewDef->renderView.vieworg ) <= 0.0f )
+			if( frustumPlanes[i].Distance( tr.viewDef->renderView.vieworg ) <= 0.0f
+					&& ( stereoFloodView == NULL || frustumPlanes[i].Distance( stereoFloodView->renderView.vieworg ) <= 0.0f ) )
 			{
 				continue;
 			}
@@ -365,36 +428,59 @@ void idRenderWorldLocal::AddAreaViewLights( int areaNum, const portalStack_t* ps
 {
 	portalArea_t* area = &portalAreas[ areaNum ];
 
-	for( areaReference_t* lref = area->lightRefs.areaNext; lref != &area->lightRefs; lref = lref->areaNext )
-	{
-		idRenderLightLocal* light = lref->light;
+	idBoundsBatch batch;
+	idRenderLightLocal* batchLights[idBoundsBatch::MAX_BOUNDS];
+	byte frustumCulled[idBoundsBatch::MAX_BOUNDS];
 
-		// debug tool to allow viewing of only one light at a time
-		if( r_singleLight.GetInteger() >= 0 && r_singleLight.GetInteger() != light->index )
+	areaReference_t* lref = area->lightRefs.areaNext;
+	while( lref != &area->lightRefs )
+	{
+		// a light volume outside the view frustum can't light anything that is visible
+		batch.Clear();
+		for( ; lref != &area->lightRefs && !batch.IsFull(); lref = lref->areaNext )
 		{
-			continue;
+			batchLights[batch.Append( lref->light->globalLightBounds )] = lref->light;
 		}
-
-		// check for being closed off behind a door
-		// a light that doesn't cast shadows will still light even if it is behind a door
-		if( r_useLightAreaCulling.GetBool() && !light->LightCastsShadows()
-				&& light->areaNum != -1 && !tr.viewDef->connectedAreas[ light->areaNum ] )
+		if( r_useLightPortalCulling.GetInteger() != 0 )
 		{
-			continue;
+			CullBoundsBatchToView( batch, frustumCulled );
 		}
-
-		// cull frustum
-		if( CullLightByPortals( light, ps ) )
+		else
 		{
-			// we are culled out through this portal chain, but it might
-			// still be visible through others
-			continue;
+			memset( frustumCulled, 0, batch.Num() );
 		}
 
-		viewLight_t* vLight = R_SetLightDefViewLight( light );
+		for( int i = 0; i < batch.Num(); i++ )
+		{
+			idRenderLightLocal* light = batchLights[i];
 
-		// expand the scissor rect
-		vLight->scissorRect.Union( ps->rect );
+			// debug tool to allow viewing of only one light at a time
+			if( r_singleLight.GetInteger() >= 0 && r_singleLight.GetInteger() != light->index )
+			{
+				continue;
+			}
+
+			// check for being closed off behind a door
+			// a light that doesn't cast shadows will still light even if it is behind a door
+			if( r_useLightAreaCulling.GetBool() && !light->LightCastsShadows()
+					&& light->areaNum != -1 && !tr.viewDef->connectedAreas[ light->areaNum ] )
+			{
+				continue;
+			}
+
+			// cull frustum
+			if( frustumCulled[i] || CullLightByPortals( light, ps ) )
+			{
+				// we are culled out through this portal chain, but it might
+				// still be visible through others
+				continue;
+			}
+
+			viewLight_t* vLight = R_SetLightDefViewLight( light );
+
+			// expand the scissor rect
+			vLight->scissorRect.Union( ps->rect );
+		}
 	}
 }
 
@@ -503,6 +589,28 @@ bool idRenderWorldLocal::PortalIsFoggedOut( const portal_t* p )
 	return true;
 }
 
+/*
+===================
+R_PortalEdgePlane
+
+Returns false if the plane through the view origin and the portal edge is degenerate.
+===================
+*/
+static bool R_PortalEdgePlane( const idVec3& origin, const idVec3& p1, const idVec3& p2, idPlane& plane )
+{
+	const idVec3 v1 = origin - p1;
+	const idVec3 v2 = origin - p2;
+
+	plane.Normal().Cross( v2, v1 );
+	if( plane.Normalize() < 0.01f )
+	{
+		return false;
+	}
+	plane.FitThroughPoint( origin );
+
+	return true;
+}
+
 /*
 ===================
 idRenderWorldLocal::FloodViewThroughArea_r
@@ -534,7 +642,15 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3& origin, int areaN
 		}
 
 		// make sure this portal is facing away from the view
-		const float d = p->plane.Distance( origin );
+		float d = p->plane.Distance( origin );
+		float nearestDist = d;
+		if( stereoFloodView != NULL )
+		{
+			// the portal is crossed if it faces away from either eye
+			const float partnerDist = p->plane.Distance( stereoFloodView->renderView.vieworg );
+			nearestDist = Min( d, partnerDist );
+			d = Max( d, partnerDist );
+		}
 		if( d < -0.1f )
 		{
 			continue;
@@ -557,7 +673,7 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3& origin, int areaN
 
 		// if we are very close to the portal surface, don't bother clipping
 		// it, which tends to give epsilon problems that make the area vanish
-		if( d < 1.0f )
+		if( nearestDist < 1.0f )
 		{
 
 			// go through this portal
@@ -599,6 +715,15 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3& origin, int areaN
 		// so we can scissor things outside it
 		newStack.rect = ScreenRectFromWinding( &w, &tr.identitySpace );
 
+		if( stereoFloodView != NULL )
+		{
+			// both eyes share the scissor rects, so they have to cover the portal in either view
+			viewDef_t* eyeView = tr.viewDef;
+			tr.viewDef = stereoFloodView;
+			newStack.rect.Union( ScreenRectFromWinding( &w, &tr.identitySpace ) );
+			tr.viewDef = eyeView;
+		}
+
 		// slop might have spread it a pixel outside, so trim it back
 		newStack.rect.Intersect( ps->rect );
 
@@ -620,17 +745,22 @@ void idRenderWorldLocal::FloodViewThroughArea_r( const idVec3& origin, int areaN
 				j = 0;
 			}
 
-			const idVec3& v1 = origin - w[i].ToVec3();
-			const idVec3& v2 = origin - w[j].ToVec3();
-
-			newStack.portalPlanes[newStack.numPortalPlanes].Normal().Cross( v2, v1 );
-
 			// if it is degenerate, skip the plane
-			if( newStack.portalPlanes[newStack.numPortalPlanes].Normalize() < 0.01f )
+			idPlane& plane = newStack.portalPlanes[newStack.numPortalPlanes];
+			if( !R_PortalEdgePlane( origin, w[i].ToVec3(), w[j].ToVec3(), plane ) )
 			{
 				continue;
 			}
-			newStack.portalPlanes[newStack.numPortalPlanes].FitThroughPoint( origin );
+
+			// the other eye of a stereo pair sees further past this edge if it is
+			// inside the plane, in which case the plane through that eye bounds both
+			if( stereoFloodView != NULL && plane.Distance( stereoFloodView->renderView.vieworg ) < 0.0f )
+			{
+				if( !R_PortalEdgePlane( stereoFloodView->renderView.vieworg, w[i].ToVec3(), w[j].ToVec3(), plane ) )
+				{
+					continue;
+				}
+			}
 
 			newStack.numPortalPlanes++;
 		}
@@ -762,13 +892,6 @@ void idRenderWorldLocal::FindViewLightsAndEntities()
 	tr.viewDef->viewEntitys = NULL;
 	tr.viewDef->viewEnvprobes = NULL; // RB
 
-	// all areas are initially not visible, but each portal
-	// chain that leads to them will expand the visible rectangle
-	for( int i = 0; i < numPortalAreas; i++ )
-	{
-		areaScreenRect[i].Clear();
-	}
-
 	// find the area to start the portal flooding in
 	if( !r_usePortals.GetBool() )
 	{
@@ -784,6 +907,19 @@ void idRenderWorldLocal::FindViewLightsAndEntities()
 	// light-behind-door culling
 	BuildConnectedAreas();
 
+	// the other eye of a stereo pair may already have found everything this view can see
+	if( ReuseStereoVisibility() )
+	{
+		return;
+	}
+
+	// all areas are initially not visible, but each portal
+	// chain that leads to them will expand the visible rectangle
+	for( int i = 0; i < numPortalAreas; i++ )
+	{
+		areaScreenRect[i].Clear();
+	}
+
 	// flow through all the portals and add models / lights
 	if( r_singleArea.GetBool() )
 	{
@@ -811,10 +947,207 @@ void idRenderWorldLocal::FindViewLightsAndEntities()
 	}
 	else
 	{
-		// note that the center of projection for flowing through portals may
-		// be a different point than initialViewAreaOrigin for subviews that
-		// may have the viewOrigin in a solid/invalid area
-		FlowViewThroughPortals( tr.viewDef->renderView.vieworg, 5, tr.viewDef->frustums[FRUSTUM_PRIMARY] );
+		viewDef_t* partnerView = SetupStereoPartnerView();
+		if( partnerView != NULL )
+		{
+			// flow both eyes through the portals at once with a frustum that contains both of them
+			idPlane unionPlanes[5];
+			const idVec3& forward = tr.viewDef->renderView.viewaxis[0];
+			for( int i = 0; i < 5; i++ )
+			{
+				// the eyes only differ by a sideways offset, so the wider of the two planes
+				// contains the other plane once it is pushed out to both eye origins
+				const idPlane& eyePlane = tr.viewDef->frustums[FRUSTUM_PRIMARY][i];
+				const idPlane& partnerPlane = partnerView->frustums[FRUSTUM_PRIMARY][i];
+				unionPlanes[i] = ( eyePlane.Normal() * forward <= partnerPlane.Normal() * forward ) ? eyePlane : partnerPlane;
+				const float eyeDist = Max( unionPlanes[i].Normal() * tr.viewDef->renderView.vieworg, unionPlanes[i].Normal() * partnerView->renderView.vieworg );
+				unionPlanes[i][3] = Min( unionPlanes[i][3], -eyeDist );
+			}
+
+			stereoFloodView = partnerView;
+			FlowViewThroughPortals( tr.viewDef->renderView.vieworg, 5, unionPlanes );
+			stereoFloodView = NULL;
+
+			SaveStereoVisibility( partnerView );
+		}
+		else
+		{
+			// note that the center of projection for flowing through portals may
+			// be a different point than initialViewAreaOrigin for subviews that
+			// may have the viewOrigin in a solid/invalid area
+			FlowViewThroughPortals( tr.viewDef->renderView.vieworg, 5, tr.viewDef->frustums[FRUSTUM_PRIMARY] );
+		}
+	}
+}
+
+/*
+=============
+idRenderWorldLocal::SetupStereoPartnerView
+
+Returns the view of the other eye if the current view is one eye of a stereo
+pair that should flow through the portals for both eyes at once.
+=============
+*/
+viewDef_t* idRenderWorldLocal::SetupStereoPartnerView()
+{
+	const renderView_t& eyeView = tr.viewDef->renderView;
+
+	if( !r_useStereoSharedVisibility.GetBool() || tr.viewDef->isSubview )
+	{
+		return NULL;
+	}
+	if( eyeView.viewEyeBuffer == 0 || eyeView.stereoWorldSeparation == 0.0f )
+	{
+		return NULL;
+	}
+
+	viewDef_t* partnerView = ( viewDef_t* )R_FrameAlloc( sizeof( *partnerView ), FRAME_ALLOC_VIEW_DEF );
+	*partnerView = *tr.viewDef;
+	partnerView->renderView.vieworg -= ( 2.0f * eyeView.stereoWorldSeparation ) * eyeView.viewaxis[1];
+	partnerView->renderView.vieworg_weapon -= ( 2.0f * eyeView.stereoWorldSeparation ) * eyeView.viewaxis[1];
+	partnerView->renderView.viewEyeBuffer = -eyeView.viewEyeBuffer;
+	partnerView->renderView.stereoScreenSeparation = -eyeView.stereoScreenSeparation;
+	partnerView->renderView.stereoWorldSeparation = -eyeView.stereoWorldSeparation;
+	partnerView->initialViewAreaOrigin = partnerView->renderView.vieworg;
+
+	// the connected areas and the start of the flow have to be the same for both eyes
+	if( PointInArea( partnerView->initialViewAreaOrigin ) != tr.viewDef->areaNum )
+	{
+		return NULL;
+	}
+
+	R_SetupViewFrustum( partnerView );
+
+	return partnerView;
+}
+
+/*
+=============
+idRenderWorldLocal::SaveStereoVisibility
+
+Remembers everything the stereo pair flow found, so the other eye view can skip the portal flow.
+This is done before any per view culling shrinks the lists.
+=============
+*/
+void idRenderWorldLocal::SaveStereoVisibility( const viewDef_t* partnerView )
+{
+	stereoVisibility_t& vis = stereoVisibility[nextStereoVisibility];
+	nextStereoVisibility = ( nextStereoVisibility + 1 ) % MAX_STEREO_VISIBILITY;
+
+	vis.frameCount = tr.frameCount;
+	vis.partnerView = partnerView->renderView;
+	vis.areaNum = tr.viewDef->areaNum;
+
+	vis.areas.SetNum( 0 );
+	for( int i = 0; i < numPortalAreas; i++ )
+	{
+		if( portalAreas[i].viewCount == tr.viewCount )
+		{
+			vis.areas.Append( i );
+		}
+	}
+
+	vis.entities.SetNum( 0 );
+	vis.entityRects.SetNum( 0 );
+	for( const viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+	{
+		vis.entities.Append( vEntity->entityDef );
+		vis.entityRects.Append( vEntity->scissorRect );
+	}
+
+	vis.lights.SetNum( 0 );
+	vis.lightRects.SetNum( 0 );
+	for( const viewLight_t* vLight = tr.viewDef->viewLights; vLight != NULL; vLight = vLight->next )
+	{
+		vis.lights.Append( vLight->lightDef );
+		vis.lightRects.Append( vLight->scissorRect );
+	}
+
+	vis.envprobes.SetNum( 0 );
+	vis.envprobeRects.SetNum( 0 );
+	for( const viewEnvprobe_t* vProbe = tr.viewDef->viewEnvprobes; vProbe != NULL; vProbe = vProbe->next )
+	{
+		vis.envprobes.Append( vProbe->envprobeDef );
+		vis.envprobeRects.Append( vProbe->scissorRect );
+	}
+}
+
+/*
+=============
+idRenderWorldLocal::ReuseStereoVisibility
+
+If the other eye of this frame already flowed through the portals for both eyes,
+creates the viewEntities, viewLights and viewEnvprobes from its results.
+=============
+*/
+bool idRenderWorldLocal::ReuseStereoVisibility()
+{
+	if( !r_useStereoSharedVisibility.GetBool() || tr.viewDef->isSubview || tr.viewDef->renderView.viewEyeBuffer == 0 )
+	{
+		return false;
+	}
+
+	const renderView_t& eyeView = tr.viewDef->renderView;
+
+	const stereoVisibility_t* vis = NULL;
+	for( int i = 0; i < MAX_STEREO_VISIBILITY; i++ )
+	{
+		const stereoVisibility_t& check = stereoVisibility[i];
+		if( check.frameCount != tr.frameCount || check.areaNum != tr.viewDef->areaNum )
+		{
+			continue;
+		}
+		const renderView_t& partnerView = check.partnerView;
+		if( partnerView.viewEyeBuffer != eyeView.viewEyeBuffer || partnerView.viewID != eyeView.viewID
+				|| partnerView.time[0] != eyeView.time[0] || partnerView.fov_x != eyeView.fov_x || partnerView.fov_y != eyeView.fov_y )
+		{
+			continue;
+		}
+		if( !partnerView.vieworg.Compare( eyeView.vieworg, 0.01f ) || !partnerView.viewaxis.Compare( eyeView.viewaxis, 0.0001f ) )
+		{
+			continue;
+		}
+		vis = &check;
+		break;
+	}
+
+	if( vis == NULL )
+	{
+		return false;
+	}
+
+	for( int i = 0; i < vis->areas.Num(); i++ )
+	{
+		portalAreas[ vis->areas[i] ].viewCount = tr.viewCount;
+	}
+
+	// the scissor rects cover both eyes, so they can be used as is
+	for( int i = 0; i < vis->entities.Num(); i++ )
+	{
+		R_SetEntityDefViewEntity( vis->entities[i] )->scissorRect = vis->entityRects[i];
+	}
+	for( int i = 0; i < vis->lights.Num(); i++ )
+	{
+		R_SetLightDefViewLight( vis->lights[i] )->scissorRect = vis->lightRects[i];
+	}
+	for( int i = 0; i < vis->envprobes.Num(); i++ )
+	{
+		R_SetEnvprobeDefViewEnvprobe( vis->envprobes[i] )->scissorRect = vis->envprobeRects[i];
+	}
+
+	return true;
+}
+
+/*
+=============
+idRenderWorldLocal::InvalidateStereoVisibility
+=============
+*/
+void idRenderWorldLocal::InvalidateStereoVisibility()
+{
+	for( int i = 0; i < MAX_STEREO_VISIBILITY; i++ )
+	{
+		stereoVisibility[i].frameCount = -1;
 	}
 }
 
@@ -1151,3 +1484,86 @@ int idRenderWorldLocal::GetPortalState( qhandle_t portal )
 	return doublePortals[portal - 1].blockingBits;
 }
 
+
+/*
+=================
+testCullBoundsBatch
+
+Compares culling bounds one at a time with CullBoundsToMVP against the batched
+CullBoundsToMVPBatch, including the cost of filling the batches.
+=================
+*/
+CONSOLE_COMMAND( testCullBoundsBatch, "benchmarks idRenderMatrix::CullBoundsToMVPBatch against CullBoundsToMVP, usage: testCullBoundsBatch [numRuns]", NULL )
+{
+	const int numRuns = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, 1000, atoi( args.Argv( 1 ) ) ) : 20;
+	const int counts[3] = { 100, 1000, 10000 };
+	const int maxBounds = counts[2];
+
+	idRenderMatrix viewMatrix;
+	idRenderMatrix projectionMatrix;
+	idRenderMatrix mvp;
+	idRenderMatrix::CreateViewMatrix( vec3_origin, idAngles( 10.0f, 30.0f, 0.0f ).ToMat3(), viewMatrix );
+	idRenderMatrix::CreateProjectionMatrixFov( 90.0f, 73.74f, 3.0f, 0.0f, 0.0f, 0.0f, projectionMatrix );
+	idRenderMatrix::Multiply( projectionMatrix, viewMatrix, mvp );
+
+	// entity sized bounds scattered around the view, a bit more than half of them are culled
+	idBounds* bounds = ( idBounds* )Mem_Alloc( maxBounds * sizeof( idBounds ), TAG_TEMP );
+	byte* culled = ( byte* )Mem_Alloc( maxBounds, TAG_TEMP );
+	idRandom random( 1234 );
+	for( int i = 0; i < maxBounds; i++ )
+	{
+		const idVec3 center( random.CRandomFloat() * 2000.0f, random.CRandomFloat() * 2000.0f, random.CRandomFloat() * 500.0f );
+		const idVec3 extents( 8.0f + random.RandomFloat() * 120.0f, 8.0f + random.RandomFloat() * 120.0f, 8.0f + random.RandomFloat() * 120.0f );
+		bounds[i][0] = center - extents;
+		bounds[i][1] = center + extents;
+	}
+
+	R_SetBatchCullingKernel();
+	idLib::Printf( "  bounds       single      batched   culled   mismatches (usec, %d runs, %s kernel)\n", numRuns, idRenderMatrix::GetBatchCullingKernel() );
+
+	idBoundsBatch batch;
+	for( int c = 0; c < 3; c++ )
+	{
+		const int numBounds = counts[c];
+
+		uint64 times[2] = { 0, 0 };
+		int numCulled = 0;
+		int numMismatches = 0;
+		for( int run = 0; run < numRuns; run++ )
+		{
+			uint64 start = Sys_Microseconds();
+			for( int i = 0; i < numBounds; i++ )
+			{
+				culled[i] = idRenderMatrix::CullBoundsToMVP( mvp, bounds[i] ) ? 1 : 0;
+			}
+			times[0] += Sys_Microseconds() - start;
+
+			start = Sys_Microseconds();
+			numCulled = 0;
+			numMismatches = 0;
+			for( int i = 0; i < numBounds; )
+			{
+				const int first = i;
+				batch.Clear();
+				for( ; i < numBounds && !batch.IsFull(); i++ )
+				{
+					batch.Append( bounds[i] );
+				}
+
+				byte batchCulled[idBoundsBatch::MAX_BOUNDS];
+				idRenderMatrix::CullBoundsToMVPBatch( mvp, batch, batchCulled );
+				for( int j = 0; j < batch.Num(); j++ )
+				{
+					numCulled += batchCulled[j];
+					numMismatches += ( batchCulled[j] != culled[first + j] );
+				}
+			}
+			times[1] += Sys_Microseconds() - start;
+		}
+
+		idLib::Printf( "%8d %12.1f %12.1f %8d %12d\n", numBounds, ( float )times[0] / numRuns, ( float )times[1] / numRuns, numCulled, numMismatches );
+	}
+
+	Mem_Free( culled );
+	Mem_Free( bounds );
+}
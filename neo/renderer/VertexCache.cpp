@@ -38,6 +38,8 @@ idCVar r_showVertexCache( "r_showVertexCache", "0", CVAR_RENDERER | CVAR_BOOL, "
 idCVar r_showVertexCacheTimings( "r_showVertexCacheTimings", "0", CVAR_RENDERER | CVAR_BOOL, "Print stats about the vertex cache every frame" );
 
 
+static const char* cacheTypeNames[CACHE_NUM_TYPES] = { "vertex", "index", "joint" };
+
 /*
 ==============
 ClearGeoBufferSet
@@ -45,30 +47,131 @@ ClearGeoBufferSet
 */
 static void ClearGeoBufferSet( geoBufferSet_t& gbs )
 {
-	gbs.indexMemUsed.SetValue( 0 );
-	gbs.vertexMemUsed.SetValue( 0 );
-	gbs.jointMemUsed.SetValue( 0 );
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
+	{
+		gbs.memUsed[i].SetValue( 0 );
+		gbs.memOverflow[i].SetValue( 0 );
+	}
 	gbs.allocations = 0;
 }
 
 /*
 ==============
-MapGeoBufferSet
+AllocGeoBufferPage
 ==============
 */
-static void MapGeoBufferSet( geoBufferSet_t& gbs )
+static void AllocGeoBufferPage( geoBufferSet_t& gbs, const cacheType_t type, const int page )
 {
-	if( gbs.mappedVertexBase == NULL )
+	assert( page < VERTCACHE_MAX_PAGES );
+	gbs.mappedBase[type][page] = NULL;
+	switch( type )
 	{
-		gbs.mappedVertexBase = ( byte* )gbs.vertexBuffer.MapBuffer( BM_WRITE );
+		case CACHE_VERTEX:
+			gbs.vertexBuffer[page].AllocBufferObject( NULL, gbs.pageSize[type] );
+			break;
+		case CACHE_INDEX:
+			gbs.indexBuffer[page].AllocBufferObject( NULL, gbs.pageSize[type] );
+			break;
+		case CACHE_JOINT:
+			gbs.jointBuffer[page].AllocBufferObject( NULL, gbs.pageSize[type] / sizeof( idJointMat ) );
+			break;
+		default:
+			assert( false );
 	}
-	if( gbs.mappedIndexBase == NULL )
+}
+
+/*
+==============
+FreeGeoBufferPage
+==============
+*/
+static void FreeGeoBufferPage( geoBufferSet_t& gbs, const cacheType_t type, const int page )
+{
+	switch( type )
 	{
-		gbs.mappedIndexBase = ( byte* )gbs.indexBuffer.MapBuffer( BM_WRITE );
+		case CACHE_VERTEX:
+			gbs.vertexBuffer[page].FreeBufferObject();
+			break;
+		case CACHE_INDEX:
+			gbs.indexBuffer[page].FreeBufferObject();
+			break;
+		case CACHE_JOINT:
+			gbs.jointBuffer[page].FreeBufferObject();
+			break;
+		default:
+			assert( false );
 	}
-	if( gbs.mappedJointBase == NULL && gbs.jointBuffer.GetAllocedSize() != 0 )
+	gbs.mappedBase[type][page] = NULL;
+}
+
+/*
+==============
+MapGeoBufferPage
+==============
+*/
+static void MapGeoBufferPage( geoBufferSet_t& gbs, const cacheType_t type, const int page )
+{
+	if( gbs.mappedBase[type][page] != NULL )
 	{
-		gbs.mappedJointBase = ( byte* )gbs.jointBuffer.MapBuffer( BM_WRITE );
+		return;
+	}
+	switch( type )
+	{
+		case CACHE_VERTEX:
+			gbs.mappedBase[type][page] = ( byte* )gbs.vertexBuffer[page].MapBuffer( BM_WRITE );
+			break;
+		case CACHE_INDEX:
+			gbs.mappedBase[type][page] = ( byte* )gbs.indexBuffer[page].MapBuffer( BM_WRITE );
+			break;
+		case CACHE_JOINT:
+			gbs.mappedBase[type][page] = ( byte* )gbs.jointBuffer[page].MapBuffer( BM_WRITE );
+			break;
+		default:
+			assert( false );
+	}
+}
+
+/*
+==============
+UnmapGeoBufferPage
+==============
+*/
+static void UnmapGeoBufferPage( geoBufferSet_t& gbs, const cacheType_t type, const int page )
+{
+	if( gbs.mappedBase[type][page] == NULL )
+	{
+		return;
+	}
+	switch( type )
+	{
+		case CACHE_VERTEX:
+			gbs.vertexBuffer[page].UnmapBuffer();
+			break;
+		case CACHE_INDEX:
+			gbs.indexBuffer[page].UnmapBuffer();
+			break;
+		case CACHE_JOINT:
+			gbs.jointBuffer[page].UnmapBuffer();
+			break;
+		default:
+			assert( false );
+	}
+	gbs.mappedBase[type][page] = NULL;
+}
+
+/*
+==============
+MapGeoBufferSet
+==============
+*/
+static void MapGeoBufferSet( geoBufferSet_t& gbs )
+{
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
+	{
+		for( int j = 0; j < gbs.numPages[i]; j++ )
+		{
+			MapGeoBufferPage( gbs, ( cacheType_t )i, j );
+		}
 	}
 }
 
@@ -79,20 +182,34 @@ UnmapGeoBufferSet
 */
 static void UnmapGeoBufferSet( geoBufferSet_t& gbs )
 {
-	if( gbs.mappedVertexBase != NULL )
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
 	{
-		gbs.vertexBuffer.UnmapBuffer();
-		gbs.mappedVertexBase = NULL;
+		for( int j = 0; j < gbs.numPages[i]; j++ )
+		{
+			UnmapGeoBufferPage( gbs, ( cacheType_t )i, j );
+		}
 	}
-	if( gbs.mappedIndexBase != NULL )
+}
+
+/*
+==============
+ResizeGeoBufferSet
+
+adds or frees pages until there are numPages of the type
+==============
+*/
+static void ResizeGeoBufferSet( geoBufferSet_t& gbs, const cacheType_t type, const int numPages )
+{
+	assert( numPages <= VERTCACHE_MAX_PAGES );
+	while( gbs.numPages[type] < numPages )
 	{
-		gbs.indexBuffer.UnmapBuffer();
-		gbs.mappedIndexBase = NULL;
+		AllocGeoBufferPage( gbs, type, gbs.numPages[type] );
+		gbs.numPages[type]++;
 	}
-	if( gbs.mappedJointBase != NULL )
+	while( gbs.numPages[type] > numPages )
 	{
-		gbs.jointBuffer.UnmapBuffer();
-		gbs.mappedJointBase = NULL;
+		gbs.numPages[type]--;
+		FreeGeoBufferPage( gbs, type, gbs.numPages[type] );
 	}
 }
 
@@ -103,15 +220,34 @@ AllocGeoBufferSet
 */
 static void AllocGeoBufferSet( geoBufferSet_t& gbs, const int vertexBytes, const int indexBytes, const int jointBytes )
 {
-	gbs.vertexBuffer.AllocBufferObject( NULL, vertexBytes );
-	gbs.indexBuffer.AllocBufferObject( NULL, indexBytes );
-	if( jointBytes != 0 )
+	memset( gbs.mappedBase, 0, sizeof( gbs.mappedBase ) );
+	gbs.pageSize[CACHE_VERTEX] = vertexBytes;
+	gbs.pageSize[CACHE_INDEX] = indexBytes;
+	gbs.pageSize[CACHE_JOINT] = jointBytes;
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
 	{
-		gbs.jointBuffer.AllocBufferObject( NULL, jointBytes / sizeof( idJointMat ) );
+		gbs.numPages[i] = 0;
+		if( gbs.pageSize[i] != 0 )
+		{
+			ResizeGeoBufferSet( gbs, ( cacheType_t )i, 1 );
+		}
 	}
 	ClearGeoBufferSet( gbs );
 }
 
+/*
+==============
+FreeGeoBufferSet
+==============
+*/
+static void FreeGeoBufferSet( geoBufferSet_t& gbs )
+{
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
+	{
+		ResizeGeoBufferSet( gbs, ( cacheType_t )i, 0 );
+	}
+}
+
 /*
 ==============
 idVertexCache::Init
@@ -126,12 +262,18 @@ void idVertexCache::Init( bool restart )
 	mostUsedIndex = 0;
 	mostUsedJoint = 0;
 
+	numOverflowFrames = 0;
+
 	for( int i = 0; i < VERTCACHE_NUM_FRAMES; i++ )
 	{
 		AllocGeoBufferSet( frameData[i], VERTCACHE_VERTEX_MEMORY_PER_FRAME, VERTCACHE_INDEX_MEMORY_PER_FRAME, VERTCACHE_JOINT_MEMORY_PER_FRAME );
 	}
 	AllocGeoBufferSet( staticData, STATIC_VERTEX_MEMORY, STATIC_INDEX_MEMORY, 0 );
 
+	// large enough for the biggest frame allocation, which is a whole page
+	const int maxFramePageSize = Max( Max( VERTCACHE_VERTEX_MEMORY_PER_FRAME, VERTCACHE_INDEX_MEMORY_PER_FRAME ), VERTCACHE_JOINT_MEMORY_PER_FRAME );
+	overflowBuffer = ( byte* )Mem_Alloc16( maxFramePageSize, TAG_RENDER );
+
 	MapGeoBufferSet( frameData[listNum] );
 }
 
@@ -144,10 +286,12 @@ void idVertexCache::Shutdown()
 {
 	for( int i = 0; i < VERTCACHE_NUM_FRAMES; i++ )
 	{
-		frameData[i].vertexBuffer.FreeBufferObject();
-		frameData[i].indexBuffer.FreeBufferObject();
-		frameData[i].jointBuffer.FreeBufferObject();
+		FreeGeoBufferSet( frameData[i] );
 	}
+	FreeGeoBufferSet( staticData );
+
+	Mem_Free16( overflowBuffer );
+	overflowBuffer = NULL;
 }
 
 /*
@@ -166,11 +310,23 @@ void idVertexCache::PurgeAll()
 idVertexCache::FreeStaticData
 
 call on loading a new map
+
+All the static data of the previous map is dropped, so the next map is packed from the
+start of the first page again. Pages that were only needed by the previous map are released.
 ==============
 */
 void idVertexCache::FreeStaticData()
 {
+	UnmapGeoBufferSet( staticData );
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
+	{
+		if( staticData.numPages[i] > 1 )
+		{
+			ResizeGeoBufferSet( staticData, ( cacheType_t )i, 1 );
+		}
+	}
 	ClearGeoBufferSet( staticData );
+
 	mostUsedVertex = 0;
 	mostUsedIndex = 0;
 	mostUsedJoint = 0;
@@ -193,57 +349,82 @@ vertCacheHandle_t idVertexCache::ActuallyAlloc( geoBufferSet_t& vcs, const void*
 	// RB end
 
 	assert( ( bytes & 15 ) == 0 );
+	assert( type >= 0 && type < CACHE_NUM_TYPES );
 
-	// thread safe interlocked adds
-	byte** base = NULL;
-	int	endPos = 0;
-	if( type == CACHE_INDEX )
+	const bool isStatic = ( &vcs == &staticData );
+	const int pageSize = vcs.pageSize[type];
+	if( bytes > pageSize )
 	{
-		base = &vcs.mappedIndexBase;
-		endPos = vcs.indexMemUsed.Add( bytes );
-		if( endPos > vcs.indexBuffer.GetAllocedSize() )
-		{
-			idLib::Error( "Out of index cache" );
-		}
+		idLib::Error( "%i bytes don't fit in a %s cache page", bytes, cacheTypeNames[type] );
 	}
-	else if( type == CACHE_VERTEX )
+
+	// thread safe interlocked adds, an allocation never straddles two pages,
+	// the end of a page that it doesn't fit in is skipped
+	int page = 0;
+	int offset = 0;
+	while( true )
 	{
-		base = &vcs.mappedVertexBase;
-		endPos = vcs.vertexMemUsed.Add( bytes );
-		if( endPos > vcs.vertexBuffer.GetAllocedSize() )
+		const int endPos = vcs.memUsed[type].Add( bytes );
+		const int startPos = endPos - bytes;
+		page = startPos / pageSize;
+		offset = startPos - page * pageSize;
+		if( offset + bytes <= pageSize )
 		{
-			idLib::Error( "Out of vertex cache" );
+			break;
 		}
+		// if the next try can't fit behind this one either, skip to the next page boundary,
+		// otherwise an allocation of a whole page would never start at the beginning of a page
+		const int endOffset = endPos % pageSize;
+		if( endOffset != 0 && endOffset + bytes > pageSize )
+		{
+			vcs.memUsed[type].Add( pageSize - endOffset );
+		}
+	}
+
+	vcs.allocations++;
+
+	byte* base = NULL;
+	if( page < vcs.numPages[type] )
+	{
+		base = vcs.mappedBase[type][page];
 	}
-	else if( type == CACHE_JOINT )
+	else if( isStatic )
 	{
-		base = &vcs.mappedJointBase;
-		endPos = vcs.jointMemUsed.Add( bytes );
-		if( endPos > vcs.jointBuffer.GetAllocedSize() )
+		// static data is only allocated by the main thread while loading, so it can add pages
+		assert( idLib::IsMainThread() );
+		if( page >= VERTCACHE_MAX_PAGES )
 		{
-			idLib::Error( "Out of joint buffer cache" );
+			idLib::FatalError( "Out of static %s cache, %i pages of %i kB", cacheTypeNames[type], VERTCACHE_MAX_PAGES, pageSize / 1024 );
 		}
+		idLib::Printf( "Adding static %s cache page %i\n", cacheTypeNames[type], page );
+		ResizeGeoBufferSet( vcs, type, page + 1 );
 	}
 	else
 	{
-		assert( false );
+		// the frame doesn't fit, the buffers grow before the frame after the next one
+		// and this allocation won't be drawn
+		vcs.memOverflow[type].Add( bytes );
+		page = VERTCACHE_OVERFLOW_PAGE;
+		offset = 0;
+		base = overflowBuffer;
 	}
 
-	vcs.allocations++;
-
-	int offset = endPos - bytes;
-
 	// Actually perform the data transfer
 	if( data != NULL )
 	{
-		MapGeoBufferSet( vcs );
-		CopyBuffer( *base + offset, ( const byte* )data, bytes );
+		if( base == NULL )
+		{
+			MapGeoBufferPage( vcs, type, page );
+			base = vcs.mappedBase[type][page];
+		}
+		CopyBuffer( base + offset, ( const byte* )data, bytes );
 	}
 
 	vertCacheHandle_t handle =	( ( uint64 )( currentFrame & VERTCACHE_FRAME_MASK ) << VERTCACHE_FRAME_SHIFT ) |
 								( ( uint64 )( offset & VERTCACHE_OFFSET_MASK ) << VERTCACHE_OFFSET_SHIFT ) |
-								( ( uint64 )( bytes & VERTCACHE_SIZE_MASK ) << VERTCACHE_SIZE_SHIFT );
-	if( &vcs == &staticData )
+								( ( uint64 )( page & VERTCACHE_PAGE_MASK ) << VERTCACHE_PAGE_SHIFT ) |
+								( ( uint64 )( ( ( bytes + ( 1 << VERTCACHE_SIZE_UNIT_SHIFT ) - 1 ) >> VERTCACHE_SIZE_UNIT_SHIFT ) & VERTCACHE_SIZE_MASK ) << VERTCACHE_SIZE_SHIFT );
+	if( isStatic )
 	{
 		handle |= VERTCACHE_STATIC;
 	}
@@ -252,25 +433,76 @@ vertCacheHandle_t idVertexCache::ActuallyAlloc( geoBufferSet_t& vcs, const void*
 
 /*
 ==============
-idVertexCache::GetVertexBuffer
+idVertexCache::MappedBuffer
 ==============
 */
-bool idVertexCache::GetVertexBuffer( vertCacheHandle_t handle, idVertexBuffer* vb )
+byte* idVertexCache::MappedBuffer( vertCacheHandle_t handle, cacheType_t type )
 {
-	const int isStatic = handle & VERTCACHE_STATIC;
-	const uint64 size = ( int )( handle >> VERTCACHE_SIZE_SHIFT ) & VERTCACHE_SIZE_MASK;
-	const uint64 offset = ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	release_assert( !CacheIsStatic( handle ) );
 	const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-	if( isStatic )
+	release_assert( frameNum == ( currentFrame & VERTCACHE_FRAME_MASK ) );
+	const int page = CachePage( handle );
+	if( page == VERTCACHE_OVERFLOW_PAGE )
 	{
-		vb->Reference( staticData.vertexBuffer, offset, size );
-		return true;
+		return overflowBuffer;
 	}
-	if( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
+	return frameData[ listNum ].mappedBase[type][page] + CacheOffset( handle );
+}
+
+/*
+==============
+idVertexCache::GetDrawVertexBuffer
+==============
+*/
+idVertexBuffer* idVertexCache::GetDrawVertexBuffer( vertCacheHandle_t handle )
+{
+	const int page = CachePage( handle );
+	if( CacheIsStatic( handle ) )
+	{
+		return &staticData.vertexBuffer[page];
+	}
+	const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
+	if( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) || page == VERTCACHE_OVERFLOW_PAGE )
+	{
+		return NULL;
+	}
+	return &frameData[drawListNum].vertexBuffer[page];
+}
+
+/*
+==============
+idVertexCache::GetDrawIndexBuffer
+==============
+*/
+idIndexBuffer* idVertexCache::GetDrawIndexBuffer( vertCacheHandle_t handle )
+{
+	const int page = CachePage( handle );
+	if( CacheIsStatic( handle ) )
+	{
+		return &staticData.indexBuffer[page];
+	}
+	const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
+	if( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) || page == VERTCACHE_OVERFLOW_PAGE )
+	{
+		return NULL;
+	}
+	return &frameData[drawListNum].indexBuffer[page];
+}
+
+/*
+==============
+idVertexCache::GetVertexBuffer
+==============
+*/
+bool idVertexCache::GetVertexBuffer( vertCacheHandle_t handle, idVertexBuffer* vb )
+{
+	const idVertexBuffer* page = GetDrawVertexBuffer( handle );
+	if( page == NULL )
 	{
 		return false;
 	}
-	vb->Reference( frameData[drawListNum].vertexBuffer, offset, size );
+	const int offset = CacheOffset( handle );
+	vb->Reference( *page, offset, Min( CacheSize( handle ), page->GetSize() - offset ) );
 	return true;
 }
 
@@ -281,20 +513,13 @@ idVertexCache::GetIndexBuffer
 */
 bool idVertexCache::GetIndexBuffer( vertCacheHandle_t handle, idIndexBuffer* ib )
 {
-	const int isStatic = handle & VERTCACHE_STATIC;
-	const uint64 size = ( int )( handle >> VERTCACHE_SIZE_SHIFT ) & VERTCACHE_SIZE_MASK;
-	const uint64 offset = ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
-	const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-	if( isStatic )
-	{
-		ib->Reference( staticData.indexBuffer, offset, size );
-		return true;
-	}
-	if( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
+	const idIndexBuffer* page = GetDrawIndexBuffer( handle );
+	if( page == NULL )
 	{
 		return false;
 	}
-	ib->Reference( frameData[drawListNum].indexBuffer, offset, size );
+	const int offset = CacheOffset( handle );
+	ib->Reference( *page, offset, Min( CacheSize( handle ), page->GetSize() - offset ) );
 	return true;
 }
 
@@ -305,24 +530,41 @@ idVertexCache::GetJointBuffer
 */
 bool idVertexCache::GetJointBuffer( vertCacheHandle_t handle, idJointBuffer* jb )
 {
-	const int isStatic = handle & VERTCACHE_STATIC;
-	const uint64 numBytes = ( int )( handle >> VERTCACHE_SIZE_SHIFT ) & VERTCACHE_SIZE_MASK;
-	const uint64 jointOffset = ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	const int page = CachePage( handle );
+	const uint64 jointOffset = CacheOffset( handle );
 	const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-	const uint64 numJoints = numBytes / sizeof( idJointMat );
-	if( isStatic )
-	{
-		jb->Reference( staticData.jointBuffer, jointOffset, numJoints );
-		return true;
-	}
-	if( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) )
+	if( !CacheIsStatic( handle ) && ( frameNum != ( ( currentFrame - 1 ) & VERTCACHE_FRAME_MASK ) || page == VERTCACHE_OVERFLOW_PAGE ) )
 	{
 		return false;
 	}
-	jb->Reference( frameData[drawListNum].jointBuffer, jointOffset, numJoints );
+	const idJointBuffer& pageBuffer = CacheIsStatic( handle ) ? staticData.jointBuffer[page] : frameData[drawListNum].jointBuffer[page];
+	const uint64 numBytes = Min( ( uint64 )CacheSize( handle ), pageBuffer.GetNumJoints() * sizeof( idJointMat ) - jointOffset );
+	jb->Reference( pageBuffer, jointOffset, numBytes / sizeof( idJointMat ) );
 	return true;
 }
 
+/*
+==============
+idVertexCache::GrowFrameBuffers
+
+adds pages to a frame set that isn't mapped until the high water mark plus some slack fits
+==============
+*/
+void idVertexCache::GrowFrameBuffers( geoBufferSet_t& gbs )
+{
+	const int mostUsed[CACHE_NUM_TYPES] = { mostUsedVertex, mostUsedIndex, mostUsedJoint };
+	for( int i = 0; i < CACHE_NUM_TYPES; i++ )
+	{
+		const int64 needed = ( int64 )mostUsed[i] + mostUsed[i] / 4;
+		const int numPages = idMath::ClampInt( 1, VERTCACHE_MAX_PAGES, ( int )( ( needed + gbs.pageSize[i] - 1 ) / gbs.pageSize[i] ) );
+		if( numPages > gbs.numPages[i] )
+		{
+			idLib::Printf( "Growing the frame %s cache from %i to %i pages of %i kB\n", cacheTypeNames[i], gbs.numPages[i], numPages, gbs.pageSize[i] / 1024 );
+			ResizeGeoBufferSet( gbs, ( cacheType_t )i, numPages );
+		}
+	}
+}
+
 /*
 ==============
 idVertexCache::BeginBackEnd
@@ -330,25 +572,39 @@ idVertexCache::BeginBackEnd
 */
 void idVertexCache::BeginBackEnd()
 {
-	mostUsedVertex = Max( mostUsedVertex, frameData[listNum].vertexMemUsed.GetValue() );
-	mostUsedIndex = Max( mostUsedIndex, frameData[listNum].indexMemUsed.GetValue() );
-	mostUsedJoint = Max( mostUsedJoint, frameData[listNum].jointMemUsed.GetValue() );
+	geoBufferSet_t& frame = frameData[listNum];
+
+	mostUsedVertex = Max( mostUsedVertex, frame.memUsed[CACHE_VERTEX].GetValue() );
+	mostUsedIndex = Max( mostUsedIndex, frame.memUsed[CACHE_INDEX].GetValue() );
+	mostUsedJoint = Max( mostUsedJoint, frame.memUsed[CACHE_JOINT].GetValue() );
+
+	const int overflowBytes = frame.memOverflow[CACHE_VERTEX].GetValue() + frame.memOverflow[CACHE_INDEX].GetValue() + frame.memOverflow[CACHE_JOINT].GetValue();
+	if( overflowBytes > 0 )
+	{
+		numOverflowFrames++;
+		idLib::Warning( "idVertexCache: frame %i skipped %i kB of geometry that didn't fit", currentFrame, overflowBytes / 1024 );
+	}
 
 	if( r_showVertexCache.GetBool() )
 	{
 		idLib::Printf( "%08d: %d allocations, %dkB vertex, %dkB index, %ikB joint : %dkB vertex, %dkB index, %ikB joint\n",
-					   currentFrame, frameData[listNum].allocations,
-					   frameData[listNum].vertexMemUsed.GetValue() / 1024,
-					   frameData[listNum].indexMemUsed.GetValue() / 1024,
-					   frameData[listNum].jointMemUsed.GetValue() / 1024,
+					   currentFrame, frame.allocations,
+					   frame.memUsed[CACHE_VERTEX].GetValue() / 1024,
+					   frame.memUsed[CACHE_INDEX].GetValue() / 1024,
+					   frame.memUsed[CACHE_JOINT].GetValue() / 1024,
 					   mostUsedVertex / 1024,
 					   mostUsedIndex / 1024,
 					   mostUsedJoint / 1024 );
+		idLib::Printf( "          pages %i/%i/%i, static %dkB/%dkB vertex, %dkB/%dkB index, %i overflow frames\n",
+					   frame.numPages[CACHE_VERTEX], frame.numPages[CACHE_INDEX], frame.numPages[CACHE_JOINT],
+					   StaticMemoryUsed( CACHE_VERTEX ) / 1024, StaticMemoryAllocated( CACHE_VERTEX ) / 1024,
+					   StaticMemoryUsed( CACHE_INDEX ) / 1024, StaticMemoryAllocated( CACHE_INDEX ) / 1024,
+					   numOverflowFrames );
 	}
 
 	// unmap the current frame so the GPU can read it
 	const int startUnmap = Sys_Milliseconds();
-	UnmapGeoBufferSet( frameData[listNum] );
+	UnmapGeoBufferSet( frame );
 	UnmapGeoBufferSet( staticData );
 	const int endUnmap = Sys_Milliseconds();
 	if( endUnmap - startUnmap > 1 )
@@ -361,6 +617,10 @@ void idVertexCache::BeginBackEnd()
 	currentFrame++;
 
 	listNum = currentFrame % VERTCACHE_NUM_FRAMES;
+
+	// the GPU is done with the set that is about to be mapped, so pages can be added to it
+	GrowFrameBuffers( frameData[listNum] );
+
 	const int startMap = Sys_Milliseconds();
 	MapGeoBufferSet( frameData[listNum] );
 	const int endMap = Sys_Milliseconds();
@@ -374,8 +634,8 @@ void idVertexCache::BeginBackEnd()
 
 #if 0
 	const int startBind = Sys_Milliseconds();
-	glBindBuffer( GL_ARRAY_BUFFER, ( GLuint )frameData[drawListNum].vertexBuffer.GetAPIObject() );
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ( GLuint )frameData[drawListNum].indexBuffer.GetAPIObject() );
+	glBindBuffer( GL_ARRAY_BUFFER, ( GLuint )frameData[drawListNum].vertexBuffer[0].GetAPIObject() );
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ( GLuint )frameData[drawListNum].indexBuffer[0].GetAPIObject() );
 	const int endBind = Sys_Milliseconds();
 	if( endBind - startBind > 1 )
 	{
@@ -384,4 +644,3 @@ void idVertexCache::BeginBackEnd()
 #endif
 
 }
-
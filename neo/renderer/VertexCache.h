@@ -28,6 +28,7 @@ If you have questions concerning this license or the applicable additional terms
 #ifndef __VERTEXCACHE2_H__
 #define __VERTEXCACHE2_H__
 
+// size of the first buffer page of each frame set, more pages are added when a frame doesn't fit
 const int VERTCACHE_INDEX_MEMORY_PER_FRAME = 31 * 1024 * 1024;
 const int VERTCACHE_VERTEX_MEMORY_PER_FRAME = 31 * 1024 * 1024;
 const int VERTCACHE_JOINT_MEMORY_PER_FRAME = 256 * 1024;
@@ -43,13 +44,24 @@ const int STATIC_INDEX_MEMORY = 31 * 1024 * 1024;
 // const int STATIC_VERTEX_MEMORY = 31 * 1024 * 1024;	// make sure it fits in VERTCACHE_OFFSET_MASK!
 const int STATIC_VERTEX_MEMORY = 32 * 1024 * 1024;	// make sure it fits in VERTCACHE_OFFSET_MASK!
 
-// vertCacheHandle_t packs size, offset, and frame number into 64 bits
+// Each buffer set grows by adding pages of the above sizes. Static pages are added as soon as
+// the map data doesn't fit, frame pages are added between frames. Allocations that don't fit
+// in the pages of a frame go to a scratch buffer and are not drawn.
+const int VERTCACHE_MAX_PAGES = 8;
+
+// vertCacheHandle_t packs size, page, offset, and frame number into 64 bits
+// the offset is in bytes so sub-handles can be built, the size is rounded up to 256 byte
+// blocks, it is only used for the buffer references, which are clamped to the end of the page
 typedef uint64 vertCacheHandle_t;
 const int VERTCACHE_STATIC = 1;					// in the static set, not the per-frame set
 const int VERTCACHE_SIZE_SHIFT = 1;
-const int VERTCACHE_SIZE_MASK = 0x7fffff;		// 8 megs
+const int VERTCACHE_SIZE_MASK = 0x7ffff;		// 128 megs
+const int VERTCACHE_SIZE_UNIT_SHIFT = 8;
+const int VERTCACHE_PAGE_SHIFT = 20;
+const int VERTCACHE_PAGE_MASK = 0xf;
+const int VERTCACHE_OVERFLOW_PAGE = VERTCACHE_PAGE_MASK;	// didn't fit in any page, writes go to a scratch buffer
 const int VERTCACHE_OFFSET_SHIFT = 24;
-const int VERTCACHE_OFFSET_MASK = 0x1ffffff;	// 32 megs
+const int VERTCACHE_OFFSET_MASK = 0x1ffffff;	// 32 megs per page
 const int VERTCACHE_FRAME_SHIFT = 49;
 const int VERTCACHE_FRAME_MASK = 0x7fff;		// 15 bits = 32k frames to wrap around
 
@@ -61,20 +73,20 @@ enum cacheType_t
 {
 	CACHE_VERTEX,
 	CACHE_INDEX,
-	CACHE_JOINT
+	CACHE_JOINT,
+	CACHE_NUM_TYPES
 };
 
 struct geoBufferSet_t
 {
-	idIndexBuffer			indexBuffer;
-	idVertexBuffer			vertexBuffer;
-	idJointBuffer			jointBuffer;
-	byte* 					mappedVertexBase;
-	byte* 					mappedIndexBase;
-	byte* 					mappedJointBase;
-	idSysInterlockedInteger	indexMemUsed;
-	idSysInterlockedInteger	vertexMemUsed;
-	idSysInterlockedInteger	jointMemUsed;
+	idIndexBuffer			indexBuffer[VERTCACHE_MAX_PAGES];
+	idVertexBuffer			vertexBuffer[VERTCACHE_MAX_PAGES];
+	idJointBuffer			jointBuffer[VERTCACHE_MAX_PAGES];
+	byte* 					mappedBase[CACHE_NUM_TYPES][VERTCACHE_MAX_PAGES];
+	int						numPages[CACHE_NUM_TYPES];
+	int						pageSize[CACHE_NUM_TYPES];
+	idSysInterlockedInteger	memUsed[CACHE_NUM_TYPES];		// including the page tails that allocations didn't fit in
+	idSysInterlockedInteger	memOverflow[CACHE_NUM_TYPES];	// allocations that didn't fit in any page
 	int						allocations;	// number of index and vertex allocations combined
 };
 
@@ -105,37 +117,21 @@ public:
 	// this data is valid until the next map load
 	vertCacheHandle_t	AllocStaticVertex( const void* data, int bytes )
 	{
-		if( staticData.vertexMemUsed.GetValue() + bytes > STATIC_VERTEX_MEMORY )
-		{
-			idLib::FatalError( "AllocStaticVertex failed, increase STATIC_VERTEX_MEMORY" );
-		}
 		return ActuallyAlloc( staticData, data, bytes, CACHE_VERTEX );
 	}
 	vertCacheHandle_t	AllocStaticIndex( const void* data, int bytes )
 	{
-		if( staticData.indexMemUsed.GetValue() + bytes > STATIC_INDEX_MEMORY )
-		{
-			idLib::FatalError( "AllocStaticIndex failed, increase STATIC_INDEX_MEMORY" );
-		}
 		return ActuallyAlloc( staticData, data, bytes, CACHE_INDEX );
 	}
 
 	byte* 			MappedVertexBuffer( vertCacheHandle_t handle )
 	{
-		release_assert( !CacheIsStatic( handle ) );
-		const uint64 offset = ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
-		const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		release_assert( frameNum == ( currentFrame & VERTCACHE_FRAME_MASK ) );
-		return frameData[ listNum ].mappedVertexBase + offset;
+		return MappedBuffer( handle, CACHE_VERTEX );
 	}
 
 	byte* 			MappedIndexBuffer( vertCacheHandle_t handle )
 	{
-		release_assert( !CacheIsStatic( handle ) );
-		const uint64 offset = ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
-		const uint64 frameNum = ( int )( handle >> VERTCACHE_FRAME_SHIFT ) & VERTCACHE_FRAME_MASK;
-		release_assert( frameNum == ( currentFrame & VERTCACHE_FRAME_MASK ) );
-		return frameData[ listNum ].mappedIndexBase + offset;
+		return MappedBuffer( handle, CACHE_INDEX );
 	}
 
 	// Returns false if it's been purged
@@ -153,6 +149,10 @@ public:
 		{
 			return false;
 		}
+		if( CachePage( handle ) == VERTCACHE_OVERFLOW_PAGE )
+		{
+			return false;
+		}
 		return true;
 	}
 
@@ -161,13 +161,42 @@ public:
 		return ( handle & VERTCACHE_STATIC ) != 0;
 	}
 
+	static int		CacheSize( const vertCacheHandle_t handle )
+	{
+		return ( ( int )( handle >> VERTCACHE_SIZE_SHIFT ) & VERTCACHE_SIZE_MASK ) << VERTCACHE_SIZE_UNIT_SHIFT;
+	}
+
+	static int		CachePage( const vertCacheHandle_t handle )
+	{
+		return ( int )( handle >> VERTCACHE_PAGE_SHIFT ) & VERTCACHE_PAGE_MASK;
+	}
+
+	static int		CacheOffset( const vertCacheHandle_t handle )
+	{
+		return ( int )( handle >> VERTCACHE_OFFSET_SHIFT ) & VERTCACHE_OFFSET_MASK;
+	}
+
 	// vb/ib is a temporary reference -- don't store it
 	bool			GetVertexBuffer( vertCacheHandle_t handle, idVertexBuffer* vb );
 	bool			GetIndexBuffer( vertCacheHandle_t handle, idIndexBuffer* ib );
 	bool			GetJointBuffer( vertCacheHandle_t handle, idJointBuffer* jb );
 
+	// the page a handle of the frame being drawn is in, NULL if the handle is stale or overflowed
+	idVertexBuffer* 	GetDrawVertexBuffer( vertCacheHandle_t handle );
+	idIndexBuffer* 		GetDrawIndexBuffer( vertCacheHandle_t handle );
+
 	void			BeginBackEnd();
 
+	// memory telemetry
+	int				StaticMemoryUsed( cacheType_t type ) const
+	{
+		return staticData.memUsed[type].GetValue();
+	}
+	int				StaticMemoryAllocated( cacheType_t type ) const
+	{
+		return staticData.numPages[type] * staticData.pageSize[type];
+	}
+
 public:
 	int				currentFrame;	// for determining the active buffers
 	int				listNum;		// currentFrame % VERTCACHE_NUM_FRAMES
@@ -181,8 +210,18 @@ public:
 	int				mostUsedIndex;
 	int				mostUsedJoint;
 
+	// frames that had allocations which didn't fit
+	int				numOverflowFrames;
+
 	// Try to make room for <bytes> bytes
 	vertCacheHandle_t	ActuallyAlloc( geoBufferSet_t& vcs, const void* data, int bytes, cacheType_t type );
+
+private:
+	byte* 			MappedBuffer( vertCacheHandle_t handle, cacheType_t type );
+	void			GrowFrameBuffers( geoBufferSet_t& gbs );
+
+	// written to by the allocations that didn't fit, never read
+	byte* 			overflowBuffer;
 };
 
 // platform specific code to memcpy into vertex buffers efficiently
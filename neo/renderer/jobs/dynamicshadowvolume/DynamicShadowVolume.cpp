@@ -720,7 +720,7 @@ static void StreamOut( void* dst, const void* src, int numBytes )
 R_CreateShadowVolumeTriangles
 ============
 */
-static void R_CreateShadowVolumeTriangles( triIndex_t* __restrict shadowIndices, triIndex_t* __restrict indexBuffer, int& numShadowIndexesTotal,
+static void R_CreateShadowVolumeTriangles( triIndex_t* __restrict shadowIndices, triIndex_t* __restrict indexBuffer, int& numShadowIndexesTotal, int& numShadowIndexesNoCaps,
 		const byte* __restrict facing, const silEdge_t* __restrict silEdges, const int numSilEdges,
 		const triIndex_t* __restrict indexes, const int numIndexes, const bool includeCaps )
 {
@@ -839,6 +839,9 @@ static void R_CreateShadowVolumeTriangles( triIndex_t* __restrict shadowIndices,
 		}
 	}
 
+	// the caps are written after the silhouette quads
+	numShadowIndexesNoCaps = numShadowIndices;
+
 	if( includeCaps )
 	{
 		idODSStreamedArray< triIndex_t, IN_BUFFER_SIZE, SBT_QUAD, 1 > indexesODS( indexes, numIndexes );
@@ -984,6 +987,8 @@ static void R_CreateShadowVolumeTriangles( triIndex_t* __restrict shadowIndices,
 		}
 	}
 
+	numShadowIndexesNoCaps = shadowIndexPtr - shadowIndices;
+
 	if( includeCaps )
 	{
 		idODSStreamedArray< triIndex_t, 256, SBT_QUAD, 1 > indexesODS( indexes, numIndexes );
@@ -1254,6 +1259,8 @@ void DynamicShadowVolumeJob( const dynamicShadowVolumeParms_t* parms )
 		if( parms->shadowIndices != NULL )
 		{
 			const int numTriangles = parms->numIndexes / 3;
+			int numCachedShadowIndices = 0;
+			int numCachedShadowIndicesNoCaps = 0;
 
 			// If there are any triangles facing away from the light.
 			if( numTriangles - numFrontFacing > 0 )
@@ -1268,18 +1275,47 @@ void DynamicShadowVolumeJob( const dynamicShadowVolumeParms_t* parms )
 				// Check if we can avoid rendering the shadow volume caps.
 				bool renderShadowCaps = parms->forceShadowCaps || renderZFail;
 
-				// Create new triangles along the silhouette planes and optionally add end-cap triangles on the model and on the distant projection.
-				R_CreateShadowVolumeTriangles( parms->shadowIndices, parms->indexBuffer, numShadowIndices, parms->tempFacing,
-											   parms->silEdges, parms->numSilEdges, parms->indexes, parms->numIndexes, renderShadowCaps );
+				if( parms->cachedShadowIndices != NULL )
+				{
+					// Create the complete shadow volume in main memory, later frames only decide whether or not the caps are rendered.
+					R_CreateShadowVolumeTriangles( parms->cachedShadowIndices, parms->indexBuffer, numCachedShadowIndices, numCachedShadowIndicesNoCaps, parms->tempFacing,
+												   parms->silEdges, parms->numSilEdges, parms->indexes, parms->numIndexes, true );
+
+					numShadowIndices = renderShadowCaps ? numCachedShadowIndices : numCachedShadowIndicesNoCaps;
+					memcpy( parms->shadowIndices, parms->cachedShadowIndices, numShadowIndices * sizeof( triIndex_t ) );
+				}
+				else
+				{
+					// Create new triangles along the silhouette planes and optionally add end-cap triangles on the model and on the distant projection.
+					int numShadowIndicesNoCaps = 0;
+					R_CreateShadowVolumeTriangles( parms->shadowIndices, parms->indexBuffer, numShadowIndices, numShadowIndicesNoCaps, parms->tempFacing,
+												   parms->silEdges, parms->numSilEdges, parms->indexes, parms->numIndexes, renderShadowCaps );
+				}
 
 				assert( numShadowIndices <= parms->maxShadowIndices );
 			}
+
+			if( parms->numCachedShadowIndices != NULL )
+			{
+				*parms->numCachedShadowIndicesNoCaps = numCachedShadowIndicesNoCaps;
+				*parms->numCachedShadowIndices = numCachedShadowIndices;
+			}
 		}
 
 		// Create new indices with only the triangles that are inside the light volume.
 		if( parms->lightIndices != NULL )
 		{
-			R_CreateLightTriangles( parms->lightIndices, parms->indexBuffer, numLightIndices, parms->tempCulled, parms->indexes, parms->numIndexes );
+			if( parms->cachedLightIndices != NULL )
+			{
+				R_CreateLightTriangles( parms->cachedLightIndices, parms->indexBuffer, numLightIndices, parms->tempCulled, parms->indexes, parms->numIndexes );
+				memcpy( parms->lightIndices, parms->cachedLightIndices, numLightIndices * sizeof( triIndex_t ) );
+
+				*parms->numCachedLightIndices = numLightIndices;
+			}
+			else
+			{
+				R_CreateLightTriangles( parms->lightIndices, parms->indexBuffer, numLightIndices, parms->tempCulled, parms->indexes, parms->numIndexes );
+			}
 
 			assert( numLightIndices <= parms->maxLightIndices );
 		}
@@ -46,6 +46,9 @@ particularly important for spot lights that would otherwise cast shadows in all
 However, there can also be significant savings when a small point light touches a large
 model like for instance a world model.
 
+The job can optionally keep a copy of the indices in main memory, which is used by the
+interaction cache to skip this job in later frames for entities and lights that do not change.
+
 ================================================================================================
 */
 
@@ -106,6 +109,12 @@ struct dynamicShadowVolumeParms_t
 	float* 							shadowZMin;				// streamed out to main memory
 	float* 							shadowZMax;				// streamed out to main memory
 	volatile shadowVolumeState_t* 	shadowVolumeState;		// streamed out to main memory
+	// optional copies kept in main memory for later frames, the shadow volume always includes the caps
+	triIndex_t* 					cachedShadowIndices;	// streamed out to main memory
+	int* 							numCachedShadowIndices;	// streamed out to main memory
+	int* 							numCachedShadowIndicesNoCaps;	// streamed out to main memory
+	triIndex_t* 					cachedLightIndices;		// streamed out to main memory
+	int* 							numCachedLightIndices;	// streamed out to main memory
 	// next in chain on view entity
 	dynamicShadowVolumeParms_t* 	next;
 	int								pad;
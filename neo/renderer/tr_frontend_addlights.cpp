@@ -490,6 +490,12 @@ static void R_AddSingleLight( viewLight_t* vLight )
 				continue;
 			}
 
+			// the shadow can only fall on surfaces that are hidden behind the world
+			if( R_CullShadowBoundsByOcclusion( viewDef, shadowBounds ) )
+			{
+				continue;
+			}
+
 			// debug tool to allow viewing of only one entity at a time
 			if( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != edef->index )
 			{
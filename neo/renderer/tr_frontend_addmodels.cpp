@@ -478,6 +478,11 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 				{
 					continue;
 				}
+
+				if( R_CullShadowBoundsByOcclusion( viewDef, shadowBounds ) )
+				{
+					continue;
+				}
 			}
 			contactedLights[numContactedLights] = vLight;
 			staticInteractions[numContactedLights] = world->interactionTable[vLight->lightDef->index * world->interactionTableWidth + entityIndex];
@@ -572,6 +577,12 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 	idVec3 localViewOrigin;
 	R_GlobalPointToLocal( vEntity->modelMatrix, viewDef->renderView.vieworg, localViewOrigin );
 
+	// the light triangles and shadow volumes of dynamic interactions can be kept across frames
+	// as long as the entity isn't updated, which is not the case for callbacks and continuously
+	// changing models like particles
+	const bool useInteractionCache = r_useInteractionCache.GetBool() && renderEntity->callback == NULL &&
+									 !( renderEntity->hModel->IsDynamicModel() == DM_CONTINUOUS && renderEntity->hModel->NumJoints() == 0 );
+
 	//---------------------------
 	// add all the model surfaces
 	//---------------------------
@@ -795,6 +806,20 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 			idVec3 localLightOrigin;
 			R_GlobalPointToLocal( vEntity->modelMatrix, lightDef->globalLightOrigin, localLightOrigin );
 
+			// find the indices of this dynamic interaction that were kept from an earlier frame
+			interactionCacheSurface_t* cacheSurf = NULL;
+			if( surfInter == NULL && useInteractionCache )
+			{
+				idRenderMatrix localLightProject;
+				idRenderMatrix::Multiply( lightDef->baseLightProject, entityDef->modelRenderMatrix, localLightProject );
+
+				if( entityDef->interactionCache == NULL )
+				{
+					entityDef->interactionCache = new( TAG_RENDER_INTERACTION ) idInteractionCache;
+				}
+				cacheSurf = entityDef->interactionCache->FindSurface( lightDef->index, surfaceNum, tri, localLightOrigin, localLightProject, r_cullDynamicShadowTriangles.GetBool() );
+			}
+
 			//--------------------------
 			// surface light interactions
 			//--------------------------
@@ -823,7 +848,20 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 						lightDrawSurf->indexCache = tri->indexCache;
 
 						// optionally cull the triangles to the light volume
-						if( r_cullDynamicLightTriangles.GetBool() )
+						if( r_cullDynamicLightTriangles.GetBool() && cacheSurf != NULL && cacheSurf->numLightIndices >= 0 )
+						{
+							// the culled triangles of an earlier frame only need to be copied to the vertex cache,
+							// the whole source surface is drawn if the index cache allocation failed
+							vertCacheHandle_t lightIndexCache = vertexCache.AllocIndex( cacheSurf->lightIndices, ALIGN( Max( cacheSurf->numLightIndices, 1 ) * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
+							if( vertexCache.CacheIsCurrent( lightIndexCache ) )
+							{
+								lightDrawSurf->numIndexes = cacheSurf->numLightIndices;
+								lightDrawSurf->indexCache = lightIndexCache;
+							}
+
+							tr.pc.c_interactionCacheHits++;
+						}
+						else if( r_cullDynamicLightTriangles.GetBool() )
 						{
 
 							vertCacheHandle_t lightIndexCache = vertexCache.AllocIndex( NULL, ALIGN( lightDrawSurf->numIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
@@ -867,6 +905,20 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 								dynamicShadowParms->shadowZMin = NULL;
 								dynamicShadowParms->shadowZMax = NULL;
 								dynamicShadowParms->shadowVolumeState = & lightDrawSurf->shadowVolumeState;
+								dynamicShadowParms->cachedShadowIndices = NULL;
+								dynamicShadowParms->numCachedShadowIndices = NULL;
+								dynamicShadowParms->numCachedShadowIndicesNoCaps = NULL;
+								dynamicShadowParms->cachedLightIndices = NULL;
+								dynamicShadowParms->numCachedLightIndices = NULL;
+
+								// keep a copy of the culled triangles for later frames
+								if( cacheSurf != NULL && entityDef->interactionCache->AllocLightIndices( cacheSurf ) )
+								{
+									dynamicShadowParms->cachedLightIndices = cacheSurf->lightIndices;
+									dynamicShadowParms->numCachedLightIndices = &cacheSurf->numLightIndices;
+
+									tr.pc.c_interactionCacheMisses++;
+								}
 
 								lightDrawSurf->shadowVolumeState = SHADOWVOLUME_UNFINISHED;
 
@@ -1097,72 +1149,136 @@ void R_AddSingleModel( viewEntity_t* vEntity )
 
 				const int maxShadowVolumeIndexes = tri->numSilEdges * 6 + tri->numIndexes * 2;
 
-				shadowDrawSurf->numIndexes = 0;
-				shadowDrawSurf->indexCache = vertexCache.AllocIndex( NULL, ALIGN( maxShadowVolumeIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
-				shadowDrawSurf->shadowCache = tri->shadowCache;
-				shadowDrawSurf->scissorRect = vLight->scissorRect;		// default to the light scissor and light depth bounds
-				shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_DONE;	// assume the shadow volume is done in case the index cache allocation failed
-
-				// if the index cache was successfully allocated then setup the parms to create a shadow volume in parallel
-				if( vertexCache.CacheIsCurrent( shadowDrawSurf->indexCache ) && !r_skipDynamicShadows.GetBool() )
+				if( cacheSurf != NULL && cacheSurf->numShadowIndices >= 0 && !r_skipDynamicShadows.GetBool() )
 				{
-
-					// if the parms were not already allocated for culling interaction triangles to the light frustum
-					if( dynamicShadowParms == NULL )
+					// The shadow volume of an earlier frame only needs to be copied to the vertex cache.
+					// Whether or not the caps are rendered is determined like for a static interaction,
+					// without the precise inside test because there are no static shadow verts.
+					shadowDrawSurf->numIndexes = 0;
+					shadowDrawSurf->indexCache = vertexCache.AllocIndex( cacheSurf->shadowIndices, ALIGN( Max( cacheSurf->numShadowIndices, 1 ) * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
+					shadowDrawSurf->shadowCache = tri->shadowCache;
+					shadowDrawSurf->scissorRect = vLight->scissorRect;		// default to the light scissor and light depth bounds
+					shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_DONE;	// assume the shadow volume is done in case the index cache allocation failed
+
+					// if the index cache was successfully allocated then setup the parms to finish the cached shadow volume in parallel
+					if( vertexCache.CacheIsCurrent( shadowDrawSurf->indexCache ) )
 					{
-						dynamicShadowParms = ( dynamicShadowVolumeParms_t* )R_FrameAlloc( sizeof( dynamicShadowParms[0] ), FRAME_ALLOC_SHADOW_VOLUME_PARMS );
+						staticShadowVolumeParms_t* staticShadowParms = ( staticShadowVolumeParms_t* )R_FrameAlloc( sizeof( staticShadowParms[0] ), FRAME_ALLOC_SHADOW_VOLUME_PARMS );
+
+						staticShadowParms->verts = NULL;
+						staticShadowParms->numVerts = 0;
+						staticShadowParms->indexes = NULL;
+						staticShadowParms->numIndexes = 0;
+						staticShadowParms->numShadowIndicesWithCaps = cacheSurf->numShadowIndices;
+						staticShadowParms->numShadowIndicesNoCaps = cacheSurf->numShadowIndicesNoCaps;
+						staticShadowParms->triangleBounds = tri->bounds;
+						staticShadowParms->triangleMVP = vEntity->mvp;
+						staticShadowParms->localLightOrigin = localLightOrigin;
+						staticShadowParms->localViewOrigin = localViewOrigin;
+						staticShadowParms->zNear = znear;
+						staticShadowParms->lightZMin = vLight->scissorRect.zmin;
+						staticShadowParms->lightZMax = vLight->scissorRect.zmax;
+						staticShadowParms->forceShadowCaps = forceShadowCaps;
+						staticShadowParms->useShadowPreciseInsideTest = false;
+						staticShadowParms->useShadowDepthBounds = r_useShadowDepthBounds.GetBool();
+						staticShadowParms->numShadowIndices = & shadowDrawSurf->numIndexes;
+						staticShadowParms->renderZFail = & shadowDrawSurf->renderZFail;
+						staticShadowParms->shadowZMin = & shadowDrawSurf->scissorRect.zmin;
+						staticShadowParms->shadowZMax = & shadowDrawSurf->scissorRect.zmax;
+						staticShadowParms->shadowVolumeState = & shadowDrawSurf->shadowVolumeState;
+
+						shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_UNFINISHED;
+
+						staticShadowParms->next = vEntity->staticShadowVolumes;
+						vEntity->staticShadowVolumes = staticShadowParms;
 					}
-					else
+
+					tr.pc.c_interactionCacheHits++;
+				}
+				else
+				{
+					shadowDrawSurf->numIndexes = 0;
+					shadowDrawSurf->indexCache = vertexCache.AllocIndex( NULL, ALIGN( maxShadowVolumeIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
+					shadowDrawSurf->shadowCache = tri->shadowCache;
+					shadowDrawSurf->scissorRect = vLight->scissorRect;		// default to the light scissor and light depth bounds
+					shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_DONE;	// assume the shadow volume is done in case the index cache allocation failed
+
+					// if the index cache was successfully allocated then setup the parms to create a shadow volume in parallel
+					if( vertexCache.CacheIsCurrent( shadowDrawSurf->indexCache ) && !r_skipDynamicShadows.GetBool() )
 					{
-						// the shadow volume will be rendered first so when the interaction surface is drawn the triangles have been culled for sure
-						*dynamicShadowParms->shadowVolumeState = SHADOWVOLUME_DONE;
-					}
 
-					dynamicShadowParms->verts = tri->verts;
-					dynamicShadowParms->numVerts = tri->numVerts;
-					dynamicShadowParms->indexes = tri->indexes;
-					dynamicShadowParms->numIndexes = tri->numIndexes;
-					dynamicShadowParms->silEdges = tri->silEdges;
-					dynamicShadowParms->numSilEdges = tri->numSilEdges;
-					dynamicShadowParms->joints = gpuSkinned ? tri->staticModelWithJoints->jointsInverted : NULL;
-					dynamicShadowParms->numJoints = gpuSkinned ? tri->staticModelWithJoints->numInvertedJoints : 0;
-					dynamicShadowParms->triangleBounds = tri->bounds;
-					dynamicShadowParms->triangleMVP = vEntity->mvp;
-					dynamicShadowParms->localLightOrigin = localLightOrigin;
-					dynamicShadowParms->localViewOrigin = localViewOrigin;
-					idRenderMatrix::Multiply( vLight->lightDef->baseLightProject, entityDef->modelRenderMatrix, dynamicShadowParms->localLightProject );
-					dynamicShadowParms->zNear = znear;
-					dynamicShadowParms->lightZMin = vLight->scissorRect.zmin;
-					dynamicShadowParms->lightZMax = vLight->scissorRect.zmax;
-					dynamicShadowParms->cullShadowTrianglesToLight = r_cullDynamicShadowTriangles.GetBool();
-					dynamicShadowParms->forceShadowCaps = forceShadowCaps;
-					dynamicShadowParms->useShadowPreciseInsideTest = r_useShadowPreciseInsideTest.GetBool();
-					dynamicShadowParms->useShadowDepthBounds = r_useShadowDepthBounds.GetBool();
-					dynamicShadowParms->tempFacing = NULL;
-					dynamicShadowParms->tempCulled = NULL;
-					dynamicShadowParms->tempVerts = NULL;
-					dynamicShadowParms->indexBuffer = NULL;
-					dynamicShadowParms->shadowIndices = ( triIndex_t* )vertexCache.MappedIndexBuffer( shadowDrawSurf->indexCache );
-					dynamicShadowParms->maxShadowIndices = maxShadowVolumeIndexes;
-					dynamicShadowParms->numShadowIndices = & shadowDrawSurf->numIndexes;
-					// dynamicShadowParms->lightIndices may have already been set for the interaction surface
-					// dynamicShadowParms->maxLightIndices may have already been set for the interaction surface
-					// dynamicShadowParms->numLightIndices may have already been set for the interaction surface
-					dynamicShadowParms->renderZFail = & shadowDrawSurf->renderZFail;
-					dynamicShadowParms->shadowZMin = & shadowDrawSurf->scissorRect.zmin;
-					dynamicShadowParms->shadowZMax = & shadowDrawSurf->scissorRect.zmax;
-					dynamicShadowParms->shadowVolumeState = & shadowDrawSurf->shadowVolumeState;
+						// if the parms were not already allocated for culling interaction triangles to the light frustum
+						if( dynamicShadowParms == NULL )
+						{
+							dynamicShadowParms = ( dynamicShadowVolumeParms_t* )R_FrameAlloc( sizeof( dynamicShadowParms[0] ), FRAME_ALLOC_SHADOW_VOLUME_PARMS );
+						}
+						else
+						{
+							// the shadow volume will be rendered first so when the interaction surface is drawn the triangles have been culled for sure
+							*dynamicShadowParms->shadowVolumeState = SHADOWVOLUME_DONE;
+						}
+
+						dynamicShadowParms->verts = tri->verts;
+						dynamicShadowParms->numVerts = tri->numVerts;
+						dynamicShadowParms->indexes = tri->indexes;
+						dynamicShadowParms->numIndexes = tri->numIndexes;
+						dynamicShadowParms->silEdges = tri->silEdges;
+						dynamicShadowParms->numSilEdges = tri->numSilEdges;
+						dynamicShadowParms->joints = gpuSkinned ? tri->staticModelWithJoints->jointsInverted : NULL;
+						dynamicShadowParms->numJoints = gpuSkinned ? tri->staticModelWithJoints->numInvertedJoints : 0;
+						dynamicShadowParms->triangleBounds = tri->bounds;
+						dynamicShadowParms->triangleMVP = vEntity->mvp;
+						dynamicShadowParms->localLightOrigin = localLightOrigin;
+						dynamicShadowParms->localViewOrigin = localViewOrigin;
+						idRenderMatrix::Multiply( vLight->lightDef->baseLightProject, entityDef->modelRenderMatrix, dynamicShadowParms->localLightProject );
+						dynamicShadowParms->zNear = znear;
+						dynamicShadowParms->lightZMin = vLight->scissorRect.zmin;
+						dynamicShadowParms->lightZMax = vLight->scissorRect.zmax;
+						dynamicShadowParms->cullShadowTrianglesToLight = r_cullDynamicShadowTriangles.GetBool();
+						dynamicShadowParms->forceShadowCaps = forceShadowCaps;
+						dynamicShadowParms->useShadowPreciseInsideTest = r_useShadowPreciseInsideTest.GetBool();
+						dynamicShadowParms->useShadowDepthBounds = r_useShadowDepthBounds.GetBool();
+						dynamicShadowParms->tempFacing = NULL;
+						dynamicShadowParms->tempCulled = NULL;
+						dynamicShadowParms->tempVerts = NULL;
+						dynamicShadowParms->indexBuffer = NULL;
+						dynamicShadowParms->shadowIndices = ( triIndex_t* )vertexCache.MappedIndexBuffer( shadowDrawSurf->indexCache );
+						dynamicShadowParms->maxShadowIndices = maxShadowVolumeIndexes;
+						dynamicShadowParms->numShadowIndices = & shadowDrawSurf->numIndexes;
+						// dynamicShadowParms->lightIndices may have already been set for the interaction surface
+						// dynamicShadowParms->maxLightIndices may have already been set for the interaction surface
+						// dynamicShadowParms->numLightIndices may have already been set for the interaction surface
+						dynamicShadowParms->renderZFail = & shadowDrawSurf->renderZFail;
+						dynamicShadowParms->shadowZMin = & shadowDrawSurf->scissorRect.zmin;
+						dynamicShadowParms->shadowZMax = & shadowDrawSurf->scissorRect.zmax;
+						dynamicShadowParms->shadowVolumeState = & shadowDrawSurf->shadowVolumeState;
+						dynamicShadowParms->cachedShadowIndices = NULL;
+						dynamicShadowParms->numCachedShadowIndices = NULL;
+						dynamicShadowParms->numCachedShadowIndicesNoCaps = NULL;
+						// dynamicShadowParms->cachedLightIndices may have already been set for the interaction surface
+						// dynamicShadowParms->numCachedLightIndices may have already been set for the interaction surface
+
+						// keep a copy of the shadow volume with caps for later frames
+						if( cacheSurf != NULL && entityDef->interactionCache->AllocShadowIndices( cacheSurf, maxShadowVolumeIndexes ) )
+						{
+							dynamicShadowParms->cachedShadowIndices = cacheSurf->shadowIndices;
+							dynamicShadowParms->numCachedShadowIndices = &cacheSurf->numShadowIndices;
+							dynamicShadowParms->numCachedShadowIndicesNoCaps = &cacheSurf->numShadowIndicesNoCaps;
 
-					shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_UNFINISHED;
+							tr.pc.c_interactionCacheMisses++;
+						}
 
-					// if the parms we not already linked for culling interaction triangles to the light frustum
-					if( dynamicShadowParms->lightIndices == NULL )
-					{
-						dynamicShadowParms->next = vEntity->dynamicShadowVolumes;
-						vEntity->dynamicShadowVolumes = dynamicShadowParms;
-					}
+						shadowDrawSurf->shadowVolumeState = SHADOWVOLUME_UNFINISHED;
 
-					tr.pc.c_createShadowVolumes++;
+						// if the parms we not already linked for culling interaction triangles to the light frustum
+						if( dynamicShadowParms->lightIndices == NULL )
+						{
+							dynamicShadowParms->next = vEntity->dynamicShadowVolumes;
+							vEntity->dynamicShadowVolumes = dynamicShadowParms;
+						}
+
+						tr.pc.c_createShadowVolumes++;
+					}
 				}
 			}
 
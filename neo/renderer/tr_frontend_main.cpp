@@ -247,41 +247,194 @@ FONT-END RENDERING
 ==========================================================================================
 */
 
+idCVar r_parallelSortDrawSurfs( "r_parallelSortDrawSurfs", "4096", CVAR_RENDERER | CVAR_INTEGER, "build the draw surface sort keys with jobs for views with at least this many surfaces, 0 = never" );
+
 /*
 =================
-R_SortDrawSurfs
+R_DrawSurfSortKey
+
+sort the draw surfs based on:
+1. sort value (largest first)
+2. depth (smallest first)
+3. index (largest first)
 =================
 */
-static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
+static ID_INLINE uint64 R_DrawSurfSortKey( const drawSurf_t* drawSurf, const int index, const int numDrawSurfs )
 {
-#if 1
+	// koz sort values for 3d guis were flagged by adding 1000 to the sort value, so cancel out to sort correctly.
+	float guiSort = drawSurf->sort >= 1000 ? ( 1.0f - ( drawSurf->sort - 1000 ) ) : drawSurf->sort;
 
-	uint64* indices = ( uint64* ) _alloca16( numDrawSurfs * sizeof( indices[0] ) );
+	float sort = SS_POST_PROCESS - guiSort; // koz drawSurfs[i]->sort;
 
-	// sort the draw surfs based on:
-	// 1. sort value (largest first)
-	// 2. depth (smallest first)
-	// 3. index (largest first)
-	assert( numDrawSurfs <= 0xFFFF );
-	for( int i = 0; i < numDrawSurfs; i++ )
+	assert( sort >= 0.0f );
+
+	uint64 dist = 0;
+	if( drawSurf->frontEndGeo != NULL )
 	{
-		// koz sort values for 3d guis were flagged by adding 1000 to the sort value, so cancel out to sort correctly.
-		float guiSort = drawSurfs[i]->sort >= 1000 ? ( 1.0f - ( drawSurfs[i]->sort - 1000 ) ) : drawSurfs[i]->sort;
+		float min = 0.0f;
+		float max = 1.0f;
+		idRenderMatrix::DepthBoundsForBounds( min, max, drawSurf->space->mvp, drawSurf->frontEndGeo->bounds );
+		dist = idMath::Ftoui16( min * 0xFFFF );
+	}
+
+	return ( ( numDrawSurfs - index ) & 0xFFFF ) | ( dist << 16 ) | ( ( uint64 )( *( uint32* )&sort ) << 32 );
+}
+
+static const int SORT_KEY_RADIX_BITS	= 8;
+static const int SORT_KEY_RADIX			= 1 << SORT_KEY_RADIX_BITS;
+static const int SORT_KEY_PASSES		= 64 / SORT_KEY_RADIX_BITS;
+static const int MAX_SORT_KEY_JOBS		= 16;
+static const int MIN_SORT_KEYS_PER_JOB	= 1024;
+
+struct sortKeysParms_t
+{
+	// input
+	const drawSurf_t* const* 	drawSurfs;
+	int							numDrawSurfs;
+	int							first;
+	int							last;
+	// output
+	uint64* 					keys;
+	unsigned int				histograms[SORT_KEY_PASSES][SORT_KEY_RADIX];
+};
+
+/*
+=================
+R_DrawSurfSortKeysJob
+
+Builds the sort keys for a range of draw surfs and the radix histograms of all
+passes for them. The histograms don't depend on the order of the keys so they
+can all be counted in this one pass and simply be added up over the jobs.
+=================
+*/
+static void R_DrawSurfSortKeysJob( sortKeysParms_t* parms )
+{
+	memset( parms->histograms, 0, sizeof( parms->histograms ) );
+
+	for( int i = parms->first; i < parms->last; i++ )
+	{
+		const uint64 key = R_DrawSurfSortKey( parms->drawSurfs[i], i, parms->numDrawSurfs );
+		parms->keys[i] = key;
+		for( int pass = 0; pass < SORT_KEY_PASSES; pass++ )
+		{
+			parms->histograms[pass][( key >> ( pass * SORT_KEY_RADIX_BITS ) ) & ( SORT_KEY_RADIX - 1 )]++;
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_DrawSurfSortKeysJob, "R_DrawSurfSortKeysJob" );
+
+/*
+=================
+R_RadixSortDrawSurfKeys
+
+LSD radix sort of the keys from largest to smallest. Passes for which all keys have
+the same digit are skipped, which is common for the upper bits of the sort value.
+Returns the buffer that holds the sorted keys which is either keys or temp.
+=================
+*/
+static uint64* R_RadixSortDrawSurfKeys( uint64* keys, uint64* temp, const int numKeys, unsigned int histograms[SORT_KEY_PASSES][SORT_KEY_RADIX] )
+{
+	for( int pass = 0; pass < SORT_KEY_PASSES; pass++ )
+	{
+		const int shift = pass * SORT_KEY_RADIX_BITS;
+		unsigned int* offsets = histograms[pass];
+
+		if( offsets[( keys[0] >> shift ) & ( SORT_KEY_RADIX - 1 )] == ( unsigned int )numKeys )
+		{
+			continue;
+		}
+
+		// largest digit first
+		unsigned int offset = 0;
+		for( int digit = SORT_KEY_RADIX - 1; digit >= 0; digit-- )
+		{
+			const unsigned int count = offsets[digit];
+			offsets[digit] = offset;
+			offset += count;
+		}
+
+		for( int i = 0; i < numKeys; i++ )
+		{
+			const uint64 key = keys[i];
+			temp[offsets[( key >> shift ) & ( SORT_KEY_RADIX - 1 )]++] = key;
+		}
+
+		SwapValues( keys, temp );
+	}
+	return keys;
+}
 
-		float sort = SS_POST_PROCESS - guiSort; // koz drawSurfs[i]->sort;
+/*
+=================
+R_RadixSortDrawSurfs
 
-		assert( sort >= 0.0f );
+keys and temp must have room for numDrawSurfs keys and parms for numJobs jobs.
+=================
+*/
+static void R_RadixSortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs, uint64* keys, uint64* temp, sortKeysParms_t* parms, const int numJobs )
+{
+	assert( numDrawSurfs <= 0xFFFF );
+	assert( numJobs >= 1 && numJobs <= MAX_SORT_KEY_JOBS );
 
-		uint64 dist = 0;
-		if( drawSurfs[i]->frontEndGeo != NULL )
+	for( int i = 0; i < numJobs; i++ )
+	{
+		parms[i].drawSurfs = drawSurfs;
+		parms[i].numDrawSurfs = numDrawSurfs;
+		parms[i].first = ( numDrawSurfs * i ) / numJobs;
+		parms[i].last = ( numDrawSurfs * ( i + 1 ) ) / numJobs;
+		parms[i].keys = keys;
+	}
+
+	if( numJobs > 1 )
+	{
+		// the front end job list is idle at this point
+		for( int i = 0; i < numJobs; i++ )
 		{
-			float min = 0.0f;
-			float max = 1.0f;
-			idRenderMatrix::DepthBoundsForBounds( min, max, drawSurfs[i]->space->mvp, drawSurfs[i]->frontEndGeo->bounds );
-			dist = idMath::Ftoui16( min * 0xFFFF );
+			tr.frontEndJobList->AddJob( ( jobRun_t )R_DrawSurfSortKeysJob, &parms[i] );
 		}
+		tr.frontEndJobList->Submit();
+		tr.frontEndJobList->Wait();
 
-		indices[i] = ( ( numDrawSurfs - i ) & 0xFFFF ) | ( dist << 16 ) | ( ( uint64 )( *( uint32* )&sort ) << 32 );
+		for( int i = 1; i < numJobs; i++ )
+		{
+			for( int pass = 0; pass < SORT_KEY_PASSES; pass++ )
+			{
+				for( int digit = 0; digit < SORT_KEY_RADIX; digit++ )
+				{
+					parms[0].histograms[pass][digit] += parms[i].histograms[pass][digit];
+				}
+			}
+		}
+	}
+	else
+	{
+		R_DrawSurfSortKeysJob( &parms[0] );
+	}
+
+	const uint64* sorted = R_RadixSortDrawSurfKeys( keys, temp, numDrawSurfs, parms[0].histograms );
+
+	drawSurf_t** newDrawSurfs = ( drawSurf_t** )( ( sorted == keys ) ? temp : keys );
+	for( int i = 0; i < numDrawSurfs; i++ )
+	{
+		newDrawSurfs[i] = drawSurfs[numDrawSurfs - ( sorted[i] & 0xFFFF )];
+	}
+	memcpy( drawSurfs, newDrawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
+}
+
+/*
+=================
+R_QuickSortDrawSurfs
+
+The previous sort, only kept as a reference for testSortDrawSurfs.
+=================
+*/
+static void R_QuickSortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs, uint64* indices )
+{
+	assert( numDrawSurfs <= 0xFFFF );
+	for( int i = 0; i < numDrawSurfs; i++ )
+	{
+		indices[i] = R_DrawSurfSortKey( drawSurfs[i], i, numDrawSurfs );
 	}
 
 	const int64 MAX_LEVELS = 128;
@@ -361,6 +514,34 @@ static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
 		newDrawSurfs[i] = drawSurfs[numDrawSurfs - ( indices[i] & 0xFFFF )];
 	}
 	memcpy( drawSurfs, newDrawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
+}
+
+/*
+=================
+R_SortDrawSurfs
+=================
+*/
+static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
+{
+#if 1
+
+	if( numDrawSurfs <= 1 )
+	{
+		return;
+	}
+
+	// build the keys with jobs for big views like large open areas, mirrors or stereo views
+	int numJobs = 1;
+	if( r_parallelSortDrawSurfs.GetInteger() > 0 && numDrawSurfs >= r_parallelSortDrawSurfs.GetInteger() )
+	{
+		numJobs = idMath::ClampInt( 1, MAX_SORT_KEY_JOBS, numDrawSurfs / MIN_SORT_KEYS_PER_JOB );
+	}
+
+	uint64* keys = ( uint64* )R_FrameAlloc( numDrawSurfs * sizeof( keys[0] ), FRAME_ALLOC_UNKNOWN );
+	uint64* temp = ( uint64* )R_FrameAlloc( numDrawSurfs * sizeof( temp[0] ), FRAME_ALLOC_UNKNOWN );
+	sortKeysParms_t* parms = ( sortKeysParms_t* )R_FrameAlloc( numJobs * sizeof( parms[0] ), FRAME_ALLOC_UNKNOWN );
+
+	R_RadixSortDrawSurfs( drawSurfs, numDrawSurfs, keys, temp, parms, numJobs );
 
 #else
 
@@ -397,6 +578,154 @@ static void R_SortDrawSurfs( drawSurf_t** drawSurfs, const int numDrawSurfs )
 #endif
 }
 
+/*
+=================
+R_VerifySortedDrawSurfs
+
+Checks that sorted holds the same draw surfs as reference in the same order. Only the
+sort value and depth of the keys are compared, so surfs with equal keys may be swapped.
+Returns the index of the first mismatch or -1.
+=================
+*/
+static int R_VerifySortedDrawSurfs( const drawSurf_t* const* reference, const drawSurf_t* const* sorted, const int numDrawSurfs, const drawSurf_t* surfs, bool* seen )
+{
+	memset( seen, 0, numDrawSurfs * sizeof( seen[0] ) );
+	for( int i = 0; i < numDrawSurfs; i++ )
+	{
+		const ptrdiff_t surfNum = sorted[i] - surfs;
+		if( surfNum < 0 || surfNum >= numDrawSurfs || seen[surfNum] )
+		{
+			return i;
+		}
+		seen[surfNum] = true;
+
+		const uint64 referenceKey = R_DrawSurfSortKey( reference[i], 0, numDrawSurfs ) >> 16;
+		const uint64 sortedKey = R_DrawSurfSortKey( sorted[i], 0, numDrawSurfs ) >> 16;
+		if( referenceKey != sortedKey )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+=================
+testSortDrawSurfs
+
+Compares the previous quick sort against the radix sort with and without the
+parallel key pass on synthetic views of 1k, 10k and 60k draw surfaces, and checks
+that all of them produce the same order.
+=================
+*/
+CONSOLE_COMMAND( testSortDrawSurfs, "benchmarks and verifies R_SortDrawSurfs at 1k, 10k and 60k draw surfaces, usage: testSortDrawSurfs [numRuns]", NULL )
+{
+	const int numRuns = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, 1000, atoi( args.Argv( 1 ) ) ) : 20;
+	const int counts[3] = { 1000, 10000, 60000 };
+	const int maxDrawSurfs = counts[2];
+
+	viewEntity_t* space = ( viewEntity_t* )Mem_ClearedAlloc( sizeof( viewEntity_t ), TAG_TEMP );
+	space->mvp.Identity();
+
+	srfTriangles_t* geos = ( srfTriangles_t* )Mem_ClearedAlloc( maxDrawSurfs * sizeof( srfTriangles_t ), TAG_TEMP );
+	drawSurf_t* surfs = ( drawSurf_t* )Mem_ClearedAlloc( maxDrawSurfs * sizeof( drawSurf_t ), TAG_TEMP );
+	drawSurf_t** original = ( drawSurf_t** )Mem_Alloc( maxDrawSurfs * sizeof( drawSurf_t* ), TAG_TEMP );
+	drawSurf_t** drawSurfs = ( drawSurf_t** )Mem_Alloc( maxDrawSurfs * sizeof( drawSurf_t* ), TAG_TEMP );
+	drawSurf_t** reference = ( drawSurf_t** )Mem_Alloc( maxDrawSurfs * sizeof( drawSurf_t* ), TAG_TEMP );
+	bool* seen = ( bool* )Mem_Alloc( maxDrawSurfs * sizeof( bool ), TAG_TEMP );
+	uint64* keys = ( uint64* )Mem_Alloc16( maxDrawSurfs * sizeof( uint64 ), TAG_TEMP );
+	uint64* temp = ( uint64* )Mem_Alloc16( maxDrawSurfs * sizeof( uint64 ), TAG_TEMP );
+	sortKeysParms_t* parms = ( sortKeysParms_t* )Mem_Alloc( MAX_SORT_KEY_JOBS * sizeof( sortKeysParms_t ), TAG_TEMP );
+
+	// a handful of material sort values with the surfaces spread out in depth
+	idRandom random( 1234 );
+	for( int i = 0; i < maxDrawSurfs; i++ )
+	{
+		const idVec3 center( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() );
+		geos[i].bounds[0] = center - idVec3( 0.01f, 0.01f, 0.01f );
+		geos[i].bounds[1] = center + idVec3( 0.01f, 0.01f, 0.01f );
+		surfs[i].frontEndGeo = &geos[i];
+		surfs[i].space = space;
+		surfs[i].sort = ( float )random.RandomInt( SS_NEAREST + 1 );
+		original[i] = &surfs[i];
+	}
+
+	// the parallel sort uses the front end job list
+	tr.frontEndJobList->Wait();
+
+	idLib::Printf( "   surfs   quick sort   radix sort   radix + jobs (usec, %d runs)\n", numRuns );
+
+	int numFailed = 0;
+
+	for( int c = 0; c < 3; c++ )
+	{
+		const int numDrawSurfs = counts[c];
+		const int numJobs = idMath::ClampInt( 1, MAX_SORT_KEY_JOBS, numDrawSurfs / MIN_SORT_KEYS_PER_JOB );
+
+		uint64 times[3] = { 0, 0, 0 };
+		int mismatches[3] = { 0, 0, 0 };
+		for( int run = 0; run < numRuns; run++ )
+		{
+			for( int method = 0; method < 3; method++ )
+			{
+				memcpy( drawSurfs, original, numDrawSurfs * sizeof( drawSurfs[0] ) );
+
+				const uint64 start = Sys_Microseconds();
+				if( method == 0 )
+				{
+					R_QuickSortDrawSurfs( drawSurfs, numDrawSurfs, keys );
+				}
+				else
+				{
+					R_RadixSortDrawSurfs( drawSurfs, numDrawSurfs, keys, temp, parms, ( method == 1 ) ? 1 : numJobs );
+				}
+				times[method] += Sys_Microseconds() - start;
+
+				if( method == 0 )
+				{
+					memcpy( reference, drawSurfs, numDrawSurfs * sizeof( drawSurfs[0] ) );
+				}
+				else
+				{
+					const int mismatch = R_VerifySortedDrawSurfs( reference, drawSurfs, numDrawSurfs, surfs, seen );
+					if( mismatch >= 0 )
+					{
+						if( mismatches[method] == 0 )
+						{
+							idLib::Warning( "testSortDrawSurfs: %s sort of %d surfs differs from the quick sort at %d",
+											( method == 1 ) ? "radix" : "parallel radix", numDrawSurfs, mismatch );
+						}
+						mismatches[method]++;
+					}
+				}
+			}
+		}
+
+		idLib::Printf( "%8d %12.1f %12.1f %14.1f\n", numDrawSurfs, ( float )times[0] / numRuns, ( float )times[1] / numRuns, ( float )times[2] / numRuns );
+		numFailed += mismatches[1] + mismatches[2];
+	}
+
+	if( numFailed > 0 )
+	{
+		idLib::Printf( "FAILED: %d sorts didn't match the quick sort\n", numFailed );
+	}
+	else
+	{
+		idLib::Printf( "all sorts match the quick sort\n" );
+	}
+
+	Mem_Free( parms );
+	Mem_Free16( temp );
+	Mem_Free16( keys );
+	Mem_Free( seen );
+	Mem_Free( reference );
+	Mem_Free( drawSurfs );
+	Mem_Free( original );
+	Mem_Free( surfs );
+	Mem_Free( geos );
+	Mem_Free( space );
+}
+
 // RB begin
 static void R_SetupSplitFrustums( viewDef_t* viewDef )
 {
@@ -590,44 +919,57 @@ static void R_FindClosestEnvironmentProbes()
 
 /*
 ================
-R_RenderView
-
-A view may be either the actual camera view,
-a mirror / remote location, or a 3D view on a gui surface.
+R_SetupViewFrustum
 
-Parms will typically be allocated with R_FrameAlloc
+Sets up the view and projection matrices and the primary frustum planes of a view.
 ================
 */
-void R_RenderView( viewDef_t* parms )
+void R_SetupViewFrustum( viewDef_t* viewDef )
 {
-	// save view in case we are a subview
-	viewDef_t* oldView = tr.viewDef;
-
-	tr.viewDef = parms;
-
 	// setup the matrix for world space to eye space
-	R_SetupViewMatrix( tr.viewDef );
+	R_SetupViewMatrix( viewDef );
 
 	// we need to set the projection matrix before doing
 	// portal-to-screen scissor calculations
-	R_SetupProjectionMatrix( tr.viewDef );
+	R_SetupProjectionMatrix( viewDef );
 
 	// setup render matrices for faster culling
-	idRenderMatrix::Transpose( *( idRenderMatrix* )tr.viewDef->projectionMatrix, tr.viewDef->projectionRenderMatrix );
+	idRenderMatrix::Transpose( *( idRenderMatrix* )viewDef->projectionMatrix, viewDef->projectionRenderMatrix );
 	idRenderMatrix viewRenderMatrix;
-	idRenderMatrix::Transpose( *( idRenderMatrix* )tr.viewDef->worldSpace.modelViewMatrix, viewRenderMatrix );
-	idRenderMatrix::Multiply( tr.viewDef->projectionRenderMatrix, viewRenderMatrix, tr.viewDef->worldSpace.mvp );
+	idRenderMatrix::Transpose( *( idRenderMatrix* )viewDef->worldSpace.modelViewMatrix, viewRenderMatrix );
+	idRenderMatrix::Multiply( viewDef->projectionRenderMatrix, viewRenderMatrix, viewDef->worldSpace.mvp );
 
 	// the planes of the view frustum are needed for portal visibility culling
-	idRenderMatrix::GetFrustumPlanes( tr.viewDef->frustums[FRUSTUM_PRIMARY], tr.viewDef->worldSpace.mvp, false, true );
+	idRenderMatrix::GetFrustumPlanes( viewDef->frustums[FRUSTUM_PRIMARY], viewDef->worldSpace.mvp, false, true );
 
 	// the DOOM 3 frustum planes point outside the frustum
 	for( int i = 0; i < 6; i++ )
 	{
-		tr.viewDef->frustums[FRUSTUM_PRIMARY][i] = - tr.viewDef->frustums[FRUSTUM_PRIMARY][i];
+		viewDef->frustums[FRUSTUM_PRIMARY][i] = - viewDef->frustums[FRUSTUM_PRIMARY][i];
 	}
 	// remove the Z-near to avoid portals from being near clipped
-	tr.viewDef->frustums[FRUSTUM_PRIMARY][4][3] -= r_znear.GetFloat();
+	viewDef->frustums[FRUSTUM_PRIMARY][4][3] -= r_znear.GetFloat();
+}
+
+/*
+================
+R_RenderView
+
+A view may be either the actual camera view,
+a mirror / remote location, or a 3D view on a gui surface.
+
+Parms will typically be allocated with R_FrameAlloc
+================
+*/
+void R_RenderView( viewDef_t* parms )
+{
+	// save view in case we are a subview
+	viewDef_t* oldView = tr.viewDef;
+
+	tr.viewDef = parms;
+
+	// setup the view matrices and the primary view frustum
+	R_SetupViewFrustum( tr.viewDef );
 
 	// RB begin
 	R_SetupSplitFrustums( tr.viewDef );
@@ -637,9 +979,15 @@ void R_RenderView( viewDef_t* parms )
 	// for all the the entityDefs and lightDefs that are in the visible portal areas
 	static_cast<idRenderWorldLocal*>( parms->renderWorld )->FindViewLightsAndEntities();
 
+	// remove the entities and lights that are completely hidden behind large world surfaces
+	R_SoftwareOcclusionCull();
+
 	// wait for any shadow volume jobs from the previous frame to finish
 	tr.frontEndJobList->Wait();
 
+	// free the cached dynamic interactions that haven't been used for a while
+	static_cast<idRenderWorldLocal*>( parms->renderWorld )->PurgeInteractionCaches();
+
 	// make sure that interactions exist for all light / entity combinations that are visible
 	// add any pre-generated light shadows, and calculate the light shader values
 	R_AddLights();
@@ -647,6 +995,9 @@ void R_RenderView( viewDef_t* parms )
 	// adds ambient surfaces and create any necessary interaction surfaces to add to the light lists
 	R_AddModels();
 
+	// count the shadows the parallel add model jobs culled by occlusion
+	R_FinishSoftwareOcclusionCull();
+
 	// build up the GUIs on world surfaces
 	R_AddInGameGuis( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs );
 
@@ -0,0 +1,679 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "precompiled.h"
+#pragma hdrstop
+
+#include "RenderCommon.h"
+
+// shadows culled by R_CullShadowBoundsByOcclusion, which runs on the add model jobs
+static idSysInterlockedInteger numOcclusionCulledShadows;
+
+/*
+==========================================================================================
+
+WORLD OCCLUDERS
+
+==========================================================================================
+*/
+
+/*
+=====================
+R_SurfaceIsOccluder
+
+Only surfaces that are guaranteed to hide everything behind them in every frame can be used.
+=====================
+*/
+static bool R_SurfaceIsOccluder( const modelSurface_t* surf )
+{
+	const idMaterial* shader = surf->shader;
+	const srfTriangles_t* tri = surf->geometry;
+
+	if( shader == NULL || tri == NULL || tri->verts == NULL || tri->indexes == NULL )
+	{
+		return false;
+	}
+	if( !shader->IsDrawn() || shader->Coverage() != MC_OPAQUE || shader->Deform() != DFRM_NONE )
+	{
+		return false;
+	}
+	if( shader->HasSubview() || shader->TestMaterialFlag( MF_POLYGONOFFSET ) || shader->TestMaterialFlag( MF_NOOCCLUDER ) )
+	{
+		return false;
+	}
+	return true;
+}
+
+/*
+=====================
+R_AddOccluderTriangle
+=====================
+*/
+static void R_AddOccluderTriangle( areaOccluders_t& occluders, const idVec3& v0, const idVec3& v1, const idVec3& v2 )
+{
+	const int base = occluders.verts.Num();
+	occluders.verts.Append( v0 );
+	occluders.verts.Append( v1 );
+	occluders.verts.Append( v2 );
+	occluders.indexes.Append( base + 0 );
+	occluders.indexes.Append( base + 1 );
+	occluders.indexes.Append( base + 2 );
+	occluders.facePlanes.Append( idPlane( v0, v1, v2 ) );
+}
+
+/*
+=====================
+idRenderWorldLocal::BuildAreaOccluders
+
+Collects the large opaque triangles of every area model. The static world
+geometry never changes after the map is loaded, so this is only done once.
+=====================
+*/
+void idRenderWorldLocal::BuildAreaOccluders()
+{
+	FreeAreaOccluders();
+
+	const int startTime = Sys_Milliseconds();
+	const float minArea = r_occluderMinArea.GetFloat();
+	int numTris = 0;
+
+	areaOccluders.SetNum( numPortalAreas );
+
+	for( int i = 0; i < numPortalAreas; i++ )
+	{
+		const idRenderModel* model = renderModelManager->CheckModel( va( "_area%i", i ) );
+		if( model == NULL )
+		{
+			continue;
+		}
+
+		areaOccluders_t& occluders = areaOccluders[i];
+
+		for( int j = 0; j < model->NumSurfaces(); j++ )
+		{
+			const modelSurface_t* surf = model->Surface( j );
+			if( !R_SurfaceIsOccluder( surf ) )
+			{
+				continue;
+			}
+
+			const srfTriangles_t* tri = surf->geometry;
+			const bool twoSided = ( surf->shader->GetCullType() == CT_TWO_SIDED );
+
+			for( int k = 0; k + 2 < tri->numIndexes; k += 3 )
+			{
+				const idVec3& v0 = tri->verts[tri->indexes[k + 0]].xyz;
+				const idVec3& v1 = tri->verts[tri->indexes[k + 1]].xyz;
+				const idVec3& v2 = tri->verts[tri->indexes[k + 2]].xyz;
+
+				const float area = 0.5f * ( ( v1 - v0 ).Cross( v2 - v0 ) ).Length();
+				if( area < minArea )
+				{
+					continue;
+				}
+
+				R_AddOccluderTriangle( occluders, v0, v1, v2 );
+				if( twoSided )
+				{
+					R_AddOccluderTriangle( occluders, v0, v2, v1 );
+				}
+			}
+		}
+
+		numTris += occluders.facePlanes.Num();
+	}
+
+	areaOccludersBuilt = true;
+
+	common->Printf( "%i occluder triangles in %i areas built in %i msec\n", numTris, numPortalAreas, Sys_Milliseconds() - startTime );
+}
+
+/*
+=====================
+idRenderWorldLocal::FreeAreaOccluders
+=====================
+*/
+void idRenderWorldLocal::FreeAreaOccluders()
+{
+	areaOccluders.Clear();
+	areaOccludersBuilt = false;
+}
+
+/*
+=====================
+idRenderWorldLocal::RasterizeAreaOccluders
+
+Rasterizes the occluders of all areas that were reached by the portal flow of the current view.
+=====================
+*/
+int idRenderWorldLocal::RasterizeAreaOccluders( idOcclusionBuffer& buffer, const idVec3& viewOrigin )
+{
+	if( !areaOccludersBuilt )
+	{
+		BuildAreaOccluders();
+	}
+
+	int numTris = 0;
+	for( int i = 0; i < areaOccluders.Num(); i++ )
+	{
+		if( portalAreas[i].viewCount != tr.viewCount )
+		{
+			continue;
+		}
+		const areaOccluders_t& occluders = areaOccluders[i];
+		if( occluders.indexes.Num() == 0 )
+		{
+			continue;
+		}
+		numTris += buffer.RasterizeTriangles( occluders.verts.Ptr(), occluders.indexes.Ptr(), occluders.facePlanes.Ptr(), occluders.indexes.Num(), viewOrigin );
+	}
+	return numTris;
+}
+
+/*
+==========================================================================================
+
+VIEW CULLING
+
+==========================================================================================
+*/
+
+/*
+=====================
+R_SoftwareOcclusionCull
+
+Rasterizes the world occluders of the visible areas and removes the view entities and
+view lights that are completely hidden behind them. Entities keep their viewEntity with
+an empty scissor rect, so they can still cast shadows into the view.
+
+The occlusion buffer stays attached to the viewDef, so the shadow-only
+entity / light pairs can be tested by R_AddLights and R_AddModels.
+=====================
+*/
+void R_SoftwareOcclusionCull()
+{
+	viewDef_t* viewDef = tr.viewDef;
+	viewDef->occlusionBuffer = NULL;
+
+	if( !r_useSoftwareOcclusion.GetBool() )
+	{
+		return;
+	}
+
+	// subviews are usually small and their portal flow already culls most of the world
+	if( viewDef->isSubview || viewDef->renderWorld == NULL || viewDef->areaNum < 0 )
+	{
+		return;
+	}
+
+	SCOPED_PROFILE_EVENT( "R_SoftwareOcclusionCull" );
+
+	const uint64 startTime = Sys_Microseconds();
+
+	const float zNear = ( viewDef->renderView.cramZNear ) ? ( r_znear.GetFloat() * 0.25f ) : r_znear.GetFloat();
+
+	idOcclusionBuffer& buffer = *tr.occlusionBuffer;
+	buffer.Clear( viewDef->worldSpace.mvp, zNear );
+	tr.pc.c_occluderTris += viewDef->renderWorld->RasterizeAreaOccluders( buffer, viewDef->renderView.vieworg );
+
+	if( buffer.IsEmpty() )
+	{
+		tr.pc.occlusionMicroSec += Sys_Microseconds() - startTime;
+		return;
+	}
+
+	viewDef->occlusionBuffer = &buffer;
+
+	//-------------------------------------------------
+	// entities
+	//-------------------------------------------------
+
+	for( viewEntity_t* vEntity = viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
+	{
+		if( vEntity->scissorRect.IsEmpty() )
+		{
+			continue;
+		}
+
+		const idRenderEntityLocal* entityDef = vEntity->entityDef;
+
+		// depth hacked models are drawn in front of the world
+		if( entityDef->parms.weaponDepthHack || entityDef->parms.modelDepthHack != 0.0f )
+		{
+			continue;
+		}
+
+		tr.pc.c_occlusionTestedEntities++;
+
+		idRenderMatrix mvp;
+		idRenderMatrix::Multiply( viewDef->worldSpace.mvp, entityDef->modelRenderMatrix, mvp );
+
+		if( buffer.IsOccluded( mvp, entityDef->localReferenceBounds ) )
+		{
+			vEntity->scissorRect.Clear();
+			tr.pc.c_occlusionCulledEntities++;
+		}
+	}
+
+	//-------------------------------------------------
+	// lights, a light that is completely hidden can only
+	// light and shadow surfaces that are hidden as well
+	//-------------------------------------------------
+
+	viewLight_t** ptr = &viewDef->viewLights;
+	while( *ptr != NULL )
+	{
+		viewLight_t* vLight = *ptr;
+
+		if( buffer.IsOccluded( viewDef->worldSpace.mvp, vLight->lightDef->globalLightBounds ) )
+		{
+			vLight->lightDef->viewCount = -1;
+			*ptr = vLight->next;
+			tr.pc.c_occlusionCulledLights++;
+			continue;
+		}
+
+		ptr = &vLight->next;
+	}
+
+	tr.pc.occlusionMicroSec += Sys_Microseconds() - startTime;
+}
+
+/*
+=====================
+R_CullShadowBoundsByOcclusion
+
+Returns true if the shadow of a shadow-only entity can only fall on hidden surfaces.
+May be run in parallel.
+=====================
+*/
+bool R_CullShadowBoundsByOcclusion( const viewDef_t* viewDef, const idBounds& shadowBounds )
+{
+	if( viewDef->occlusionBuffer == NULL )
+	{
+		return false;
+	}
+	if( !viewDef->occlusionBuffer->IsOccluded( viewDef->worldSpace.mvp, shadowBounds ) )
+	{
+		return false;
+	}
+	numOcclusionCulledShadows.Increment();
+	return true;
+}
+
+/*
+=====================
+R_FinishSoftwareOcclusionCull
+
+Adds the shadows culled by the parallel add model jobs to the performance counters.
+=====================
+*/
+void R_FinishSoftwareOcclusionCull()
+{
+	tr.pc.c_occlusionCulledShadows += numOcclusionCulledShadows.GetValue();
+	numOcclusionCulledShadows.SetValue( 0 );
+}
+
+/*
+==========================================================================================
+
+CORRECTNESS TEST
+
+==========================================================================================
+*/
+
+/*
+=====================
+R_TestOcclusionCase
+=====================
+*/
+static bool R_TestOcclusionCase( const idOcclusionBuffer& buffer, const idRenderMatrix& mvp, const char* name, const idBounds& bounds, bool expectOccluded )
+{
+	const bool occluded = buffer.IsOccluded( mvp, bounds );
+	if( occluded != expectOccluded )
+	{
+		idLib::Warning( "%s: expected %s", name, expectOccluded ? "occluded" : "visible" );
+		return false;
+	}
+	return true;
+}
+
+/*
+=====================
+R_TestSyntheticOcclusion
+
+A single square in front of the view with boxes placed around it.
+=====================
+*/
+static int R_TestSyntheticOcclusion( idOcclusionBuffer& buffer )
+{
+	idRenderMatrix viewMatrix;
+	idRenderMatrix projectionMatrix;
+	idRenderMatrix mvp;
+	idRenderMatrix::CreateViewMatrix( vec3_origin, mat3_identity, viewMatrix );
+	idRenderMatrix::CreateProjectionMatrixFov( 90.0f, 90.0f, 1.0f, 0.0f, 0.0f, 0.0f, projectionMatrix );
+	idRenderMatrix::Multiply( projectionMatrix, viewMatrix, mvp );
+
+	// a 100x100 square 100 units in front of the view
+	const idVec3 verts[4] =
+	{
+		idVec3( 100.0f, -50.0f, -50.0f ),
+		idVec3( 100.0f,  50.0f, -50.0f ),
+		idVec3( 100.0f,  50.0f,  50.0f ),
+		idVec3( 100.0f, -50.0f,  50.0f )
+	};
+	int indexes[6] = { 0, 1, 2, 0, 2, 3 };
+	idPlane planes[2];
+	for( int i = 0; i < 2; i++ )
+	{
+		planes[i] = idPlane( verts[indexes[i * 3 + 0]], verts[indexes[i * 3 + 1]], verts[indexes[i * 3 + 2]] );
+		if( planes[i].Distance( vec3_origin ) < 0.0f )
+		{
+			SwapValues( indexes[i * 3 + 1], indexes[i * 3 + 2] );
+			planes[i] = -planes[i];
+		}
+	}
+
+	int numFailed = 0;
+
+	buffer.Clear( mvp, 1.0f );
+	buffer.RasterizeTriangles( verts, indexes, planes, 6, vec3_origin );
+
+	// the pixels along the diagonal of the square aren't completely covered by either triangle
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind", idBounds( idVec3( 200, 10, -30 ), idVec3( 220, 30, -10 ) ), true );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind the diagonal", idBounds( idVec3( 200, -10, -10 ), idVec3( 220, 10, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "in front", idBounds( idVec3( 50, -10, -10 ), idVec3( 70, 10, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "crossing", idBounds( idVec3( 90, -10, -10 ), idVec3( 110, 10, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind but larger", idBounds( idVec3( 200, -150, -10 ), idVec3( 220, 150, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind and beside", idBounds( idVec3( 200, 150, -10 ), idVec3( 220, 170, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "around the view", idBounds( idVec3( -10, -10, -10 ), idVec3( 300, 10, 10 ) ), false );
+
+	// the same square seen from behind must not occlude anything
+	for( int i = 0; i < 2; i++ )
+	{
+		SwapValues( indexes[i * 3 + 1], indexes[i * 3 + 2] );
+		planes[i] = -planes[i];
+	}
+	buffer.Clear( mvp, 1.0f );
+	buffer.RasterizeTriangles( verts, indexes, planes, 6, vec3_origin );
+
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind a back face", idBounds( idVec3( 200, 10, -30 ), idVec3( 220, 30, -10 ) ), false );
+
+	// two large triangles with a crack narrower than a pixel between them must not close it
+	const idVec3 crackVerts[6] =
+	{
+		idVec3( 100.0f, -100.0f, -50.0f ),
+		idVec3( 100.0f,   -0.05f, -50.0f ),
+		idVec3( 100.0f,   -0.05f,  100.0f ),
+		idVec3( 100.0f,    0.05f, -50.0f ),
+		idVec3( 100.0f,  100.0f, -50.0f ),
+		idVec3( 100.0f,    0.05f,  100.0f )
+	};
+	int crackIndexes[6] = { 0, 1, 2, 3, 4, 5 };
+	for( int i = 0; i < 2; i++ )
+	{
+		planes[i] = idPlane( crackVerts[crackIndexes[i * 3 + 0]], crackVerts[crackIndexes[i * 3 + 1]], crackVerts[crackIndexes[i * 3 + 2]] );
+		if( planes[i].Distance( vec3_origin ) < 0.0f )
+		{
+			SwapValues( crackIndexes[i * 3 + 1], crackIndexes[i * 3 + 2] );
+			planes[i] = -planes[i];
+		}
+	}
+	buffer.Clear( mvp, 1.0f );
+	buffer.RasterizeTriangles( crackVerts, crackIndexes, planes, 6, vec3_origin );
+
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "behind a crack", idBounds( idVec3( 200, -1, -10 ), idVec3( 220, 1, 10 ) ), false );
+	numFailed += !R_TestOcclusionCase( buffer, mvp, "beside a crack", idBounds( idVec3( 200, -40, -10 ), idVec3( 220, -20, 10 ) ), true );
+
+	return numFailed;
+}
+
+/*
+=====================
+R_SegmentHitsOccluders
+
+Exact test of a line segment against the front facing occluder triangles.
+=====================
+*/
+static bool R_SegmentHitsOccluders( const idList<areaOccluders_t, TAG_RENDER>& areaOccluders, const idVec3& start, const idVec3& end )
+{
+	const idVec3 dir = end - start;
+
+	for( int i = 0; i < areaOccluders.Num(); i++ )
+	{
+		const areaOccluders_t& occluders = areaOccluders[i];
+		for( int j = 0; j < occluders.facePlanes.Num(); j++ )
+		{
+			const idPlane& plane = occluders.facePlanes[j];
+			if( plane.Distance( start ) < 0.0f )
+			{
+				continue;
+			}
+
+			const idVec3& v0 = occluders.verts[occluders.indexes[j * 3 + 0]];
+			const idVec3& v1 = occluders.verts[occluders.indexes[j * 3 + 1]];
+			const idVec3& v2 = occluders.verts[occluders.indexes[j * 3 + 2]];
+
+			// Moller-Trumbore
+			const idVec3 e1 = v1 - v0;
+			const idVec3 e2 = v2 - v0;
+			const idVec3 p = dir.Cross( e2 );
+			const float det = e1 * p;
+			if( idMath::Fabs( det ) < idMath::FLT_SMALLEST_NON_DENORMAL )
+			{
+				continue;
+			}
+			const float invDet = 1.0f / det;
+			const idVec3 s = start - v0;
+			const float u = ( s * p ) * invDet;
+			if( u < 0.0f || u > 1.0f )
+			{
+				continue;
+			}
+			const idVec3 q = s.Cross( e1 );
+			const float v = ( dir * q ) * invDet;
+			if( v < 0.0f || u + v > 1.0f )
+			{
+				continue;
+			}
+			const float t = ( e2 * q ) * invDet;
+			if( t > 0.0f && t < 1.0f )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/*
+=====================
+R_OcclusionFalsePositive
+
+Returns true if a box that was culled has a sample point inside the view
+that can be reached from the view origin without crossing an occluder.
+=====================
+*/
+static bool R_OcclusionFalsePositive( const idList<areaOccluders_t, TAG_RENDER>& areaOccluders, const idRenderMatrix& mvp, float zNear,
+									  const idRenderMatrix& modelMatrix, const idBounds& bounds, const idVec3& viewOrigin )
+{
+	// a 3x3x3 grid of points pulled slightly inside the box, so boxes resting on a wall are not tested on the wall itself
+	const idVec3 center = bounds.GetCenter();
+	for( int i = 0; i < 27; i++ )
+	{
+		idVec3 local;
+		local.x = bounds[0].x + ( bounds[1].x - bounds[0].x ) * ( i % 3 ) * 0.5f;
+		local.y = bounds[0].y + ( bounds[1].y - bounds[0].y ) * ( ( i / 3 ) % 3 ) * 0.5f;
+		local.z = bounds[0].z + ( bounds[1].z - bounds[0].z ) * ( i / 9 ) * 0.5f;
+		local = center + ( local - center ) * 0.99f;
+
+		idVec3 point;
+		modelMatrix.TransformPoint( local, point );
+
+		idVec4 clip;
+		mvp.TransformPoint( point, clip );
+		if( clip.w <= zNear || idMath::Fabs( clip.x ) > clip.w || idMath::Fabs( clip.y ) > clip.w )
+		{
+			continue;
+		}
+
+		if( !R_SegmentHitsOccluders( areaOccluders, viewOrigin, point ) )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+=====================
+testSoftwareOcclusion
+
+Checks the occlusion buffer against a few synthetic cases and then, if a map is loaded,
+against ray casts from the current view to every entity and light it culls. The buffer is
+built from the occluders of all areas, which can only cull more than the portal limited
+buffer used while rendering.
+=====================
+*/
+CONSOLE_COMMAND( testSoftwareOcclusion, "checks the software occlusion culling against exact ray casts from the current view", NULL )
+{
+	idOcclusionBuffer* buffer = tr.occlusionBuffer;
+	if( buffer == NULL )
+	{
+		idLib::Printf( "The renderer is not initialized\n" );
+		return;
+	}
+
+	const int numSyntheticFailed = R_TestSyntheticOcclusion( *buffer );
+	idLib::Printf( "synthetic cases: %s\n", numSyntheticFailed == 0 ? "passed" : va( "%i FAILED", numSyntheticFailed ) );
+
+	idRenderWorldLocal* world = tr.primaryWorld;
+	if( world == NULL || world->numPortalAreas == 0 || tr.primaryRenderView.fov_x == 0.0f )
+	{
+		idLib::Printf( "No map loaded, skipping the map test\n" );
+		return;
+	}
+
+	// set up the matrices the same way R_RenderView does
+	viewDef_t* viewDef = ( viewDef_t* )R_ClearedStaticAlloc( sizeof( *viewDef ) );
+	viewDef->renderView = tr.primaryRenderView;
+	viewDef->viewport.x2 = renderSystem->GetWidth() - 1;
+	viewDef->viewport.y2 = renderSystem->GetHeight() - 1;
+	R_SetupViewMatrix( viewDef );
+	R_SetupProjectionMatrix( viewDef );
+
+	idRenderMatrix projectionRenderMatrix;
+	idRenderMatrix viewRenderMatrix;
+	idRenderMatrix mvp;
+	idRenderMatrix::Transpose( *( idRenderMatrix* )viewDef->projectionMatrix, projectionRenderMatrix );
+	idRenderMatrix::Transpose( *( idRenderMatrix* )viewDef->worldSpace.modelViewMatrix, viewRenderMatrix );
+	idRenderMatrix::Multiply( projectionRenderMatrix, viewRenderMatrix, mvp );
+
+	const idVec3 viewOrigin = viewDef->renderView.vieworg;
+	const float zNear = ( viewDef->renderView.cramZNear ) ? ( r_znear.GetFloat() * 0.25f ) : r_znear.GetFloat();
+	R_StaticFree( viewDef );
+
+	if( !world->areaOccludersBuilt )
+	{
+		world->BuildAreaOccluders();
+	}
+
+	const int startTime = Sys_Microseconds();
+	buffer->Clear( mvp, zNear );
+	for( int i = 0; i < world->areaOccluders.Num(); i++ )
+	{
+		const areaOccluders_t& occluders = world->areaOccluders[i];
+		buffer->RasterizeTriangles( occluders.verts.Ptr(), occluders.indexes.Ptr(), occluders.facePlanes.Ptr(), occluders.indexes.Num(), viewOrigin );
+	}
+	const int rasterizeTime = Sys_Microseconds() - startTime;
+
+	int numTested = 0;
+	int numCulled = 0;
+	int numFalsePositives = 0;
+
+	for( int i = 0; i < world->entityDefs.Num(); i++ )
+	{
+		const idRenderEntityLocal* def = world->entityDefs[i];
+		if( def == NULL || def->parms.weaponDepthHack || def->parms.modelDepthHack != 0.0f )
+		{
+			continue;
+		}
+		if( idRenderMatrix::CullBoundsToMVP( mvp, def->globalReferenceBounds ) )
+		{
+			continue;
+		}
+
+		numTested++;
+
+		idRenderMatrix entityMVP;
+		idRenderMatrix::Multiply( mvp, def->modelRenderMatrix, entityMVP );
+		if( !buffer->IsOccluded( entityMVP, def->localReferenceBounds ) )
+		{
+			continue;
+		}
+
+		numCulled++;
+		if( R_OcclusionFalsePositive( world->areaOccluders, mvp, zNear, def->modelRenderMatrix, def->localReferenceBounds, viewOrigin ) )
+		{
+			idLib::Warning( "entity %i '%s' was culled but is visible", i, def->parms.hModel != NULL ? def->parms.hModel->Name() : "" );
+			numFalsePositives++;
+		}
+	}
+
+	idRenderMatrix identity;
+	identity.Identity();
+
+	for( int i = 0; i < world->lightDefs.Num(); i++ )
+	{
+		const idRenderLightLocal* light = world->lightDefs[i];
+		if( light == NULL || idRenderMatrix::CullBoundsToMVP( mvp, light->globalLightBounds ) )
+		{
+			continue;
+		}
+
+		numTested++;
+
+		if( !buffer->IsOccluded( mvp, light->globalLightBounds ) )
+		{
+			continue;
+		}
+
+		numCulled++;
+		if( R_OcclusionFalsePositive( world->areaOccluders, mvp, zNear, identity, light->globalLightBounds, viewOrigin ) )
+		{
+			idLib::Warning( "light %i '%s' was culled but is visible", i, light->lightShader != NULL ? light->lightShader->GetName() : "" );
+			numFalsePositives++;
+		}
+	}
+
+	idLib::Printf( "%s: %i occluder tris rasterized in %i usec\n", world->mapName.c_str(), buffer->GetNumRasterizedTriangles(), rasterizeTime );
+	idLib::Printf( "%i entities and lights in the view frustum, %i culled, %i false positives\n", numTested, numCulled, numFalsePositives );
+
+	// the next view rebuilds the buffer with its own matrix
+	buffer->Clear( mvp, zNear );
+}
@@ -85,7 +85,28 @@ Sys_GetProcessorId
 */
 cpuid_t Sys_GetProcessorId()
 {
-	return CPUID_GENERIC;
+	int flags = CPUID_GENERIC;
+
+	// the AVX2 kernels are compiled for any x86 target and picked at run time with these
+#if defined(__x86_64__) || defined(__i386__)
+	static int avxFlags = -1;
+	if( avxFlags < 0 )
+	{
+		__builtin_cpu_init();
+		avxFlags = 0;
+		if( __builtin_cpu_supports( "avx2" ) )
+		{
+			avxFlags |= CPUID_AVX2;
+		}
+		if( __builtin_cpu_supports( "fma" ) )
+		{
+			avxFlags |= CPUID_FMA;
+		}
+	}
+	flags |= avxFlags;
+#endif
+
+	return ( cpuid_t )flags;
 }
 
 /*
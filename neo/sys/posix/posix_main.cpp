@@ -842,6 +842,30 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return st.st_mtime;
 }
 
+const void* Sys_MapFile( idFileHandle fp, size_t length, void** mapping )
+{
+	*mapping = NULL;
+	if( fp == NULL || length == 0 )
+	{
+		return NULL;
+	}
+
+	void* data = mmap( NULL, length, PROT_READ, MAP_PRIVATE, fileno( fp ), 0 );
+	if( data == MAP_FAILED )
+	{
+		return NULL;
+	}
+	return data;
+}
+
+void Sys_UnmapFile( const void* data, size_t length, void* mapping )
+{
+	if( data != NULL )
+	{
+		munmap( const_cast< void* >( data ), length );
+	}
+}
+
 void Sys_Sleep( int msec )
 {
 #if 0 // DG: I don't really care, this spams the console (and on windows this case isn't handled either)
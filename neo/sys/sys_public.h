@@ -58,7 +58,9 @@ enum cpuid_t
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
 	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
 	CPUID_XENON							= 0x10000,	// Xbox 360
-	CPUID_CELL							= 0x20000	// PS3
+	CPUID_CELL							= 0x20000,	// PS3
+	CPUID_AVX2							= 0x40000,	// Advanced Vector Extensions 2, only set if the OS saves the YMM registers
+	CPUID_FMA							= 0x80000	// Fused Multiply-Add (FMA3), only set if the OS saves the YMM registers
 };
 
 enum fpuExceptions_t
@@ -893,6 +895,12 @@ void			Sys_ShowConsole( int visLevel, bool quitOnClose );
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// Maps length bytes of an open file read-only into the address space. The returned
+// pointer stays valid until Sys_UnmapFile, even if the file handle is closed.
+// Returns NULL if the platform or the file doesn't support mapping.
+const void* 	Sys_MapFile( idFileHandle fp, size_t length, void** mapping );
+void			Sys_UnmapFile( const void* data, size_t length, void* mapping );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char* 	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char* 	Sys_SecToStr( int sec );
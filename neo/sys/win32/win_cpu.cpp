@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "win_local.h"
 
+#include <intrin.h>
+
 #pragma warning(disable:4740)	// warning C4740: flow in or out of inline asm code suppresses global optimization
 #pragma warning(disable:4731)	// warning C4731: 'XXX' : frame pointer register 'ebx' modified by inline assembly code
 
@@ -765,6 +767,41 @@ void Sys_CPUCount( int & numLogicalCPUCores, int & numPhysicalCPUCores, int & nu
 	numCPUPackages = cpuInfo.processorPackageCount;
 }
 
+/*
+================
+HasAVX2AndFMA
+
+  sets CPUID_AVX2 and CPUID_FMA, both are only usable if the OS saves the YMM registers
+================
+*/
+static int HasAVX2AndFMA() {
+	int regs[4];
+
+	__cpuid( regs, 0 );
+	if ( regs[_REG_EAX] < 7 ) {
+		return 0;
+	}
+
+	__cpuid( regs, 1 );
+	const int osxsaveAVX = ( 1 << 27 ) | ( 1 << 28 );
+	if ( ( regs[_REG_ECX] & osxsaveAVX ) != osxsaveAVX || ( _xgetbv( 0 ) & 6 ) != 6 ) {
+		return 0;
+	}
+
+	int flags = 0;
+	// bit 12 of ECX denotes FMA existence
+	if ( regs[_REG_ECX] & ( 1 << 12 ) ) {
+		flags |= CPUID_FMA;
+	}
+
+	// bit 5 of EBX of leaf 7 denotes AVX2 existence
+	__cpuidex( regs, 7, 0 );
+	if ( regs[_REG_EBX] & ( 1 << 5 ) ) {
+		flags |= CPUID_AVX2;
+	}
+	return flags;
+}
+
 /*
 ================
 Sys_GetCPUId
@@ -779,6 +816,9 @@ cpuid_t Sys_GetCPUId()
 	flags |= CPUID_SSE;
 	flags |= CPUID_SSE2;
 
+	// check for AVX2 and FMA
+	flags |= HasAVX2AndFMA();
+
 	return (cpuid_t)flags;
 #else
 	int flags;
@@ -835,6 +875,9 @@ cpuid_t Sys_GetCPUId()
 		flags |= CPUID_DAZ;
 	}
 
+	// check for AVX2 and FMA
+	flags |= HasAVX2AndFMA();
+
 	return (cpuid_t)flags;
 #endif
 }
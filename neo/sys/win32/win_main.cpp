@@ -549,6 +549,53 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return itime.QuadPart;
 }
 
+/*
+=================
+Sys_MapFile
+=================
+*/
+const void* Sys_MapFile( idFileHandle fp, size_t length, void** mapping )
+{
+	*mapping = NULL;
+	if( fp == INVALID_HANDLE_VALUE || fp == NULL || length == 0 )
+	{
+		return NULL;
+	}
+
+	HANDLE fileMapping = CreateFileMapping( fp, NULL, PAGE_READONLY, 0, 0, NULL );
+	if( fileMapping == NULL )
+	{
+		return NULL;
+	}
+
+	const void* data = MapViewOfFile( fileMapping, FILE_MAP_READ, 0, 0, length );
+	if( data == NULL )
+	{
+		CloseHandle( fileMapping );
+		return NULL;
+	}
+
+	*mapping = fileMapping;
+	return data;
+}
+
+/*
+=================
+Sys_UnmapFile
+=================
+*/
+void Sys_UnmapFile( const void* data, size_t length, void* mapping )
+{
+	if( data != NULL )
+	{
+		UnmapViewOfFile( data );
+	}
+	if( mapping != NULL )
+	{
+		CloseHandle( ( HANDLE )mapping );
+	}
+}
+
 /*
 ========================
 Sys_Rmdir
@@ -1659,6 +1706,14 @@ void Sys_Init()
 		{
 			string += "SSE3 & ";
 		}
+		if( win32.cpuid & CPUID_AVX2 )
+		{
+			string += "AVX2 & ";
+		}
+		if( win32.cpuid & CPUID_FMA )
+		{
+			string += "FMA & ";
+		}
 		if( win32.cpuid & CPUID_HTT )
 		{
 			string += "HTT & ";
@@ -1708,6 +1763,14 @@ void Sys_Init()
 			{
 				id |= CPUID_SSE3;
 			}
+			else if( token.Icmp( "avx2" ) == 0 )
+			{
+				id |= CPUID_AVX2;
+			}
+			else if( token.Icmp( "fma" ) == 0 )
+			{
+				id |= CPUID_FMA;
+			}
 			else if( token.Icmp( "htt" ) == 0 )
 			{
 				id |= CPUID_HTT;